@@ -3,13 +3,32 @@
 
 from setuptools import setup
 from numpy.distutils.core import setup, Extension
-import os, platform
+import os, platform, subprocess, sys
+
+srcdir = os.path.join('src', 'offshorebos')
+
+# Run a generator script when its header is missing or older than one of the files it is made from, as
+# the Makefile does, so that the headers in the source tree are not rewritten on every run
+def generate(script, header, sources):
+    paths = [os.path.join(srcdir, f) for f in [script] + sources]
+    target = os.path.join(srcdir, header)
+    if (not os.path.exists(target)) or any(os.path.getmtime(f) > os.path.getmtime(target) for f in paths):
+        subprocess.check_call([sys.executable, paths[0]])
+
+# Compile the variable defaults from wind_obos_defaults.csv into the library
+generate('make_defaults_table.py', 'lib_wind_obos_defaults_table.h', ['wind_obos_defaults.csv'])
+
+# List the variables used by each stage of the model, for incremental runs
+generate('make_stage_deps.py', 'lib_wind_obos_stage_deps.h', ['lib_wind_obos.cpp', 'lib_wind_obos.h', 'lib_wind_obos_variables.h'])
 
 
 if platform.system() == 'Windows':
-    arglist = ['-std=gnu++11','-fPIC']
+    arglist = ['-std=gnu++11','-fPIC','-pthread']
 else:
-    arglist = ['-std=c++11','-fPIC']
+    arglist = ['-std=c++11','-fPIC','-pthread']
+
+# Stage timings inside run() (see lib_wind_obos_profile.h), e.g. WOBOS_PROFILE=1 python setup.py install
+macros = [('WOBOS_PROFILE', None)] if os.environ.get('WOBOS_PROFILE') else []
 
 setup(
     name='OffshoreBOS',
@@ -24,7 +43,22 @@ setup(
     license='Apache License, Version 2.0',
     ext_modules=[Extension('lib_wind_obos', ['src/offshorebos/lib_wind_obos.cpp',
                                              'src/offshorebos/lib_wind_obos_cable_vessel.cpp',
-                                             'src/offshorebos/lib_wind_obos_defaults.cpp'],
-                           extra_compile_args=arglist)],
+                                             'src/offshorebos/lib_wind_obos_defaults.cpp',
+                                             'src/offshorebos/lib_wind_obos_batch.cpp',
+                                             'src/offshorebos/lib_wind_obos_cable_cost.cpp',
+                                             'src/offshorebos/lib_wind_obos_jacobian.cpp',
+                                             'src/offshorebos/lib_wind_obos_cable_cache.cpp',
+                                             'src/offshorebos/lib_wind_obos_stats.cpp',
+                                             'src/offshorebos/lib_wind_obos_montecarlo.cpp',
+                                             'src/offshorebos/lib_wind_obos_sensitivity.cpp',
+                                             'src/offshorebos/lib_wind_obos_substructure.cpp',
+                                             'src/offshorebos/lib_wind_obos_install_sim.cpp',
+                                             'src/offshorebos/lib_wind_obos_weather.cpp',
+                                             'src/offshorebos/lib_wind_obos_weather_sweep.cpp',
+                                             'src/offshorebos/lib_wind_obos_array_layout.cpp',
+                                             'src/offshorebos/lib_wind_obos_python.cpp'],
+                           define_macros=macros,
+                           extra_compile_args=arglist,
+                           extra_link_args=['-pthread'])],
     zip_safe=False
 )
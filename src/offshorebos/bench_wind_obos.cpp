@@ -0,0 +1,400 @@
+// Micro-benchmarks of the wobos hot paths over a corpus of plant scenarios (make bench).
+//
+// Usage: bench_wind_obos.exe [-c corpus.csv] [-t seconds] [-f filter] [-o results.csv] [-b baseline.csv]
+//   -c  scenario corpus, one plant per row (default wind_obos_bench_scenarios.csv)
+//   -t  minimum measured time per benchmark and scenario (default 0.05 s)
+//   -f  only run the benchmarks whose name contains this string
+//   -o  write the results as csv, e.g. to serve as the baseline of a later run
+//   -b  compare against the results of an earlier run
+//
+// Every benchmark reports the time per operation, heap allocations per operation (every operator new in
+// the process is counted) and operations per second.  Benchmarks of a model stage restore the scenario
+// inputs and run the stages before it outside of the timed region, so each timed call sees the same state
+// that it sees within run().  The cable optimizer cache is off except in run_cable_cache, so that the other
+// benchmarks keep timing the optimizers themselves.  Timings are only meaningful for an optimized build, e.g.
+//   make clean; make bench CCFLAGS="-O2 -std=c++11 -fPIC -pthread"
+
+#include "lib_wind_obos.h"
+#include "lib_wind_obos_cable_cache.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <map>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+using namespace std;
+
+
+// Count heap allocations
+static atomic<size_t> nAllocations(0);
+
+void* operator new(size_t size) {
+  nAllocations.fetch_add(1, memory_order_relaxed);
+  void* p = malloc(size ? size : 1);
+  if (!p) throw bad_alloc();
+  return p;
+}
+void* operator new[](size_t size) {return operator new(size);}
+void operator delete(void* p) noexcept {free(p);}
+void operator delete[](void* p) noexcept {free(p);}
+
+
+// Helper for string parsing
+static string trim(const string& str, const string& whitespace = " \t\r") {
+  const auto strBegin = str.find_first_not_of(whitespace);
+  if (strBegin == std::string::npos) return "";
+  const auto strEnd = str.find_last_not_of(whitespace);
+  return str.substr(strBegin, strEnd - strBegin + 1);
+}
+
+static vector<string> split_csv(const string &line) {
+  vector<string> out;
+  stringstream lineStream(line);
+  string cell;
+  while (getline(lineStream, cell, ',')) out.push_back(trim(cell));
+  return out;
+}
+
+
+// A plant from the corpus: the variable table of a wobos object with the scenario applied
+struct bench_scenario {
+  string name;
+  vector<double> varValues;
+};
+
+static vector<bench_scenario> read_corpus(const string &fname);
+
+
+// Measured cost of one benchmark on one scenario
+struct bench_result {
+  string benchmark;
+  string scenario;
+  size_t iterations;
+  double nsPerOp;
+  double allocsPerOp;
+};
+
+
+// One benchmark.  prepare (optional) runs before every timed call of op and is not measured.
+struct bench_case {
+  string name;
+  function<void(wobos&)> prepare;
+  function<void(wobos&)> op;
+};
+
+
+// Access to the model stages, which are private to wobos
+class wobos_bench {
+ public:
+  static vector<bench_case> cases(const bench_scenario &scen);
+  static void reset(wobos &obos, const bench_scenario &scen, size_t cableCache=0);
+
+ private:
+  typedef void (wobos::*stage)();
+  static const vector<pair<string, stage>>& stages();
+};
+
+
+// The stages of run(), in order
+const vector<pair<string, wobos_bench::stage>>& wobos_bench::stages() {
+  static const vector<pair<string, stage>> out {
+    {"set_turbine_parameters",                 &wobos::set_turbine_parameters},
+    {"calculate_substructure_mass_cost",       &wobos::calculate_substructure_mass_cost},
+    {"calculate_electrical_infrastructure_cost", &wobos::calculate_electrical_infrastructure_cost},
+    {"calculate_assembly_and_installation",    &wobos::calculate_assembly_and_installation},
+    {"calculate_port_and_staging_costs",       &wobos::calculate_port_and_staging_costs},
+    {"calculate_engineering_management_cost",  &wobos::calculate_engineering_management_cost},
+    {"calculate_development_cost",             &wobos::calculate_development_cost},
+    {"calculate_bos_cost",                     &wobos::calculate_bos_cost}};
+  return out;
+}
+
+
+// Same sequence as the Python wrapper before a run, from the scenario inputs.  Cached cable choices are
+// dropped unless the cable cache is given a capacity.
+void wobos_bench::reset(wobos &obos, const bench_scenario &scen, size_t cableCache) {
+  cable_choice_cache::shared().set_capacity(cableCache);
+  copy(scen.varValues.begin(), scen.varValues.end(), obos.varValues);
+  obos.map2variables();
+  obos.set_vessel_defaults();
+}
+
+
+vector<bench_case> wobos_bench::cases(const bench_scenario &scen) {
+  vector<bench_case> out;
+
+  out.push_back({"construct", nullptr, [] (wobos &obos) {wobos tmp; obos.total_bos_cost += tmp.nTurb;}});
+  out.push_back({"map2variables", nullptr, [] (wobos &obos) {obos.map2variables();}});
+  out.push_back({"variables2map", nullptr, [] (wobos &obos) {obos.variables2map();}});
+
+  // Each stage of run() from the state left by the stages before it
+  const vector<pair<string, stage>> &s = stages();
+  for (size_t k=0; k<s.size(); k++)
+    out.push_back({s[k].first,
+	  [&scen, &s, k] (wobos &obos) {reset(obos, scen); for (size_t i=0; i<k; i++) (obos.*(s[i].second))();},
+	  [&s, k] (wobos &obos) {(obos.*(s[k].second))();}});
+
+  // The substructure kernel over 1024 water depths between half and one and a half times the plant's
+  const size_t nGrid = 1024;
+  shared_ptr<vector<double>> depths(new vector<double>(nGrid)), mass(new vector<double>(nGrid)), cost(new vector<double>(nGrid));
+  for (size_t k=0; k<nGrid; k++) (*depths)[k] = scen.varValues[wobos::variable_index("waterD")] * (0.5 + (double)k/nGrid);
+  out.push_back({"substructure_mass_cost_1024",
+	[&scen] (wobos &obos) {reset(obos, scen);},
+	[depths, mass, cost] (wobos &obos) {
+	  obos.substructure_mass_cost(depths->size(), NULL, &(*depths)[0], NULL, NULL, &(*mass)[0], &(*cost)[0]);
+	}});
+
+  // The installation simulation of the plant's turbines, scaled up to 10000 of them
+  out.push_back({"install_simulation_10000",
+	[&scen] (wobos &obos) {reset(obos, scen); obos.run();},
+	[] (wobos &obos) {
+	  install_campaign c = obos.turbine_install_campaign();
+	  c.nUnits = 10000;
+	  obos.total_bos_cost += obos.installSim.simulate(c).hours;
+	}});
+
+  // The optimizers from the state they see within a run with the cable optimizer switched on
+  out.push_back({"ArrayCabCostOptimizer",
+	[&scen] (wobos &obos) {reset(obos, scen); obos.run();},
+	[] (wobos &obos) {obos.ArrayCabCostOptimizer();}});
+  out.push_back({"ExportCabCostOptimizer",
+	[&scen] (wobos &obos) {reset(obos, scen); obos.run();},
+	[] (wobos &obos) {obos.ExportCabCostOptimizer();}});
+
+  out.push_back({"run",
+	[&scen] (wobos &obos) {reset(obos, scen);},
+	[] (wobos &obos) {obos.run();}});
+
+  // Repeated runs of the same plant, which find their cable choices in the cache after the first one
+  out.push_back({"run_cable_cache",
+	[&scen] (wobos &obos) {reset(obos, scen, 1024);},
+	[] (wobos &obos) {obos.run();}});
+
+  // Incremental runs with nothing changed, and in sweeps that nudge one input on every call
+  out.push_back({"run_incremental",
+	[&scen] (wobos &obos) {reset(obos, scen);},
+	[] (wobos &obos) {obos.run_incremental();}});
+  for (const char* name : {"distPort", "laydownCR"}) {
+    const int id = wobos::variable_index(name);
+    size_t step = 0;
+    out.push_back({string("run_incremental_") + name,
+	  [&scen, id, step] (wobos &obos) mutable {
+	    reset(obos, scen);
+	    *obos.variable_member(id) = scen.varValues[id] * (1.0 + 1e-3*(step++ % 2));
+	  },
+	  [] (wobos &obos) {obos.run_incremental();}});
+  }
+  return out;
+}
+
+
+static vector<bench_scenario> read_corpus(const string &fname) {
+  ifstream infile(fname.c_str());
+  if (!infile.is_open()) throw runtime_error("Cannot open scenario corpus: " + fname);
+
+  vector<bench_scenario> out;
+  vector<string> header;
+  string line;
+  while (getline(infile, line)) {
+    // Skip comments and empty lines
+    string::size_type n = line.find("#");
+    if (n != string::npos) line.erase(n);
+    if (trim(line).empty()) continue;
+
+    vector<string> row = split_csv(line);
+    if (header.empty()) {
+      header = row;
+      for (size_t k=1; k<header.size(); k++)
+	if (wobos::variable_index(header[k]) < 0) throw invalid_argument("Unknown variable in scenario corpus: " + header[k]);
+      continue;
+    }
+    if (row.size() != header.size()) throw invalid_argument("Wrong number of columns in scenario corpus: " + row[0]);
+
+    // Enumerated values are given by name, everything else as a number
+    wobos obos;
+    for (size_t k=1; k<row.size(); k++) {
+      char *end;
+      double val = strtod(row[k].c_str(), &end);
+      if (!row[k].empty() && (*end == '\0')) obos.set_map_variable(header[k], val);
+      else {
+	string valStr(row[k]);
+	transform(valStr.begin(), valStr.end(), valStr.begin(), ::toupper);
+	obos.set_map_variable(header[k], valStr);
+      }
+    }
+
+    bench_scenario scen;
+    scen.name = row[0];
+    for (int k=0; k<NVARIABLES; k++) scen.varValues.push_back(obos.get_map_variable(k));
+    out.push_back(scen);
+  }
+  return out;
+}
+
+
+typedef chrono::steady_clock bench_clock;
+
+static double elapsed_ns(bench_clock::time_point t0, bench_clock::time_point t1) {
+  return chrono::duration<double, nano>(t1 - t0).count();
+}
+
+
+// Cost of reading the clock twice, which is taken off every individually timed call
+static double clock_overhead_ns() {
+  const size_t n = 100000;
+  double total = 0.0;
+  for (size_t k=0; k<n; k++) {
+    bench_clock::time_point t0 = bench_clock::now();
+    bench_clock::time_point t1 = bench_clock::now();
+    total += elapsed_ns(t0, t1);
+  }
+  return total / n;
+}
+
+
+static bench_result measure(const bench_case &bc, const bench_scenario &scen, double minTime, double clockNs) {
+  bench_result res;
+  res.benchmark = bc.name;
+  res.scenario  = scen.name;
+
+  wobos obos;
+  wobos_bench::reset(obos, scen);
+  obos.run();
+
+  const double minNs = 1e9 * minTime;
+  double totalNs = 0.0;
+  size_t allocs  = 0;
+  size_t n       = 0;
+
+  if (!bc.prepare) {
+    // Time batches of calls, doubling the batch until it takes long enough
+    bc.op(obos);
+    for (size_t batch=1; ; batch*=2) {
+      size_t a0 = nAllocations.load(memory_order_relaxed);
+      bench_clock::time_point t0 = bench_clock::now();
+      for (size_t k=0; k<batch; k++) bc.op(obos);
+      bench_clock::time_point t1 = bench_clock::now();
+      allocs  = nAllocations.load(memory_order_relaxed) - a0;
+      totalNs = elapsed_ns(t0, t1);
+      n       = batch;
+      if (totalNs >= minNs) break;
+    }
+  }
+  else {
+    // Time every call on its own, as prepare has to run in between.  Stop once the calls add up to
+    // minTime, or the whole loop (mostly prepare) has taken twice that.
+    bench_clock::time_point start = bench_clock::now();
+    for (n=0; (n < 10) || ((totalNs < minNs) && (elapsed_ns(start, bench_clock::now()) < 2*minNs)); n++) {
+      bc.prepare(obos);
+      size_t a0 = nAllocations.load(memory_order_relaxed);
+      bench_clock::time_point t0 = bench_clock::now();
+      bc.op(obos);
+      bench_clock::time_point t1 = bench_clock::now();
+      allocs  += nAllocations.load(memory_order_relaxed) - a0;
+      totalNs += max(0.0, elapsed_ns(t0, t1) - clockNs);
+    }
+  }
+
+  res.iterations  = n;
+  res.nsPerOp     = totalNs / n;
+  res.allocsPerOp = double(allocs) / n;
+  return res;
+}
+
+
+static map<string, double> read_baseline(const string &fname) {
+  ifstream infile(fname.c_str());
+  if (!infile.is_open()) throw runtime_error("Cannot open baseline results: " + fname);
+
+  map<string, double> out;
+  string line;
+  getline(infile, line);  // header
+  while (getline(infile, line)) {
+    vector<string> row = split_csv(line);
+    if (row.size() < 4) continue;
+    out[row[0] + "," + row[1]] = atof(row[3].c_str());
+  }
+  return out;
+}
+
+
+int main(int argc, char** argv) {
+  string corpusFile("wind_obos_bench_scenarios.csv");
+  string filter, outFile, baseFile;
+  double minTime = 0.05;
+
+  for (int k=1; k<argc; k++) {
+    string arg(argv[k]);
+    if (k+1 >= argc) {cout << "Missing value for " << arg << endl; return 1;}
+    if (arg == "-c") corpusFile = argv[++k];
+    else if (arg == "-t") minTime = atof(argv[++k]);
+    else if (arg == "-f") filter = argv[++k];
+    else if (arg == "-o") outFile = argv[++k];
+    else if (arg == "-b") baseFile = argv[++k];
+    else {cout << "Unknown option " << arg << endl; return 1;}
+  }
+
+  vector<bench_scenario> corpus;
+  map<string, double> baseline;
+  try {
+    corpus = read_corpus(corpusFile);
+    if (!baseFile.empty()) baseline = read_baseline(baseFile);
+  } catch(exception& e) {
+    cout << e.what() << endl;
+    return 1;
+  }
+
+#ifndef __OPTIMIZE__
+  cout << "WARNING: benchmark built without optimization" << endl;
+#endif
+  const double clockNs = clock_overhead_ns();
+  cout << corpus.size() << " scenarios from " << corpusFile << ", clock overhead " << fixed << setprecision(1) << clockNs << " ns" << endl << endl;
+
+  cout << left << setw(42) << "benchmark" << setw(20) << "scenario" << right << setw(10) << "iters"
+       << setw(14) << "ns/op" << setw(12) << "allocs/op" << setw(14) << "ops/s";
+  if (!baseline.empty()) cout << setw(10) << "change";
+  cout << endl;
+
+  vector<bench_result> results;
+  for (size_t s=0; s<corpus.size(); s++) {
+    vector<bench_case> cases = wobos_bench::cases(corpus[s]);
+    for (size_t k=0; k<cases.size(); k++) {
+      if (!filter.empty() && (cases[k].name.find(filter) == string::npos)) continue;
+
+      bench_result res = measure(cases[k], corpus[s], minTime, clockNs);
+      results.push_back(res);
+
+      cout << left << setw(42) << res.benchmark << setw(20) << res.scenario << right << setw(10) << res.iterations
+	   << setprecision(1) << setw(14) << res.nsPerOp << setprecision(2) << setw(12) << res.allocsPerOp
+	   << setprecision(0) << setw(14) << (res.nsPerOp > 0.0 ? 1e9 / res.nsPerOp : 0.0);
+      map<string, double>::const_iterator it = baseline.find(res.benchmark + "," + res.scenario);
+      if ((it != baseline.end()) && (it->second > 0.0))
+	cout << setprecision(1) << setw(9) << showpos << 100.0*(res.nsPerOp / it->second - 1.0) << noshowpos << "%";
+      cout << endl;
+    }
+  }
+
+  if (!outFile.empty()) {
+    ofstream outfile(outFile.c_str());
+    outfile << "benchmark,scenario,iterations,ns_per_op,allocs_per_op,ops_per_s" << endl;
+    outfile << setprecision(6) << defaultfloat;
+    for (size_t k=0; k<results.size(); k++)
+      outfile << results[k].benchmark << "," << results[k].scenario << "," << results[k].iterations << ","
+	      << results[k].nsPerOp << "," << results[k].allocsPerOp << ","
+	      << (results[k].nsPerOp > 0.0 ? 1e9 / results[k].nsPerOp : 0.0) << endl;
+  }
+
+  return 0;
+}
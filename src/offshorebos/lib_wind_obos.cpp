@@ -48,6 +48,8 @@
 *******************************************************************************************************/
 
 #include "lib_wind_obos.h"
+#include "lib_wind_obos_stage_deps.h"
+#include "lib_wind_obos_cable_cache.h"
 
 #include <iostream>
 #include <fstream>
@@ -58,7 +60,12 @@
 #include <tuple>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <memory>
 #include <algorithm>
+#include <type_traits>
+#include <cstring>
+#include <limits>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846264338327
@@ -74,37 +81,212 @@ using namespace std;
 extern "C" {
   wobos* pywobos_new() {return new wobos();}
   void pywobos_run(wobos* obos) {obos->run();}
+  void pywobos_run_incremental(wobos* obos) {obos->run_incremental();}
   void pywobos_set_vessel_defaults(wobos* obos) {obos->set_vessel_defaults();}
   void pywobos_map2variables(wobos* obos) {obos->map2variables();}
   void pywobos_variables2map(wobos* obos) {obos->variables2map();}
   void pywobos_set_map_variable(wobos* obos, const char* key, double val) {obos->set_map_variable(key, val);}
   double pywobos_get_map_variable(wobos* obos, const char* key) {return obos->get_map_variable(key);}
+  int pywobos_variable_index(const char* key) {return wobos::variable_index(string(key));}
+  void pywobos_set_variable(wobos* obos, int id, double val) {obos->set_map_variable(id, val);}
+  double pywobos_get_variable(wobos* obos, int id) {return obos->get_map_variable(id);}
+  int pywobos_nvariables() {return NVARIABLES;}
+  const char* pywobos_variable_name(int id) {return wobos::variable_name(id);}
+  int pywobos_variable_flags(int id) {return wobos::variable_flags(id);}
+  int pywobos_variable_percent_flag() {return VAR_PERCENT;}
+  double* pywobos_variables(wobos* obos) {return obos->variable_values();}
+  int pywobos_profile_enabled() {return wobos_profile::enabled() ? 1 : 0;}
+  int pywobos_profile_nstages() {return NSTAGES;}
+  const char* pywobos_profile_stage_name(int stage) {return wobos_profile::stage_name(stage);}
+  void pywobos_profile_get(wobos* obos, double* calls, double* seconds, double* candidates) {
+    copy(obos->profile.calls, obos->profile.calls + NSTAGES, calls);
+    copy(obos->profile.seconds, obos->profile.seconds + NSTAGES, seconds);
+    copy(obos->profile.candidates, obos->profile.candidates + NSTAGES, candidates);
+  }
+  void pywobos_profile_reset(wobos* obos) {obos->profile.reset();}
+  void pywobos_cable_cache_clear() {cable_choice_cache::shared().clear();}
+  size_t pywobos_cable_cache_size() {return cable_choice_cache::shared().size();}
+  size_t pywobos_cable_cache_capacity() {return cable_choice_cache::shared().capacity();}
+  void pywobos_cable_cache_set_capacity(size_t n) {cable_choice_cache::shared().set_capacity(n);}
+  void pywobos_cable_cache_stats(unsigned long long* hits, unsigned long long* misses) {cable_choice_cache::shared().stats(*hits, *misses);}
+  int pywobos_set_weather(wobos* obos, size_t n, const double* wind, const double* wave) {
+    if (n == 0) obos->weather.reset();
+    else obos->weather = make_shared<const wobos_weather>(vector<double>(wind, wind + n), vector<double>(wave, wave + n));
+    return 1;
+  }
+  int pywobos_read_weather(wobos* obos, const char* fname) {
+    try {
+      obos->weather = wobos_weather::open(string(fname));
+      return 1;
+    } catch(exception& e) {
+      cout << e.what() << endl;
+      return 0;
+    }
+  }
+  size_t pywobos_weather_hours(wobos* obos) {return obos->weather ? obos->weather->hours() : 0;}
+  // Turbine, substructure and cable rows of hours, mean, p50, p90, max and contingency
+  int pywobos_weather_delays(wobos* obos, double* delays) {
+    try {
+      weather_delay d[3];
+      obos->weather_delays(d[0], d[1], d[2]);
+      for (int k=0; k<3; k++) {
+	double row[] = {d[k].hours, d[k].mean, d[k].p50, d[k].p90, d[k].max, d[k].contingency};
+	copy(row, row + 6, delays + 6*k);
+      }
+      return 1;
+    } catch(exception& e) {
+      cout << e.what() << endl;
+      return 0;
+    }
+  }
+  int pywobos_set_weather_contingencies(wobos* obos) {
+    try {
+      obos->set_weather_contingencies();
+      return 1;
+    } catch(exception& e) {
+      cout << e.what() << endl;
+      return 0;
+    }
+  }
+  // Also sets nTurb to match the layout; nTurb == 0 goes back to the grid
+  int pywobos_set_array_layout(wobos* obos, size_t nTurb, const double* turbX, const double* turbY,
+			       size_t nSubs, const double* subsX, const double* subsY) {
+    try {
+      if (nTurb == 0) obos->arrayLayout.reset();
+      else {
+	obos->arrayLayout = make_shared<const wobos_array_layout>(vector<double>(turbX, turbX + nTurb), vector<double>(turbY, turbY + nTurb),
+								  vector<double>(subsX, subsX + nSubs), vector<double>(subsY, subsY + nSubs));
+	obos->set_map_variable("nTurb", (double)nTurb);
+      }
+      return 1;
+    } catch(exception& e) {
+      cout << e.what() << endl;
+      return 0;
+    }
+  }
+  int pywobos_substructure_mass_cost(wobos* obos, size_t n, const double* turbR, const double* waterD, const double* hubH,
+				     const double* rnaM, double* mass, double* cost) {
+    try {
+      obos->substructure_mass_cost(n, turbR, waterD, hubH, rnaM, mass, cost);
+      return 1;
+    } catch(exception& e) {
+      cout << e.what() << endl;
+      return 0;
+    }
+  }
+}
+
+
+// Binding of each entry in lib_wind_obos_variables.h to its class member.  Exactly one of the
+// member pointers is set, depending on the member type.
+template <class T> struct wobos_binding {
+  const char* name;
+  int flags;
+  T wobos_t<T>::*dval;
+  int wobos_t<T>::*ival;
+  bool wobos_t<T>::*bval;
+
+  static constexpr wobos_binding make(const char* name, int flags, T wobos_t<T>::*p) {return {name, flags, p, nullptr, nullptr};}
+  static constexpr wobos_binding make(const char* name, int flags, int wobos_t<T>::*p) {return {name, flags, nullptr, p, nullptr};}
+  static constexpr wobos_binding make(const char* name, int flags, bool wobos_t<T>::*p) {return {name, flags, nullptr, nullptr, p};}
+
+  // Value of the member as stored in the variable table, and the reverse
+  double get(const wobos_t<T> &obos) const {
+    if (dval)      return primal(obos.*dval);
+    else if (ival) return (double)(obos.*ival);
+    else           return (obos.*bval) ? 1.0 : 0.0;
+  }
+  void set(wobos_t<T> &obos, double val) const {
+    if (dval)      obos.*dval = val;
+    else if (ival) obos.*ival = (int)val;
+    else           obos.*bval = (val == 0.0) ? false : true;
+  }
+
+  static const wobos_binding table[NVARIABLES];
+};
+
+template <class T> const wobos_binding<T> wobos_binding<T>::table[NVARIABLES] = {
+#define WOBOS_VARIABLE_BINDING(name, flags) make(#name, flags, &wobos_t<T>::name),
+  WOBOS_VARIABLES(WOBOS_VARIABLE_BINDING)
+#undef WOBOS_VARIABLE_BINDING
+};
+
+
+// Name to index lookup, built once per process
+template <class T>
+int wobos_t<T>::variable_index(const string &name) {
+  static const unordered_map<string, int> name2index = [] () {
+    unordered_map<string, int> out;
+    for (int i=0; i<NVARIABLES; i++) out[wobos_binding<T>::table[i].name] = i;
+    return out;
+  }();
+  auto it = name2index.find(name);
+  return (it == name2index.end()) ? -1 : it->second;
+}
+
+template <class T>
+const char* wobos_t<T>::variable_name(int id) {return ((id >= 0) && (id < NVARIABLES)) ? wobos_binding<T>::table[id].name : NULL;}
+
+template <class T>
+int wobos_t<T>::variable_flags(int id) {return ((id >= 0) && (id < NVARIABLES)) ? wobos_binding<T>::table[id].flags : 0;}
+
+template <class T>
+T* wobos_t<T>::variable_member(int id) {
+  if ( (id < 0) || (id >= NVARIABLES) || !wobos_binding<T>::table[id].dval ) return NULL;
+  return &(this->*(wobos_binding<T>::table[id].dval));
+}
+
+
+template <class T>
+void wobos_t<T>::substructure_mass_cost(size_t n, const double *turbR, const double *waterD, const double *hubH,
+				       const double *rnaM, double *mass, double *cost) const {
+  substructure_rates rates;
+  rates.mpileCR     = primal(mpileCR);
+  rates.mtransCR    = primal(mtransCR);
+  rates.jlatticeCR  = primal(jlatticeCR);
+  rates.jtransCR    = primal(jtransCR);
+  rates.jpileCR     = primal(jpileCR);
+  rates.spStifColCR = primal(spStifColCR);
+  rates.spTapColCR  = primal(spTapColCR);
+  rates.ballCR      = primal(ballCR);
+  rates.ssStifColCR = primal(ssStifColCR);
+  rates.ssTrussCR   = primal(ssTrussCR);
+  rates.ssHeaveCR   = primal(ssHeaveCR);
+  rates.sSteelCR    = primal(sSteelCR);
+  ::substructure_mass_cost(substructure, rates, n, substructure_column(turbR, primal(this->turbR)),
+			   substructure_column(waterD, primal(this->waterD)), substructure_column(hubH, primal(this->hubH)),
+			   substructure_column(rnaM, primal(this->rnaM)), mass, cost);
 }
 
 
-// Default constructor loads values from text file
-wobos::wobos() {
-  // Set cable and vessel templates
-  set_templates();
+// Default constructor applies the built-in defaults
+template <class T>
+wobos_t<T>::wobos_t() {
+  // Share the built-in cable and vessel templates
+  templates = wobos_templates::builtin();
+  vesselSubstructure = -1;
+
+  // Zero out all variables before applying defaults
+  fill(varValues, varValues + NVARIABLES, 0.0);
 
-  // Load in defaults from csv-file and store locally for use in SAM and WISDEM
-  wobos_default = wind_obos_defaults();
+  // Defaults are parsed once per process and shared for use in SAM and WISDEM
+  wobos_default = &wind_obos_defaults::instance();
 
   // Store default variables locally
-  for (int i=0; i<wobos_default.variables.size(); i++) {
-    string keyStr = wobos_default.variables[i].name;
-    string valStr = wobos_default.variables[i].valueStr;
+  for (int i=0; i<wobos_default->variables.size(); i++) {
+    const string &keyStr = wobos_default->variables[i].name;
+    const string &valStr = wobos_default->variables[i].valueStr;
 
     if ( (keyStr == "anchor") || (keyStr == "turbInstallMethod") || (keyStr == "substructure") ||
 	 (keyStr == "towerInstallMethod") || (keyStr == "installStrategy") ||
-	 (keyStr == "cableOptimizer") || (keyStr == "arrayCables") || (keyStr == "exportCables") ) {
+	 (keyStr == "cableOptimizer") || (keyStr == "installSimulation") || (keyStr == "arrayCables") || (keyStr == "exportCables") ) {
       set_map_variable(keyStr, valStr);
     }
-    else if (mapVars.find(keyStr) == mapVars.end()) {
+    else if (variable_index(keyStr) < 0) {
       cout << "CANNOT FIND: " << keyStr << " = " << valStr << endl;
     }
-    else if (wobos_default.variables[i].isDouble()) {
-      set_map_variable(keyStr, wobos_default.variables[i].value);
+    else if (wobos_default->variables[i].isDouble()) {
+      set_map_variable(keyStr, wobos_default->variables[i].value);
     }
     else {
       cout << "CANNOT SET: " << keyStr << " = " << valStr << endl;
@@ -116,642 +298,62 @@ wobos::wobos() {
 }
 
 
-// Take values in string-double map and store them in class variables.  This is useful for input from text file and external wrappings.
-void wobos::map2variables() {
-  // Non-double variables
-  substructure = (int)mapVars["substructure"];
-  anchor = (int)mapVars["anchor"];
-  turbInstallMethod = (int)mapVars["turbInstallMethod"];
-  towerInstallMethod = (int)mapVars["towerInstallMethod"];
-  installStrategy = (int)mapVars["installStrategy"];
-  cableOptimizer = (mapVars["cableOptimizer"] == 0.0) ? false : true;
-
-  // Turbine / Plant variables
-  turbCapEx = mapVars["turbCapEx"];
-  nTurb = mapVars["nTurb"];
-  rotorD = mapVars["rotorD"];
-  turbR = mapVars["turbR"];
-  hubH = mapVars["hubH"];
-  waterD = mapVars["waterD"];
-  distShore = mapVars["distShore"];
-  distPort = mapVars["distPort"];
-  distPtoA = mapVars["distPtoA"];
-  distAtoS = mapVars["distAtoS"];
-  moorLines = mapVars["moorLines"];
-  buryDepth = mapVars["buryDepth"];
-  arrayY = mapVars["arrayY"];
-  arrayX = mapVars["arrayX"];
-  substructCont = mapVars["substructCont"];
-  turbCont = mapVars["turbCont"];
-  elecCont = mapVars["elecCont"];
-  interConVolt = mapVars["interConVolt"];
-  distInterCon = mapVars["distInterCon"];
-  scrapVal = mapVars["scrapVal"];
-  number_install_seasons = mapVars["number_install_seasons"];
-
-  //General
-  projLife = mapVars["projLife"];
-  inspectClear = mapVars["inspectClear"];
-  plantComm = mapVars["plantComm"];
-  procurement_contingency = mapVars["procurement_contingency"];
-  install_contingency = mapVars["install_contingency"];
-  construction_insurance = mapVars["construction_insurance"];
-  capital_cost_year_0 = mapVars["capital_cost_year_0"];
-  capital_cost_year_1 = mapVars["capital_cost_year_1"];
-  capital_cost_year_2 = mapVars["capital_cost_year_2"];
-  capital_cost_year_3 = mapVars["capital_cost_year_3"];
-  capital_cost_year_4 = mapVars["capital_cost_year_4"];
-  capital_cost_year_5 = mapVars["capital_cost_year_5"];
-  tax_rate = mapVars["tax_rate"];
-  interest_during_construction = mapVars["interest_during_construction"];
-
-  //Substructure & Foundation
-  mpileCR = mapVars["mpileCR"];
-  mtransCR = mapVars["mtransCR"];
-  mpileD = mapVars["mpileD"];
-  mpileL = mapVars["mpileL"];
-  jlatticeCR = mapVars["jlatticeCR"];
-  jtransCR = mapVars["jtransCR"];
-  jpileCR = mapVars["jpileCR"];
-  jlatticeA = mapVars["jlatticeA"];
-  jpileL = mapVars["jpileL"];
-  jpileD = mapVars["jpileD"];
-  spStifColCR = mapVars["spStifColCR"];
-  spTapColCR = mapVars["spTapColCR"];
-  ballCR = mapVars["ballCR"];
-  deaFixLeng = mapVars["deaFixLeng"];
-  ssStifColCR = mapVars["ssStifColCR"];
-  ssTrussCR = mapVars["ssTrussCR"];
-  ssHeaveCR = mapVars["ssHeaveCR"];
-  sSteelCR = mapVars["sSteelCR"];
-  moorDia = mapVars["moorDia"];
-  moorCR = mapVars["moorCR"];
-  mpEmbedL = mapVars["mpEmbedL"];
-  scourMat = mapVars["scourMat"];
-  
-  //Electrical Infrastructure
-  pwrFac = mapVars["pwrFac"];
-  buryFac = mapVars["buryFac"];
-  arrVoltage = mapVars["arrVoltage"];
-  arrCab1Size = mapVars["arrCab1Size"];
-  arrCab1Mass = mapVars["arrCab1Mass"];
-  cab1CurrRating = mapVars["cab1CurrRating"];
-  cab1CR = mapVars["cab1CR"];
-  cab1TurbInterCR = mapVars["cab1TurbInterCR"];
-  arrCab2Size = mapVars["arrCab2Size"];
-  arrCab2Mass = mapVars["arrCab2Mass"];
-  cab2CurrRating = mapVars["cab2CurrRating"];
-  cab2CR = mapVars["cab2CR"];
-  cab2TurbInterCR = mapVars["cab2TurbInterCR"];
-  cab2SubsInterCR = mapVars["cab2SubsInterCR"];
-  catLengFac = mapVars["catLengFac"];
-  exCabFac = mapVars["exCabFac"];
-  subsTopFab = mapVars["subsTopFab"];
-  subsTopDes = mapVars["subsTopDes"];
-  topAssemblyFac = mapVars["topAssemblyFac"];
-  subsJackCR = mapVars["subsJackCR"];
-  subsPileCR = mapVars["subsPileCR"];
-  dynCabFac = mapVars["dynCabFac"];
-  shuntCR = mapVars["shuntCR"];
-  highVoltSG = mapVars["highVoltSG"];
-  medVoltSG = mapVars["medVoltSG"];
-  backUpGen = mapVars["backUpGen"];
-  workSpace = mapVars["workSpace"];
-  otherAncillary = mapVars["otherAncillary"];
-  mptCR = mapVars["mptCR"];
-  expVoltage = mapVars["expVoltage"];
-  expCabSize = mapVars["expCabSize"];
-  expCabMass = mapVars["expCabMass"];
-  expCabCR = mapVars["expCabCR"];
-  expCurrRating = mapVars["expCurrRating"];
-  expSubsInterCR = mapVars["expSubsInterCR"];
-	
-  //Assembly & Installation
-  moorTimeFac = mapVars["moorTimeFac"];
-  moorLoadout = mapVars["moorLoadout"];
-  moorSurvey = mapVars["moorSurvey"];
-  prepAA = mapVars["prepAA"];
-  prepSpar = mapVars["prepSpar"];
-  upendSpar = mapVars["upendSpar"];
-  prepSemi = mapVars["prepSemi"];
-  turbFasten = mapVars["turbFasten"];
-  boltTower = mapVars["boltTower"];
-  boltNacelle1 = mapVars["boltNacelle1"];
-  boltNacelle2 = mapVars["boltNacelle2"];
-  boltNacelle3 = mapVars["boltNacelle3"];
-  boltBlade1 = mapVars["boltBlade1"];
-  boltBlade2 = mapVars["boltBlade2"];
-  boltRotor = mapVars["boltRotor"];
-  vesselPosTurb = mapVars["vesselPosTurb"];
-  vesselPosJack = mapVars["vesselPosJack"];
-  vesselPosMono = mapVars["vesselPosMono"];
-  subsVessPos = mapVars["subsVessPos"];
-  monoFasten = mapVars["monoFasten"];
-  jackFasten = mapVars["jackFasten"];
-  prepGripperMono = mapVars["prepGripperMono"];
-  prepGripperJack = mapVars["prepGripperJack"];
-  placePiles = mapVars["placePiles"];
-  prepHamMono = mapVars["prepHamMono"];
-  removeHamMono = mapVars["removeHamMono"];
-  prepHamJack = mapVars["prepHamJack"];
-  removeHamJack = mapVars["removeHamJack"];
-  placeJack = mapVars["placeJack"];
-  levJack = mapVars["levJack"];
-  placeTemplate = mapVars["placeTemplate"];
-  hamRate = mapVars["hamRate"];
-  placeMP = mapVars["placeMP"];
-  instScour = mapVars["instScour"];
-  placeTP = mapVars["placeTP"];
-  groutTP = mapVars["groutTP"];
-  tpCover = mapVars["tpCover"];
-  prepTow = mapVars["prepTow"];
-  spMoorCon = mapVars["spMoorCon"];
-  ssMoorCon = mapVars["ssMoorCon"];
-  spMoorCheck = mapVars["spMoorCheck"];
-  ssMoorCheck = mapVars["ssMoorCheck"];
-  ssBall = mapVars["ssBall"];
-  surfLayRate = mapVars["surfLayRate"];
-  cabPullIn = mapVars["cabPullIn"];
-  cabTerm = mapVars["cabTerm"];
-  cabLoadout = mapVars["cabLoadout"];
-  buryRate = mapVars["buryRate"];
-  subsPullIn = mapVars["subsPullIn"];
-  shorePullIn = mapVars["shorePullIn"];
-  landConstruct = mapVars["landConstruct"];
-  expCabLoad = mapVars["expCabLoad"];
-  subsLoad = mapVars["subsLoad"];
-  placeTop = mapVars["placeTop"];
-  pileSpreadDR = mapVars["pileSpreadDR"];
-  pileSpreadMob = mapVars["pileSpreadMob"];
-  groutSpreadDR = mapVars["groutSpreadDR"];
-  groutSpreadMob = mapVars["groutSpreadMob"];
-  seaSpreadDR = mapVars["seaSpreadDR"];
-  seaSpreadMob = mapVars["seaSpreadMob"];
-  compRacks = mapVars["compRacks"];
-  cabSurveyCR = mapVars["cabSurveyCR"];
-  cabDrillDist = mapVars["cabDrillDist"];
-  cabDrillCR = mapVars["cabDrillCR"];
-  mpvRentalDR = mapVars["mpvRentalDR"];
-  diveTeamDR = mapVars["diveTeamDR"];
-  winchDR = mapVars["winchDR"];
-  civilWork = mapVars["civilWork"];
-  elecWork = mapVars["elecWork"];
-	
-  //Port & Staging
-  nCrane600 = mapVars["nCrane600"];
-  nCrane1000 = mapVars["nCrane1000"];
-  crane600DR = mapVars["crane600DR"];
-  crane1000DR = mapVars["crane1000DR"];
-  craneMobDemob = mapVars["craneMobDemob"];
-  entranceExitRate = mapVars["entranceExitRate"];
-  dockRate = mapVars["dockRate"];
-  wharfRate = mapVars["wharfRate"];
-  laydownCR = mapVars["laydownCR"];
-	
-  //Engineering & Management
-  estEnMFac = mapVars["estEnMFac"];
-	
-  //Development
-  preFEEDStudy = mapVars["preFEEDStudy"];
-  feedStudy = mapVars["feedStudy"];
-  stateLease = mapVars["stateLease"];
-  outConShelfLease = mapVars["outConShelfLease"];
-  saPlan = mapVars["saPlan"];
-  conOpPlan = mapVars["conOpPlan"];
-  nepaEisMet = mapVars["nepaEisMet"];
-  physResStudyMet = mapVars["physResStudyMet"];
-  bioResStudyMet = mapVars["bioResStudyMet"];
-  socEconStudyMet = mapVars["socEconStudyMet"];
-  navStudyMet = mapVars["navStudyMet"];
-  nepaEisProj = mapVars["nepaEisProj"];
-  physResStudyProj = mapVars["physResStudyProj"];
-  bioResStudyProj = mapVars["bioResStudyProj"];
-  socEconStudyProj = mapVars["socEconStudyProj"];
-  navStudyProj = mapVars["navStudyProj"];
-  coastZoneManAct = mapVars["coastZoneManAct"];
-  rivsnHarbsAct = mapVars["rivsnHarbsAct"];
-  cleanWatAct402 = mapVars["cleanWatAct402"];
-  cleanWatAct404 = mapVars["cleanWatAct404"];
-  faaPlan = mapVars["faaPlan"];
-  endSpecAct = mapVars["endSpecAct"];
-  marMamProtAct = mapVars["marMamProtAct"];
-  migBirdAct = mapVars["migBirdAct"];
-  natHisPresAct = mapVars["natHisPresAct"];
-  addLocPerm = mapVars["addLocPerm"];
-  metTowCR = mapVars["metTowCR"];
-  decomDiscRate = mapVars["decomDiscRate"];
-
-  
-  // INPUTS OR OUTPUTS
-  // Inputs if running connected to other modules in WISDEM
-  // Outputs if running isolated
-  
-  // Turbine outputs
-  hubD = mapVars["hubD"];
-  bladeL = mapVars["bladeL"];
-  max_chord = mapVars["max_chord"];
-  nacelleW = mapVars["nacelleW"];
-  nacelleL = mapVars["nacelleL"];
-  rnaM = mapVars["rnaM"];
-  towerD = mapVars["towerD"];
-  towerM = mapVars["towerM"];
-
-  //Substructure & Foundation outputs
-  subTotM = mapVars["subTotM"];
-  subTotCost = mapVars["subTotCost"];
-  moorCost = mapVars["moorCost"];
-  
-  // OUTPUTS
-
-  //Electrical Infrastructure outputs
-  systAngle = mapVars["systAngle"];
-  freeCabLeng = mapVars["freeCabLeng"];
-  fixCabLeng = mapVars["fixCabLeng"];
-  nExpCab = mapVars["nExpCab"];
-  expCabLeng = mapVars["expCabLeng"];
-  expCabCost = mapVars["expCabCost"];
-  nSubstation = mapVars["nSubstation"];
-  cab1Leng = mapVars["cab1Leng"];
-  cab2Leng = mapVars["cab2Leng"];
-  arrCab1Cost = mapVars["arrCab1Cost"];
-  arrCab2Cost = mapVars["arrCab2Cost"];
-  subsSubM = mapVars["subsSubM"];
-  subsPileM = mapVars["subsPileM"];
-  subsTopM = mapVars["subsTopM"];
-  totElecCost = mapVars["totElecCost"];
-  
-  //Assembly & Installation outputs
-  moorTime = mapVars["moorTime"];
-  floatPrepTime = mapVars["floatPrepTime"];
-  turbDeckArea = mapVars["turbDeckArea"];
-  nTurbPerTrip = mapVars["nTurbPerTrip"];
-  turbInstTime = mapVars["turbInstTime"];
-  subDeckArea = mapVars["subDeckArea"];
-  nSubPerTrip = mapVars["nSubPerTrip"];
-  subInstTime = mapVars["subInstTime"];
-  arrInstTime = mapVars["arrInstTime"];
-  expInstTime = mapVars["expInstTime"];
-  subsInstTime = mapVars["subsInstTime"];
-  totInstTime = mapVars["totInstTime"];
-  cabSurvey = mapVars["cabSurvey"];
-  array_cable_install_cost = mapVars["array_cable_install_cost"];
-  export_cable_install_cost = mapVars["export_cable_install_cost"];
-  substation_install_cost = mapVars["substation_install_cost"];
-  turbine_install_cost = mapVars["turbine_install_cost"];
-  substructure_install_cost = mapVars["substructure_install_cost"];
-  electrical_install_cost = mapVars["electrical_install_cost"];
-  mob_demob_cost = mapVars["mob_demob_cost"];
-
-  //Port & Staging outputs
-  totPnSCost = mapVars["totPnSCost"];
-
-  //Development outputs
-  totDevCost = mapVars["totDevCost"];
-
-  // Main Cost Outputs
-  bos_capex = mapVars["bos_capex"];
-  construction_insurance_cost = mapVars["construction_insurance_cost"];
-  total_contingency_cost = mapVars["total_contingency_cost"];
-  construction_finance_cost = mapVars["construction_finance_cost"];
-  construction_finance_factor = mapVars["construction_finance_factor"];
-  soft_costs = mapVars["soft_costs"];
-  totAnICost = mapVars["totAnICost"];
-  totEnMCost = mapVars["totEnMCost"];
-  commissioning = mapVars["commissioning"];
-  decomCost = mapVars["decomCost"];
-  total_bos_cost = mapVars["total_bos_cost"];
-}
-
-
-void wobos::variables2map() {
-  // Non-double variables
-  mapVars["substructure"]       = (double)substructure;
-  mapVars["anchor"]             = (double)anchor;
-  mapVars["turbInstallMethod"]  = (double)turbInstallMethod;
-  mapVars["towerInstallMethod"] = (double)towerInstallMethod;
-  mapVars["installStrategy"]    = (double)installStrategy;
-  mapVars["cableOptimizer"]     = (cableOptimizer) ? 1.0 : 0.0;
-
-  // Turbine / Plant variables
-  mapVars["turbCapEx"] = turbCapEx;
-  mapVars["nTurb"] = nTurb;
-  mapVars["rotorD"] = rotorD;
-  mapVars["turbR"] = turbR;
-  mapVars["hubH"] = hubH;
-  mapVars["waterD"] = waterD;
-  mapVars["distShore"] = distShore;
-  mapVars["distPort"] = distPort;
-  mapVars["distPtoA"] = distPtoA;
-  mapVars["distAtoS"] = distAtoS;
-  mapVars["moorLines"] = moorLines;
-  mapVars["buryDepth"] = buryDepth;
-  mapVars["arrayY"] = arrayY;
-  mapVars["arrayX"] = arrayX;
-  mapVars["substructCont"] = substructCont;
-  mapVars["turbCont"] = turbCont;
-  mapVars["elecCont"] = elecCont;
-  mapVars["interConVolt"] = interConVolt;
-  mapVars["distInterCon"] = distInterCon;
-  mapVars["scrapVal"] = scrapVal;
-  mapVars["number_install_seasons"] = number_install_seasons;
-
-  //General
-  mapVars["projLife"] = projLife;
-  mapVars["inspectClear"] = inspectClear;
-  mapVars["plantComm"] = plantComm;
-  mapVars["procurement_contingency"] = procurement_contingency;
-  mapVars["install_contingency"] = install_contingency;
-  mapVars["construction_insurance"] = construction_insurance;
-  mapVars["capital_cost_year_0"] = capital_cost_year_0;
-  mapVars["capital_cost_year_1"] = capital_cost_year_1;
-  mapVars["capital_cost_year_2"] = capital_cost_year_2;
-  mapVars["capital_cost_year_3"] = capital_cost_year_3;
-  mapVars["capital_cost_year_4"] = capital_cost_year_4;
-  mapVars["capital_cost_year_5"] = capital_cost_year_5;
-  mapVars["tax_rate"] = tax_rate;
-  mapVars["interest_during_construction"] = interest_during_construction;
-
-  //Substructure & Foundation
-  mapVars["mpileCR"] = mpileCR;
-  mapVars["mtransCR"] = mtransCR;
-  mapVars["mpileD"] = mpileD;
-  mapVars["mpileL"] = mpileL;
-  mapVars["jlatticeCR"] = jlatticeCR;
-  mapVars["jtransCR"] = jtransCR;
-  mapVars["jpileCR"] = jpileCR;
-  mapVars["jlatticeA"] = jlatticeA;
-  mapVars["jpileL"] = jpileL;
-  mapVars["jpileD"] = jpileD;
-  mapVars["spStifColCR"] = spStifColCR;
-  mapVars["spTapColCR"] = spTapColCR;
-  mapVars["ballCR"] = ballCR;
-  mapVars["deaFixLeng"] = deaFixLeng;
-  mapVars["ssStifColCR"] = ssStifColCR;
-  mapVars["ssTrussCR"] = ssTrussCR;
-  mapVars["ssHeaveCR"] = ssHeaveCR;
-  mapVars["sSteelCR"] = sSteelCR;
-  mapVars["moorDia"] = moorDia;
-  mapVars["moorCR"] = moorCR;
-  mapVars["mpEmbedL"] = mpEmbedL;
-  mapVars["scourMat"] = scourMat;
-  
-  //Electrical Infrastructure
-  mapVars["pwrFac"] = pwrFac;
-  mapVars["buryFac"] = buryFac;
-  mapVars["arrVoltage"] = arrVoltage;
-  mapVars["arrCab1Size"] = arrCab1Size;
-  mapVars["arrCab1Mass"] = arrCab1Mass;
-  mapVars["cab1CurrRating"] = cab1CurrRating;
-  mapVars["cab1CR"] = cab1CR;
-  mapVars["cab1TurbInterCR"] = cab1TurbInterCR;
-  mapVars["arrCab2Size"] = arrCab2Size;
-  mapVars["arrCab2Mass"] = arrCab2Mass;
-  mapVars["cab2CurrRating"] = cab2CurrRating;
-  mapVars["cab2CR"] = cab2CR;
-  mapVars["cab2TurbInterCR"] = cab2TurbInterCR;
-  mapVars["cab2SubsInterCR"] = cab2SubsInterCR;
-  mapVars["catLengFac"] = catLengFac;
-  mapVars["exCabFac"] = exCabFac;
-  mapVars["subsTopFab"] = subsTopFab;
-  mapVars["subsTopDes"] = subsTopDes;
-  mapVars["topAssemblyFac"] = topAssemblyFac;
-  mapVars["subsJackCR"] = subsJackCR;
-  mapVars["subsPileCR"] = subsPileCR;
-  mapVars["dynCabFac"] = dynCabFac;
-  mapVars["shuntCR"] = shuntCR;
-  mapVars["highVoltSG"] = highVoltSG;
-  mapVars["medVoltSG"] = medVoltSG;
-  mapVars["backUpGen"] = backUpGen;
-  mapVars["workSpace"] = workSpace;
-  mapVars["otherAncillary"] = otherAncillary;
-  mapVars["mptCR"] = mptCR;
-  mapVars["expVoltage"] = expVoltage;
-  mapVars["expCabSize"] = expCabSize;
-  mapVars["expCabMass"] = expCabMass;
-  mapVars["expCabCR"] = expCabCR;
-  mapVars["expCurrRating"] = expCurrRating;
-  mapVars["expSubsInterCR"] = expSubsInterCR;
-	
-  //Assembly & Installation
-  mapVars["moorTimeFac"] = moorTimeFac;
-  mapVars["moorLoadout"] = moorLoadout;
-  mapVars["moorSurvey"] = moorSurvey;
-  mapVars["prepAA"] = prepAA;
-  mapVars["prepSpar"] = prepSpar;
-  mapVars["upendSpar"] = upendSpar;
-  mapVars["prepSemi"] = prepSemi;
-  mapVars["turbFasten"] = turbFasten;
-  mapVars["boltTower"] = boltTower;
-  mapVars["boltNacelle1"] = boltNacelle1;
-  mapVars["boltNacelle2"] = boltNacelle2;
-  mapVars["boltNacelle3"] = boltNacelle3;
-  mapVars["boltBlade1"] = boltBlade1;
-  mapVars["boltBlade2"] = boltBlade2;
-  mapVars["boltRotor"] = boltRotor;
-  mapVars["vesselPosTurb"] = vesselPosTurb;
-  mapVars["vesselPosJack"] = vesselPosJack;
-  mapVars["vesselPosMono"] = vesselPosMono;
-  mapVars["subsVessPos"] = subsVessPos;
-  mapVars["monoFasten"] = monoFasten;
-  mapVars["jackFasten"] = jackFasten;
-  mapVars["prepGripperMono"] = prepGripperMono;
-  mapVars["prepGripperJack"] = prepGripperJack;
-  mapVars["placePiles"] = placePiles;
-  mapVars["prepHamMono"] = prepHamMono;
-  mapVars["removeHamMono"] = removeHamMono;
-  mapVars["prepHamJack"] = prepHamJack;
-  mapVars["removeHamJack"] = removeHamJack;
-  mapVars["placeJack"] = placeJack;
-  mapVars["levJack"] = levJack;
-  mapVars["placeTemplate"] = placeTemplate;
-  mapVars["hamRate"] = hamRate;
-  mapVars["placeMP"] = placeMP;
-  mapVars["instScour"] = instScour;
-  mapVars["placeTP"] = placeTP;
-  mapVars["groutTP"] = groutTP;
-  mapVars["tpCover"] = tpCover;
-  mapVars["prepTow"] = prepTow;
-  mapVars["spMoorCon"] = spMoorCon;
-  mapVars["ssMoorCon"] = ssMoorCon;
-  mapVars["spMoorCheck"] = spMoorCheck;
-  mapVars["ssMoorCheck"] = ssMoorCheck;
-  mapVars["ssBall"] = ssBall;
-  mapVars["surfLayRate"] = surfLayRate;
-  mapVars["cabPullIn"] = cabPullIn;
-  mapVars["cabTerm"] = cabTerm;
-  mapVars["cabLoadout"] = cabLoadout;
-  mapVars["buryRate"] = buryRate;
-  mapVars["subsPullIn"] = subsPullIn;
-  mapVars["shorePullIn"] = shorePullIn;
-  mapVars["landConstruct"] = landConstruct;
-  mapVars["expCabLoad"] = expCabLoad;
-  mapVars["subsLoad"] = subsLoad;
-  mapVars["placeTop"] = placeTop;
-  mapVars["pileSpreadDR"] = pileSpreadDR;
-  mapVars["pileSpreadMob"] = pileSpreadMob;
-  mapVars["groutSpreadDR"] = groutSpreadDR;
-  mapVars["groutSpreadMob"] = groutSpreadMob;
-  mapVars["seaSpreadDR"] = seaSpreadDR;
-  mapVars["seaSpreadMob"] = seaSpreadMob;
-  mapVars["compRacks"] = compRacks;
-  mapVars["cabSurveyCR"] = cabSurveyCR;
-  mapVars["cabDrillDist"] = cabDrillDist;
-  mapVars["cabDrillCR"] = cabDrillCR;
-  mapVars["mpvRentalDR"] = mpvRentalDR;
-  mapVars["diveTeamDR"] = diveTeamDR;
-  mapVars["winchDR"] = winchDR;
-  mapVars["civilWork"] = civilWork;
-  mapVars["elecWork"] = elecWork;
-	
-  //Port & Staging
-  mapVars["nCrane600"] = nCrane600;
-  mapVars["nCrane1000"] = nCrane1000;
-  mapVars["crane600DR"] = crane600DR;
-  mapVars["crane1000DR"] = crane1000DR;
-  mapVars["craneMobDemob"] = craneMobDemob;
-  mapVars["entranceExitRate"] = entranceExitRate;
-  mapVars["dockRate"] = dockRate;
-  mapVars["wharfRate"] = wharfRate;
-  mapVars["laydownCR"] = laydownCR;
-	
-  //Engineering & Management
-  mapVars["estEnMFac"] = estEnMFac;
-	
-  //Development
-  mapVars["preFEEDStudy"] = preFEEDStudy;
-  mapVars["feedStudy"] = feedStudy;
-  mapVars["stateLease"] = stateLease;
-  mapVars["outConShelfLease"] = outConShelfLease;
-  mapVars["saPlan"] = saPlan;
-  mapVars["conOpPlan"] = conOpPlan;
-  mapVars["nepaEisMet"] = nepaEisMet;
-  mapVars["physResStudyMet"] = physResStudyMet;
-  mapVars["bioResStudyMet"] = bioResStudyMet;
-  mapVars["socEconStudyMet"] = socEconStudyMet;
-  mapVars["navStudyMet"] = navStudyMet;
-  mapVars["nepaEisProj"] = nepaEisProj;
-  mapVars["physResStudyProj"] = physResStudyProj;
-  mapVars["bioResStudyProj"] = bioResStudyProj;
-  mapVars["socEconStudyProj"] = socEconStudyProj;
-  mapVars["navStudyProj"] = navStudyProj;
-  mapVars["coastZoneManAct"] = coastZoneManAct;
-  mapVars["rivsnHarbsAct"] = rivsnHarbsAct;
-  mapVars["cleanWatAct402"] = cleanWatAct402;
-  mapVars["cleanWatAct404"] = cleanWatAct404;
-  mapVars["faaPlan"] = faaPlan;
-  mapVars["endSpecAct"] = endSpecAct;
-  mapVars["marMamProtAct"] = marMamProtAct;
-  mapVars["migBirdAct"] = migBirdAct;
-  mapVars["natHisPresAct"] = natHisPresAct;
-  mapVars["addLocPerm"] = addLocPerm;
-  mapVars["metTowCR"] = metTowCR;
-  mapVars["decomDiscRate"] = decomDiscRate;
-  
-  // INPUTS or OUTPUTS
-  // Inputs if running connected to other modules in WISDEM
-  // Outputs if running isolated
-
-  // Turbine outputs
-  mapVars["hubD"] = hubD;
-  mapVars["bladeL"] = bladeL;
-  mapVars["max_chord"] = max_chord;
-  mapVars["nacelleW"] = nacelleW;
-  mapVars["nacelleL"] = nacelleL;
-  mapVars["rnaM"] = rnaM;
-  mapVars["towerD"] = towerD;
-  mapVars["towerM"] = towerM;
-
-  //Substructure & Foundation outputs
-  mapVars["subTotM"] = subTotM;
-  mapVars["subTotCost"] = subTotCost;
-  mapVars["moorCost"] = moorCost;
-  
-  // OUTPUTS
-  //Electrical Infrastructure outputs
-  mapVars["systAngle"] = systAngle;
-  mapVars["freeCabLeng"] = freeCabLeng;
-  mapVars["fixCabLeng"] = fixCabLeng;
-  mapVars["nExpCab"] = nExpCab;
-  mapVars["expCabLeng"] = expCabLeng;
-  mapVars["expCabCost"] = expCabCost;
-  mapVars["nSubstation"] = nSubstation;
-  mapVars["cab1Leng"] = cab1Leng;
-  mapVars["cab2Leng"] = cab2Leng;
-  mapVars["arrCab1Cost"] = arrCab1Cost;
-  mapVars["arrCab2Cost"] = arrCab2Cost;
-  mapVars["subsSubM"] = subsSubM;
-  mapVars["subsPileM"] = subsPileM;
-  mapVars["subsTopM"] = subsTopM;
-  mapVars["totElecCost"] = totElecCost;
-  
-  //Assembly & Installation outputs
-  mapVars["moorTime"] = moorTime;
-  mapVars["floatPrepTime"] = floatPrepTime;
-  mapVars["turbDeckArea"] = turbDeckArea;
-  mapVars["nTurbPerTrip"] = nTurbPerTrip;
-  mapVars["turbInstTime"] = turbInstTime;
-  mapVars["subDeckArea"] = subDeckArea;
-  mapVars["nSubPerTrip"] = nSubPerTrip;
-  mapVars["subInstTime"] = subInstTime;
-  mapVars["arrInstTime"] = arrInstTime;
-  mapVars["expInstTime"] = expInstTime;
-  mapVars["subsInstTime"] = subsInstTime;
-  mapVars["totInstTime"] = totInstTime;
-  mapVars["cabSurvey"] = cabSurvey;
-  mapVars["array_cable_install_cost"] = array_cable_install_cost;
-  mapVars["export_cable_install_cost"] = export_cable_install_cost;
-  mapVars["substation_install_cost"] = substation_install_cost;
-  mapVars["turbine_install_cost"] = turbine_install_cost;
-  mapVars["substructure_install_cost"] = substructure_install_cost;
-  mapVars["electrical_install_cost"] = electrical_install_cost;
-  mapVars["mob_demob_cost"] = mob_demob_cost;
-
-  //Port & Staging outputs
-  mapVars["totPnSCost"] = totPnSCost;
-
-  //Development outputs
-  mapVars["totDevCost"] = totDevCost;
-
-  // Main Cost Outputs
-  mapVars["bos_capex"] = bos_capex;
-  mapVars["construction_insurance_cost"] = construction_insurance_cost;
-  mapVars["total_contingency_cost"] = total_contingency_cost;
-  mapVars["construction_finance_cost"] = construction_finance_cost;
-  mapVars["construction_finance_factor"] = construction_finance_factor;
-  mapVars["soft_costs"] = soft_costs;
-  mapVars["totAnICost"] = totAnICost;
-  mapVars["totEnMCost"] = totEnMCost;
-  mapVars["commissioning"] = commissioning;
-  mapVars["decomCost"] = decomCost;
-  mapVars["total_bos_cost"] = total_bos_cost;
-}
-
-void wobos::set_map_variable(string keyStr, string valStr) {
+// Take values in the variable table and store them in class variables.  This is useful for input from text file and external wrappings.
+template <class T>
+void wobos_t<T>::map2variables() {
+  for (int i=0; i<NVARIABLES; i++) wobos_binding<T>::table[i].set(*this, varValues[i]);
+}
+
+
+template <class T>
+void wobos_t<T>::variables2map() {
+  for (int i=0; i<NVARIABLES; i++) varValues[i] = wobos_binding<T>::table[i].get(*this);
+}
+
+// String settings for the enumerated inputs, shared by all instances
+static const map<string, int> str2substructure { {"MONOPILE", MONOPILE}, {"JACKET", JACKET}, {"SPAR", SPAR}, {"SEMISUBMERSIBLE", SEMISUBMERSIBLE} };
+static const map<string, int> str2anchor { {"DRAGEMBEDMENT", DRAGEMBEDMENT}, {"SUCTIONPILE", SUCTIONPILE} };
+static const map<string, int> str2turbInstallMethod { {"INDIVIDUAL",INDIVIDUAL}, {"BUNNYEARS",BUNNYEARS}, {"ROTORASSEMBLED", ROTORASSEMBLED} } ;
+static const map<string, int> str2towerInstallMethod { {"ONEPIECE", ONEPIECE}, {"TWOPIECE", TWOPIECE} } ;
+static const map<string, int> str2installStrategy { {"PRIMARYVESSEL", PRIMARYVESSEL}, {"FEEDERBARGE", FEEDERBARGE} } ;
+
+// Unrecognized strings map to the first enum entry
+static int str2enum(const map<string, int> &str2val, const string &valStr) {
+  map<string, int>::const_iterator it = str2val.find(valStr);
+  return (it == str2val.end()) ? 0 : it->second;
+}
+
+template <class T>
+void wobos_t<T>::set_map_variable(string keyStr, string valStr) {
   if (keyStr == "substructure") {
-    substructure = str2substructure[valStr];
-    mapVars[keyStr] = (double)substructure;
+    substructure = str2enum(str2substructure, valStr);
+    varValues[VAR_substructure] = (double)substructure;
     set_vessel_defaults();
     // TODO- if vessels are specified in the text file, this will have to be done before those are read
   }
   else if (keyStr == "anchor") {
-    anchor = str2anchor[valStr];
-    mapVars[keyStr] = (double)anchor;
+    anchor = str2enum(str2anchor, valStr);
+    varValues[VAR_anchor] = (double)anchor;
   }
   else if (keyStr == "turbInstallMethod") {
-    turbInstallMethod = str2turbInstallMethod[valStr];
-    mapVars[keyStr] = (double)turbInstallMethod;
+    turbInstallMethod = str2enum(str2turbInstallMethod, valStr);
+    varValues[VAR_turbInstallMethod] = (double)turbInstallMethod;
   }
   else if (keyStr == "towerInstallMethod") {
-    towerInstallMethod = str2towerInstallMethod[valStr];
-    mapVars[keyStr] = (double)towerInstallMethod;
+    towerInstallMethod = str2enum(str2towerInstallMethod, valStr);
+    varValues[VAR_towerInstallMethod] = (double)towerInstallMethod;
   }
   else if (keyStr == "installStrategy") {
-    installStrategy = str2installStrategy[valStr];
-    mapVars[keyStr] = (double)installStrategy;
+    installStrategy = str2enum(str2installStrategy, valStr);
+    varValues[VAR_installStrategy] = (double)installStrategy;
   }
   else if (keyStr == "cableOptimizer") {
     cableOptimizer = ((valStr=="FALSE") || (valStr=="0")) ? false : true;
-    mapVars[keyStr] = (cableOptimizer) ? 1.0 : 0.0;
+    varValues[VAR_cableOptimizer] = (cableOptimizer) ? 1.0 : 0.0;
+  }
+  else if (keyStr == "installSimulation") {
+    installSimulation = ((valStr=="FALSE") || (valStr=="0")) ? false : true;
+    varValues[VAR_installSimulation] = (installSimulation) ? 1.0 : 0.0;
   }
   else if ( (keyStr == "arrayCables") || (keyStr == "exportCables") ) {
     vector<int> cableVoltages;
@@ -765,17 +367,63 @@ void wobos::set_map_variable(string keyStr, string valStr) {
     else expCables = set_cables(cableVoltages);
   }
 }
-void wobos::set_map_variable(string keyStr, double val) {
-  if ( (val > 1.0) && (variable_percentage.find(keyStr) != variable_percentage.end()) )
+template <class T>
+void wobos_t<T>::set_map_variable(int id, double val) {
+  if ( (id < 0) || (id >= NVARIABLES) ) return;
+
+  if ( (val > 1.0) && (wobos_binding<T>::table[id].flags & VAR_PERCENT) )
 	val *= 1e-2;
 
-  mapVars[keyStr] = val;
+  varValues[id] = val;
+}
+template <class T>
+double wobos_t<T>::get_map_variable(int id) {return ((id >= 0) && (id < NVARIABLES)) ? varValues[id] : 0.0;}
+template <class T>
+void wobos_t<T>::set_map_variable(string keyStr, double val) {set_map_variable(variable_index(keyStr), val);}
+template <class T>
+void wobos_t<T>::set_map_variable(const char* key, double val) {set_map_variable(variable_index(string(key)), val);}
+template <class T>
+double wobos_t<T>::get_map_variable(const char* key) {return get_map_variable(variable_index(string(key)));}
+
+
+shared_ptr<const wobos_templates> wobos_templates::builtin() {
+  // Function-local static, so initialization is thread-safe and happens only once per process
+  static const shared_ptr<const wobos_templates> shared = [] () {
+    shared_ptr<wobos_templates> temp = make_shared<wobos_templates>();
+    temp->set_templates();
+    return shared_ptr<const wobos_templates>(temp);
+  }();
+  return shared;
+}
+
+
+const cableFamily& wobos_templates::get_cable(int voltage) const {
+  static const cableFamily empty;
+  map<int, cableFamily>::const_iterator it = arrayTemplates.find(voltage);
+  return (it == arrayTemplates.end()) ? empty : it->second;
+}
+
+
+const vessel& wobos_templates::get_vessel(const string &name) const {
+  static const vessel blank;
+  map<string, vessel>::const_iterator it = vesselTemplates.find(name);
+  return (it == vesselTemplates.end()) ? blank : it->second;
 }
-void wobos::set_map_variable(const char* key, double val) {set_map_variable(string(key), val);}
-double wobos::get_map_variable(const char* key) {return mapVars[string(key)];}
 
 
-void wobos::set_templates() {
+vector<pair<double, double> > wobos_templates::weather_limits() const {
+  vector<pair<double, double> > limits;
+  for (map<string, vessel>::const_iterator it=vesselTemplates.begin(); it!=vesselTemplates.end(); ++it) {
+    const vessel &v = it->second;
+    if ((v.max_wind_speed > 0.0) || (v.max_wave_height > 0.0)) limits.push_back(make_pair(v.max_wind_speed, v.max_wave_height));
+  }
+  sort(limits.begin(), limits.end());
+  limits.erase(unique(limits.begin(), limits.end()), limits.end());
+  return limits;
+}
+
+
+void wobos_templates::set_templates() {
   cableFamily arrayCable33kV = cableFamily();
   arrayCable33kV.set_all_area( {95.0,   120.0,  150.0,  185.0,  240.0,  300.0,  400.0,  500.0,  630.0,  800.0,  1000.0} );
   arrayCable33kV.set_all_mass( {20.384, 21.854, 23.912, 25.676, 28.910, 32.242, 37.142, 42.336, 48.706, 57.428, 66.738} );
@@ -1024,76 +672,97 @@ void wobos::set_templates() {
 }
 
 
+// Copy-on-write: the shared templates are never modified, this instance gets its own updated copy instead
+template <class T>
+void wobos_t<T>::set_cable_template(int voltage, const cableFamily &family) {
+  shared_ptr<wobos_templates> temp = make_shared<wobos_templates>(*templates);
+  temp->arrayTemplates[voltage] = family;
+  templates = temp;
+}
+
+
+template <class T>
+void wobos_t<T>::set_vessel_template(const string &name, const vessel &vesselIn) {
+  shared_ptr<wobos_templates> temp = make_shared<wobos_templates>(*templates);
+  temp->vesselTemplates[name] = vesselIn;
+  templates = temp;
+}
+
+
 // Helper function that chooses cables from an input vector of voltages
-vector<cableFamily> wobos::set_cables(vector<int> cableVoltages) {
+template <class T>
+vector<cableFamily> wobos_t<T>::set_cables(vector<int> cableVoltages) {
   vector<cableFamily> outvec;
   outvec.resize(cableVoltages.size());
   for (int i=0; i<cableVoltages.size(); i++)
-    outvec[i] = cableFamily( arrayTemplates[cableVoltages[i]] );
+    outvec[i] = cableFamily( templates->get_cable(cableVoltages[i]) );
   return outvec;
 }
 
 
 // Helper function that chooses vessels from an input vector of names
-vector<vessel> wobos::set_vessels(vector<string> vesselNames) {
+template <class T>
+vector<vessel> wobos_t<T>::set_vessels(vector<string> vesselNames) {
   vector<vessel> outvec;
   outvec.resize(vesselNames.size());
   for (int i=0; i<vesselNames.size(); i++)
-    outvec[i] = vessel( vesselTemplates[vesselNames[i]] );
+    outvec[i] = vessel( templates->get_vessel(vesselNames[i]) );
   return outvec;
 }
 
 
-void wobos::set_vessel_defaults() {
+template <class T>
+void wobos_t<T>::set_vessel_defaults() {
+  vesselSubstructure = substructure;
 
   scourProtVessel = vessel();
 
-  elecSupportVessels = vector<vessel> {vesselTemplates["PERSONNEL_TRANSPORT"], vesselTemplates["GUARD"]} ;
+  elecSupportVessels = vector<vessel> {templates->get_vessel("PERSONNEL_TRANSPORT"), templates->get_vessel("GUARD")} ;
 
-  turbFeederBarge = vesselTemplates["LARGE_JACKUP_BARGE"];
-  subFeederBarge  = vesselTemplates["LARGE_JACKUP_BARGE"];
+  turbFeederBarge = templates->get_vessel("LARGE_JACKUP_BARGE");
+  subFeederBarge  = templates->get_vessel("LARGE_JACKUP_BARGE");
 
-  arrCabInstVessel = vesselTemplates["LARGE_ARRAY_CABLE_LAY"];
-  expCabInstVessel = vesselTemplates["LARGE_EXPORT_CABLE_LAY"];
+  arrCabInstVessel = templates->get_vessel("LARGE_ARRAY_CABLE_LAY");
+  expCabInstVessel = templates->get_vessel("LARGE_EXPORT_CABLE_LAY");
 
   if (isFixed()) {
-    turbInstVessel   = vesselTemplates["HIGH_HEIGHT_LARGE_SIZED_JACKUP"];
-    subInstVessel    = vesselTemplates["HIGH_HEIGHT_LARGE_SIZED_JACKUP"];
-    substaInstVessel = vesselTemplates["SEMISUBMERSIBLE_CRANE"];
+    turbInstVessel   = templates->get_vessel("HIGH_HEIGHT_LARGE_SIZED_JACKUP");
+    subInstVessel    = templates->get_vessel("HIGH_HEIGHT_LARGE_SIZED_JACKUP");
+    substaInstVessel = templates->get_vessel("SEMISUBMERSIBLE_CRANE");
     
-    turbSupportVessels = vector<vessel> {vesselTemplates["PERSONNEL_TRANSPORT"], vesselTemplates["GUARD"]} ;
-    subSupportVessels  = vector<vessel> {vesselTemplates["PERSONNEL_TRANSPORT"], vesselTemplates["GUARD"]} ;
-    elecTugs           = vector<vessel> {vesselTemplates["LARGE_AHST"]} ;
+    turbSupportVessels = vector<vessel> {templates->get_vessel("PERSONNEL_TRANSPORT"), templates->get_vessel("GUARD")} ;
+    subSupportVessels  = vector<vessel> {templates->get_vessel("PERSONNEL_TRANSPORT"), templates->get_vessel("GUARD")} ;
+    elecTugs           = vector<vessel> {templates->get_vessel("LARGE_AHST")} ;
       
     if (substructure == MONOPILE)
-      scourProtVessel = vesselTemplates["SIDE_ROCK_DUMPER"];
+      scourProtVessel = templates->get_vessel("SIDE_ROCK_DUMPER");
   }
   
   else if (substructure == SPAR) {
     
-    turbInstVessel   = vesselTemplates["LARGE_AHST"];
-    subInstVessel    = vesselTemplates["MEDIUM_AHST"];
-    substaInstVessel = vesselTemplates["LARGE_AHST"];
+    turbInstVessel   = templates->get_vessel("LARGE_AHST");
+    subInstVessel    = templates->get_vessel("MEDIUM_AHST");
+    substaInstVessel = templates->get_vessel("LARGE_AHST");
     
-    turbSupportVessels = vector<vessel> {vesselTemplates["MEDIUM_AHST"], vesselTemplates["MEDIUM_JACKUP_BARGE"],
-					      vesselTemplates["SEA_GOING_SUPPORT_TUG"], vesselTemplates["PERSONNEL_TRANSPORT"],
-					      vesselTemplates["GUARD"], vesselTemplates["BALLASTING"], vesselTemplates["BALLAST_HOPPER"] } ;
+    turbSupportVessels = vector<vessel> {templates->get_vessel("MEDIUM_AHST"), templates->get_vessel("MEDIUM_JACKUP_BARGE"),
+					      templates->get_vessel("SEA_GOING_SUPPORT_TUG"), templates->get_vessel("PERSONNEL_TRANSPORT"),
+					      templates->get_vessel("GUARD"), templates->get_vessel("BALLASTING"), templates->get_vessel("BALLAST_HOPPER") } ;
 
-    subSupportVessels =  vector<vessel> {vesselTemplates["MEDIUM_JACKUP_BARGE"], vesselTemplates["SEA_GOING_SUPPORT_TUG"],
-					      vesselTemplates["PERSONNEL_TRANSPORT"], vesselTemplates["GUARD"],
-					      vesselTemplates["BALLASTING"], vesselTemplates["BALLAST_HOPPER"] } ;
+    subSupportVessels =  vector<vessel> {templates->get_vessel("MEDIUM_JACKUP_BARGE"), templates->get_vessel("SEA_GOING_SUPPORT_TUG"),
+					      templates->get_vessel("PERSONNEL_TRANSPORT"), templates->get_vessel("GUARD"),
+					      templates->get_vessel("BALLASTING"), templates->get_vessel("BALLAST_HOPPER") } ;
 
-    elecTugs = vector<vessel> {vesselTemplates["LARGE_AHST"], vesselTemplates["SEA_GOING_SUPPORT_TUG"]} ;
+    elecTugs = vector<vessel> {templates->get_vessel("LARGE_AHST"), templates->get_vessel("SEA_GOING_SUPPORT_TUG")} ;
   }
   
   else if (substructure == SEMISUBMERSIBLE) {
-    turbInstVessel   = vesselTemplates["MEDIUM_AHST"];
-    subInstVessel    = vesselTemplates["MEDIUM_AHST"];
-    substaInstVessel = vesselTemplates["LARGE_AHST"];
+    turbInstVessel   = templates->get_vessel("MEDIUM_AHST");
+    subInstVessel    = templates->get_vessel("MEDIUM_AHST");
+    substaInstVessel = templates->get_vessel("LARGE_AHST");
 
-    turbSupportVessels = vector<vessel> {vesselTemplates["SEA_GOING_SUPPORT_TUG"], vesselTemplates["GUARD"]} ;
-    subSupportVessels  = vector<vessel> {vesselTemplates["SEA_GOING_SUPPORT_TUG"], vesselTemplates["GUARD"]} ;
-    elecTugs           = vector<vessel> {vesselTemplates["LARGE_AHST"], vesselTemplates["SEA_GOING_SUPPORT_TUG"]} ;
+    turbSupportVessels = vector<vessel> {templates->get_vessel("SEA_GOING_SUPPORT_TUG"), templates->get_vessel("GUARD")} ;
+    subSupportVessels  = vector<vessel> {templates->get_vessel("SEA_GOING_SUPPORT_TUG"), templates->get_vessel("GUARD")} ;
+    elecTugs           = vector<vessel> {templates->get_vessel("LARGE_AHST"), templates->get_vessel("SEA_GOING_SUPPORT_TUG")} ;
   }
   
 }
@@ -1103,12 +772,15 @@ void wobos::set_vessel_defaults() {
 //Offshore BOS model 'Soft Costs' Module starts here and ends at  function definition
 //*******************************************************************************************
 
-void wobos::calculate_bos_cost() {
+template <class T>
+template <class P>
+void wobos_t<T>::calculate_bos_cost() {
+  WOBOS_PROFILE_STAGE(profile, STAGE_BOS_COST);
   // Commissioning cost
   commissioning = (totAnICost + totDevCost + totElecCost + totEnMCost + subTotCost + totPnSCost + turbCapEx*(turbR*nTurb*1000))*plantComm;
 
   // Calculate the present value in dollars of the cost of decommissioning the wind plant
-  decomCost = isFloating() ?
+  decomCost = path_floating<P>() ?
     (((0.2*(moorTime / totInstTime) + 0.6*(turbInstTime / totInstTime) + 0.1*(arrInstTime / totInstTime) + 0.1*(expInstTime / totInstTime) +
        0.4*(subsInstTime / totInstTime))*totAnICost) - scrapVal) / pow((1 + decomDiscRate), projLife) :
     (((0.9*(subInstTime / totInstTime) + 0.7*(turbInstTime / totInstTime) + 0.2*(arrInstTime / totInstTime) + 0.2*(expInstTime / totInstTime) +
@@ -1152,7 +824,9 @@ void wobos::calculate_bos_cost() {
 
 // Calculate turbine parameters
 // NOTE: All these quantities can be inputs or outputs, depending on how the module is called
-void wobos::set_turbine_parameters() {
+template <class T>
+void wobos_t<T>::set_turbine_parameters() {
+  WOBOS_PROFILE_STAGE(profile, STAGE_SET_TURBINE_PARAMETERS);
   // Hub diameter
   if (hubD <= 0.0) 
     hubD = 0.25*turbR + 2; // meters
@@ -1187,7 +861,8 @@ void wobos::set_turbine_parameters() {
 //SubstructTotCost() function definition
 //*******************************************************************************************
 
-tuple<double, double> wobos::calculate_monopile() {
+template <class T>
+tuple<T, T> wobos_t<T>::calculate_monopile() {
   // Assign monopile length if it is not assigned
   if (mpileL <= 0) {mpileL = waterD + mpEmbedL + 5;}
 
@@ -1195,100 +870,105 @@ tuple<double, double> wobos::calculate_monopile() {
   if (mpileD <= 0) {mpileD = turbR;}
 
   // Calculate monopile single pile mass in tonnes
-  double mpileM     = (pow((turbR * 1000), 1.5) + (pow(hubH, 3.7) / 10) + 2100 *
+  T mpileM     = (pow((turbR * 1000), 1.5) + (pow(hubH, 3.7) / 10) + 2100 *
 		       pow(waterD, 2.25) + pow((rnaM * 1000), 1.13)) / 10000;
 
   // Calculate monopile single transition piece mass in tonnes
-  double mtransM    = exp(2.77 + 1.04*pow(turbR, 0.5) + 0.00127*pow(waterD, 1.5));
+  T mtransM    = exp(2.77 + 1.04*pow(turbR, 0.5) + 0.00127*pow(waterD, 1.5));
 
   // Calculate monopile single pile cost in dollars
-  double mPileCost  = mpileM * mpileCR;
+  T mPileCost  = mpileM * mpileCR;
 
   // Calculate monopile single transition piece cost in dollars
-  double mTransCost = mtransM * mtransCR;
+  T mTransCost = mtransM * mtransCR;
 
   return make_tuple(mpileM+mtransM, mPileCost+mTransCost);
 }
 
 
-tuple<double, double> wobos::calculate_jacket() {
+template <class T>
+tuple<T, T> wobos_t<T>::calculate_jacket() {
   // Calculate single jacket lattice mass in tonnes
-  double jlatticeM    = exp(3.71 + 0.00176*pow(turbR, 2.5) + 0.645*log(waterD));
+  T jlatticeM    = exp(3.71 + 0.00176*pow(turbR, 2.5) + 0.645*log(waterD));
 
   // Calculate single jacket transition piece mass in tonnes
-  double jtransM      = 1 / (-0.0131 + 0.0381 / log(turbR) - 0.00000000227*pow(waterD, 3));
+  T jtransM      = 1 / (-0.0131 + 0.0381 / log(turbR) - 0.00000000227*pow(waterD, 3));
   
   // Calculate jacket pile mass in tonnes (total for 4 piles)
-  double jpileM       = 8 * pow(jlatticeM, 0.5574);
+  T jpileM       = 8 * pow(jlatticeM, 0.5574);
 
   // Calculate single jacket lattice cost in dollars
-  double jLatticeCost = jlatticeM * jlatticeCR;
+  T jLatticeCost = jlatticeM * jlatticeCR;
 
   // Calculate single jacket transition piece cost in dollars
-  double jTransCost   = jtransM * jtransCR;
+  T jTransCost   = jtransM * jtransCR;
   
   // Calculate total cost for 4 jacket piles in dollars
-  double jPileCost    = jpileM * jpileCR;
+  T jPileCost    = jpileM * jpileCR;
 
   return make_tuple(jlatticeM+jtransM+jpileM, jLatticeCost+jTransCost+jPileCost);
 }
 
 
-tuple<double, double> wobos::calculate_spar() {
+template <class T>
+tuple<T, T> wobos_t<T>::calculate_spar() {
   // Calculate mass of the stiffened column for single spar in tonnes
-  double spStifColM    = 535.93 + 17.664*pow(turbR, 2) + 0.02328*waterD*log(waterD);
+  T spStifColM    = 535.93 + 17.664*pow(turbR, 2) + 0.02328*waterD*log(waterD);
   
   // Calculate mass of the tapered column for a single spar in tonnes
-  double spTapColM     = 125.81*log(turbR) + 58.712;
+  T spTapColM     = 125.81*log(turbR) + 58.712;
   
   // Calculate the stiffened column cost for a single spar in dollars
-  double spStifColCost = spStifColM * spStifColCR;
+  T spStifColCost = spStifColM * spStifColCR;
 
   // Calculate the tapered column cost for a single spar in dollars
-  double spTapColCost  = spTapColM * spTapColCR;
+  T spTapColCost  = spTapColM * spTapColCR;
 
   return make_tuple(spStifColM+spTapColM, spStifColCost+spTapColCost);
 }
 
 
-tuple<double, double> wobos::calculate_ballast() {
+template <class T>
+tuple<T, T> wobos_t<T>::calculate_ballast() {
   // Calculate the ballast mass for a single spar in tonnes
-  double ballM    = -16.536*pow(turbR, 2) + 1261.8*turbR - 1554.6;
+  T ballM    = -16.536*pow(turbR, 2) + 1261.8*turbR - 1554.6;
 
   // Calculate the ballast cost for a single spar in dollars
-  double ballCost = ballM * ballCR;
+  T ballCost = ballM * ballCR;
 
   return make_tuple(ballM, ballCost);
 }
 
 
-tuple<double, double> wobos::calculate_semi() {
+template <class T>
+tuple<T, T> wobos_t<T>::calculate_semi() {
 
   // Calculate the stiffened column mass for a single semisubmersible in tonnes
-  double ssStifColM    = -0.9571*pow(turbR, 2) + 40.89*turbR + 802.09;
+  T ssStifColM    = -0.9571*pow(turbR, 2) + 40.89*turbR + 802.09;
 
   // Calculate the truss mass for a single semisubmersible in tonnes
-  double ssTrussM      = 2.7894*pow(turbR, 2) + 15.591*turbR + 266.03;
+  T ssTrussM      = 2.7894*pow(turbR, 2) + 15.591*turbR + 266.03;
 
   // Calculate the heave plate mass for a single semisubmersible in tonnes
-  double ssHeaveM      = -0.4397*pow(turbR, 2) + 21.545*turbR + 177.42;
+  T ssHeaveM      = -0.4397*pow(turbR, 2) + 21.545*turbR + 177.42;
 
   // Calculate the stiffened column cost for a single semisubmersible in dollars
-  double ssStifColCost = ssStifColM * ssStifColCR;
+  T ssStifColCost = ssStifColM * ssStifColCR;
   
   // Calculate the truss cost for a single semisubmersible in dollars
-  double ssTrussCost   = ssTrussM * ssTrussCR;
+  T ssTrussCost   = ssTrussM * ssTrussCR;
 
   // Calculate the heave plate cost for a single semisubmersible in dollars
-  double ssHeaveCost   = ssHeaveM * ssHeaveCR;
+  T ssHeaveCost   = ssHeaveM * ssHeaveCR;
   
   return make_tuple(ssStifColM+ssTrussM+ssHeaveM, ssStifColCost+ssTrussCost+ssHeaveCost);
 }
 
 
-tuple<double, double> wobos::calculate_secondary_steel(int substructure) {
+template <class T>
+tuple<T, T> wobos_t<T>::calculate_secondary_steel(int substructure) {
   // calculate the secondary steel mass in tonnes for a single substructure (ladders, boat landings, railing, etc.)
-  double sSteelM;
+  T sSteelM;
   switch (substructure) {
   case MONOPILE:
   case JACKET:
@@ -1302,23 +982,26 @@ tuple<double, double> wobos::calculate_secondary_steel(int substructure) {
     break;
   }
   
-  double sSteelCost = sSteelM * sSteelCR;
+  T sSteelCost = sSteelM * sSteelCR;
 
   return make_tuple(sSteelM, sSteelCost);
 }
 // Overload operator to pass in class variable if no argument is given
-tuple<double, double> wobos::calculate_secondary_steel() {return calculate_secondary_steel(substructure);}
+template <class T>
+tuple<T, T> wobos_t<T>::calculate_secondary_steel() {return calculate_secondary_steel(substructure);}
 
 
 // Calculate the mooring system and anchor cost in dollars for a singe floating substructure (spar or semisubmersible)
 // NOTE: This calculation may be provided as an input if run via WISDEM
-void wobos::calculate_mooring() {
+template <class T>
+template <class P>
+void wobos_t<T>::calculate_mooring() {
   
   if (moorCost <= 0.0) {
     
     // Check if mooring diameter was given as input.  If not, set standard sizes based on turbine rating
     if (moorDia <= 0.0) {
-      double turbR_fit = -0.0004*pow(turbR, 2) + 0.0132*turbR + 0.0536;
+      T turbR_fit = -0.0004*pow(turbR, 2) + 0.0132*turbR + 0.0536;
       if (turbR_fit <= 0.09) {
 	moorDia = 0.09;
       } else if (turbR_fit <= 0.12) {
@@ -1340,11 +1023,11 @@ void wobos::calculate_mooring() {
     }
     
     // Calculate mooring breaking load
-    double moorBL = 419449 * pow(moorDia, 2) + 93415 * moorDia - 3577.9;
+    T moorBL = 419449 * pow(moorDia, 2) + 93415 * moorDia - 3577.9;
     
-    //calculate mooring line length and anchor cost depending on anchor type
-    double moorLeng, anchorCost;
-    switch (anchor) {
+    //calculate mooring line length and path_anchor<P>() cost depending on path_anchor<P>() type
+    T moorLeng, anchorCost;
+    switch (path_anchor<P>()) {
     case DRAGEMBEDMENT:
       moorLeng   = 0.0002*pow(waterD, 2.0) + 1.264*waterD + 47.776 + deaFixLeng;
       anchorCost = moorBL / GRAVITY / 20.0 * 2000.0;
@@ -1361,12 +1044,15 @@ void wobos::calculate_mooring() {
 }
 
 
-void wobos::calculate_substructure_mass_cost() {
+template <class T>
+template <class P>
+void wobos_t<T>::calculate_substructure_mass_cost() {
+  WOBOS_PROFILE_STAGE(profile, STAGE_SUBSTRUCTURE_MASS_COST);
   // Calculate total substructure mass (tonnes) for a single substructure depending on substructure type
   // Calculate the total substructure cost for entire project in dollars
   // NOTE: These quantities could be inputs if module is called within WISDEM
   if ( (subTotM <= 0.0) || (subTotCost <= 0.0) ) {
-    switch (substructure) {
+    switch (path_substructure<P>()) {
       
     case MONOPILE:
       tie(subTotM, subTotCost) = calculate_monopile();
@@ -1377,7 +1063,7 @@ void wobos::calculate_substructure_mass_cost() {
       break;
       
     case SPAR:
-      double ballM, ballCost;
+      T ballM, ballCost;
       tie(subTotM, subTotCost) = calculate_spar();
       tie(ballM, ballCost)     = calculate_ballast();
       subTotM    += ballM;
@@ -1390,13 +1076,13 @@ void wobos::calculate_substructure_mass_cost() {
     }
     
     // All substructures get secondary steel additions
-    double sSteelM, sSteelCost;
-    tie(sSteelM, sSteelCost) = calculate_secondary_steel();
+    T sSteelM, sSteelCost;
+    tie(sSteelM, sSteelCost) = calculate_secondary_steel(path_substructure<P>());
     subTotM    += sSteelM;
     subTotCost += sSteelCost;
 
     // Floaters have mooring lines too
-    if (isFloating()) calculate_mooring();
+    if (path_floating<P>()) calculate_mooring<P>();
     subTotCost += moorCost;
   }
   
@@ -1410,121 +1096,78 @@ void wobos::calculate_substructure_mass_cost() {
 //TotElectricalCost() function definition
 //*******************************************************************************************
 
-double wobos::calculate_export_cable_cost(double expCurrRating, double expVoltage, double expCabMass, double expSubsInterCR, double expCabCR) {
-  // Calculate the total number of export cables that are required based on electrical limits of the cables
-  nExpCab = ceil(((turbR*nTurb) / ((sqrt(3)*expCurrRating*expVoltage*pwrFac*(1 - (buryDepth - 1)*buryFac)) / 1000)));
-
-  // Calculate the export cable length in meters
-  expCabLeng = isFixed() ? (distShore * 1000 + waterD)*nExpCab*1.1 : (distShore * 1000 + freeCabLeng + 500)*nExpCab*1.1;
-  
-  // Calculate the total cost in dollars of the export cabling including interface costs
-  expCabCost = isFloating() ?
-    expCabCR*((expCabLeng - 500 - freeCabLeng) + dynCabFac*(500 + freeCabLeng)) + expSubsInterCR*nExpCab :
-    expCabCR*expCabLeng + expSubsInterCR*nExpCab;
-  
-  // Calculate the mass of each section that makes up the export cable(s)
-  double expCabSecM = expCabMass*expCabLeng / nExpCab / 1000;
-  
-  // Calculate the total number of cable sections per vessel trip for the export cable(s)
-  double expCabSecPerTrip = expCabInstVessel.carousel_weight / expCabSecM;
-  
-  // Calculate the total duration in days required to install the export cable system
-  double fac = (buryDepth > 0) ? 1 / buryRate : 0;
-  expInstTime = ceil(ceil((ceil(nExpCab / expCabSecPerTrip) * (distPort / (expCabInstVessel.transit_speed * 1.852) + expCabLoad) +
-			   (1 + exCabFac)*(distShore * 1000)*(1 / surfLayRate + fac) + (subsPullIn + shorePullIn + cabTerm)*nExpCab) / 24 + landConstruct) *
-		     (1 / (1 - elecCont)));
-
-  // Total cost includes material and installation costs- only used in optimization routine
-  double totalCost = expInstTime*expCabInstVessel.day_rate + expCabCost + expCabLeng*cabSurveyCR;
-
-  return totalCost;
+// Snapshot of the plant values used by the cable cost kernels in lib_wind_obos_cable_cost
+template <class T>
+cable_context_t<T> wobos_t<T>::get_cable_context() const {
+  cable_context_t<T> c;
+  c.fixed         = (substructure == MONOPILE) || (substructure == JACKET);
+  c.floating      = (substructure == SPAR) || (substructure == SEMISUBMERSIBLE);
+  c.turbR         = turbR;
+  c.nTurb         = nTurb;
+  c.rotorD        = rotorD;
+  c.waterD        = waterD;
+  c.distShore     = distShore;
+  c.distPort      = distPort;
+  c.arrayX        = arrayX;
+  c.arrayY        = arrayY;
+  c.buryDepth     = buryDepth;
+  c.elecCont      = elecCont;
+  c.pwrFac        = pwrFac;
+  c.buryFac       = buryFac;
+  c.exCabFac      = exCabFac;
+  c.dynCabFac     = dynCabFac;
+  c.systAngle     = systAngle;
+  c.freeCabLeng   = freeCabLeng;
+  c.fixCabLeng    = fixCabLeng;
+  c.nSubstation   = nSubstation;
+  c.surfLayRate   = surfLayRate;
+  c.cabPullIn     = cabPullIn;
+  c.cabTerm       = cabTerm;
+  c.cabLoadout    = cabLoadout;
+  c.buryRate      = buryRate;
+  c.subsPullIn    = subsPullIn;
+  c.shorePullIn   = shorePullIn;
+  c.landConstruct = landConstruct;
+  c.expCabLoad    = expCabLoad;
+  c.cabSurveyCR   = cabSurveyCR;
+  c.arrCarouselWeight = arrCabInstVessel.carousel_weight;
+  c.arrTransitSpeed   = arrCabInstVessel.transit_speed;
+  c.arrDayRate        = arrCabInstVessel.day_rate;
+  c.expCarouselWeight = expCabInstVessel.carousel_weight;
+  c.expTransitSpeed   = expCabInstVessel.transit_speed;
+  c.expDayRate        = expCabInstVessel.day_rate;
+  c.arrayLayout       = arrayLayout.get();
+  return c;
 }
 
 
+template <class T>
+T wobos_t<T>::calculate_export_cable_cost(T expCurrRating, T expVoltage, T expCabMass, T expSubsInterCR, T expCabCR) {
+  export_cable_result_t<T> res = export_cable_cost(get_cable_context(), expCurrRating, expVoltage, expCabMass, expSubsInterCR, expCabCR);
+  nExpCab     = res.nExpCab;
+  expCabLeng  = res.expCabLeng;
+  expCabCost  = res.expCabCost;
+  expInstTime = res.expInstTime;
+  return res.totalCost;
+}
 
-double wobos::calculate_array_cable_cost(double cab1CurrRating, double cab2CurrRating, double arrVoltage, double arrCab1Mass, double arrCab2Mass,
-					 double cab1CR, double cab2CR, double cab1TurbInterCR, double cab2TurbInterCR, double cab2SubsInterCR) {
-
-  auto numTurbCable = [&] (double rating) {return (floor(((sqrt(3)*rating*arrVoltage*pwrFac*(1 - (buryDepth - 1)*buryFac)) / 1000) / turbR));};
-
-  // Calculate the total number of full strings (string = a set of turbines that share the
-  // same electrical line back to the substation from the array)
-  double fullStrings = floor(nTurb / numTurbCable(cab2CurrRating) );
-  
-  // Calculate the number of turbines on a partial string (partial string = a string that
-  // is created when the remainder of (number of turbines)/(full strings) is greater than zero
-  // Using a lambda function to streamline
-  double nTurbPS = fmod(nTurb, numTurbCable(cab2CurrRating)); 
-  
-  // Calculate the number of turbines that can fit onto array cable 1/2 given power transfer limits
-  double nTurbCab1 = numTurbCable(cab1CurrRating);
-  double nTurbCab2 = numTurbCable(cab2CurrRating);
-  
-  // Calculate the number of turbine interfaces on array cable 1/2
-  double max1 = max(0.0, nTurbCab2 - nTurbCab1);
-  double max2 = max(0.0, nTurbPS - nTurbCab1 - 1);
-  double nTurbInter1 = (nTurbPS == 0) ? (nTurbCab1*fullStrings)*2.0 : (nTurbCab1*fullStrings + min((nTurbPS - 1), nTurbCab1)) * 2.0;
-  double nTurbInter2 = (max1*fullStrings + max2) * 2.0;
-  if (nTurbPS > 0.0) nTurbInter2 += 1.0;
-  
-  // Calculate the number of array cable substation interfaces: array cable 2 is used for all runs from array to substation
-  double nSubsInter = (nTurbPS == 0) ? fullStrings : fullStrings + 1;
-  double stringFac = (nSubstation > 0) ? nSubsInter / nSubstation : nSubsInter;
-  
-  // Calculate the length of array cable 1/2 in meters
-  // TODO: THIS MAX1 FIX SEEMS LIKE A BUG
-  // TODO: The max1 and max2 do not match the document in any equation used (nTurbInter, cabLeng, arrInstTime)!
-  max1--;
-  cab1Leng = isFixed() ?
-    (arrayY*rotorD + waterD * 2)*(nTurbInter1 / 2)*(1 + exCabFac) :
-    (2 * freeCabLeng + fixCabLeng)*(nTurbInter1 / 2)*(1 + exCabFac);
-
-  cab2Leng = isFixed() ?
-    (((arrayY*rotorD + waterD * 2)*(max1*fullStrings + max2)) + nSubstation *
-     ((stringFac * ((rotorD*arrayY) + sqrt(pow(((rotorD*arrayX)*(stringFac - 1)), 2) + pow((rotorD*arrayY), 2)))) / 2 + stringFac*waterD))*(exCabFac + 1) :
-    (((2 * freeCabLeng + fixCabLeng)*max1*fullStrings + max2) + nSubstation *
-     (stringFac*((2 * freeCabLeng + fixCabLeng) + sqrt(pow(((stringFac - 1) *((2 * freeCabLeng) + (arrayX*rotorD) - (2 * ((tan(systAngle*(M_PI / 180))*waterD) + 70)))), 2)
-						       + pow((2 * freeCabLeng + fixCabLeng), 2)))) / 2)*(exCabFac + 1);
-  max1++;
-
-  // Calculate the total cost in dollars of array cable 1/2 including interface costs
-  arrCab1Cost = isFloating() ? dynCabFac*cab1Leng*cab1CR + cab1TurbInterCR*nTurbInter1 : cab1Leng*cab1CR + cab1TurbInterCR*nTurbInter1;
-  arrCab2Cost = isFloating() ?
-    dynCabFac*cab2Leng*cab2CR + nTurbInter2*cab2TurbInterCR + nSubsInter*cab2SubsInterCR :
-    cab2Leng*cab2CR + nTurbInter2*cab2TurbInterCR + nSubsInter*cab2SubsInterCR;
-
-  //calculate the mass of each section that makes up array cable 1
-  auto cabSecMass = [&] (double arrMass) {return isFixed() ?
-					 arrMass * (arrayY*rotorD + waterD * 2)*(1 + exCabFac) / 1000 :
-					  arrMass * (freeCabLeng * 2 + fixCabLeng)*(1 + exCabFac) / 1000;};
-  double cab1SecM = cabSecMass(arrCab1Mass);
-  double cab2SecM = cabSecMass(arrCab2Mass);
-  
-  // Calculate the total number of cable sections per vessel trip for array cable 1/2
-  auto cabSecPerTrip = [&] (double cabM) {return floor(arrCabInstVessel.carousel_weight / cabM);};
-  double cab1SecPerTrip = cabSecPerTrip(cab1SecM);
-  double cab2SecPerTrip = cabSecPerTrip(cab2SecM);
-  
-  //check if cable is buried or not
-  double fac1 = (buryDepth > 0) ? 1 / buryRate : 0.0;
-
-  //check if a partial string exists
-  double fac2 = (nTurbPS == 0) ? (fullStrings*(fullStrings + 1)) / 2 : ((fullStrings + 1)*((fullStrings + 1) + 1)) / 2.0;
-
-  // Calculate the total duration in days required to install the array cabling
-  arrInstTime = ceil((1 + ((((cab1Leng + cab2Leng - (waterD*(nTurbInter1 + nTurbInter2 + nSubsInter))*(1 + exCabFac)) * (fac1 + 1 / surfLayRate) +
-			     (cabPullIn + cabTerm)*(nTurbInter1 + nTurbInter2 + nSubsInter)) +
-			    (ceil(((nTurbInter1*0.5) / cab1SecPerTrip)) + (ceil(((max1*fullStrings + max2 + fac2) / cab2SecPerTrip)))) *
-			    (cabLoadout + distPort / (arrCabInstVessel.transit_speed * 1.852)))*(1 / (1 - elecCont)) / 24)));
-
-  // Total cost includes material and installation costs- only used in optimization routine
-  double totalCost = arrCab1Cost + arrCab2Cost + arrInstTime*arrCabInstVessel.day_rate + (cab1Leng + cab2Leng)*cabSurveyCR;
 
-  return totalCost;
+template <class T>
+T wobos_t<T>::calculate_array_cable_cost(T cab1CurrRating, T cab2CurrRating, T arrVoltage, T arrCab1Mass, T arrCab2Mass,
+					    T cab1CR, T cab2CR, T cab1TurbInterCR, T cab2TurbInterCR, T cab2SubsInterCR) {
+  array_cable_result_t<T> res = array_cable_cost(get_cable_context(), cab1CurrRating, cab2CurrRating, arrVoltage, arrCab1Mass, arrCab2Mass,
+					    cab1CR, cab2CR, cab1TurbInterCR, cab2TurbInterCR, cab2SubsInterCR);
+  cab1Leng    = res.cab1Leng;
+  cab2Leng    = res.cab2Leng;
+  arrCab1Cost = res.arrCab1Cost;
+  arrCab2Cost = res.arrCab2Cost;
+  arrInstTime = res.arrInstTime;
+  return res.totalCost;
 }
 
 
-double wobos::calculate_subsea_cable_cost() {
+template <class T>
+T wobos_t<T>::calculate_subsea_cable_cost() {
   // Calculate system angle (system angle = a value used to calculate a hypotenuse distance
   // which is used to approximate the free hanging length of the array cable for floating wind plants)
   systAngle = -0.0047*waterD + 18.743;
@@ -1541,16 +1184,17 @@ double wobos::calculate_subsea_cable_cost() {
   if (cableOptimizer) ExportCabCostOptimizer();
 
   // Note, class variables that are set inside this function are used, not the output total that includes installation costs too
-  double expCabCostTot = calculate_export_cable_cost(expCurrRating, expVoltage, expCabMass, expSubsInterCR, expCabCR);
+  T expCabCostTot = calculate_export_cable_cost(expCurrRating, expVoltage, expCabMass, expSubsInterCR, expCabCR);
 
   // Calculate the number of substations that are required (this impacts array cable calculations)
   nSubstation = max(1.0, ceil(0.5 * nExpCab) );
+  if (arrayLayout) nSubstation = max(nSubstation, (double)arrayLayout->substations());
   
   // If optimizing, set parameters that govern cost function
   if (cableOptimizer) ArrayCabCostOptimizer();
 
   // Note, class variables that are set inside this function are used, not the output total that includes installation costs too
-  double arrCabCostTot = calculate_array_cable_cost(cab1CurrRating, cab2CurrRating, arrVoltage, arrCab1Mass, arrCab2Mass,
+  T arrCabCostTot = calculate_array_cable_cost(cab1CurrRating, cab2CurrRating, arrVoltage, arrCab1Mass, arrCab2Mass,
 						    cab1CR, cab2CR, cab1TurbInterCR, cab2TurbInterCR, cab2SubsInterCR);
 
   //calculate the total cost in dollars of the sub-sea cabling which includes export and array cabling
@@ -1558,38 +1202,40 @@ double wobos::calculate_subsea_cable_cost() {
 }
 
 
-double wobos::calculate_substation_cost() {
+template <class T>
+template <class P>
+T wobos_t<T>::calculate_substation_cost() {
   // calculate the total number of main power transformers (MPTs) that are required
-  double nMPT = ceil(((nTurb*turbR) / 250));
+  T nMPT = ceil(((nTurb*turbR) / 250));
   
   // calculate the rating in megavolt amperes of a single MPT
   //if the remainder of '((nTurb*turbR*1.15)/nMPT)/10' is greater than 5 round up, else round down
-  double mptRating = roundf(((nTurb*turbR*1.15) / nMPT) / 10.0) * 10.0;
+  T mptRating = roundf(((nTurb*turbR*1.15) / nMPT) / 10.0) * 10.0;
 
   //calculate the total cost for all MPTs in dollars
-  double mptCost = mptRating * nMPT * mptCR;
+  T mptCost = mptRating * nMPT * mptCR;
   
   // calculate the topside mass of the offshore substation(s) in tonnes
   subsTopM    = 3.85*(mptRating*nMPT) + 285.0;
 
   // calculate the offshore substation topside cost in dollars
-  double subsTopCost = subsTopM*subsTopFab + subsTopDes;
+  T subsTopCost = subsTopM*subsTopFab + subsTopDes;
   
   // calculate the cost in dollars of the shunt reactors used to dissipate capacitive reactance
-  double shuntReactors = mptRating*nMPT*shuntCR*0.5;
+  T shuntReactors = mptRating*nMPT*shuntCR*0.5;
   
   // calculate the cost in dollars of the switchgear used for redundancy and protection against electrical surges or faults
-  double switchGear = nMPT*(highVoltSG + medVoltSG);
+  T switchGear = nMPT*(highVoltSG + medVoltSG);
   
   //calculate the cost in dollars of any remaining, necessary ancillary systems
-  double ancillarySys = backUpGen + workSpace + otherAncillary;
+  T ancillarySys = backUpGen + workSpace + otherAncillary;
   
   // calculate the cost of assembling the offshore substation on land in dollars
-  double subsLandAssembly = (switchGear + shuntReactors + mptCost)*topAssemblyFac;
+  T subsLandAssembly = (switchGear + shuntReactors + mptCost)*topAssemblyFac;
 
   // calculate the substructure mass and cost- fraction of topside if fixed, double-large semi if floating
-  double subsSubCost;
-  if (isFixed()) {
+  T subsSubCost;
+  if (path_fixed<P>()) {
     subsSubM    = 0.4 * subsTopM;
     
     // Calculate the mass of the jacket piles in tonnes used for offshore substation substructure for fixed turbine wind plants
@@ -1605,7 +1251,7 @@ double wobos::calculate_substation_cost() {
     tie(subsSubM, subsSubCost) = calculate_semi();
     subsSubCost += moorCost;
     // All substructures get secondary steel additions
-    double sSteelM, sSteelCost;
+    T sSteelM, sSteelCost;
     tie(sSteelM, sSteelCost) = calculate_secondary_steel(SEMISUBMERSIBLE);
     subsSubM    += sSteelM;
     subsSubCost += sSteelCost;
@@ -1620,18 +1266,19 @@ double wobos::calculate_substation_cost() {
 }
 
 
-double wobos::calculate_onshore_transmission_cost() {
+template <class T>
+T wobos_t<T>::calculate_onshore_transmission_cost() {
   // calculate the cost in dollars of the electrical switch yard
-  double switchYard = 18115 * interConVolt + 165944;
+  T switchYard = 18115 * interConVolt + 165944;
   
   // calculate the onshore substation cost in dollars
-  double onShoreSubs = 11652 * (interConVolt + turbR*nTurb) + 1200000;
+  T onShoreSubs = 11652 * (interConVolt + turbR*nTurb) + 1200000;
   
   // calculate miscellaneous costs associated with the onshore substation in dollars
-  double onshoreMisc = 11795 * pow((turbR*nTurb), 0.3549) + 350000;
+  T onshoreMisc = 11795 * pow((turbR*nTurb), 0.3549) + 350000;
   
   // calculate the cost in dollars of the overhead transmission line for connection back to grid
-  double transLine = (1176 * interConVolt + 218257)*pow(distInterCon, -0.1063)*distInterCon;
+  T transLine = (1176 * interConVolt + 218257)*pow(distInterCon, -0.1063)*distInterCon;
 
   //calculate the total cost in dollars of the onshore transmission system which includes the onshore
   //substation, switch yard, connection to grid, and other misc. costs
@@ -1640,16 +1287,19 @@ double wobos::calculate_onshore_transmission_cost() {
 
 
 
-void wobos::calculate_electrical_infrastructure_cost() {
+template <class T>
+template <class P>
+void wobos_t<T>::calculate_electrical_infrastructure_cost() {
+  WOBOS_PROFILE_STAGE(profile, STAGE_ELECTRICAL_INFRASTRUCTURE_COST);
 
   // Calculate subsea cable cost
-  double subCabCost = calculate_subsea_cable_cost();
+  T subCabCost = calculate_subsea_cable_cost();
   
   // Calculate the total cost in dollars of the offshore substation  
-  double offSubsCost = calculate_substation_cost();
+  T offSubsCost = calculate_substation_cost<P>();
 
   // Calculate the total cost in dollars of the onshore transmission system
-  double onshoreTransCost = calculate_onshore_transmission_cost();
+  T onshoreTransCost = calculate_onshore_transmission_cost();
 
   //calculate the total cost for the entire electrical infrastructure system
   totElecCost = subCabCost + offSubsCost + onshoreTransCost;
@@ -1662,11 +1312,13 @@ void wobos::calculate_electrical_infrastructure_cost() {
 //function definition
 //*******************************************************************************************
 
-double wobos::MinTurbDeckArea() {
+template <class T>
+template <class P>
+T wobos_t<T>::MinTurbDeckArea() {
   
-  double area1;
+  T area1;
   //check for turbine installation method
-  switch (turbInstallMethod) {
+  switch (path_turb_install<P>()) {
   case ROTORASSEMBLED:
     area1 = (bladeL + inspectClear)*(max_chord + inspectClear) + (M_PI*pow((hubD / 2), 2)) / 2
       + (nacelleL + inspectClear)*(nacelleW + inspectClear);
@@ -1682,7 +1334,7 @@ double wobos::MinTurbDeckArea() {
     break;
   }
 
-  double area2 = (towerInstallMethod == ONEPIECE) ?
+  T area2 = (path_tower_install<P>() == ONEPIECE) ?
     area1 + pow((towerD + inspectClear), 2.0) :
     area1 + pow((towerD + inspectClear), 2.0) * 2.0;
 
@@ -1690,10 +1342,13 @@ double wobos::MinTurbDeckArea() {
 }
 
 
-double wobos::TurbineInstall() {
-  double sum;
+// Hours at each position to install one turbine, without jacking up and down
+template <class T>
+template <class P>
+T wobos_t<T>::TurbineInstallHours() {
+  T sum;
   //check turbine installation method
-  switch (turbInstallMethod) {
+  switch (path_turb_install<P>()) {
   case ROTORASSEMBLED:
     sum = vesselPosTurb + boltTower + boltNacelle3 + boltRotor;
     break;
@@ -1705,24 +1360,32 @@ double wobos::TurbineInstall() {
     break;
   }
 
-  if (towerInstallMethod == TWOPIECE) sum += boltTower;
+  if (path_tower_install<P>() == TWOPIECE) sum += boltTower;
+
+  if (path_floating<P>()) sum -= vesselPosTurb + turbFasten;
+  return sum;
+}
+
 
-  if (isFloating()) sum -= vesselPosTurb + turbFasten;
+template <class T>
+template <class P>
+T wobos_t<T>::TurbineInstall() {
+  T sum = TurbineInstallHours<P>();
 
-  double sum2 = (installStrategy == PRIMARYVESSEL) ? 
+  T sum2 = (path_strategy<P>() == PRIMARYVESSEL) ? 
     (ceil(nTurb / nTurbPerTrip))*(distPort / ((turbInstVessel.transit_speed * 1852) / 1000)) * 2 + turbFasten*nTurb : 0;
 
   //check substructure type
-  if (substructure == SPAR) {
+  if (path_substructure<P>() == SPAR) {
     return ceil(1.5*(((distPtoA / (turbInstVessel.tow_speed))*(nTurb / nTurbPerTrip)) / 24 + sum *
 		     (1 / (1 - turbCont))*nTurb / 24) + (1 / (1 - substructCont))*(nTurb / 24) *
 		(distAtoS / (turbInstVessel.tow_speed) + (spMoorCon + spMoorCheck + prepTow)) );
 
-  } else if (substructure == SEMISUBMERSIBLE) {
+  } else if (path_substructure<P>() == SEMISUBMERSIBLE) {
     return ceil(sum*(1 / (1 - turbCont))*nTurb / 24 +
 		((nTurb / 24)*(1 / (1 - substructCont)) * ((prepTow + ssBall + ssMoorCheck + ssMoorCon) +
 							   (distPort / turbInstVessel.tow_speed))));
-  } else { // ((substructure == MONOPILE) || (substructure == JACKET))
+  } else { // ((path_substructure<P>() == MONOPILE) || (path_substructure<P>() == JACKET))
     return ceil((((sum + ((waterD + 10) / (turbInstVessel.jackup_speed * 60)) * 2) *
 		  nTurb + (nTurb - ceil((nTurb / nTurbPerTrip)))*(arrayY*rotorD) /
 		  (turbInstVessel.transit_speed * 1852) + sum2) / 24)*(1 / (1 - turbCont)));
@@ -1730,61 +1393,190 @@ double wobos::TurbineInstall() {
 }
 
 
-double wobos::SubstructureInstTime() {
+template <class T>
+template <class P>
+T wobos_t<T>::SubstructureInstTime() {
 
-  double fac1 = 0;
-  if (installStrategy == PRIMARYVESSEL) {
-    fac1 = (substructure == JACKET) ?
+  T fac1 = 0;
+  if (path_strategy<P>() == PRIMARYVESSEL) {
+    fac1 = (path_substructure<P>() == JACKET) ?
       ceil(nTurb / nSubPerTrip)*(distPort / (subInstVessel.transit_speed * 1.852)) * 2 * 2 + 2 * jackFasten*nTurb :
       ceil(nTurb / nSubPerTrip)*(distPort / (subInstVessel.transit_speed * 1.852)) * 2 * 1 + monoFasten*nTurb;
   }
   
   //check substructure type
-  double sum1 = (substructure == JACKET) ?
+  T sum1 = (path_substructure<P>() == JACKET) ?
     vesselPosJack * 2 + placeTemplate + prepGripperJack + placePiles + prepHamJack + removeHamJack + placeJack
     + levJack + ((jpileL - 5) / hamRate) * 4 + ((waterD + 10) / (subInstVessel.jackup_speed * 60)) * 2 * 2 :
     vesselPosMono + prepGripperMono + placeMP + prepHamMono + removeHamMono + placeTP + groutTP //change
     + tpCover + (mpEmbedL / hamRate) + ((waterD + 10) / (subInstVessel.jackup_speed * 60)) * 2;
   
   //check if fixed substructure type is selected
-  return isFixed() ?
+  return path_fixed<P>() ?
     ceil(((1 / (1 - substructCont))*((sum1*nTurb + (nTurb - ceil((nTurb / nSubPerTrip)))
 				      *(rotorD*arrayX) / (subInstVessel.transit_speed * 1852)) + fac1)) / 24) :
     moorTime + floatPrepTime;
 }
 
 
-void wobos::calculate_assembly_and_installation() {
+// Installation of fixed substructure turbines for install_simulator, in hours as TurbineInstall
+template <class T>
+template <class P>
+install_campaign wobos_t<T>::turbine_install_campaign() {
+  install_campaign c;
+  c.nUnits       = (size_t)ceil(primal(nTurb));
+  c.unitsPerLoad = (size_t)min(floor(primal(nTurbPerTrip)), (double)c.nUnits);
+  install_pass pass = {primal(turbFasten),
+		       primal(TurbineInstallHours<P>() + ((waterD + 10) / (turbInstVessel.jackup_speed * 60)) * 2)};
+  c.passes.push_back(pass);
+  c.transitHours  = primal(distPort / ((turbInstVessel.transit_speed * 1852) / 1000));
+  c.moveHours     = primal((arrayY*rotorD) / (turbInstVessel.transit_speed * 1852));
+  c.weatherFactor = primal(1 / (1 - turbCont));
+  c.startHour     = primal(installStartHour);
+  if (path_strategy<P>() == FEEDERBARGE) {
+    c.nBarges           = (size_t)max(turbFeederBarge.number_of_vessels, 1.0);
+    c.bargeTransitHours = primal(distPort / (turbFeederBarge.transit_speed * 1.852));
+  }
+  if (weather) {
+    c.weather      = weather->windows(turbInstVessel.max_wind_speed, turbInstVessel.max_wave_height).get();
+    c.bargeWeather = weather->windows(turbFeederBarge.max_wind_speed, turbFeederBarge.max_wave_height).get();
+  }
+  return c;
+}
+
+
+// Installation of fixed substructures for install_simulator, in hours as SubstructureInstTime.  Jacket piles
+// go in through the template on one visit and the jackets on the next.
+template <class T>
+template <class P>
+install_campaign wobos_t<T>::substructure_install_campaign() {
+  T jackup = ((waterD + 10) / (subInstVessel.jackup_speed * 60)) * 2;
+  install_campaign c;
+  c.nUnits       = (size_t)ceil(primal(nTurb));
+  c.unitsPerLoad = (size_t)min(floor(primal(nSubPerTrip)), (double)c.nUnits);
+  if (path_substructure<P>() == JACKET) {
+    install_pass piles = {primal(jackFasten), primal(vesselPosJack + placeTemplate + placePiles + prepHamJack + removeHamJack
+						     + ((jpileL - 5) / hamRate) * 4 + jackup)};
+    install_pass jackets = {primal(jackFasten), primal(vesselPosJack + prepGripperJack + placeJack + levJack + jackup)};
+    c.passes.push_back(piles);
+    c.passes.push_back(jackets);
+  } else {
+    install_pass monopiles = {primal(monoFasten), primal(vesselPosMono + prepGripperMono + placeMP + prepHamMono + removeHamMono
+							 + placeTP + groutTP + tpCover + (mpEmbedL / hamRate) + jackup)};
+    c.passes.push_back(monopiles);
+  }
+  c.transitHours  = primal(distPort / (subInstVessel.transit_speed * 1.852));
+  c.moveHours     = primal((rotorD*arrayX) / (subInstVessel.transit_speed * 1852));
+  c.weatherFactor = primal(1 / (1 - substructCont));
+  c.startHour     = primal(installStartHour);
+  if (path_strategy<P>() == FEEDERBARGE) {
+    c.nBarges           = (size_t)max(subFeederBarge.number_of_vessels, 1.0);
+    c.bargeTransitHours = primal(distPort / (subFeederBarge.transit_speed * 1.852));
+  }
+  if (weather) {
+    c.weather      = weather->windows(subInstVessel.max_wind_speed, subInstVessel.max_wave_height).get();
+    c.bargeWeather = weather->windows(subFeederBarge.max_wind_speed, subFeederBarge.max_wave_height).get();
+  }
+  return c;
+}
+
+
+// Wait for windows of a vessel for several activities in a row, e.g. the visits to one substructure position
+static weather_delay sum_delays(const weather_windows &windows, const vector<double> &hours) {
+  weather_delay out = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  for (size_t k=0; k<hours.size(); k++) {
+    weather_delay d = windows.delays(hours[k]);
+    out.hours += d.hours;
+    out.mean  += d.mean;
+    out.p50   += d.p50;
+    out.p90   += d.p90;
+    out.max   += d.max;
+  }
+  out.contingency = (out.mean < numeric_limits<double>::infinity()) ? out.mean / (out.hours + out.mean) : 1.0;
+  return out;
+}
+
+
+template <class T>
+void wobos_t<T>::weather_delays(weather_delay &turbDelay, weather_delay &subDelay, weather_delay &cableDelay) {
+  if (!weather) throw runtime_error("No weather to find installation windows in");
+
+  // A turbine, jacked up for fixed substructures
+  T turbHours = TurbineInstallHours();
+  if (isFixed()) turbHours += ((waterD + 10) / (turbInstVessel.jackup_speed * 60)) * 2;
+  turbDelay = sum_delays(*weather->windows(turbInstVessel.max_wind_speed, turbInstVessel.max_wave_height),
+			 vector<double>(1, primal(turbHours)));
+
+  // A substructure, or the hookup of a floating one
+  vector<double> subHours;
+  if (isFixed()) {
+    install_campaign c = substructure_install_campaign();
+    for (size_t k=0; k<c.passes.size(); k++) subHours.push_back(c.passes[k].installHours);
+  }
+  else if (substructure == SPAR) subHours.push_back(primal(spMoorCon + spMoorCheck + prepTow));
+  else subHours.push_back(primal(prepTow + ssBall + ssMoorCheck + ssMoorCon));
+  subDelay = sum_delays(*weather->windows(subInstVessel.max_wind_speed, subInstVessel.max_wave_height), subHours);
+
+  // An array cable section between neighbouring turbines, laid, buried and pulled in at both ends
+  T layRate = (buryDepth > 0) ? 1 / surfLayRate + 1 / buryRate : 1 / surfLayRate;
+  T cabHours = (arrayY*rotorD)*(1 + exCabFac)*layRate + 2*(cabPullIn + cabTerm);
+  cableDelay = sum_delays(*weather->windows(arrCabInstVessel.max_wind_speed, arrCabInstVessel.max_wave_height),
+			  vector<double>(1, primal(cabHours)));
+}
+
+
+template <class T>
+void wobos_t<T>::set_weather_contingencies() {
+  weather_delay turbine, sub, cable;
+  weather_delays(turbine, sub, cable);
+  if ((turbine.contingency >= 1.0) || (sub.contingency >= 1.0) || (cable.contingency >= 1.0))
+    throw runtime_error("No weather window long enough for an installation activity");
+
+  turbCont      = turbine.contingency;
+  substructCont = sub.contingency;
+  elecCont      = cable.contingency;
+  varValues[VAR_turbCont]      = turbine.contingency;
+  varValues[VAR_substructCont] = sub.contingency;
+  varValues[VAR_elecCont]      = cable.contingency;
+}
+
+
+template <class T>
+template <class P>
+void wobos_t<T>::calculate_assembly_and_installation() {
+  WOBOS_PROFILE_STAGE(profile, STAGE_ASSEMBLY_AND_INSTALLATION);
 
   // Calculate the total duration in days for the mooring system installation
-  moorTime = (anchor == DRAGEMBEDMENT) ? 5.0 + waterD*moorTimeFac : 11.0 + waterD*moorTimeFac;
+  moorTime = (path_anchor<P>() == DRAGEMBEDMENT) ? 5.0 + waterD*moorTimeFac : 11.0 + waterD*moorTimeFac;
   moorTime = ceil((((moorLoadout + moorSurvey + moorTime)*moorLines + (waterD*moorTimeFac)*moorLines +
 		    (distPort * 1000 * 2 / (subInstVessel.transit_speed * 1852)))*nTurb / 24)*(1 / (1 - substructCont)));
 
   // Calculate the total duration in days to prep floating substructures for turbine installation
-  floatPrepTime = (substructure == SPAR) ?
+  floatPrepTime = (path_substructure<P>() == SPAR) ?
     ceil(((((prepSpar + upendSpar) + (distPtoA / subInstVessel.tow_speed))*nTurb) / 24) + prepAA / 24) :
     ceil((prepSemi*nTurb) / 24);
   
   // Calculate the minimum deck area that is required to for a single turbine
-  turbDeckArea = MinTurbDeckArea();
+  turbDeckArea = MinTurbDeckArea<P>();
   
   // Calculated the maximum number of turbines that can be transported to the install site
   nTurbPerTrip = 1;
-  if (isFixed()) {
-    nTurbPerTrip = (installStrategy == PRIMARYVESSEL) ?
+  if (path_fixed<P>()) {
+    nTurbPerTrip = (path_strategy<P>() == PRIMARYVESSEL) ?
       min((turbInstVessel.deck_space / turbDeckArea), (turbInstVessel.payload / (rnaM + towerM))) :
       min((turbFeederBarge.deck_space / turbDeckArea), (turbFeederBarge.payload / (rnaM + towerM)));
-  } else if (substructure == SPAR) {
+  } else if (path_substructure<P>() == SPAR) {
     nTurbPerTrip = min((turbFeederBarge.deck_space / turbDeckArea), (turbFeederBarge.payload / (rnaM + towerM)));
   }
 
-  // Calculate the total duration in days required to install all turbines
-  turbInstTime = TurbineInstall();
+  // Calculate the total duration in days required to install all turbines, simulated for fixed substructures
+  // if installSimulation is on (then with a zero derivative, like any ceil)
+  turbInstTime = (installSimulation && path_fixed<P>()) ?
+    T(ceil(installSim.simulate(turbine_install_campaign<P>()).hours / 24)) : TurbineInstall<P>();
 
   // Calculate the minimum turbine deck area that is required for a single substructure (fixed substructures only
   // return 0 for floating substructures)
-  switch (substructure) {
+  switch (path_substructure<P>()) {
   case MONOPILE:
     subDeckArea = (mpileL + inspectClear)*(mpileD + inspectClear) + pow((mpileD + inspectClear + 1), 2);
     break;
@@ -1798,17 +1590,18 @@ void wobos::calculate_assembly_and_installation() {
 
   // Calculate the maximum number of substructures that can be transported to the install site
   nSubPerTrip = 1;
-  if (isFixed()) {
-    nSubPerTrip = (installStrategy == PRIMARYVESSEL) ?
+  if (path_fixed<P>()) {
+    nSubPerTrip = (path_strategy<P>() == PRIMARYVESSEL) ?
       floor(min((subInstVessel.deck_space / subDeckArea), (subInstVessel.payload / subTotM))) :
       floor(min((subFeederBarge.deck_space / subDeckArea), (subFeederBarge.payload / subTotM)));
   }
   
   // Calculate the total duration in days required to install all substructures
-  subInstTime = SubstructureInstTime();
+  subInstTime = (installSimulation && path_fixed<P>()) ?
+    T(ceil(installSim.simulate(substructure_install_campaign<P>()).hours / 24)) : SubstructureInstTime<P>();
 
   // Calculate the total duration in days required to install the offshore substation
-  subsInstTime = isFixed() ?
+  subsInstTime = path_fixed<P>() ?
     ceil(((subsLoad + subsVessPos + placeTop) + (distPort / (substaInstVessel.transit_speed * 1.852))) /
 	 24 * (1 / (1 - elecCont))) :
     ceil(((subsLoad + subsVessPos + placeTop + ssMoorCon + ssMoorCheck) +
@@ -1816,53 +1609,59 @@ void wobos::calculate_assembly_and_installation() {
   
   // Calculate the total duration in days required to install the complete wind plant
   totInstTime = turbInstTime + arrInstTime + expInstTime + subsInstTime;
-  totInstTime += isFloating() ? moorTime + floatPrepTime : subInstTime;
+  totInstTime += path_floating<P>() ? moorTime + floatPrepTime : subInstTime;
   
   // Calculate the cost of surveying and verifying cable installation
   cabSurvey =  (expCabLeng + cab1Leng + cab2Leng) * cabSurveyCR;
   
-  TurbInstCost();
-  SubInstCost();
-  ElectricalInstCost();
-  VesselMobDemobCost();
-  totAnICost = TotInstCost();
+  TurbInstCost<P>();
+  SubInstCost<P>();
+  ElectricalInstCost<P>();
+  VesselMobDemobCost<P>();
+  totAnICost = TotInstCost<P>();
 }
 
 
 //Calculate the cost of each vessel used for turbine installation
-void wobos::TurbInstCost() {
+template <class T>
+template <class P>
+void wobos_t<T>::TurbInstCost() {
 
   turbine_install_cost = turbInstVessel.get_rate() * turbInstTime;
 
   for (size_t i=0; i<turbSupportVessels.size(); i++)
     turbine_install_cost += turbSupportVessels[i].get_rate() * turbInstTime;
 
-  if ((installStrategy == FEEDERBARGE) || (substructure == SPAR))
+  if ((path_strategy<P>() == FEEDERBARGE) || (path_substructure<P>() == SPAR))
     turbine_install_cost += turbFeederBarge.get_rate() * turbInstTime;
 }
 
 
 // Calculate substructure installation cost
-void wobos::SubInstCost() {
+template <class T>
+template <class P>
+void wobos_t<T>::SubInstCost() {
 
-  double instTime1 = (substructure == SPAR) ? (subInstTime - moorTime) : subInstTime;
-  double instTime2 = (substructure == SPAR) ? moorTime : subInstTime;
+  T instTime1 = (path_substructure<P>() == SPAR) ? (subInstTime - moorTime) : subInstTime;
+  T instTime2 = (path_substructure<P>() == SPAR) ? moorTime : subInstTime;
 
   substructure_install_cost = subInstVessel.get_rate() * instTime2;
 
   for (size_t i=0; i < subSupportVessels.size(); i++)
     substructure_install_cost += subSupportVessels[i].get_rate() * instTime1;
   
-  if ((installStrategy == FEEDERBARGE) || (substructure == SPAR))
+  if ((path_strategy<P>() == FEEDERBARGE) || (path_substructure<P>() == SPAR))
     substructure_install_cost += subFeederBarge.get_rate() * instTime1;
   
-  if (substructure == MONOPILE)
+  if (path_substructure<P>() == MONOPILE)
     substructure_install_cost += (instScour/24) * nTurb * scourProtVessel.get_rate();
 }
 
 
 // Calculate electrical infrastructure installation cost
-void wobos::ElectricalInstCost() {
+template <class T>
+template <class P>
+void wobos_t<T>::ElectricalInstCost() {
 
   array_cable_install_cost  = arrCabInstVessel.get_rate() * arrInstTime;
   export_cable_install_cost = expCabInstVessel.get_rate() * expInstTime;
@@ -1871,7 +1670,7 @@ void wobos::ElectricalInstCost() {
   for (size_t i=0; i<elecTugs.size(); i++)
     substation_install_cost += elecTugs[i].get_rate() * subsInstTime;
 
-  if (isFixed())
+  if (path_fixed<P>())
     substation_install_cost += substaInstVessel.get_rate() * subsInstTime;
 
   electrical_install_cost = array_cable_install_cost + export_cable_install_cost + substation_install_cost;
@@ -1891,7 +1690,9 @@ double my_mobilization_cost(vessel myvessel, set<int> *myset) {
 }
 
 // Calculate mobilization and demobilization costs for unique vessels
-void wobos::VesselMobDemobCost() {
+template <class T>
+template <class P>
+void wobos_t<T>::VesselMobDemobCost() {
 
   // Initialize output
   mob_demob_cost = 0.0;
@@ -1919,33 +1720,38 @@ void wobos::VesselMobDemobCost() {
   for (size_t i=0; i<elecSupportVessels.size(); i++)
     mob_demob_cost += my_mobilization_cost( elecSupportVessels[i], &myset);
   
-  if(installStrategy == FEEDERBARGE || substructure == SPAR) {
+  if(path_strategy<P>() == FEEDERBARGE || path_substructure<P>() == SPAR) {
     mob_demob_cost += my_mobilization_cost( turbFeederBarge, &myset);
     mob_demob_cost += my_mobilization_cost( subFeederBarge, &myset);
   }
 
-  // Expense this for number of installation seasons
-  mob_demob_cost *= number_install_seasons;
+  // Expense this for number of installation seasons, and for as many more as it takes to install the plant in
+  // seasons of installSeasonLength days
+  installSeasons = number_install_seasons;
+  if (installSeasonLength > 0) installSeasons = max(installSeasons, T(ceil(totInstTime / installSeasonLength)));
+  mob_demob_cost *= installSeasons;
 }
 
 
 //calculate the total cost in dollars for the complete assembly and installation of the wind plant
-double wobos::TotInstCost() {
+template <class T>
+template <class P>
+T wobos_t<T>::TotInstCost() {
 
   // Initialize summation
-  double sum = cabSurvey + cabDrillDist*cabDrillCR + (mpvRentalDR + diveTeamDR + winchDR)*landConstruct + civilWork + elecWork +
+  T sum = cabSurvey + cabDrillDist*cabDrillCR + (mpvRentalDR + diveTeamDR + winchDR)*landConstruct + civilWork + elecWork +
     turbine_install_cost + substructure_install_cost + electrical_install_cost + mob_demob_cost;
   
-  if (isFixed()) {
+  if (path_fixed<P>()) {
     sum += subInstTime*(pileSpreadDR + groutSpreadDR) + groutSpreadMob + pileSpreadMob + compRacks;
-  } else if (anchor == SUCTIONPILE) {// floating and suction pile
+  } else if (path_anchor<P>() == SUCTIONPILE) {// floating and suction pile
     sum += seaSpreadDR*moorTime + seaSpreadMob;
   }
   
   // Substructure specific
-  if (substructure == MONOPILE) {
+  if (path_substructure<P>() == MONOPILE) {
     sum += scourMat*nTurb;
-  } else if (substructure == SPAR) {
+  } else if (path_substructure<P>() == SPAR) {
     sum += compRacks;
   }
   
@@ -1957,16 +1763,18 @@ double wobos::TotInstCost() {
 //function definition
 //*******************************************************************************************
 
-double wobos::calculate_entrance_exit_costs() {
+template <class T>
+template <class P>
+T wobos_t<T>::calculate_entrance_exit_costs() {
   //check substructure type
-  if (substructure == SEMISUBMERSIBLE) {
+  if (path_substructure<P>() == SEMISUBMERSIBLE) {
     return ((nTurb*turbInstVessel.length * turbInstVessel.breadth) + 1)*entranceExitRate;
-  } else if (substructure == SPAR) {
+  } else if (path_substructure<P>() == SPAR) {
     return (ceil(nTurb / nTurbPerTrip)*(turbInstVessel.length * turbInstVessel.breadth + turbFeederBarge.length
 					* turbFeederBarge.breadth) + 1)*entranceExitRate;
   } else {
     //check installation vessel strategy
-    if (installStrategy == PRIMARYVESSEL) {
+    if (path_strategy<P>() == PRIMARYVESSEL) {
       return ((ceil(nTurb / nTurbPerTrip)*(turbInstVessel.length * turbInstVessel.breadth) +
 	       ceil(nTurb / nSubPerTrip)*(subInstVessel.length * subInstVessel.breadth)) + substaInstVessel.length * substaInstVessel.breadth)
 	*entranceExitRate;
@@ -1979,56 +1787,59 @@ double wobos::calculate_entrance_exit_costs() {
 }
 
 
-void wobos::calculate_port_and_staging_costs() {
+template <class T>
+template <class P>
+void wobos_t<T>::calculate_port_and_staging_costs() {
+  WOBOS_PROFILE_STAGE(profile, STAGE_PORT_AND_STAGING_COSTS);
 
   // Calculate the cost in dollars of port entrance and exit fees based on vessel size and number of entrances/exits
-  double entrExitCost = calculate_entrance_exit_costs();
+  T entrExitCost = calculate_entrance_exit_costs<P>();
 
   // Calculate the cost in dollars of the wharf where loading and unloading operations will take place
-  double wharfCost = isFixed() ?
+  T wharfCost = path_fixed<P>() ?
     ((rnaM + towerM + subTotM)*nTurb + subsTopM + subsSubM + subsPileM)*wharfRate :
     ((rnaM + towerM)*nTurb + subsTopM)*wharfRate;
 
   // calculate the cost in dollars of the vessel docking cost as a function of installation duration
-  double dockCost = isFloating() ?
+  T dockCost = path_floating<P>() ?
     (moorTime + floatPrepTime + turbInstTime + subsInstTime)*dockRate :
     (turbInstTime + subInstTime + subsInstTime)*dockRate;
   
   // Calculate the required area in square meters for substructure staging and pre-assembly
-  double subLaydownA;
-  if (installStrategy == FEEDERBARGE) {
+  T subLaydownA;
+  if (path_strategy<P>() == FEEDERBARGE) {
     subLaydownA = (subDeckArea*nSubPerTrip*subFeederBarge.number_of_vessels) * 2;
   } else {
-    subLaydownA = isFixed() ? (subDeckArea*nSubPerTrip) * 2 : 0;
+    subLaydownA = path_fixed<P>() ? (subDeckArea*nSubPerTrip) * 2 : 0;
   }
   
   // Calculate the cost in dollars of the laydown and staging area for substructures
-  double subLayCost = subInstTime * laydownCR * subLaydownA;
+  T subLayCost = subInstTime * laydownCR * subLaydownA;
   
   // Calculate the required area in square meters for the turbine staging and pre-assembly
-  double turbLaydownA = (installStrategy == FEEDERBARGE) ?
+  T turbLaydownA = (path_strategy<P>() == FEEDERBARGE) ?
     turbDeckArea*nTurbPerTrip*turbFeederBarge.number_of_vessels * 2 :
     turbDeckArea*nTurbPerTrip * 2;
   
   // Calculate the cost in dollars of the staging area for the turbines
-  double turbLayCost = turbInstTime * turbLaydownA * laydownCR;
+  T turbLayCost = turbInstTime * turbLaydownA * laydownCR;
 
   // Set number of cranes needed
   if (nCrane1000 <= 0) nCrane1000 = 1;
   if (nCrane600 <= 0) {
-    nCrane600 = (substructure == SPAR) ? 3 : 1;
+    nCrane600 = (path_substructure<P>() == SPAR) ? 3 : 1;
   }
 
   // Calculate the cost in dollars of the cranes that are required to carry out lifting operations at port
-  double craneCost = isFloating() ? (nCrane600*crane600DR + nCrane1000*crane1000DR)*(turbInstTime + floatPrepTime + moorTime)
+  T craneCost = path_floating<P>() ? (nCrane600*crane600DR + nCrane1000*crane1000DR)*(turbInstTime + floatPrepTime + moorTime)
     + (crane1000DR*(ceil(subsTopM / 1000))*(placeTop / 24)) + craneMobDemob :
     (nCrane600*crane600DR + nCrane1000*crane1000DR)*(turbInstTime + subInstTime) + craneMobDemob;
   
   // Calculate the total port cost in dollars which includes the wharf, docking, and entrance/exit costs
-  double totPortCost = entrExitCost + dockCost + wharfCost;
+  T totPortCost = entrExitCost + dockCost + wharfCost;
 
   // Calculate the total staging cost in dollars which includes the laydown, staging, and crane costs
-  double totStageCost = turbLayCost + subLayCost + craneCost;
+  T totStageCost = turbLayCost + subLayCost + craneCost;
   
   // Calculate the total cost in dollars of all port and staging related costs and fees
   totPnSCost = totPortCost + totStageCost;
@@ -2042,7 +1853,9 @@ void wobos::calculate_port_and_staging_costs() {
 
 //calculate the total engineering and management cost based on a percentage of total hard costs
 //(hard costs = procurement and installation costs excluding turbine costs)
-void wobos::calculate_engineering_management_cost() {
+template <class T>
+void wobos_t<T>::calculate_engineering_management_cost() {
+  WOBOS_PROFILE_STAGE(profile, STAGE_ENGINEERING_MANAGEMENT_COST);
   totEnMCost = estEnMFac*(subTotCost + totPnSCost + totElecCost + totAnICost);
 }
 
@@ -2050,19 +1863,21 @@ void wobos::calculate_engineering_management_cost() {
 //Offshore BOS model 'Development' module starts here and ends after TotalDevCost() function
 //definition
 //*******************************************************************************************
-void wobos::calculate_development_cost() {
+template <class T>
+void wobos_t<T>::calculate_development_cost() {
+  WOBOS_PROFILE_STAGE(profile, STAGE_DEVELOPMENT_COST);
   // Calculate the cost in dollars of the front end engineering design study pre-development
-  double feedCost = preFEEDStudy + feedStudy;
+  T feedCost = preFEEDStudy + feedStudy;
   
   // Calculate the total compliance cost in dollars which includes various leases and legal compliance costs
-  double permStudyComp = stateLease + outConShelfLease + saPlan + conOpPlan + nepaEisMet + physResStudyMet + bioResStudyMet
+  T permStudyComp = stateLease + outConShelfLease + saPlan + conOpPlan + nepaEisMet + physResStudyMet + bioResStudyMet
 		+ socEconStudyMet + navStudyMet + nepaEisProj + physResStudyProj + bioResStudyProj + socEconStudyProj
 		+ navStudyProj + coastZoneManAct + rivsnHarbsAct + cleanWatAct402 + cleanWatAct404 + faaPlan
 		+ endSpecAct + marMamProtAct + migBirdAct + natHisPresAct + addLocPerm;
 
   // Calculate the cost in dollars of the meteorological tower used for wind resource and other site
   // assessment studies including installation costs
-  double metFabCost = nTurb*turbR*metTowCR;
+  T metFabCost = nTurb*turbR*metTowCR;
   
   // Calculate the total development cost in dollars
   totDevCost = metFabCost + permStudyComp + feedCost;
@@ -2075,9 +1890,10 @@ void wobos::calculate_development_cost() {
 
 //This optimizer determines which cables for the array are of the lowest cost considering both
 //procurement costs and installation costs
-void wobos::ArrayCabCostOptimizer() {
+template <class T>
+void wobos_t<T>::ArrayCabCostOptimizer() {
+  WOBOS_PROFILE_STAGE(profile, STAGE_ARRAY_CABLE_OPTIMIZER);
   size_t nArrVolts = arrCables.size();
-  size_t nArrCables = arrCables[0].cables.size();
   
   //The next 3 arrays contain default data for the array cables. note that if the number of cables
   //changes form the default of 11 then these tables will need the appropriate additions of the
@@ -2129,16 +1945,84 @@ void wobos::ArrayCabCostOptimizer() {
   size_t cabIndex2    = 0;
   size_t arrVoltIndex = 0;
   double oldCost      = 1e30;
-  double newCost      = 0;
-
-  for (size_t k = 0; k < nArrVolts; k++) { // volt loop
-    for (size_t i = 0; i < nArrCables; i++) { // cable1 loop
-      for (size_t j = i + 1; j < nArrCables; j++) { // cable 2 loop
-	newCost = calculate_array_cable_cost(arrCables[k].cables[i].currRating, arrCables[k].cables[j].currRating, arrCables[k].voltage,
-					     arrCables[k].cables[i].mass, arrCables[k].cables[j].mass, arrCables[k].cables[i].cost, arrCables[k].cables[j].cost,
-					     arrCables[k].cables[i].turbInterfaceCost, arrCables[k].cables[j].turbInterfaceCost, arrCables[k].cables[j].subsInterfaceCost);
-	if (newCost < oldCost) {
-	    oldCost      = newCost;
+
+  // Cost only grows with cable cost rate, turbine interface cost and mass (through the number of vessel trips),
+  // as long as none of the terms multiplying them are negative.  In that case a cable that is no better than an
+  // earlier cable carrying the same number of turbines never has to be tried as array cable 1.
+  const cable_context ctx = primal(get_cable_context());
+  bool prune = (ctx.elecCont < 1.0) && (ctx.cabLoadout >= 0.0) && (ctx.distPort >= 0.0) && (ctx.arrTransitSpeed > 0.0) &&
+    (ctx.arrDayRate >= 0.0) && (ctx.arrCarouselWeight >= 0.0) && (ctx.cabSurveyCR >= 0.0) &&
+    (ctx.dynCabFac >= 0.0) && (ctx.exCabFac > -1.0);
+
+  // Same context and catalog, same choice
+  vector<double> key;
+  cable_choice best;
+  cable_choice_cache::make_key(CABLE_CACHE_ARRAY, ctx, arrCables, key);
+  bool cached = cable_choice_cache::shared().find(key, best);
+
+  for (size_t k = 0; !cached && k < nArrVolts; k++) { // volt loop
+    const cable_columns family(arrCables[k]);
+    size_t nCab = family.size();
+
+    // Terms that only depend on one cable
+    vector<double> nTurbCab(nCab), secPerTrip(nCab);
+    vector<size_t> group(nCab);
+    vector<double> groupTurbCab;
+    for (size_t i = 0; i < nCab; i++) {
+      nTurbCab[i]   = array_cable_turbines(ctx, family.currRating[i], family.voltage);
+      secPerTrip[i] = array_cable_sections_per_trip(ctx, family.mass[i]);
+      prune = prune && (family.mass[i] >= 0.0);
+
+      // Cables with the same number of turbines per string share the array layout
+      group[i] = find(groupTurbCab.begin(), groupTurbCab.end(), nTurbCab[i]) - groupTurbCab.begin();
+      if (group[i] == groupTurbCab.size()) groupTurbCab.push_back(nTurbCab[i]);
+    }
+
+    vector<bool> dominated(nCab, false);
+    for (size_t i = 0; prune && i < nCab; i++)
+      for (size_t a = 0; a < i; a++)
+	if ( !dominated[a] && (group[a] == group[i]) && (family.cost[a] <= family.cost[i]) &&
+	     (family.turbInterfaceCost[a] <= family.turbInterfaceCost[i]) && (family.mass[a] <= family.mass[i]) ) {
+	  dominated[i] = true;
+	  break;
+	}
+
+    // Layouts are computed once per pair of groups and laid out in one row per array cable 1 group, which
+    // is filled from the first cable of that group onward (later cables of the group only pair with later cables)
+    size_t nGroup = groupTurbCab.size();
+    vector<array_cable_layout> layouts(nGroup*nGroup);
+    vector<bool> haveLayout(nGroup*nGroup, false);
+    vector<array_cable_row> rows(nGroup);
+    vector<bool> haveRow(nGroup, false), rowNonNegative(nGroup, true);
+    vector<double> pairCost(nCab);
+
+    for (size_t i = 0; i < nCab; i++) { // cable1 loop
+      size_t gi = group[i];
+      if (!haveRow[gi]) {
+	rows[gi].resize(nCab);
+	for (size_t j = i + 1; j < nCab; j++) {
+	  size_t g = gi*nGroup + group[j];
+	  if (!haveLayout[g]) {
+	    layouts[g]    = calculate_array_cable_layout(ctx, nTurbCab[i], nTurbCab[j]);
+	    haveLayout[g] = true;
+	  }
+	  rows[gi].set(j, layouts[g]);
+	  rowNonNegative[gi] = rowNonNegative[gi] && (layouts[g].cab1Leng >= 0.0) && (layouts[g].nTurbInter1 >= 0.0);
+	}
+	haveRow[gi] = true;
+      }
+      if (dominated[i] && rowNonNegative[gi]) continue;
+
+      // All cable 2 candidates in one vector pass, then pick the first lowest cost in catalog order.  There is no
+      // lower bound to skip rows that cannot beat the best cost: the pass costs less than the bound's terms (the
+      // installation time of every layout without vessel trips, and their minima over the row) take to set up.
+      array_cable_cost_pairs(ctx, family.cost[i], family.turbInterfaceCost[i], secPerTrip[i], rows[gi], family, &secPerTrip[0],
+			     i + 1, nCab, &pairCost[0]);
+      WOBOS_PROFILE_CANDIDATES(profile, STAGE_ARRAY_CABLE_OPTIMIZER, nCab - i - 1);
+      for (size_t j = i + 1; j < nCab; j++) { // cable 2 loop
+	if (dominated[i] && (rows[gi].cab1Leng[j] >= 0.0) && (rows[gi].nTurbInter1[j] >= 0.0)) continue;
+	if (pairCost[j] < oldCost) {
+	    oldCost      = pairCost[j];
 	    cabIndex1    = i;
 	    cabIndex2    = j;
 	    arrVoltIndex = k;
@@ -2146,6 +2030,18 @@ void wobos::ArrayCabCostOptimizer() {
       }
     }
   }
+
+  if (cached) {
+    arrVoltIndex = best.voltIndex;
+    cabIndex1    = best.cabIndex1;
+    cabIndex2    = best.cabIndex2;
+  }
+  else {
+    best.voltIndex = arrVoltIndex;
+    best.cabIndex1 = cabIndex1;
+    best.cabIndex2 = cabIndex2;
+    cable_choice_cache::shared().insert(key, best);
+  }
   
   arrVoltage      = arrCables[arrVoltIndex].voltage;
   cab1CR          = arrCables[arrVoltIndex].cables[cabIndex1].cost;
@@ -2157,12 +2053,27 @@ void wobos::ArrayCabCostOptimizer() {
   cab1TurbInterCR = arrCables[arrVoltIndex].cables[cabIndex1].turbInterfaceCost;
   cab2TurbInterCR = arrCables[arrVoltIndex].cables[cabIndex2].turbInterfaceCost;
   cab2SubsInterCR = arrCables[arrVoltIndex].cables[cabIndex2].subsInterfaceCost;
+
+  // The choice is a step function of the plant values that the cable costs depend on
+  const T choice = array_cable_cost(get_cable_context(), cab1CurrRating, cab2CurrRating, arrVoltage, arrCab1Mass, arrCab2Mass,
+				    cab1CR, cab2CR, cab1TurbInterCR, cab2TurbInterCR, cab2SubsInterCR).totalCost;
+  mark_steps(arrVoltage, choice);
+  mark_steps(cab1CR, choice);
+  mark_steps(cab2CR, choice);
+  mark_steps(cab1CurrRating, choice);
+  mark_steps(cab2CurrRating, choice);
+  mark_steps(arrCab1Mass, choice);
+  mark_steps(arrCab2Mass, choice);
+  mark_steps(cab1TurbInterCR, choice);
+  mark_steps(cab2TurbInterCR, choice);
+  mark_steps(cab2SubsInterCR, choice);
 }
 
 
-void wobos::ExportCabCostOptimizer() {
+template <class T>
+void wobos_t<T>::ExportCabCostOptimizer() {
+  WOBOS_PROFILE_STAGE(profile, STAGE_EXPORT_CABLE_OPTIMIZER);
   size_t nExpVolts  = expCables.size();
-  size_t nExpCables = expCables[0].cables.size();
   
   //($/m) ,(kg/m)  ,(ancillary cost $/interface)
   /*double export132kvData[10][3] =  {
@@ -2203,55 +2114,290 @@ void wobos::ExportCabCostOptimizer() {
     1375}; //2500 mm2*/
   
   //calculate for each option of voltage 1 the necessary cable data
-  double newCost      = 0.0;
   double oldCost      = 1e30;
   size_t expCabIndex  = 0;
   size_t expVoltIndex = 0;
-  
-  for (size_t k=0; k<nExpVolts; k++) {
-    for (size_t i=0; i<nExpCables; i++) {
-      newCost = calculate_export_cable_cost(expCables[k].cables[i].currRating, expCables[k].voltage, expCables[k].cables[i].mass,
-					    expCables[k].cables[i].subsInterfaceCost, expCables[k].cables[i].cost);
-
-      if (newCost < oldCost) {
-	oldCost      = newCost;
+  const cable_context ctx = primal(get_cable_context());
+
+  // Same context and catalog, same choice
+  vector<double> key;
+  cable_choice best;
+  cable_choice_cache::make_key(CABLE_CACHE_EXPORT, ctx, expCables, key);
+  bool cached = cable_choice_cache::shared().find(key, best);
+  
+  for (size_t k=0; !cached && k<nExpVolts; k++) {
+    // Whole catalog in one vector pass, then pick the first lowest cost in catalog order
+    const cable_columns family(expCables[k]);
+    vector<double> newCost(family.size());
+    if (family.size() > 0) export_cable_cost_family(ctx, family, &newCost[0]);
+    WOBOS_PROFILE_CANDIDATES(profile, STAGE_EXPORT_CABLE_OPTIMIZER, family.size());
+
+    for (size_t i=0; i<family.size(); i++) {
+      if (newCost[i] < oldCost) {
+	oldCost      = newCost[i];
 	expCabIndex  = i;
 	expVoltIndex = k;
       }
     }
   }
 
+  if (cached) {
+    expVoltIndex = best.voltIndex;
+    expCabIndex  = best.cabIndex1;
+  }
+  else {
+    best.voltIndex = expVoltIndex;
+    best.cabIndex1 = expCabIndex;
+    best.cabIndex2 = 0;
+    cable_choice_cache::shared().insert(key, best);
+  }
+
   expVoltage     = expCables[expVoltIndex].voltage;
   expCurrRating  = expCables[expVoltIndex].cables[expCabIndex].currRating;
   expCabMass     = expCables[expVoltIndex].cables[expCabIndex].mass;
   expSubsInterCR = expCables[expVoltIndex].cables[expCabIndex].subsInterfaceCost;
   expCabCR       = expCables[expVoltIndex].cables[expCabIndex].cost;
+
+  // The choice is a step function of the plant values that the cable costs depend on
+  const T choice = export_cable_cost(get_cable_context(), expCurrRating, expVoltage, expCabMass, expSubsInterCR, expCabCR).totalCost;
+  mark_steps(expVoltage, choice);
+  mark_steps(expCurrRating, choice);
+  mark_steps(expCabMass, choice);
+  mark_steps(expSubsInterCR, choice);
+  mark_steps(expCabCR, choice);
 }
 
 
-void wobos::run() {
-  // Set turbine sizing
-  set_turbine_parameters();
+template <class T>
+template <class P>
+int wobos_t<T>::path_substructure() const {return (P::substructure == ANY_PATH) ? substructure : P::substructure;}
+template <class T>
+template <class P>
+int wobos_t<T>::path_strategy() const {return (P::installStrategy == ANY_PATH) ? installStrategy : P::installStrategy;}
+template <class T>
+template <class P>
+int wobos_t<T>::path_anchor() const {return (P::anchor == ANY_PATH) ? anchor : P::anchor;}
+template <class T>
+template <class P>
+int wobos_t<T>::path_turb_install() const {return (P::turbInstallMethod == ANY_PATH) ? turbInstallMethod : P::turbInstallMethod;}
+template <class T>
+template <class P>
+int wobos_t<T>::path_tower_install() const {return (P::towerInstallMethod == ANY_PATH) ? towerInstallMethod : P::towerInstallMethod;}
+template <class T>
+template <class P>
+bool wobos_t<T>::path_fixed() const {return (path_substructure<P>() == MONOPILE) || (path_substructure<P>() == JACKET);}
+template <class T>
+template <class P>
+bool wobos_t<T>::path_floating() const {return (path_substructure<P>() == SPAR) || (path_substructure<P>() == SEMISUBMERSIBLE);}
+
+
+template <class T>
+template <class P>
+const typename wobos_t<T>::stage_function* wobos_t<T>::path_stages() {
+  static const stage_function stages[NRUNSTAGES] = {
+    // Set turbine sizing
+    &wobos_t<T>::set_turbine_parameters,
+    // SUBSTRUCTURE
+    &wobos_t<T>::template calculate_substructure_mass_cost<P>,
+    // ELECTRICAL INFRASTRUCTURE
+    &wobos_t<T>::template calculate_electrical_infrastructure_cost<P>,
+    // ASSEMBLY & INSTALLATION
+    &wobos_t<T>::template calculate_assembly_and_installation<P>,
+    // PORTS & STAGING
+    &wobos_t<T>::template calculate_port_and_staging_costs<P>,
+    // ENGINEERING & MANAGEMENT
+    &wobos_t<T>::calculate_engineering_management_cost,
+    // DEVELOPMENT
+    &wobos_t<T>::calculate_development_cost,
+    // FINAL
+    &wobos_t<T>::template calculate_bos_cost<P>};
+  return stages;
+}
 
-  // SUBSTRUCTURE
-  calculate_substructure_mass_cost();
 
-  // ELECTRICAL INFRASTRUCTURE
-  calculate_electrical_infrastructure_cost();
+// Paths for every substructure and installation strategy, with the remaining branches (anchor, turbine
+// and tower installation methods) left to run time: they only pick between a few terms, while each fixed
+// value doubles the number of compiled paths.  Values outside the enums take the generic path.
+template <class T>
+const typename wobos_t<T>::stage_function* wobos_t<T>::run_stages() const {
+  bool primary = (installStrategy == PRIMARYVESSEL);
+  if (!primary && (installStrategy != FEEDERBARGE)) return path_stages< wobos_path<> >();
 
-  // ASSEMBLY & INSTALLATION
-  calculate_assembly_and_installation();  
+  switch (substructure) {
+  case MONOPILE:
+    return primary ? path_stages< wobos_path<MONOPILE, PRIMARYVESSEL> >() : path_stages< wobos_path<MONOPILE, FEEDERBARGE> >();
+  case JACKET:
+    return primary ? path_stages< wobos_path<JACKET, PRIMARYVESSEL> >() : path_stages< wobos_path<JACKET, FEEDERBARGE> >();
+  case SPAR:
+    return primary ? path_stages< wobos_path<SPAR, PRIMARYVESSEL> >() : path_stages< wobos_path<SPAR, FEEDERBARGE> >();
+  case SEMISUBMERSIBLE:
+    return primary ? path_stages< wobos_path<SEMISUBMERSIBLE, PRIMARYVESSEL> >() : path_stages< wobos_path<SEMISUBMERSIBLE, FEEDERBARGE> >();
+  default:
+    return path_stages< wobos_path<> >();
+  }
+}
 
-  // PORTS & STAGING
-  calculate_port_and_staging_costs();
 
-  // ENGINEERING & MANAGEMENT
-  calculate_engineering_management_cost();
+template <class T>
+void wobos_t<T>::run() {
+  const stage_function* stages = run_stages();
+  for (int s=0; s<NRUNSTAGES; s++) (this->*stages[s])();
+}
 
-  // DEVELOPMENT
-  calculate_development_cost();
 
-  // FINAL
-  calculate_bos_cost();
+// Whether a list of cable families has the given voltages
+static bool same_voltages(const vector<cableFamily> &cables, const vector<double> &voltages) {
+  if (cables.size() != voltages.size()) return false;
+  for (size_t k=0; k<cables.size(); k++)
+    if (cables[k].voltage != voltages[k]) return false;
+  return true;
 }
 
+
+static inline bool same_bits(double a, double b) {return memcmp(&a, &b, sizeof(double)) == 0;}
+
+
+// Members of the variables of each stage of run(), by type, for run_incremental(): variable k of a stage
+// is dvals[k], ivals[k - dvals.size()] or bvals[k - dvals.size() - ivals.size()]
+template <class T>
+struct wobos_stage_members {
+  vector<T wobos_t<T>::*> dvals;
+  vector<int wobos_t<T>::*> ivals;
+  vector<bool wobos_t<T>::*> bvals;
+
+  size_t size() const {return dvals.size() + ivals.size() + bvals.size();}
+
+  void get(const wobos_t<T> &obos, double *out) const {
+    for (size_t k=0; k<dvals.size(); k++) *out++ = primal(obos.*dvals[k]);
+    for (size_t k=0; k<ivals.size(); k++) *out++ = (double)(obos.*ivals[k]);
+    for (size_t k=0; k<bvals.size(); k++) *out++ = (obos.*bvals[k]) ? 1.0 : 0.0;
+  }
+
+  // First variable whose bits differ from values, or size() if none does
+  size_t compare(const wobos_t<T> &obos, const double *values) const {
+    const size_t nd = dvals.size(), ni = nd + ivals.size(), n = size();
+    size_t k = 0;
+    for (; k<nd; k++) if (!same_bits(primal(obos.*dvals[k]), values[k])) return k;
+    for (; k<ni; k++) if (!same_bits((double)(obos.*ivals[k - nd]), values[k])) return k;
+    for (; k<n; k++)  if (!same_bits((obos.*bvals[k - ni]) ? 1.0 : 0.0, values[k])) return k;
+    return n;
+  }
+  void set(wobos_t<T> &obos, size_t k, double val) const {
+    if (k < dvals.size())                        obos.*dvals[k] = val;
+    else if ((k -= dvals.size()) < ivals.size()) obos.*ivals[k] = (int)val;
+    else                                         obos.*bvals[k - ivals.size()] = (val == 0.0) ? false : true;
+  }
+
+  static const wobos_stage_members* stages() {
+    static const vector<wobos_stage_members> out = [] {
+      vector<wobos_stage_members> stages(NRUNSTAGES);
+      for (int s=0; s<NRUNSTAGES; s++)
+	for (int k=wobos_stage_offsets[s]; k<wobos_stage_offsets[s+1]; k++) {
+	  const wobos_binding<T> &b = wobos_binding<T>::table[wobos_stage_variables[k]];
+	  if (b.dval)      stages[s].dvals.push_back(b.dval);
+	  else if (b.ival) stages[s].ivals.push_back(b.ival);
+	  else             stages[s].bvals.push_back(b.bval);
+	}
+      return stages;
+    }();
+    return out.data();
+  }
+};
+
+
+template <class T>
+void wobos_t<T>::run_incremental() {
+  // Results are compared by value only, so only the plain model can reuse them
+  if (!is_same<T, double>::value) {
+    run();
+    return;
+  }
+
+  const stage_function* stages = run_stages();
+
+  // Cables and vessels come from the templates, and vessels from the substructure they were set up for
+  if ( (templates != memoTemplates) || (weather != memoWeather) || (arrayLayout != memoArrayLayout) ||
+       (vesselSubstructure != memoVesselSubstructure) || !same_voltages(arrCables, memoArrVoltages) || !same_voltages(expCables, memoExpVoltages) ) {
+    invalidate();
+    memoTemplates          = templates;
+    memoWeather            = weather;
+    memoArrayLayout        = arrayLayout;
+    memoVesselSubstructure = vesselSubstructure;
+    memoArrVoltages.clear();
+    memoExpVoltages.clear();
+    for (size_t k=0; k<arrCables.size(); k++) memoArrVoltages.push_back(arrCables[k].voltage);
+    for (size_t k=0; k<expCables.size(); k++) memoExpVoltages.push_back(expCables[k].voltage);
+  }
+  stageMemo.resize(NRUNSTAGES);
+  const wobos_stage_members<T> *members = wobos_stage_members<T>::stages();
+
+  bool keep = false;
+  for (int s=0; s<NRUNSTAGES; s++) {
+    const wobos_stage_members<T> &m = members[s];
+    const size_t n = m.size();
+    stage_memo &memo = stageMemo[s];
+
+    if (!keep) {
+      // Same bits going in give the same result coming out, so only the variables the stage changed are restored
+      const bool same = memo.inputs && (m.compare(*this, memo.before.data()) == n);
+      if (same && memo.valid) {
+	for (size_t k=0; k<memo.changed.size(); k++) m.set(*this, memo.changed[k], memo.after[memo.changed[k]]);
+	continue;
+      }
+
+      if (!same) {
+	// Variables that changed since the previous call may well change again (e.g. in a sweep), so this stage
+	// and the later ones run as in run() without keeping anything.  Variables that were not kept yet are kept
+	// now, so that the next call can tell whether they repeat.
+	if (memo.inputs) memo.inputs = false;
+	else {
+	  memo.before.resize(n);
+	  m.get(*this, memo.before.data());
+	  memo.inputs = true;
+	}
+	memo.valid = false;
+	for (int r=s+1; r<NRUNSTAGES; r++) stageMemo[r].inputs = stageMemo[r].valid = false;
+	for (int r=s; r<NRUNSTAGES; r++) (this->*stages[r])();
+	return;
+      }
+
+      // The same variables twice in a row: this stage and the later ones keep their results
+      keep = true;
+    }
+    else {
+      memo.before.resize(n);
+      m.get(*this, memo.before.data());
+      memo.inputs = true;
+    }
+
+    (this->*stages[s])();
+
+    memo.after.resize(n);
+    m.get(*this, memo.after.data());
+    memo.changed.clear();
+    for (size_t k=0; k<n; k++)
+      if (!same_bits(memo.after[k], memo.before[k])) memo.changed.push_back((int)k);
+    memo.valid = true;
+  }
+}
+
+
+template <class T>
+void wobos_t<T>::invalidate() {
+  for (size_t s=0; s<stageMemo.size(); s++) stageMemo[s].inputs = stageMemo[s].valid = false;
+}
+
+
+// Plain model and the model with derivatives (see lib_wind_obos_dual.h)
+template class wobos_t<double>;
+template class wobos_t<wobos_dual>;
+
+// Stages on the generic path, for stage-by-stage callers outside this file (e.g. bench_wind_obos.cpp)
+#define WOBOS_GENERIC_STAGES(T)								\
+  template void wobos_t<T>::calculate_substructure_mass_cost< wobos_path<> >();		\
+  template void wobos_t<T>::calculate_electrical_infrastructure_cost< wobos_path<> >();	\
+  template void wobos_t<T>::calculate_assembly_and_installation< wobos_path<> >();	\
+  template void wobos_t<T>::calculate_port_and_staging_costs< wobos_path<> >();		\
+  template void wobos_t<T>::calculate_bos_cost< wobos_path<> >();
+WOBOS_GENERIC_STAGES(double)
+WOBOS_GENERIC_STAGES(wobos_dual)
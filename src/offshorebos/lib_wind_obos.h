@@ -52,11 +52,19 @@
 
 #include "lib_wind_obos_defaults.h"
 #include "lib_wind_obos_cable_vessel.h"
+#include "lib_wind_obos_variables.h"
+#include "lib_wind_obos_cable_cost.h"
+#include "lib_wind_obos_substructure.h"
+#include "lib_wind_obos_install_sim.h"
+#include "lib_wind_obos_weather.h"
+#include "lib_wind_obos_dual.h"
+#include "lib_wind_obos_profile.h"
 #include <vector>
 #include <tuple>
 #include <map>
 #include <string>
 #include <set>
+#include <memory>
 using namespace std;
 
 //substructure type
@@ -70,233 +78,276 @@ enum  { ONEPIECE, TWOPIECE } ;
 //installation vessel strategy
 enum  { PRIMARYVESSEL, FEEDERBARGE } ;
 
+// Run path: the values of the substructure, installation strategy, anchor and turbine and tower installation
+// methods that the stages of run() are compiled for.  A value of ANY_PATH is read from the object at run
+// time instead.  The branches on a fixed value fold away when the stages are compiled for the path, so run()
+// picks the path of the substructure and installation strategy once (see wobos_t::run_stages) and its
+// stages never test them again.
+enum { ANY_PATH = -1 };
+template <int SUBSTRUCTURE=ANY_PATH, int STRATEGY=ANY_PATH, int ANCHOR=ANY_PATH, int TURBINSTALL=ANY_PATH, int TOWERINSTALL=ANY_PATH>
+struct wobos_path {
+  static const int substructure       = SUBSTRUCTURE;
+  static const int installStrategy    = STRATEGY;
+  static const int anchor             = ANCHOR;
+  static const int turbInstallMethod  = TURBINSTALL;
+  static const int towerInstallMethod = TOWERINSTALL;
+};
+
 
-class wobos {//WIND OFFSHORE BOS STRUCTURE TO HOLD ALL INPUTS AND OUTPUTS AND ALLOW MEMBER FUNCTIONS TO OPERATE ON THOSE VALUES
+// Cable and vessel templates.  The built-in set is created once per process and shared read-only by every
+// wobos instance, so constructing a wobos does not rebuild the cable families or vessels.
+class wobos_templates {
  public:
-  // DEFAULTS FROM CSV FILE
-  wind_obos_defaults wobos_default;
+  map<int, cableFamily> arrayTemplates;
+  map<string, vessel> vesselTemplates;
+
+  // Read-only lookups: an unknown voltage gives an empty cable family and an unknown name a blank vessel
+  const cableFamily& get_cable(int voltage) const;
+  const vessel& get_vessel(const string &name) const;
+
+  // Distinct (max_wind_speed, max_wave_height) of the vessels that have a limit, e.g. to index a weather store
+  vector<pair<double, double> > weather_limits() const;
+
+  // Built-in templates, initialized on first use
+  static shared_ptr<const wobos_templates> builtin();
+
+ private:
+  void set_templates();
+};
+
+
+// Thread safety: different wobos objects may be used from different threads at the same time.  They share
+// only the defaults and templates (read-only once built), the cable optimizer cache (locked) and the cable
+// kernel instruction set (atomic).  One object must not be used from two threads at once.
+template <class T> class wobos_t {//WIND OFFSHORE BOS STRUCTURE TO HOLD ALL INPUTS AND OUTPUTS AND ALLOW MEMBER FUNCTIONS TO OPERATE ON THOSE VALUES
+ public:
+  // DEFAULTS (wind_obos_defaults::instance(), compiled in from lib_wind_obos_defaults_table.h, shared by all instances)
+  const wind_obos_defaults *wobos_default;
   
   //MAIN INPUTS************************************************************************************************************
-  double turbCapEx; //turbine capital cost ($/kW)
-  double nTurb;//number of turbines
-  double rotorD;//rotor diameter (m)
-  double turbR;//turbine rating (MW)
-  double hubH;//hub height (m)
-  double waterD;// water depth (m)
-  double distShore;//distance to shore from install site (km)
-  double distPort;//distance to install site from install port (km)
-  double distPtoA;//distance from install port to inshore assembly area (km) (spar only)
-  double distAtoS;//distance from inshore assembly area to install site (km) (spar Only)
+  T turbCapEx; //turbine capital cost ($/kW)
+  T nTurb;//number of turbines
+  T rotorD;//rotor diameter (m)
+  T turbR;//turbine rating (MW)
+  T hubH;//hub height (m)
+  T waterD;// water depth (m)
+  T distShore;//distance to shore from install site (km)
+  T distPort;//distance to install site from install port (km)
+  T distPtoA;//distance from install port to inshore assembly area (km) (spar only)
+  T distAtoS;//distance from inshore assembly area to install site (km) (spar Only)
   int substructure; //type of substructure
   int anchor; //anchor type
   int turbInstallMethod; //turbine installation method
   int towerInstallMethod; //tower installation method
   int installStrategy; //installation vessel strategy
-  bool cableOptimizer; //switch to run the cable optimizer or not
-  double moorLines;//number of mooring lines for floating substructures
-  double buryDepth;//array and export cable burial depth (m)
-  double arrayY;//turbine array spacing between turbines on same row (rotor diameters)
-  double arrayX;// turbine array spacing between turbine rows (rotor diameters)
-  double substructCont;//substructure install weather contingency
-  double turbCont;//turbine install weather contingency
-  double elecCont;//turbine install weather contingency
-  double interConVolt;//grid interconnect voltage (kV)
-  double distInterCon;//distance from onshore substation to grid interconnect (miles)
-  double scrapVal;//scrap value of decommissioned components ($)
-  double number_install_seasons; //number of vessel mobilization/install seasons
+  bool cableOptimizer; //switch to run the cable optimizer or not (choices are cached, see lib_wind_obos_cable_cache.h)
+  bool installSimulation; //switch to time fixed substructure and turbine installation by simulation (see lib_wind_obos_install_sim.h)
+  T moorLines;//number of mooring lines for floating substructures
+  T buryDepth;//array and export cable burial depth (m)
+  T arrayY;//turbine array spacing between turbines on same row (rotor diameters)
+  T arrayX;// turbine array spacing between turbine rows (rotor diameters)
+  T substructCont;//substructure install weather contingency
+  T turbCont;//turbine install weather contingency
+  T elecCont;//turbine install weather contingency
+  T interConVolt;//grid interconnect voltage (kV)
+  T distInterCon;//distance from onshore substation to grid interconnect (miles)
+  T scrapVal;//scrap value of decommissioned components ($)
+  T number_install_seasons; //number of vessel mobilization/install seasons
+  T installSeasonLength; //days of one install season; if > 0, more seasons when the installation takes longer
+  T installStartHour; //hour of the site weather at which installation starts, for installSimulation
 
   //DETAILED INPUTS************************************************************************************************************
   //General
-  double projLife;//economic lifetime of the project (years)
-  double inspectClear;//inspection clearance for substructure and turbine components (m)
-  double plantComm; //plant commissioning cost factor
-  double procurement_contingency; //contingency factor for procurement costs
-  double install_contingency; //contingency factor for installation costs
-  double construction_insurance; //insurance during construction factor
-  double capital_cost_year_0; //capital cost spent in year 0
-  double capital_cost_year_1; //capital cost spent in year 1
-  double capital_cost_year_2; //capital cost spent in year 2
-  double capital_cost_year_3; //capital cost spent in year 3
-  double capital_cost_year_4; //capital cost spent in year 4
-  double capital_cost_year_5; //capital cost spent in year 5
-  double tax_rate; //effective tax_rate (federal & state)
-  double interest_during_construction; //interest rate during construction
+  T projLife;//economic lifetime of the project (years)
+  T inspectClear;//inspection clearance for substructure and turbine components (m)
+  T plantComm; //plant commissioning cost factor
+  T procurement_contingency; //contingency factor for procurement costs
+  T install_contingency; //contingency factor for installation costs
+  T construction_insurance; //insurance during construction factor
+  T capital_cost_year_0; //capital cost spent in year 0
+  T capital_cost_year_1; //capital cost spent in year 1
+  T capital_cost_year_2; //capital cost spent in year 2
+  T capital_cost_year_3; //capital cost spent in year 3
+  T capital_cost_year_4; //capital cost spent in year 4
+  T capital_cost_year_5; //capital cost spent in year 5
+  T tax_rate; //effective tax_rate (federal & state)
+  T interest_during_construction; //interest rate during construction
 
   //Substructure & Foundation
-  double mpileCR;//monopile pile cost rate ($/tonne)
-  double mtransCR;//monopile transition piece cost rate ($/tonne)
-  double mpileD;//monopile pile diameter (m)
-  double mpileL;//monopile length (m)
-  double jlatticeCR;//jacket lattice cost rate ($/tonne)
-  double jtransCR;//jacket transition piece cost rate ($/tonne)
-  double jpileCR;//jacket pile cost rate ($/tonne)
-  double jlatticeA;//jacket lattice footprint area
-  double jpileL;//jacket pile length
-  double jpileD;//jacket pile diameter
-  double spStifColCR;//spar stiffened column cost rate ($/tonne)
-  double spTapColCR;//spar tapered column cost rate ($/tonne)
-  double ballCR;//ballast cost rate ($/tonne)
-  double deaFixLeng;//drag embedment anchor fixed mooring line length
-  double ssStifColCR;//semisubmersible stiffened column cost rate ($/tonne)
-  double ssTrussCR;// semisubmersible truss cost rate ($/tonne)
-  double ssHeaveCR;//semisubmersible heave plate cost rate ($/tonne)
-  double sSteelCR;//secondary steel cost rate ($/tonne)
-  double moorDia;//mooring line diameter
-  double moorCR;//mooring line cost rate ($/m)
-  double mpEmbedL;//monopile embedment length (m)
-  double scourMat;
+  T mpileCR;//monopile pile cost rate ($/tonne)
+  T mtransCR;//monopile transition piece cost rate ($/tonne)
+  T mpileD;//monopile pile diameter (m)
+  T mpileL;//monopile length (m)
+  T jlatticeCR;//jacket lattice cost rate ($/tonne)
+  T jtransCR;//jacket transition piece cost rate ($/tonne)
+  T jpileCR;//jacket pile cost rate ($/tonne)
+  T jlatticeA;//jacket lattice footprint area
+  T jpileL;//jacket pile length
+  T jpileD;//jacket pile diameter
+  T spStifColCR;//spar stiffened column cost rate ($/tonne)
+  T spTapColCR;//spar tapered column cost rate ($/tonne)
+  T ballCR;//ballast cost rate ($/tonne)
+  T deaFixLeng;//drag embedment anchor fixed mooring line length
+  T ssStifColCR;//semisubmersible stiffened column cost rate ($/tonne)
+  T ssTrussCR;// semisubmersible truss cost rate ($/tonne)
+  T ssHeaveCR;//semisubmersible heave plate cost rate ($/tonne)
+  T sSteelCR;//secondary steel cost rate ($/tonne)
+  T moorDia;//mooring line diameter
+  T moorCR;//mooring line cost rate ($/m)
+  T mpEmbedL;//monopile embedment length (m)
+  T scourMat;
 	
   //Electrical Infrastructure
-  double pwrFac;//power factor to estimate losses
-  double buryFac;//cable burial factor
-  double arrVoltage;//array cable voltage (kV)
-  double arrCab1Size;//diameter in square millimeters of array cable 1
-  double arrCab1Mass;//mass of array cable 1 (kg/m)
-  double cab1CurrRating;//current rating of array cable 1 (amps)
-  double cab1CR;//cost rate of array cable 1 ($/m)
-  double cab1TurbInterCR;//array cable size 1 turbine interface cost rate ($/interface)
-  double arrCab2Size;//diameter in square millimeters of array cable 2
-  double arrCab2Mass;//mass of array cable 2 (kg/m)
-  double cab2CurrRating;//current rating of array cable 2 (amps)
-  double cab2CR;//cost rate of array cable 2 ($/m)
-  double cab2TurbInterCR;//array cable size 2 turbine interface cost rate ($/interface)
-  double cab2SubsInterCR;//array cable size 2 substation interface cost rate ($/interface)
-  double catLengFac;//free hanging or catenary cable length factor
-  double exCabFac;// excess cable factor
-  double subsTopFab;//substation topside fabrication cost ($/tonne)
-  double subsTopDes;//substation topside design cost ($)
-  double topAssemblyFac;//land based substation topside assembly factor
-  double subsJackCR;//substation jacket substructure cost rate ($/tonne)
-  double subsPileCR;//substation jacket pile cost rate ($/tonne)
-  double dynCabFac;//dynamic/free hanging cable cost premium
-  double shuntCR;//shunt reactor cost rate ($/MVA)
-  double highVoltSG;//high voltage switchgear cost ($)
-  double medVoltSG;//medium voltage switchgear cost ($)
-  double backUpGen;//back up generator cost ($)
-  double workSpace;//substation workshop and accommodations cost ($)
-  double otherAncillary;//substation other ancillary costs ($)
-  double mptCR;//main power transformer cost rate ($/MVA)
-  double expVoltage;//export cable voltage (kV)
-  double expCabSize;//diameter in square millimeters of the export cable
-  double expCabMass;//mass of the export cable (kg/m)
-  double expCabCR;//cost rate of the export cable ($/m)
-  double expCurrRating;//export cable rating (amps)
-  double expSubsInterCR;//cost rate of export cable substation interfaces ($/interface)
+  T pwrFac;//power factor to estimate losses
+  T buryFac;//cable burial factor
+  T arrVoltage;//array cable voltage (kV)
+  T arrCab1Size;//diameter in square millimeters of array cable 1
+  T arrCab1Mass;//mass of array cable 1 (kg/m)
+  T cab1CurrRating;//current rating of array cable 1 (amps)
+  T cab1CR;//cost rate of array cable 1 ($/m)
+  T cab1TurbInterCR;//array cable size 1 turbine interface cost rate ($/interface)
+  T arrCab2Size;//diameter in square millimeters of array cable 2
+  T arrCab2Mass;//mass of array cable 2 (kg/m)
+  T cab2CurrRating;//current rating of array cable 2 (amps)
+  T cab2CR;//cost rate of array cable 2 ($/m)
+  T cab2TurbInterCR;//array cable size 2 turbine interface cost rate ($/interface)
+  T cab2SubsInterCR;//array cable size 2 substation interface cost rate ($/interface)
+  T catLengFac;//free hanging or catenary cable length factor
+  T exCabFac;// excess cable factor
+  T subsTopFab;//substation topside fabrication cost ($/tonne)
+  T subsTopDes;//substation topside design cost ($)
+  T topAssemblyFac;//land based substation topside assembly factor
+  T subsJackCR;//substation jacket substructure cost rate ($/tonne)
+  T subsPileCR;//substation jacket pile cost rate ($/tonne)
+  T dynCabFac;//dynamic/free hanging cable cost premium
+  T shuntCR;//shunt reactor cost rate ($/MVA)
+  T highVoltSG;//high voltage switchgear cost ($)
+  T medVoltSG;//medium voltage switchgear cost ($)
+  T backUpGen;//back up generator cost ($)
+  T workSpace;//substation workshop and accommodations cost ($)
+  T otherAncillary;//substation other ancillary costs ($)
+  T mptCR;//main power transformer cost rate ($/MVA)
+  T expVoltage;//export cable voltage (kV)
+  T expCabSize;//diameter in square millimeters of the export cable
+  T expCabMass;//mass of the export cable (kg/m)
+  T expCabCR;//cost rate of the export cable ($/m)
+  T expCurrRating;//export cable rating (amps)
+  T expSubsInterCR;//cost rate of export cable substation interfaces ($/interface)
 	
   //Assembly & Installation
-  double moorTimeFac;//mooring installation timing factor (hrs/m)
-  double moorLoadout;//mooring system loadout timing (hrs)
-  double moorSurvey;//mooring system anchor position survey timing (hrs)
-  double prepAA;//prep inshore assembly area timing (hrs)
-  double prepSpar;//prep spare for tow out to assembly area timing (hrs)
-  double upendSpar;//upend and ballast the spar timing (hrs)
-  double prepSemi;//prep semisubmersible for turbine install timing (hrs)
-  double turbFasten;//fasten turbine for transport timing (hrs)
-  double boltTower;// bolt tower to substructure timing (hrs)
-  double boltNacelle1;//bolt nacelle to tower timing individual components method (hrs)
-  double boltNacelle2;//bolt nacelle to tower timing bunny ears method (hrs)
-  double boltNacelle3;//bolt nacelle to tower timing assembled rotor method (hrs)
-  double boltBlade1;//bolt blade to rotor timing individual components method (hrs)
-  double boltBlade2;//bolt blade to rotor timing bunny ears method (hrs)
-  double boltRotor;//bolt rotor to nacelle timing assembled rotor method (hrs)
-  double vesselPosTurb;//vessel positioning timing turbine install (hrs)
-  double vesselPosJack;//vessel positioning timing jacket install (hrs)
-  double vesselPosMono;//vessel positioning timing monopile install (hrs)
-  double subsVessPos;//vessel positioning timing offshore substation install (hrs)
-  double monoFasten;//fasten monopile for transport timing (hrs)
-  double jackFasten;//fasten jacket for transport timing (hrs)
-  double prepGripperMono;//prepare pile gripper and upender timing monopile install (hrs)
-  double prepGripperJack;//prepare pile gripper and upender timing iacket install (hrs)
-  double placePiles;//lift and place jacket piles timing (hrs)
-  double prepHamMono;//prepare pile hammer timing monopile install (hrs)
-  double removeHamMono;//remove hammer timing monopile install (hrs)
-  double prepHamJack;//prepare pile hammer timing iacket install (hrs)
-  double removeHamJack;//remove hammer timing iacket install (hrs)
-  double placeJack;//place  jacket timing (hrs)
-  double levJack;//level jacket timing (hrs)
-  double placeTemplate;//place jacket template timing (hrs)
-  double hamRate;//pile hammer rate (m/hr)
-  double placeMP;//place monopile pile timing (hrs)
-  double instScour;//install scour protection (hrs)
-  double placeTP;//place transition piece on monopile timing (hrs)
-  double groutTP;//grout transition piece (hrs)
-  double tpCover;//install transition piece cover timing (hrs)
-  double prepTow;//prep floating substructure for towing timing (hrs)
-  double spMoorCon;//connect spar to mooring system timing (hrs)
-  double ssMoorCon;//connect semisubmersible to mooring system (hrs)
-  double spMoorCheck;//check mooring connections to spar timing (hrs)
-  double ssMoorCheck;//check mooring connections to semisubmersible timing (hrs)
-  double ssBall;//ballast semisubmersible timing (hrs)
-  double surfLayRate;//electrical cable surface lay rate (m/hr)
-  double cabPullIn;//array cable pull in to interfaces timing (hrs)
-  double cabTerm;//cable termination and testing timing (hrs)
-  double cabLoadout;//array cable loadout timing (hrs)
-  double buryRate;//cable bury rate (m/hr)
-  double subsPullIn;//cable pull in to substation timing (hrs)
-  double shorePullIn;//cable pull in to shore timing (hrs)
-  double landConstruct;//land construction of required onshore electrical systems timing (days)
-  double expCabLoad;//export cable loadout timing (hrs)
-  double subsLoad;//substation loadout timing (hrs)
-  double placeTop;//lift and place substation topside timing (hrs)
-  double pileSpreadDR;//piling equipment spread day rate ($/day)
-  double pileSpreadMob;//piling equipment spread mobilization/demobilization cost ($)
-  double groutSpreadDR;//grouting equipment spread day rate ($/day)
-  double groutSpreadMob;//grouting equipment spread mobilization/demobilization cost ($)
-  double seaSpreadDR;//suction pile anchor vessel and equipment spread day rate ($/day)
-  double seaSpreadMob;//suction pile anchor vessel and equipment spread mobilization/demobilization cost ($)
-  double compRacks;//component racks cost ($)
-  double cabSurveyCR;//cost rate of surveying and verifying electrical cable installation ($/)
-  double cabDrillDist;//horizontal drilling distance for cable landfall (m)
-  double cabDrillCR;//horizontal drilling cost rate ($/m)
-  double mpvRentalDR;//MPV rental day rate ($/day)
-  double diveTeamDR;//cable landfall dive team day rate ($/day)
-  double winchDR;//Cable winch day rate
-  double civilWork;//civil construction work cost ($)
-  double elecWork;//electrical work cost ($)
+  T moorTimeFac;//mooring installation timing factor (hrs/m)
+  T moorLoadout;//mooring system loadout timing (hrs)
+  T moorSurvey;//mooring system anchor position survey timing (hrs)
+  T prepAA;//prep inshore assembly area timing (hrs)
+  T prepSpar;//prep spare for tow out to assembly area timing (hrs)
+  T upendSpar;//upend and ballast the spar timing (hrs)
+  T prepSemi;//prep semisubmersible for turbine install timing (hrs)
+  T turbFasten;//fasten turbine for transport timing (hrs)
+  T boltTower;// bolt tower to substructure timing (hrs)
+  T boltNacelle1;//bolt nacelle to tower timing individual components method (hrs)
+  T boltNacelle2;//bolt nacelle to tower timing bunny ears method (hrs)
+  T boltNacelle3;//bolt nacelle to tower timing assembled rotor method (hrs)
+  T boltBlade1;//bolt blade to rotor timing individual components method (hrs)
+  T boltBlade2;//bolt blade to rotor timing bunny ears method (hrs)
+  T boltRotor;//bolt rotor to nacelle timing assembled rotor method (hrs)
+  T vesselPosTurb;//vessel positioning timing turbine install (hrs)
+  T vesselPosJack;//vessel positioning timing jacket install (hrs)
+  T vesselPosMono;//vessel positioning timing monopile install (hrs)
+  T subsVessPos;//vessel positioning timing offshore substation install (hrs)
+  T monoFasten;//fasten monopile for transport timing (hrs)
+  T jackFasten;//fasten jacket for transport timing (hrs)
+  T prepGripperMono;//prepare pile gripper and upender timing monopile install (hrs)
+  T prepGripperJack;//prepare pile gripper and upender timing iacket install (hrs)
+  T placePiles;//lift and place jacket piles timing (hrs)
+  T prepHamMono;//prepare pile hammer timing monopile install (hrs)
+  T removeHamMono;//remove hammer timing monopile install (hrs)
+  T prepHamJack;//prepare pile hammer timing iacket install (hrs)
+  T removeHamJack;//remove hammer timing iacket install (hrs)
+  T placeJack;//place  jacket timing (hrs)
+  T levJack;//level jacket timing (hrs)
+  T placeTemplate;//place jacket template timing (hrs)
+  T hamRate;//pile hammer rate (m/hr)
+  T placeMP;//place monopile pile timing (hrs)
+  T instScour;//install scour protection (hrs)
+  T placeTP;//place transition piece on monopile timing (hrs)
+  T groutTP;//grout transition piece (hrs)
+  T tpCover;//install transition piece cover timing (hrs)
+  T prepTow;//prep floating substructure for towing timing (hrs)
+  T spMoorCon;//connect spar to mooring system timing (hrs)
+  T ssMoorCon;//connect semisubmersible to mooring system (hrs)
+  T spMoorCheck;//check mooring connections to spar timing (hrs)
+  T ssMoorCheck;//check mooring connections to semisubmersible timing (hrs)
+  T ssBall;//ballast semisubmersible timing (hrs)
+  T surfLayRate;//electrical cable surface lay rate (m/hr)
+  T cabPullIn;//array cable pull in to interfaces timing (hrs)
+  T cabTerm;//cable termination and testing timing (hrs)
+  T cabLoadout;//array cable loadout timing (hrs)
+  T buryRate;//cable bury rate (m/hr)
+  T subsPullIn;//cable pull in to substation timing (hrs)
+  T shorePullIn;//cable pull in to shore timing (hrs)
+  T landConstruct;//land construction of required onshore electrical systems timing (days)
+  T expCabLoad;//export cable loadout timing (hrs)
+  T subsLoad;//substation loadout timing (hrs)
+  T placeTop;//lift and place substation topside timing (hrs)
+  T pileSpreadDR;//piling equipment spread day rate ($/day)
+  T pileSpreadMob;//piling equipment spread mobilization/demobilization cost ($)
+  T groutSpreadDR;//grouting equipment spread day rate ($/day)
+  T groutSpreadMob;//grouting equipment spread mobilization/demobilization cost ($)
+  T seaSpreadDR;//suction pile anchor vessel and equipment spread day rate ($/day)
+  T seaSpreadMob;//suction pile anchor vessel and equipment spread mobilization/demobilization cost ($)
+  T compRacks;//component racks cost ($)
+  T cabSurveyCR;//cost rate of surveying and verifying electrical cable installation ($/)
+  T cabDrillDist;//horizontal drilling distance for cable landfall (m)
+  T cabDrillCR;//horizontal drilling cost rate ($/m)
+  T mpvRentalDR;//MPV rental day rate ($/day)
+  T diveTeamDR;//cable landfall dive team day rate ($/day)
+  T winchDR;//Cable winch day rate
+  T civilWork;//civil construction work cost ($)
+  T elecWork;//electrical work cost ($)
 	
   //Port & Staging
-  double nCrane600;
-  double nCrane1000;
-  double crane600DR;//600 tonne capacity crawler crane day rate ($/day)
-  double crane1000DR;//1000 tonne capacity crawler crane day rate ($/day)
-  double craneMobDemob;//crane mobilization and demobilization cost ($)
-  double entranceExitRate;//port entrance and exit cost ($/m^2/occurrence)
-  double dockRate;//port docking cost ($/day)
-  double wharfRate;//port wharf loading and unloading cost ($/tonne)
-  double laydownCR;//port laydown and storage cost ($/m/day)
+  T nCrane600;
+  T nCrane1000;
+  T crane600DR;//600 tonne capacity crawler crane day rate ($/day)
+  T crane1000DR;//1000 tonne capacity crawler crane day rate ($/day)
+  T craneMobDemob;//crane mobilization and demobilization cost ($)
+  T entranceExitRate;//port entrance and exit cost ($/m^2/occurrence)
+  T dockRate;//port docking cost ($/day)
+  T wharfRate;//port wharf loading and unloading cost ($/tonne)
+  T laydownCR;//port laydown and storage cost ($/m/day)
 	
   //Engineering & Management
-  double estEnMFac;//estimated engineering and management cost factor
+  T estEnMFac;//estimated engineering and management cost factor
 	
   //Development
-  double preFEEDStudy;//pre-fornt end engineering design (FEED) study cost ($)
-  double feedStudy;// FEED study cost ($)
-  double stateLease;//state leasing cost ($)
-  double outConShelfLease;//outer continental shelf lease cost ($)
-  double saPlan;//site assessment plan cost ($)
-  double conOpPlan;//construction operations plan cost ($)
-  double nepaEisMet;//national environmental protection agency (NEPA) environmental impact (EIS) meteorological (met) tower study cost ($)
-  double physResStudyMet;//physical resource met tower study cost ($)
-  double bioResStudyMet;//biological resource met tower study ($)
-  double socEconStudyMet;//socioeconomic met tower study cost ($)
-  double navStudyMet;//navigation met tower study ($)
-  double nepaEisProj;// NEPA EIS project site study cost ($)
-  double physResStudyProj;//physical resource project site study cost ($)
-  double bioResStudyProj;//biological resource project site study cost ($)
-  double socEconStudyProj;//socioeconomic project site study cost ($)
-  double navStudyProj;//navigation project site study cost ($)
-  double coastZoneManAct;//coastal zone management act compliance cost ($)
-  double rivsnHarbsAct;//rivers & harbors act section 10 compliance cost ($)
-  double cleanWatAct402;//clean water act section 402 compliance cost ($)
-  double cleanWatAct404;//clean water act section 404 compliance cost ($)
-  double faaPlan;//federal aviation administration (FAA) plans and mitigation cost ($)
-  double endSpecAct;//endangered species act compliance cost ($)
-  double marMamProtAct;//marine mammal protection act compliance cost ($)
-  double migBirdAct;//migratory bird act compliance ($)
-  double natHisPresAct;//national historic preservation act compliance cost ($)
-  double addLocPerm;//additional local and state permissions and compliance cost ($)
-  double metTowCR;//meteorological tower fabrication, design, and install cost rate ($/MW)
-  double decomDiscRate;//decommissioning expense discount rate
+  T preFEEDStudy;//pre-fornt end engineering design (FEED) study cost ($)
+  T feedStudy;// FEED study cost ($)
+  T stateLease;//state leasing cost ($)
+  T outConShelfLease;//outer continental shelf lease cost ($)
+  T saPlan;//site assessment plan cost ($)
+  T conOpPlan;//construction operations plan cost ($)
+  T nepaEisMet;//national environmental protection agency (NEPA) environmental impact (EIS) meteorological (met) tower study cost ($)
+  T physResStudyMet;//physical resource met tower study cost ($)
+  T bioResStudyMet;//biological resource met tower study ($)
+  T socEconStudyMet;//socioeconomic met tower study cost ($)
+  T navStudyMet;//navigation met tower study ($)
+  T nepaEisProj;// NEPA EIS project site study cost ($)
+  T physResStudyProj;//physical resource project site study cost ($)
+  T bioResStudyProj;//biological resource project site study cost ($)
+  T socEconStudyProj;//socioeconomic project site study cost ($)
+  T navStudyProj;//navigation project site study cost ($)
+  T coastZoneManAct;//coastal zone management act compliance cost ($)
+  T rivsnHarbsAct;//rivers & harbors act section 10 compliance cost ($)
+  T cleanWatAct402;//clean water act section 402 compliance cost ($)
+  T cleanWatAct404;//clean water act section 404 compliance cost ($)
+  T faaPlan;//federal aviation administration (FAA) plans and mitigation cost ($)
+  T endSpecAct;//endangered species act compliance cost ($)
+  T marMamProtAct;//marine mammal protection act compliance cost ($)
+  T migBirdAct;//migratory bird act compliance ($)
+  T natHisPresAct;//national historic preservation act compliance cost ($)
+  T addLocPerm;//additional local and state permissions and compliance cost ($)
+  T metTowCR;//meteorological tower fabrication, design, and install cost rate ($/MW)
+  T decomDiscRate;//decommissioning expense discount rate
 
   //VECTORS TO HOLD VARIABLES************************************************************************************************************
   //cable vectors
@@ -319,454 +370,243 @@ class wobos {//WIND OFFSHORE BOS STRUCTURE TO HOLD ALL INPUTS AND OUTPUTS AND AL
   vector<vessel> elecTugs;
   vector<vessel> elecSupportVessels;
   //CABLE & VESSEL TEMPLATES*******************************************************************************************
-  map<int, cableFamily> arrayTemplates;
-  map<string, vessel> vesselTemplates;
+  // Shared with other instances until a template is overridden, at which point this instance gets its own copy
+  shared_ptr<const wobos_templates> templates;
+  void set_cable_template(int voltage, const cableFamily &family);
+  void set_vessel_template(const string &name, const vessel &vesselIn);
+  //SITE WEATHER*******************************************************************************************************
+  // Hourly weather at the site, shared read-only with other instances; none by default.  With installSimulation,
+  // fixed substructures and turbines are installed in the workable windows of their vessels' wind and wave
+  // limits instead of with substructCont and turbCont (see lib_wind_obos_weather.h).
+  shared_ptr<const wobos_weather> weather;
+  //ARRAY LAYOUT*******************************************************************************************************
+  // Turbine and substation positions, shared read-only with other instances; none by default, for turbines on an
+  // arrayX by arrayY rotor diameter grid.  Array cable lengths and their installation then follow the strings
+  // of the layout (see lib_wind_obos_array_layout.h), and there are at least as many substations as in the
+  // layout.  nTurb should match it.
+  shared_ptr<const wobos_array_layout> arrayLayout;
   //OUTPUTS************************************************************************************************************
   // Turbine outputs
-  double hubD;
-  double bladeL;
-  double max_chord;
-  double nacelleW;
-  double nacelleL;
-  double rnaM;
-  double towerD;
-  double towerM;
+  T hubD;
+  T bladeL;
+  T max_chord;
+  T nacelleW;
+  T nacelleL;
+  T rnaM;
+  T towerD;
+  T towerM;
 
   //Substructure & Foundation outputs
-  double subTotM;
-  double subTotCost;
-  double moorCost;
+  T subTotM;
+  T subTotCost;
+  T moorCost;
   
   //Electrical Infrastructure outputs
-  double systAngle;
-  double freeCabLeng;
-  double fixCabLeng;
-  double nExpCab;
-  double expCabLeng;
-  double expCabCost;
-  double nSubstation;
-  double cab1Leng;
-  double cab2Leng;
-  double arrCab1Cost;
-  double arrCab2Cost;
-  double subsSubM;
-  double subsPileM;
-  double subsTopM;
-  double totElecCost;
+  T systAngle;
+  T freeCabLeng;
+  T fixCabLeng;
+  T nExpCab;
+  T expCabLeng;
+  T expCabCost;
+  T nSubstation;
+  T cab1Leng;
+  T cab2Leng;
+  T arrCab1Cost;
+  T arrCab2Cost;
+  T subsSubM;
+  T subsPileM;
+  T subsTopM;
+  T totElecCost;
   
   //Assembly & Installation outputs
-  double moorTime;
-  double floatPrepTime;
-  double turbDeckArea;
-  double nTurbPerTrip;
-  double turbInstTime;
-  double subDeckArea;
-  double nSubPerTrip;
-  double subInstTime;
-  double arrInstTime;
-  double expInstTime;
-  double subsInstTime;
-  double totInstTime;
-  double cabSurvey;
-  double array_cable_install_cost;
-  double export_cable_install_cost;
-  double substation_install_cost;
-  double turbine_install_cost;
-  double substructure_install_cost;
-  double electrical_install_cost;
-  double mob_demob_cost;
+  T moorTime;
+  T floatPrepTime;
+  T turbDeckArea;
+  T nTurbPerTrip;
+  T turbInstTime;
+  T subDeckArea;
+  T nSubPerTrip;
+  T subInstTime;
+  T arrInstTime;
+  T expInstTime;
+  T subsInstTime;
+  T totInstTime;
+  T cabSurvey;
+  T array_cable_install_cost;
+  T export_cable_install_cost;
+  T substation_install_cost;
+  T turbine_install_cost;
+  T substructure_install_cost;
+  T electrical_install_cost;
+  T mob_demob_cost;
+  T installSeasons;
 
   //Port & Staging outputs
-  double totPnSCost;
+  T totPnSCost;
 
   //Development outputs
-  double totDevCost;
+  T totDevCost;
 
   // Main Cost Outputs
-  double bos_capex;
-  double construction_insurance_cost;
-  double total_contingency_cost;
-  double construction_finance_cost;
-  double construction_finance_factor; //factor for construction financing
-  double soft_costs;
-  double totAnICost;
-  double totEnMCost;
-  double commissioning;
-  double decomCost;
-  double total_bos_cost;
+  T bos_capex;
+  T construction_insurance_cost;
+  T total_contingency_cost;
+  T construction_finance_cost;
+  T construction_finance_factor; //factor for construction financing
+  T soft_costs;
+  T totAnICost;
+  T totEnMCost;
+  T commissioning;
+  T decomCost;
+  T total_bos_cost;
 	
   //SUPPORTING FUNCTIONS************************************************************************************************************
   bool isFixed() { return ((substructure == MONOPILE) || (substructure == JACKET));}
   bool isFloating() { return ((substructure == SPAR) || (substructure == SEMISUBMERSIBLE));}
   void set_vessel_defaults();
+  // Waits (hours) for a weather window, over every start hour of the weather, of the installation of a turbine,
+  // a substructure (all visits to its position together) and an array cable section, each within the limits
+  // of its installation vessel.  set_weather_contingencies replaces turbCont, substructCont and elecCont by
+  // their contingencies.  Both throw runtime_error without weather, and the latter when an activity never fits.
+  void weather_delays(weather_delay &turbDelay, weather_delay &subDelay, weather_delay &cableDelay);
+  void set_weather_contingencies();
   void map2variables();
   void variables2map();
   void set_map_variable(string keyStr, string valStr);
   void set_map_variable(string keyStr, double val);
   void set_map_variable(const char* key, double val);
   double get_map_variable(const char* key);
+  // Direct access by index (see wobos_var), with no string lookup
+  void set_map_variable(int id, double val);
+  double get_map_variable(int id);
+
+  // Translate between variable names and wobos_var index (-1 if the name is unknown)
+  static int variable_index(const string &name);
+  static const char* variable_name(int id);
+  static int variable_flags(int id);
+
+  // The variable table itself (NVARIABLES values indexed by wobos_var), e.g. to share with NumPy without
+  // copying.  Values written here bypass set_map_variable, so percentages must already be fractions.
+  double* variable_values() {return varValues;}
+
+  // Class member of a continuous (double) variable, NULL for the enumerated, boolean or unknown ones
+  T* variable_member(int id);
+
+  // Substructure mass (tonnes) and cost ($) of one substructure for each of n rows of turbines/sites, with the
+  // substructure type and cost rates of this object (see lib_wind_obos_substructure.h).  A NULL column takes
+  // the value of this object.
+  void substructure_mass_cost(size_t n, const double *turbR, const double *waterD, const double *hubH,
+			      const double *rnaM, double *mass, double *cost) const;
   
   //EXECUTE FUNCTION************************************************************************************************************
   void run();
 
-  // Constructors
-  wobos();
-
-  
- private:
-  map<string, int> str2substructure { {"MONOPILE", MONOPILE}, {"JACKET", JACKET}, {"SPAR", SPAR}, {"SEMISUBMERSIBLE", SEMISUBMERSIBLE} };
-  map<string, int> str2anchor { {"DRAGEMBEDMENT", DRAGEMBEDMENT}, {"SUCTIONPILE", SUCTIONPILE} };
-  map<string, int> str2turbInstallMethod { {"INDIVIDUAL",INDIVIDUAL}, {"BUNNYEARS",BUNNYEARS}, {"ROTORASSEMBLED", ROTORASSEMBLED} } ;
-  map<string, int> str2towerInstallMethod { {"ONEPIECE", ONEPIECE}, {"TWOPIECE", TWOPIECE} } ;
-  map<string, int> str2installStrategy { {"PRIMARYVESSEL", PRIMARYVESSEL}, {"FEEDERBARGE", FEEDERBARGE} } ;
-
-  set<string> variable_percentage {"substructCont", "turbCont", "elecCont", "plantComm", "procurement_contingency", "install_contingency",
-      "construction_insurance", "capital_cost_year_0", "capital_cost_year_1", "capital_cost_year_2", "capital_cost_year_3",
-      "capital_cost_year_4", "capital_cost_year_5", "tax_rate", "interest_during_construction"};
-  
-  map<string, double> mapVars {
-    {"substructure", 0.0},
-    {"anchor", 0.0},
-    {"turbInstallMethod", 0.0},
-    {"towerInstallMethod", 0.0},
-    {"installStrategy", 0.0},
-    {"cableOptimizer", 0.0},
-    {"turbCapEx", 0.0},
-      {"nTurb", 0.0},
-  {"rotorD", 0.0},
-  {"turbR", 0.0},
-  {"hubH", 0.0},
-  {"waterD", 0.0},
-  {"distShore", 0.0},
-  {"distPort", 0.0},
-  {"distPtoA", 0.0},
-  {"distAtoS", 0.0},
-  {"moorLines", 0.0},
-  {"buryDepth", 0.0},
-  {"arrayY", 0.0},
-  {"arrayX", 0.0},
-  {"substructCont", 0.0},
-  {"turbCont", 0.0},
-  {"elecCont", 0.0},
-  {"interConVolt", 0.0},
-  {"distInterCon", 0.0},
-  {"scrapVal", 0.0},
-  {"number_install_seasons", 0.0},
+  // Same as run(), but the stages up to the first whose variables differ from the previous run_incremental()
+  // are not recomputed: their results from then are restored instead.  Results are only kept once a stage
+  // sees the same variables twice in a row, so calls that change an input every time (e.g. a sweep) run the
+  // stages from the first that it affects as run() does.  The variables of each stage are listed in
+  // lib_wind_obos_stage_deps.h.  Cables and vessels are assumed to change only through the templates,
+  // set_map_variable and set_vessel_defaults; call invalidate() after modifying them directly.
+  void run_incremental();
+  void invalidate();
 
-  //General
-  {"projLife", 0.0},
-  {"inspectClear", 0.0},
-  {"plantComm", 0.0},
-  {"procurement_contingency", 0.0},
-  {"install_contingency", 0.0},
-  {"construction_insurance", 0.0},
-  {"capital_cost_year_0", 0.0},
-  {"capital_cost_year_1", 0.0},
-  {"capital_cost_year_2", 0.0},
-  {"capital_cost_year_3", 0.0},
-  {"capital_cost_year_4", 0.0},
-  {"capital_cost_year_5", 0.0},
-  {"tax_rate", 0.0},
-  {"interest_during_construction", 0.0},
+  // Stage call counts and wall times, only recorded when built with WOBOS_PROFILE (see lib_wind_obos_profile.h)
+  wobos_profile profile;
 
-  //Substructure & Foundation
-  {"mpileCR", 0.0},
-  {"mtransCR", 0.0},
-  {"mpileD", 0.0},
-  {"mpileL", 0.0},
-  {"jlatticeCR", 0.0},
-  {"jtransCR", 0.0},
-  {"jpileCR", 0.0},
-  {"jlatticeA", 0.0},
-  {"jpileL", 0.0},
-  {"jpileD", 0.0},
-  {"spStifColCR", 0.0},
-  {"spTapColCR", 0.0},
-  {"ballCR", 0.0},
-  {"deaFixLeng", 0.0},
-  {"ssStifColCR", 0.0},
-  {"ssTrussCR", 0.0},
-  {"ssHeaveCR", 0.0},
-  {"sSteelCR", 0.0},
-  {"moorDia", 0.0},
-  {"moorCR", 0.0},
-  {"mpEmbedL", 0.0},
-  {"scourMat", 0.0},
-  
-  //Electrical Infrastructure
-  {"pwrFac", 0.0},
-  {"buryFac", 0.0},
-  {"arrVoltage", 0.0},
-  {"arrCab1Size", 0.0},
-  {"arrCab1Mass", 0.0},
-  {"cab1CurrRating", 0.0},
-  {"cab1CR", 0.0},
-  {"cab1TurbInterCR", 0.0},
-  {"arrCab2Size", 0.0},
-  {"arrCab2Mass", 0.0},
-  {"cab2CurrRating", 0.0},
-  {"cab2CR", 0.0},
-  {"cab2TurbInterCR", 0.0},
-  {"cab2SubsInterCR", 0.0},
-  {"catLengFac", 0.0},
-  {"exCabFac", 0.0},
-  {"subsTopFab", 0.0},
-  {"subsTopDes", 0.0},
-  {"topAssemblyFac", 0.0},
-  {"subsJackCR", 0.0},
-  {"subsPileCR", 0.0},
-  {"dynCabFac", 0.0},
-  {"shuntCR", 0.0},
-  {"highVoltSG", 0.0},
-  {"medVoltSG", 0.0},
-  {"backUpGen", 0.0},
-  {"workSpace", 0.0},
-  {"otherAncillary", 0.0},
-  {"mptCR", 0.0},
-  {"expVoltage", 0.0},
-  {"expCabSize", 0.0},
-  {"expCabMass", 0.0},
-  {"expCabCR", 0.0},
-  {"expCurrRating", 0.0},
-  {"expSubsInterCR", 0.0},
-	
-  //Assembly & Installation
-  {"moorTimeFac", 0.0},
-  {"moorLoadout", 0.0},
-  {"moorSurvey", 0.0},
-  {"prepAA", 0.0},
-  {"prepSpar", 0.0},
-  {"upendSpar", 0.0},
-  {"prepSemi", 0.0},
-  {"turbFasten", 0.0},
-  {"boltTower", 0.0},
-  {"boltNacelle1", 0.0},
-  {"boltNacelle2", 0.0},
-  {"boltNacelle3", 0.0},
-  {"boltBlade1", 0.0},
-  {"boltBlade2", 0.0},
-  {"boltRotor", 0.0},
-  {"vesselPosTurb", 0.0},
-  {"vesselPosJack", 0.0},
-  {"vesselPosMono", 0.0},
-  {"subsVessPos", 0.0},
-  {"monoFasten", 0.0},
-  {"jackFasten", 0.0},
-  {"prepGripperMono", 0.0},
-  {"prepGripperJack", 0.0},
-  {"placePiles", 0.0},
-  {"prepHamMono", 0.0},
-  {"removeHamMono", 0.0},
-  {"prepHamJack", 0.0},
-  {"removeHamJack", 0.0},
-  {"placeJack", 0.0},
-  {"levJack", 0.0},
-  {"placeTemplate", 0.0},
-  {"hamRate", 0.0},
-  {"placeMP", 0.0},
-  {"instScour", 0.0},
-  {"placeTP", 0.0},
-  {"groutTP", 0.0},
-  {"tpCover", 0.0},
-  {"prepTow", 0.0},
-  {"spMoorCon", 0.0},
-  {"ssMoorCon", 0.0},
-  {"spMoorCheck", 0.0},
-  {"ssMoorCheck", 0.0},
-  {"ssBall", 0.0},
-  {"surfLayRate", 0.0},
-  {"cabPullIn", 0.0},
-  {"cabTerm", 0.0},
-  {"cabLoadout", 0.0},
-  {"buryRate", 0.0},
-  {"subsPullIn", 0.0},
-  {"shorePullIn", 0.0},
-  {"landConstruct", 0.0},
-  {"expCabLoad", 0.0},
-  {"subsLoad", 0.0},
-  {"placeTop", 0.0},
-  {"pileSpreadDR", 0.0},
-  {"pileSpreadMob", 0.0},
-  {"groutSpreadDR", 0.0},
-  {"groutSpreadMob", 0.0},
-  {"seaSpreadDR", 0.0},
-  {"seaSpreadMob", 0.0},
-  {"compRacks", 0.0},
-  {"cabSurveyCR", 0.0},
-  {"cabDrillDist", 0.0},
-  {"cabDrillCR", 0.0},
-  {"mpvRentalDR", 0.0},
-  {"diveTeamDR", 0.0},
-  {"winchDR", 0.0},
-  {"civilWork", 0.0},
-  {"elecWork", 0.0},
-	
-  //Port & Staging
-  {"nCrane600", 0.0},
-  {"nCrane1000", 0.0},
-  {"crane600DR", 0.0},
-  {"crane1000DR", 0.0},
-  {"craneMobDemob", 0.0},
-  {"entranceExitRate", 0.0},
-  {"dockRate", 0.0},
-  {"wharfRate", 0.0},
-  {"laydownCR", 0.0},
-	
-  //Engineering & Management
-  {"estEnMFac", 0.0},
-	
-  //Development
-  {"preFEEDStudy", 0.0},
-  {"feedStudy", 0.0},
-  {"stateLease", 0.0},
-  {"outConShelfLease", 0.0},
-  {"saPlan", 0.0},
-  {"conOpPlan", 0.0},
-  {"nepaEisMet", 0.0},
-  {"physResStudyMet", 0.0},
-  {"bioResStudyMet", 0.0},
-  {"socEconStudyMet", 0.0},
-  {"navStudyMet", 0.0},
-  {"nepaEisProj", 0.0},
-  {"physResStudyProj", 0.0},
-  {"bioResStudyProj", 0.0},
-  {"socEconStudyProj", 0.0},
-  {"navStudyProj", 0.0},
-  {"coastZoneManAct", 0.0},
-  {"rivsnHarbsAct", 0.0},
-  {"cleanWatAct402", 0.0},
-  {"cleanWatAct404", 0.0},
-  {"faaPlan", 0.0},
-  {"endSpecAct", 0.0},
-  {"marMamProtAct", 0.0},
-  {"migBirdAct", 0.0},
-  {"natHisPresAct", 0.0},
-  {"addLocPerm", 0.0},
-  {"metTowCR", 0.0},
-    {"decomDiscRate", 0.0},
-
-    
-    // INPUTS/OUTPUTS, depending on how module is called
-  // Turbine outputs
-  {"hubD", 0.0},
-  {"bladeL", 0.0},
-  {"max_chord", 0.0},
-  {"nacelleW", 0.0},
-  {"nacelleL", 0.0},
-  {"rnaM", 0.0},
-  {"towerD", 0.0},
-  {"towerM", 0.0},
-
-  //Substructure & Foundation outputs
-  {"subTotM", 0.0},
-  {"subTotCost", 0.0},
-  {"moorCost", 0.0},
+  // Constructors
+  wobos_t();
 
-    
-    // OUTPUTS
-  //Electrical Infrastructure outputs
-  {"systAngle", 0.0},
-  {"freeCabLeng", 0.0},
-  {"fixCabLeng", 0.0},
-  {"nExpCab", 0.0},
-  {"expCabLeng", 0.0},
-  {"expCabCost", 0.0},
-  {"nSubstation", 0.0},
-  {"cab1Leng", 0.0},
-  {"cab2Leng", 0.0},
-  {"arrCab1Cost", 0.0},
-  {"arrCab2Cost", 0.0},
-  {"subsSubM", 0.0},
-  {"subsPileM", 0.0},
-  {"subsTopM", 0.0},
-  {"totElecCost", 0.0},
   
-  //Assembly & Installation outputs
-  {"moorTime", 0.0},
-  {"floatPrepTime", 0.0},
-  {"turbDeckArea", 0.0},
-  {"nTurbPerTrip", 0.0},
-  {"turbInstTime", 0.0},
-  {"subDeckArea", 0.0},
-  {"nSubPerTrip", 0.0},
-  {"subInstTime", 0.0},
-  {"arrInstTime", 0.0},
-  {"expInstTime", 0.0},
-  {"subsInstTime", 0.0},
-  {"totInstTime", 0.0},
-  {"cabSurvey", 0.0},
-  {"array_cable_install_cost", 0.0},
-  {"export_cable_install_cost", 0.0},
-  {"substation_install_cost", 0.0},
-  {"turbine_install_cost", 0.0},
-  {"substructure_install_cost", 0.0},
-  {"electrical_install_cost", 0.0},
-  {"mob_demob_cost", 0.0},
-
-  //Port & Staging outputs
-  {"totPnSCost", 0.0},
-
-  //Development outputs
-  {"totDevCost", 0.0},
-
-  // Main Cost Outputs
-  {"bos_capex", 0.0},
-  {"construction_insurance_cost", 0.0},
-  {"total_contingency_cost", 0.0},
-  {"construction_finance_cost", 0.0},
-  {"construction_finance_factor", 0.0}, //factor for construction financing
-  {"soft_costs", 0.0},
-  {"totAnICost", 0.0},
-  {"totEnMCost", 0.0},
-  {"commissioning", 0.0},
-  {"decomCost", 0.0},
-  {"total_bos_cost", 0.0}
+ private:
+  friend class wobos_batch;
+  friend class wobos_weather_sweep;
+  friend class wobos_jacobian;
+  friend class wobos_bench;
+  friend class wobos_test;
+
+  // Values of every variable in lib_wind_obos_variables.h, indexed by wobos_var
+  double varValues[NVARIABLES];
+
+  // Stage results of the previous run_incremental(), and the cables and vessels they were computed with
+  struct stage_memo {
+    bool inputs;            // before holds the variables of the stage before it last ran
+    bool valid;             // and after holds them after it ran
+    vector<double> before;
+    vector<double> after;
+    vector<int> changed;    // positions where after differs from before
+    stage_memo() : inputs(false), valid(false) {}
   };
+  vector<stage_memo> stageMemo;
+  shared_ptr<const wobos_templates> memoTemplates;
+  shared_ptr<const wobos_weather> memoWeather;
+  shared_ptr<const wobos_array_layout> memoArrayLayout;
+  int memoVesselSubstructure;
+  vector<double> memoArrVoltages;
+  vector<double> memoExpVoltages;
+  int vesselSubstructure;  // substructure that set_vessel_defaults chose the vessels for
+  install_simulator installSim;  // for installSimulation, reused between runs
 
-  void set_templates();
   vector<cableFamily> set_cables(vector<int> cableVoltages);
   vector<vessel> set_vessels(vector<string> vesselNames);
+
+  // Stages of run() in order, compiled for run path P, and those of the path that fits this object
+  typedef void (wobos_t<T>::*stage_function)();
+  template <class P> static const stage_function* path_stages();
+  const stage_function* run_stages() const;
+
+  // Branch variables as the stages of run path P see them: the path's value if it fixes one, the object's otherwise
+  template <class P> int path_substructure() const;
+  template <class P> int path_strategy() const;
+  template <class P> int path_anchor() const;
+  template <class P> int path_turb_install() const;
+  template <class P> int path_tower_install() const;
+  template <class P> bool path_fixed() const;
+  template <class P> bool path_floating() const;
   
   //General Module
   void set_turbine_parameters();  
 
   // Final summation
-  void calculate_bos_cost();
+  template <class P=wobos_path<> > void calculate_bos_cost();
 
   //Substructure & Foundation Module
-  tuple<double, double> calculate_monopile();
-  tuple<double, double> calculate_jacket();
-  tuple<double, double> calculate_spar();
-  tuple<double, double> calculate_ballast();
-  tuple<double, double> calculate_semi();
-  tuple<double, double> calculate_secondary_steel(int substructure);
-  tuple<double, double> calculate_secondary_steel();
-  void calculate_mooring();
-  void calculate_substructure_mass_cost();
+  tuple<T, T> calculate_monopile();
+  tuple<T, T> calculate_jacket();
+  tuple<T, T> calculate_spar();
+  tuple<T, T> calculate_ballast();
+  tuple<T, T> calculate_semi();
+  tuple<T, T> calculate_secondary_steel(int substructure);
+  tuple<T, T> calculate_secondary_steel();
+  template <class P=wobos_path<> > void calculate_mooring();
+  template <class P=wobos_path<> > void calculate_substructure_mass_cost();
 
   //Electrical Infrastructure Module
-  double calculate_subsea_cable_cost();
-  double calculate_substation_cost();
-  double calculate_onshore_transmission_cost();
-  double calculate_export_cable_cost(double expCurrRating, double expVoltage, double expCabMass, double expSubsInterCR, double expCabCR);
-  double calculate_array_cable_cost(double cab1CurrRating, double cab2CurrRating, double arrVoltage, double arrCab1Mass, double arrCab2Mass,
-				    double cab1CR, double cab2CR, double cab1TurbInterCR, double cab2TurbInterCR, double cab2SubsInterCR);
-  void calculate_electrical_infrastructure_cost();
+  T calculate_subsea_cable_cost();
+  template <class P=wobos_path<> > T calculate_substation_cost();
+  T calculate_onshore_transmission_cost();
+  T calculate_export_cable_cost(T expCurrRating, T expVoltage, T expCabMass, T expSubsInterCR, T expCabCR);
+  T calculate_array_cable_cost(T cab1CurrRating, T cab2CurrRating, T arrVoltage, T arrCab1Mass, T arrCab2Mass,
+			       T cab1CR, T cab2CR, T cab1TurbInterCR, T cab2TurbInterCR, T cab2SubsInterCR);
+  cable_context_t<T> get_cable_context() const;
+  template <class P=wobos_path<> > void calculate_electrical_infrastructure_cost();
 
   //Assembly & Installation Module
-  void calculate_assembly_and_installation();
-  double MinTurbDeckArea();
-  double TurbineInstall();
-  double SubstructureInstTime();
-  void TurbInstCost();
-  void SubInstCost();
-  void ElectricalInstCost();
-  void VesselMobDemobCost();
-  double TotInstCost();
+  template <class P=wobos_path<> > void calculate_assembly_and_installation();
+  template <class P=wobos_path<> > T MinTurbDeckArea();
+  template <class P=wobos_path<> > T TurbineInstall();
+  template <class P=wobos_path<> > T SubstructureInstTime();
+  template <class P=wobos_path<> > T TurbineInstallHours();
+  template <class P=wobos_path<> > install_campaign turbine_install_campaign();
+  template <class P=wobos_path<> > install_campaign substructure_install_campaign();
+  template <class P=wobos_path<> > void TurbInstCost();
+  template <class P=wobos_path<> > void SubInstCost();
+  template <class P=wobos_path<> > void ElectricalInstCost();
+  template <class P=wobos_path<> > void VesselMobDemobCost();
+  template <class P=wobos_path<> > T TotInstCost();
 
   //Port & Staging Module
-  double calculate_entrance_exit_costs();
-  void calculate_port_and_staging_costs();
+  template <class P=wobos_path<> > T calculate_entrance_exit_costs();
+  template <class P=wobos_path<> > void calculate_port_and_staging_costs();
 
   //Engineering & Management Module
   void calculate_engineering_management_cost();
@@ -774,14 +614,20 @@ class wobos {//WIND OFFSHORE BOS STRUCTURE TO HOLD ALL INPUTS AND OUTPUTS AND AL
   //Development Module
   void calculate_development_cost();
 
-  double DecomissExpense();
-  double PlantCommissioning();
+  T DecomissExpense();
+  T PlantCommissioning();
 
   //cable cost optimizing functions
   void ArrayCabCostOptimizer();
   void ExportCabCostOptimizer();
 };
 
+// The model is a template on the scalar type: wobos is the plain model, wobos_t<wobos_dual> carries
+// derivatives along (see lib_wind_obos_dual.h).  Both are instantiated in lib_wind_obos.cpp.
+typedef wobos_t<double> wobos;
+extern template class wobos_t<double>;
+extern template class wobos_t<wobos_dual>;
+
 // For SAM
 extern wobos wobos_obj;
 extern wobos *wobos_cm;
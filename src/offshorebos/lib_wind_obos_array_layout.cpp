@@ -0,0 +1,242 @@
+#include "lib_wind_obos_array_layout.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+
+wobos_array_layout::wobos_array_layout(const vector<double> &turbX, const vector<double> &turbY,
+				       const vector<double> &subsX, const vector<double> &subsY)
+  : turbX(turbX), turbY(turbY), subsX(subsX), subsY(subsY) {
+  if (turbX.empty() || subsX.empty()) throw invalid_argument("Need at least one turbine and one substation");
+  if ((turbX.size() != turbY.size()) || (subsX.size() != subsY.size()))
+    throw invalid_argument("Need one y coordinate per x coordinate");
+  const size_t n = turbX.size();
+
+  // Nearest substation of every turbine; there are only a few substations
+  nearestSubs.resize(n);
+  subsDist.resize(n);
+  for (size_t i=0; i<n; i++) {
+    double best = numeric_limits<double>::infinity();
+    for (size_t s=0; s<subsX.size(); s++) {
+      double d = hypot(turbX[i] - subsX[s], turbY[i] - subsY[s]);
+      if (d < best) {
+	best = d;
+	nearestSubs[i] = s;
+      }
+    }
+    subsDist[i] = best;
+  }
+
+  order.resize(n);
+  for (size_t i=0; i<n; i++) order[i] = i;
+  nodeSize.resize(n);
+  nodeBox.resize(4*n);
+  build(0, n, 0);
+  position.resize(n);
+  for (size_t k=0; k<n; k++) position[order[k]] = k;
+
+  // Ties in the order of the turbines, so that strings do not depend on the sort
+  outsideIn.resize(n);
+  for (size_t i=0; i<n; i++) outsideIn[i] = i;
+  const vector<double> &dist = subsDist;
+  stable_sort(outsideIn.begin(), outsideIn.end(), [&dist] (size_t a, size_t b) {return dist[a] > dist[b];});
+}
+
+
+void wobos_array_layout::find_successors() const {
+  const size_t n = turbines(), none = numeric_limits<size_t>::max();
+  successors.assign(NSUCCESSORS*n, none);
+  vector<pair<double, size_t> > found;
+  for (size_t i=0; i<n; i++) {
+    found.clear();
+    nearest_k(0, n, 0, i, NSUCCESSORS, found);
+    for (size_t k=0; k<found.size(); k++) successors[NSUCCESSORS*i + k] = found[k].second;
+  }
+}
+
+
+void wobos_array_layout::build(size_t lo, size_t hi, int depth) {
+  if (lo >= hi) return;
+  size_t mid = (lo + hi) / 2;
+  nodeSize[mid] = hi - lo;
+  const vector<double> &coord = (depth % 2 == 0) ? turbX : turbY;
+  nth_element(order.begin() + lo, order.begin() + mid, order.begin() + hi, [&coord] (size_t a, size_t b) {
+      return (coord[a] < coord[b]) || ((coord[a] == coord[b]) && (a < b));
+    });
+  build(lo, mid, depth + 1);
+  build(mid + 1, hi, depth + 1);
+
+  double *box = &nodeBox[4*mid];
+  box[0] = box[1] = turbX[order[mid]];
+  box[2] = box[3] = turbY[order[mid]];
+  if (lo < mid) extend(box, &nodeBox[4*((lo + mid) / 2)]);
+  if (mid + 1 < hi) extend(box, &nodeBox[4*((mid + 1 + hi) / 2)]);
+}
+
+
+void wobos_array_layout::extend(double *box, const double *other) {
+  box[0] = min(box[0], other[0]);
+  box[1] = max(box[1], other[1]);
+  box[2] = min(box[2], other[2]);
+  box[3] = max(box[3], other[3]);
+}
+
+
+double wobos_array_layout::box_distance2(const double *box, double x, double y) {
+  double dx = max(0.0, max(box[0] - x, x - box[1]));
+  double dy = max(0.0, max(box[2] - y, y - box[3]));
+  return dx*dx + dy*dy;
+}
+
+
+void wobos_array_layout::take(size_t turbine, vector<size_t> &freeCount) const {
+  size_t lo = 0, hi = order.size(), pos = position[turbine];
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    freeCount[mid]--;
+    if (pos == mid) return;
+    if (pos < mid) hi = mid;
+    else lo = mid + 1;
+  }
+}
+
+
+void wobos_array_layout::nearest(size_t lo, size_t hi, int depth, size_t from, const vector<size_t> &freeCount,
+				 const vector<char> &isFree, double &best, size_t &found) const {
+  if (lo >= hi) return;
+  size_t mid = (lo + hi) / 2;
+  if (freeCount[mid] == 0) return;
+  const double *box = &nodeBox[4*mid];
+  size_t s = nearestSubs[from];
+  if ( (box_distance2(box, turbX[from], turbY[from]) > best) ||
+       (box_distance2(box, subsX[s], subsY[s]) >= subsDist[from]*subsDist[from]) ) return;
+
+  // Free, on the same substation, further in and nearer than anything so far (ties to the first turbine)
+  size_t p = order[mid];
+  double dx = turbX[p] - turbX[from], dy = turbY[p] - turbY[from];
+  double d2 = dx*dx + dy*dy;
+  if ( isFree[p] && (nearestSubs[p] == nearestSubs[from]) && (subsDist[p] < subsDist[from]) &&
+       ((d2 < best) || ((d2 == best) && (p < found))) ) {
+    best  = d2;
+    found = p;
+  }
+
+  // The half of the query first, so that the other one is more likely to be skipped
+  double diff = (depth % 2 == 0) ? turbX[from] - turbX[p] : turbY[from] - turbY[p];
+  if (diff < 0.0) {
+    nearest(lo, mid, depth + 1, from, freeCount, isFree, best, found);
+    nearest(mid + 1, hi, depth + 1, from, freeCount, isFree, best, found);
+  }
+  else {
+    nearest(mid + 1, hi, depth + 1, from, freeCount, isFree, best, found);
+    nearest(lo, mid, depth + 1, from, freeCount, isFree, best, found);
+  }
+}
+
+
+void wobos_array_layout::nearest_k(size_t lo, size_t hi, int depth, size_t from, size_t k,
+				   vector<pair<double, size_t> > &found) const {
+  if (lo >= hi) return;
+  size_t mid = (lo + hi) / 2;
+  const double *box = &nodeBox[4*mid];
+  size_t s = nearestSubs[from];
+  double bound = (found.size() < k) ? subsDist[from]*subsDist[from] : found.back().first;
+  if ( (box_distance2(box, turbX[from], turbY[from]) > bound) ||
+       (box_distance2(box, subsX[s], subsY[s]) >= subsDist[from]*subsDist[from]) ) return;
+
+  // In order of distance and then turbine, as nearest() picks them
+  size_t p = order[mid];
+  double dx = turbX[p] - turbX[from], dy = turbY[p] - turbY[from];
+  pair<double, size_t> cand(dx*dx + dy*dy, p);
+  if ( (nearestSubs[p] == s) && (subsDist[p] < subsDist[from]) && (cand.first <= subsDist[from]*subsDist[from]) &&
+       ((found.size() < k) || (cand < found.back())) ) {
+    found.insert(upper_bound(found.begin(), found.end(), cand), cand);
+    if (found.size() > k) found.pop_back();
+  }
+
+  double diff = (depth % 2 == 0) ? turbX[from] - turbX[p] : turbY[from] - turbY[p];
+  if (diff < 0.0) {
+    nearest_k(lo, mid, depth + 1, from, k, found);
+    nearest_k(mid + 1, hi, depth + 1, from, k, found);
+  }
+  else {
+    nearest_k(mid + 1, hi, depth + 1, from, k, found);
+    nearest_k(lo, mid, depth + 1, from, k, found);
+  }
+}
+
+
+shared_ptr<const array_strings> wobos_array_layout::strings(size_t capacity) const {
+  if (capacity == 0) throw invalid_argument("Strings need room for at least one turbine");
+  capacity = min(capacity, turbines());
+
+  lock_guard<mutex> guard(lock);
+  shared_ptr<const array_strings> &s = stringCache[capacity];
+  if (!s) {
+    if (successors.empty() && (stringCache.size() > 1)) find_successors();
+    s = make_strings(capacity);
+  }
+  return s;
+}
+
+
+shared_ptr<const array_strings> wobos_array_layout::make_strings(size_t capacity) const {
+  const size_t n = turbines(), none = numeric_limits<size_t>::max();
+  shared_ptr<array_strings> out = make_shared<array_strings>();
+  out->capacity        = capacity;
+  out->fullStrings     = 0;
+  out->partialTurbines = 0;
+  out->sectionLength.assign(capacity + 1, 0.0);
+  out->sectionCount.assign(capacity + 1, 0.0);
+  out->linkLength      = 0.0;
+
+  vector<char> isFree(n, 1);
+  vector<size_t> freeCount(nodeSize);
+  for (size_t k=0; k<n; k++) {
+    size_t first = outsideIn[k];
+    if (!isFree[first]) continue;
+
+    vector<size_t> str(1, first);
+    isFree[first] = 0;
+    take(first, freeCount);
+    while (str.size() < capacity) {
+      // The nearest free successor, if any; the tree only if all are taken and there may be more
+      size_t from = str.back(), found = none, k = 0;
+      if (!successors.empty()) {
+	const size_t *succ = &successors[NSUCCESSORS*from];
+	while ((k < NSUCCESSORS) && (succ[k] != none) && !isFree[succ[k]]) k++;
+	if ((k < NSUCCESSORS) && (succ[k] != none)) found = succ[k];
+      }
+      else k = NSUCCESSORS;
+      if (k == NSUCCESSORS) {
+	double best = subsDist[from] * subsDist[from];
+	nearest(0, n, 0, from, freeCount, isFree, best, found);
+      }
+      if (found == none) break;
+
+      // The section from the turbine before carries the power of every turbine so far
+      double dx = turbX[found] - turbX[from], dy = turbY[found] - turbY[from];
+      out->sectionLength[str.size()] += sqrt(dx*dx + dy*dy);
+      out->sectionCount[str.size()]  += 1.0;
+      str.push_back(found);
+      isFree[found] = 0;
+      take(found, freeCount);
+    }
+
+    out->linkLength += subsDist[str.back()];
+    if (str.size() == capacity) out->fullStrings++;
+    else out->partialTurbines += str.size();
+    out->substation.push_back(nearestSubs[first]);
+    out->turbines.push_back(str);
+  }
+
+  for (size_t k=1; k<=capacity; k++) {
+    out->sectionLength[k] += out->sectionLength[k-1];
+    out->sectionCount[k]  += out->sectionCount[k-1];
+  }
+  return out;
+}
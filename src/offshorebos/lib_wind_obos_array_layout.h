@@ -0,0 +1,95 @@
+#ifndef __wind_obos_array_layout_h
+#define __wind_obos_array_layout_h
+
+// Array cable routes from the positions of the turbines and substations, e.g. an irregular layout from a
+// layout optimizer, in place of the arrayX by arrayY rotor diameter grid that calculate_array_cable_layout
+// assumes otherwise.
+//
+// Every turbine is linked to its nearest substation by a radial string of at most capacity turbines.
+// Strings are laid out from the outside in: a string starts at the turbine farthest from its substation that
+// is not on a string yet, and goes on to the nearest such turbine that is closer to the substation than the
+// last one and closer to it than the substation itself, until the string is full or there is none; then it
+// is linked to the substation.  The section from the k-th turbine of a string carries the power of k turbines,
+// so it needs a cable for at least k turbines.  Nearest turbines come from a 2-d tree (k-d tree) of the
+// turbines that skips the ones already on a string, so a layout of n turbines takes O(n log n) per capacity.
+// Once a second capacity is asked for, the few turbines that can follow each turbine are found, nearest first;
+// the nearest free one of them is the next turbine of a string, and only when none is free does the tree need
+// to be searched.
+//
+// The strings of a capacity are built the first time they are asked for and kept, so the cable optimizers,
+// which try every pair of cables and thus only a few capacities, pay for each capacity once per layout.
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+
+// Strings of at most capacity turbines, and the horizontal lengths (m) of their sections
+struct array_strings {
+  size_t capacity;
+  std::vector<std::vector<size_t> > turbines;  // per string, its turbines from the outermost one in
+  std::vector<size_t> substation;              // per string, the substation it is linked to
+  size_t fullStrings;                          // strings of capacity turbines
+  size_t partialTurbines;                      // turbines on the other strings
+
+  // Sections between turbines that carry at most k turbines, k = 0 ... capacity: their total length and count
+  std::vector<double> sectionLength;
+  std::vector<double> sectionCount;
+  double linkLength;                           // sections from the last turbine of every string to its substation
+};
+
+class wobos_array_layout {
+ public:
+  size_t turbines() const {return turbX.size();}
+  size_t substations() const {return subsX.size();}
+  const std::vector<double>& turbine_x() const {return turbX;}
+  const std::vector<double>& turbine_y() const {return turbY;}
+  const std::vector<double>& substation_x() const {return subsX;}
+  const std::vector<double>& substation_y() const {return subsY;}
+
+  // Strings of at most capacity (>= 1) turbines, shared by all users of this object (thread-safe)
+  std::shared_ptr<const array_strings> strings(size_t capacity) const;
+
+  // Constructors: turbine and substation coordinates in meters.  Throws invalid_argument without turbines or
+  // substations, or if the coordinates do not pair up.
+  wobos_array_layout(const std::vector<double> &turbX, const std::vector<double> &turbY,
+		     const std::vector<double> &subsX, const std::vector<double> &subsY);
+
+ private:
+  std::vector<double> turbX, turbY, subsX, subsY;
+  std::vector<size_t> nearestSubs;  // per turbine
+  std::vector<double> subsDist;     // to it
+
+  // 2-d tree: node [lo, hi) of order has its splitting turbine at (lo + hi) / 2, on x at even depths and on y
+  // at odd ones, and the turbines before and after it in its two halves
+  std::vector<size_t> order;
+  std::vector<size_t> position;  // of every turbine in order
+  std::vector<size_t> nodeSize;  // turbines in the node split at each position
+  std::vector<double> nodeBox;   // and their bounding box: min x, max x, min y, max y
+  std::vector<size_t> outsideIn; // turbines from the farthest from their substation in
+  static const size_t NSUCCESSORS = 4;
+
+  mutable std::mutex lock;
+  mutable std::map<size_t, std::shared_ptr<const array_strings> > stringCache;
+  mutable std::vector<size_t> successors; // per turbine, the NSUCCESSORS nearest that can follow it, none after the last
+
+  void build(size_t lo, size_t hi, int depth);
+  void find_successors() const;
+  static void extend(double *box, const double *other);
+  static double box_distance2(const double *box, double x, double y);  // squared, 0 inside
+  std::shared_ptr<const array_strings> make_strings(size_t capacity) const;
+
+  // Take a turbine out of the free counts of the nodes above it, and find the nearest free turbine that can
+  // follow turbine from on its string (none if found stays as it is), skipping nodes whose boxes are farther
+  // from it than the best so far or no closer to its substation than it is
+  void take(size_t turbine, std::vector<size_t> &freeCount) const;
+  void nearest(size_t lo, size_t hi, int depth, size_t from, const std::vector<size_t> &freeCount,
+	       const std::vector<char> &isFree, double &best, size_t &found) const;
+
+  // The k turbines that can follow turbine from, nearest first as (squared distance, turbine)
+  void nearest_k(size_t lo, size_t hi, int depth, size_t from, size_t k,
+		 std::vector<std::pair<double, size_t> > &found) const;
+};
+
+#endif
@@ -0,0 +1,125 @@
+#include "lib_wind_obos_batch.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+using namespace std;
+
+// For Python wrapping with c_types
+extern "C" {
+  wobos_batch* pywobos_batch_new(const char** inNames, int nIn, const char** outNames, int nOut) {
+    try {
+      return new wobos_batch(vector<string>(inNames, inNames+nIn), vector<string>(outNames, outNames+nOut));
+    } catch(exception& e) {
+      cout << e.what() << endl;
+      return NULL;
+    }
+  }
+  void pywobos_batch_run(wobos_batch* batch, const double* inputs, int nScenarios, double* outputs) {
+    batch->run(inputs, (size_t)nScenarios, outputs);
+  }
+  void pywobos_batch_run_parallel(wobos_batch* batch, const double* inputs, int nScenarios, double* outputs, int nthreads) {
+    batch->run_parallel(inputs, (size_t)nScenarios, outputs, nthreads);
+  }
+  void pywobos_batch_profile_get(wobos_batch* batch, double* calls, double* seconds, double* candidates) {
+    const wobos_profile &prof = batch->profile();
+    copy(prof.calls, prof.calls + NSTAGES, calls);
+    copy(prof.seconds, prof.seconds + NSTAGES, seconds);
+    copy(prof.candidates, prof.candidates + NSTAGES, candidates);
+  }
+  void pywobos_batch_profile_reset(wobos_batch* batch) {batch->reset_profile();}
+  void pywobos_batch_set_baseline(wobos_batch* batch, wobos* obos) {batch->set_baseline(*obos);}
+  void pywobos_batch_delete(wobos_batch* batch) {delete batch;}
+}
+
+
+wobos_batch::wobos_batch(vector<string> inNames, vector<string> outNames) {
+  inputNames  = inNames;
+  outputNames = outNames;
+
+  // Resolve names once here so that every scenario works on indices only
+  for (size_t k=0; k<inputNames.size(); k++) {
+    inputIds.push_back( wobos::variable_index(inputNames[k]) );
+    if (inputIds.back() < 0) throw invalid_argument("Unknown input variable: " + inputNames[k]);
+  }
+  for (size_t k=0; k<outputNames.size(); k++) {
+    outputIds.push_back( wobos::variable_index(outputNames[k]) );
+    if (outputIds.back() < 0) throw invalid_argument("Unknown output variable: " + outputNames[k]);
+  }
+
+  // Store the default state that every scenario starts from
+  baseline.assign(worker.varValues, worker.varValues + NVARIABLES);
+}
+
+
+void wobos_batch::set_baseline(const wobos &obos) {
+  wobos_profile prof = worker.profile;
+  worker = obos;
+  worker.profile = prof;
+  baseline.assign(worker.varValues, worker.varValues + NVARIABLES);
+}
+
+
+void wobos_batch::run_scenario(wobos &obos, const double* inRow, double* outRow) {
+  // Start from defaults, then apply this scenario's inputs
+  copy(baseline.begin(), baseline.end(), obos.varValues);
+  for (size_t k=0; k<inputIds.size(); k++)
+    obos.set_map_variable(inputIds[k], inRow[k]);
+
+  // Same sequence as the Python wrapper: substructure may have changed, so reset vessels too
+  obos.map2variables();
+  obos.set_vessel_defaults();
+  obos.run();
+  obos.variables2map();
+
+  for (size_t k=0; k<outputIds.size(); k++)
+    outRow[k] = obos.varValues[outputIds[k]];
+}
+
+
+void wobos_batch::run(const double* inputs, size_t nScenarios, double* outputs) {
+  for (size_t i=0; i<nScenarios; i++)
+    run_scenario(worker, inputs + i*nInputs(), outputs + i*nOutputs());
+}
+
+
+void wobos_batch::run_parallel(const double* inputs, size_t nScenarios, double* outputs, int nthreads) {
+  if (nthreads <= 0) nthreads = max(1, (int)thread::hardware_concurrency());
+  nthreads = (int)min((size_t)nthreads, nScenarios);
+  if (nthreads <= 1) {
+    run(inputs, nScenarios, outputs);
+    return;
+  }
+
+  // Small enough chunks that threads finishing early can pick up the slack
+  const size_t chunk = max((size_t)1, nScenarios / (8*nthreads));
+  atomic<size_t> next(0);
+
+  // Every thread gets its own worker, copied before any thread starts; they only share the read-only input
+  // table and write disjoint output rows.  Profiles are merged once all threads are done.
+  vector<wobos> workers(nthreads, worker);
+  for (int t=0; t<nthreads; t++) workers[t].profile.reset();
+
+  auto work = [&] (int t) {
+    wobos &obos = workers[t];
+    size_t start;
+    while ( (start = next.fetch_add(chunk)) < nScenarios ) {
+      size_t stop = min(start + chunk, nScenarios);
+      for (size_t i=start; i<stop; i++)
+	run_scenario(obos, inputs + i*nInputs(), outputs + i*nOutputs());
+    }
+  };
+
+  vector<thread> pool;
+  for (int t=0; t<nthreads; t++) pool.push_back( thread(work, t) );
+  for (size_t t=0; t<pool.size(); t++) pool[t].join();
+
+  if (wobos_profile::enabled())
+    for (int t=0; t<nthreads; t++) worker.profile.merge(workers[t].profile);
+}
@@ -0,0 +1,109 @@
+#ifndef __wind_obos_batch_h
+#define __wind_obos_batch_h
+
+#include "lib_wind_obos.h"
+#include <vector>
+#include <string>
+#include <map>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+
+// Batch evaluation of many plant scenarios.  The input table holds one scenario per row with one
+// column per entry in inputNames; the output table receives one row per scenario with one column
+// per entry in outputNames.  Both tables are dense, row-major arrays of doubles.
+//
+// A single wobos worker is constructed up front, so the compiled-in defaults, cable and vessel templates
+// are only applied once.  Before every scenario the worker is reset to the defaults so that rows
+// never see each other's values (e.g. hubD or mpileL that run() fills in when left at zero).
+//
+// run_parallel() spreads the rows over a pool of threads, each with its own copy of the worker.
+// Threads pull chunks of rows from a shared counter until the table is exhausted, so uneven rows
+// (e.g. with the cable optimizer switched on) balance out across cores.
+class wobos_batch {
+ public:
+  vector<string> inputNames;
+  vector<string> outputNames;
+
+  size_t nInputs() {return inputNames.size();}
+  size_t nOutputs() {return outputNames.size();}
+
+  // Evaluate nScenarios rows of inputs, writing nScenarios rows of outputs
+  void run(const double* inputs, size_t nScenarios, double* outputs);
+
+  // Same as run(), but spread over nthreads threads (all hardware threads if nthreads <= 0)
+  void run_parallel(const double* inputs, size_t nScenarios, double* outputs, int nthreads=0);
+
+  // Start every scenario from the variables, cables and vessel templates of obos instead of the defaults
+  void set_baseline(const wobos &obos);
+
+  // Stage profile summed over all scenarios run so far, including those of run_parallel() (see lib_wind_obos_profile.h)
+  const wobos_profile& profile() const {return worker.profile;}
+  void reset_profile() {worker.profile.reset();}
+
+  // Constructors
+  wobos_batch(vector<string> inNames, vector<string> outNames);
+
+ private:
+  wobos worker;
+  vector<int> inputIds;
+  vector<int> outputIds;
+  vector<double> baseline;
+
+  void run_scenario(wobos &obos, const double* inRow, double* outRow);
+};
+
+
+// Blocks 0 .. nBlocks-1 of an estimator that sums up many runs, e.g. Monte Carlo samples, on nthreads threads
+// (all hardware threads if nthreads <= 0).  Every thread makes its own state once with make_state(), e.g. a
+// wobos_batch_scratch, and pulls blocks from a shared counter; work(state, block, sums) fills the sums of a
+// block, which start from zero, and merge(sums) adds them to the result in block order, so that rounding is
+// the same whatever the number of threads.
+template <class S, class F, class W, class M>
+void run_blocks(size_t nBlocks, int nthreads, F make_state, const S &zero, W work, M merge) {
+  if (nthreads <= 0) nthreads = max(1, (int)thread::hardware_concurrency());
+  nthreads = (int)min((size_t)nthreads, max(nBlocks, (size_t)1));
+
+  atomic<size_t> next(0);
+  mutex mergeMutex;
+  size_t nextMerge = 0;
+  map<size_t, S> pending;  // finished blocks waiting for an earlier one
+
+  auto loop = [&] () {
+    auto state = make_state();
+    size_t b;
+    while ( (b = next.fetch_add(1)) < nBlocks ) {
+      S sums(zero);
+      work(state, b, sums);
+
+      lock_guard<mutex> lock(mergeMutex);
+      pending.insert(make_pair(b, move(sums)));
+      while (!pending.empty() && (pending.begin()->first == nextMerge)) {
+	merge(pending.begin()->second);
+	pending.erase(pending.begin());
+	nextMerge++;
+      }
+    }
+  };
+
+  if (nthreads <= 1) loop();
+  else {
+    vector<thread> pool;
+    for (int t=0; t<nthreads; t++) pool.push_back( thread(loop) );
+    for (size_t t=0; t<pool.size(); t++) pool[t].join();
+  }
+}
+
+
+// State of a thread of run_blocks: its own copy of a batch and input and output tables for rows scenarios
+struct wobos_batch_scratch {
+  wobos_batch worker;
+  vector<double> inputs;
+  vector<double> outputs;
+
+  wobos_batch_scratch(const wobos_batch &batch, size_t rows) : worker(batch),
+    inputs(max(rows * worker.nInputs(), (size_t)1)), outputs(max(rows * worker.nOutputs(), (size_t)1)) {}
+};
+
+#endif
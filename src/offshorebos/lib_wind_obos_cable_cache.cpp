@@ -0,0 +1,155 @@
+#include "lib_wind_obos_cable_cache.h"
+
+#include <cstring>
+
+using namespace std;
+
+
+cable_choice_cache& cable_choice_cache::shared() {
+  static cable_choice_cache cache;
+  return cache;
+}
+
+
+void cable_choice_cache::make_key(int optimizer, const cable_context &c, const vector<cableFamily> &catalog, vector<double> &key) {
+  const double ctx[] = {(double)optimizer, c.fixed ? 1.0 : 0.0, c.floating ? 1.0 : 0.0,
+			c.turbR, c.nTurb, c.rotorD, c.waterD, c.distShore, c.distPort, c.arrayX, c.arrayY, c.buryDepth,
+			c.elecCont, c.pwrFac, c.buryFac, c.exCabFac, c.dynCabFac, c.systAngle, c.freeCabLeng, c.fixCabLeng,
+			c.nSubstation, c.surfLayRate, c.cabPullIn, c.cabTerm, c.cabLoadout, c.buryRate, c.subsPullIn,
+			c.shorePullIn, c.landConstruct, c.expCabLoad, c.cabSurveyCR,
+			c.arrCarouselWeight, c.arrTransitSpeed, c.arrDayRate, c.expCarouselWeight, c.expTransitSpeed, c.expDayRate};
+  size_t n = sizeof(ctx)/sizeof(double);
+  for (size_t k=0; k<catalog.size(); k++) n += 2 + 5*catalog[k].cables.size();
+  if (c.arrayLayout) n += 2 + 2*c.arrayLayout->turbines() + 2*c.arrayLayout->substations();
+  key.reserve(n);
+  key.assign(ctx, ctx + sizeof(ctx)/sizeof(double));
+
+  // Positions of the array layout, if any
+  key.push_back(c.arrayLayout ? 1.0 : 0.0);
+  if (c.arrayLayout) {
+    const wobos_array_layout &a = *c.arrayLayout;
+    key.push_back((double)a.turbines());
+    key.insert(key.end(), a.turbine_x().begin(), a.turbine_x().end());
+    key.insert(key.end(), a.turbine_y().begin(), a.turbine_y().end());
+    key.push_back((double)a.substations());
+    key.insert(key.end(), a.substation_x().begin(), a.substation_x().end());
+    key.insert(key.end(), a.substation_y().begin(), a.substation_y().end());
+  }
+
+  // Cable values the optimizers read (see cable_columns)
+  for (size_t k=0; k<catalog.size(); k++) {
+    key.push_back(catalog[k].voltage);
+    key.push_back((double)catalog[k].cables.size());
+    for (size_t i=0; i<catalog[k].cables.size(); i++) {
+      const cable &cab = catalog[k].cables[i];
+      key.push_back(cab.cost);
+      key.push_back(cab.mass);
+      key.push_back(cab.currRating);
+      key.push_back(cab.turbInterfaceCost);
+      key.push_back(cab.subsInterfaceCost);
+    }
+  }
+}
+
+
+uint64_t cable_choice_cache::hash_key(const vector<double> &key) {
+  // 64-bit FNV-1a over whole words, with a final avalanche so that the low bits used by the map mix well
+  uint64_t h = 14695981039346656037ULL;
+  for (size_t k=0; k<key.size(); k++) {
+    uint64_t bits;
+    memcpy(&bits, &key[k], sizeof(bits));
+    h = (h ^ bits) * 1099511628211ULL;
+  }
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return h;
+}
+
+
+bool cable_choice_cache::find(const vector<double> &key, cable_choice &choice) {
+  uint64_t h = hash_key(key);
+  lock_guard<mutex> guard(lock);
+  if (maxEntries == 0) return false;
+
+  unordered_map<uint64_t, list<entry>::iterator>::iterator it = index.find(h);
+  bool hit = (it != index.end()) && (it->second->key.size() == key.size()) &&
+    (memcmp(&it->second->key[0], &key[0], key.size()*sizeof(double)) == 0);
+  if (!hit) {
+    nMisses++;
+    return false;
+  }
+  nHits++;
+  entries.splice(entries.begin(), entries, it->second);
+  choice = it->second->choice;
+  return true;
+}
+
+
+void cable_choice_cache::insert(const vector<double> &key, const cable_choice &choice) {
+  uint64_t h = hash_key(key);
+  lock_guard<mutex> guard(lock);
+  if (maxEntries == 0) return;
+
+  // A different key with the same hash is replaced
+  unordered_map<uint64_t, list<entry>::iterator>::iterator it = index.find(h);
+  if (it != index.end()) {
+    it->second->key    = key;
+    it->second->choice = choice;
+    entries.splice(entries.begin(), entries, it->second);
+    return;
+  }
+
+  entry e;
+  e.hash   = h;
+  e.key    = key;
+  e.choice = choice;
+  entries.push_front(e);
+  index[h] = entries.begin();
+  evict();
+}
+
+
+void cable_choice_cache::evict() {
+  while (entries.size() > maxEntries) {
+    index.erase(entries.back().hash);
+    entries.pop_back();
+  }
+}
+
+
+void cable_choice_cache::clear() {
+  lock_guard<mutex> guard(lock);
+  entries.clear();
+  index.clear();
+  nHits = nMisses = 0;
+}
+
+
+size_t cable_choice_cache::size() {
+  lock_guard<mutex> guard(lock);
+  return entries.size();
+}
+
+
+size_t cable_choice_cache::capacity() {
+  lock_guard<mutex> guard(lock);
+  return maxEntries;
+}
+
+
+void cable_choice_cache::set_capacity(size_t n) {
+  lock_guard<mutex> guard(lock);
+  maxEntries = n;
+  evict();
+}
+
+
+void cable_choice_cache::stats(unsigned long long &hits, unsigned long long &misses) {
+  lock_guard<mutex> guard(lock);
+  hits   = nHits;
+  misses = nMisses;
+}
+
+
+cable_choice_cache::cable_choice_cache(size_t n) : maxEntries(n), nHits(0), nMisses(0) {}
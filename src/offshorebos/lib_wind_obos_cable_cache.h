@@ -0,0 +1,69 @@
+#ifndef __wind_obos_cable_cache_h
+#define __wind_obos_cable_cache_h
+
+// Process-wide memo of the cable optimizer choices.  The export and array cable optimizers pick a cable
+// (or pair of cables) from a catalog with nothing but the plant context (cable_context) and the catalog
+// itself, so the same context and catalog always give the same choice.  Sweeps that only vary other
+// inputs (e.g. cost rates outside the electrical infrastructure) then skip the optimizer after the
+// first run.  The cache is shared by all wobos objects and threads of a process and evicts the least
+// recently used choice once it holds capacity() of them; a capacity of 0 switches it off.
+//
+// Keys hold every value of the context and catalog, compared bit for bit, so a hit never differs from
+// what the optimizer would have chosen.
+
+#include "lib_wind_obos_cable_cost.h"
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+
+enum {CABLE_CACHE_EXPORT, CABLE_CACHE_ARRAY};
+
+// Catalog indices chosen by an optimizer (cabIndex2 is unused for export cables)
+struct cable_choice {
+  size_t voltIndex;
+  size_t cabIndex1;
+  size_t cabIndex2;
+};
+
+class cable_choice_cache {
+ public:
+  // Cache used by the optimizers
+  static cable_choice_cache& shared();
+
+  // Key of an optimizer (CABLE_CACHE_EXPORT or CABLE_CACHE_ARRAY) run on a context and catalog
+  static void make_key(int optimizer, const cable_context &ctx, const std::vector<cableFamily> &catalog, std::vector<double> &key);
+
+  bool find(const std::vector<double> &key, cable_choice &choice);
+  void insert(const std::vector<double> &key, const cable_choice &choice);
+
+  void clear();
+  size_t size();
+  size_t capacity();
+  void set_capacity(size_t n);
+
+  // Lookups since the last clear()
+  void stats(unsigned long long &hits, unsigned long long &misses);
+
+  cable_choice_cache(size_t n=1024);
+
+ private:
+  struct entry {
+    uint64_t hash;
+    std::vector<double> key;
+    cable_choice choice;
+  };
+
+  std::mutex lock;
+  size_t maxEntries;
+  unsigned long long nHits, nMisses;
+  std::list<entry> entries;  // most recently used first
+  std::unordered_map<uint64_t, std::list<entry>::iterator> index;
+
+  static uint64_t hash_key(const std::vector<double> &key);
+  void evict();
+};
+
+#endif
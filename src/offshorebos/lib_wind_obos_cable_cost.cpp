@@ -0,0 +1,609 @@
+#include "lib_wind_obos_cable_cost.h"
+
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+using namespace std;
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327
+#endif
+
+
+template <class T>
+export_cable_result_t<T> export_cable_cost(const cable_context_t<T> &c, T expCurrRating, T expVoltage, T expCabMass,
+					   T expSubsInterCR, T expCabCR) {
+  export_cable_result_t<T> out;
+
+  // Calculate the total number of export cables that are required based on electrical limits of the cables
+  out.nExpCab = ceil(((c.turbR*c.nTurb) / ((sqrt(3)*expCurrRating*expVoltage*c.pwrFac*(1 - (c.buryDepth - 1)*c.buryFac)) / 1000)));
+  T nExpCab = out.nExpCab;
+
+  // Calculate the export cable length in meters
+  out.expCabLeng = c.fixed ? (c.distShore * 1000 + c.waterD)*nExpCab*1.1 : (c.distShore * 1000 + c.freeCabLeng + 500)*nExpCab*1.1;
+  T expCabLeng = out.expCabLeng;
+
+  // Calculate the total cost in dollars of the export cabling including interface costs
+  out.expCabCost = c.floating ?
+    expCabCR*((expCabLeng - 500 - c.freeCabLeng) + c.dynCabFac*(500 + c.freeCabLeng)) + expSubsInterCR*nExpCab :
+    expCabCR*expCabLeng + expSubsInterCR*nExpCab;
+
+  // Calculate the mass of each section that makes up the export cable(s)
+  T expCabSecM = expCabMass*expCabLeng / nExpCab / 1000;
+
+  // Calculate the total number of cable sections per vessel trip for the export cable(s)
+  T expCabSecPerTrip = c.expCarouselWeight / expCabSecM;
+
+  // Calculate the total duration in days required to install the export cable system
+  T fac = (c.buryDepth > 0) ? 1 / c.buryRate : 0;
+  out.expInstTime = ceil(ceil((ceil(nExpCab / expCabSecPerTrip) * (c.distPort / (c.expTransitSpeed * 1.852) + c.expCabLoad) +
+			       (1 + c.exCabFac)*(c.distShore * 1000)*(1 / c.surfLayRate + fac) + (c.subsPullIn + c.shorePullIn + c.cabTerm)*nExpCab) / 24 + c.landConstruct) *
+			 (1 / (1 - c.elecCont)));
+
+  // Total cost includes material and installation costs- only used in optimization routine
+  out.totalCost = out.expInstTime*c.expDayRate + out.expCabCost + expCabLeng*c.cabSurveyCR;
+
+  return out;
+}
+
+
+// Number of turbines that can fit onto an array cable given power transfer limits
+template <class T> T array_cable_turbines(const cable_context_t<T> &c, T currRating, T arrVoltage) {
+  return floor(((sqrt(3)*currRating*arrVoltage*c.pwrFac*(1 - (c.buryDepth - 1)*c.buryFac)) / 1000) / c.turbR);
+}
+
+
+// Number of array cable sections (turbine to turbine) that fit on the cable lay vessel per trip
+template <class T> T array_cable_sections_per_trip(const cable_context_t<T> &c, T arrCabMass) {
+  //calculate the mass of each section that makes up the array cable
+  T cabSecM = c.fixed ?
+    arrCabMass * (c.arrayY*c.rotorD + c.waterD * 2)*(1 + c.exCabFac) / 1000 :
+    arrCabMass * (c.freeCabLeng * 2 + c.fixCabLeng)*(1 + c.exCabFac) / 1000;
+  return floor(c.arrCarouselWeight / cabSecM);
+}
+
+
+// Array cable counts and lengths from the strings of an array layout, the cable of every section chosen by the
+// number of turbines it carries
+template <class T> static array_cable_layout_t<T> array_layout_cables(const cable_context_t<T> &c, T nTurbCab1, T nTurbCab2) {
+  array_cable_layout_t<T> out;
+  out.max1 = out.max2 = out.fac2 = 0.0;
+
+  // No turbine fits on array cable 2: a cost that no optimizer picks, as on the grid
+  double cap = floor(primal(nTurbCab2));
+  if (!(cap >= 1.0)) {
+    const double inf = numeric_limits<double>::infinity();
+    out.fullStrings = out.nTurbPS = 0.0;
+    out.nTurbInter1 = out.nTurbInter2 = out.nSubsInter = 0.0;
+    out.cab1Leng = out.cab2Leng = out.cab2Sections = inf;
+    return out;
+  }
+  shared_ptr<const array_strings> s = c.arrayLayout->strings((size_t)min(cap, (double)c.arrayLayout->turbines()));
+  double cab1Turbines = floor(primal(nTurbCab1));
+  size_t k = (cab1Turbines <= 0.0) ? 0 : (size_t)min(cab1Turbines, (double)s->capacity);
+
+  // Sections that carry up to nTurbCab1 turbines are array cable 1, the others and every link to a substation
+  // array cable 2
+  double nStrings = (double)s->turbines.size();
+  double len1  = s->sectionLength[k];
+  double nSec1 = s->sectionCount[k];
+  double len2  = s->sectionLength[s->capacity] - len1 + s->linkLength;
+  double nSec2 = s->sectionCount[s->capacity] - nSec1;
+
+  // Down to the seabed and up at both ends of a section, or the free hanging lengths of floating turbines
+  T ends = c.fixed ? c.waterD * 2 : 2 * c.freeCabLeng - (2 * ((tan(c.systAngle*(M_PI / 180))*c.waterD) + 70));
+  out.cab1Leng = (len1 + nSec1*ends)*(1 + c.exCabFac);
+  out.cab2Leng = (len2 + (nSec2 + nStrings)*ends)*(1 + c.exCabFac);
+
+  out.fullStrings  = (double)s->fullStrings;
+  out.nTurbPS      = (double)s->partialTurbines;
+  out.nTurbInter1  = nSec1 * 2.0;
+  out.nTurbInter2  = nSec2 * 2.0 + nStrings;
+  out.nSubsInter   = nStrings;
+  out.cab2Sections = nSec2 + nStrings;
+  return out;
+}
+
+
+template <class T> array_cable_layout_t<T> calculate_array_cable_layout(const cable_context_t<T> &c, T nTurbCab1, T nTurbCab2) {
+  if (c.arrayLayout) return array_layout_cables(c, nTurbCab1, nTurbCab2);
+  array_cable_layout_t<T> out;
+
+  // Calculate the total number of full strings (string = a set of turbines that share the
+  // same electrical line back to the substation from the array)
+  out.fullStrings = floor(c.nTurb / nTurbCab2);
+  T fullStrings = out.fullStrings;
+
+  // Calculate the number of turbines on a partial string (partial string = a string that
+  // is created when the remainder of (number of turbines)/(full strings) is greater than zero
+  out.nTurbPS = fmod(c.nTurb, nTurbCab2);
+  T nTurbPS = out.nTurbPS;
+
+  // Calculate the number of turbine interfaces on array cable 1/2
+  T max1 = max(0.0, nTurbCab2 - nTurbCab1);
+  T max2 = max(0.0, nTurbPS - nTurbCab1 - 1);
+  out.nTurbInter1 = (nTurbPS == 0) ? (nTurbCab1*fullStrings)*2.0 : (nTurbCab1*fullStrings + min((nTurbPS - 1), nTurbCab1)) * 2.0;
+  out.nTurbInter2 = (max1*fullStrings + max2) * 2.0;
+  if (nTurbPS > 0.0) out.nTurbInter2 += 1.0;
+
+  // Calculate the number of array cable substation interfaces: array cable 2 is used for all runs from array to substation
+  out.nSubsInter = (nTurbPS == 0) ? fullStrings : fullStrings + 1;
+  T stringFac = (c.nSubstation > 0) ? out.nSubsInter / c.nSubstation : out.nSubsInter;
+
+  // Calculate the length of array cable 1/2 in meters
+  // TODO: THIS MAX1 FIX SEEMS LIKE A BUG
+  // TODO: The max1 and max2 do not match the document in any equation used (nTurbInter, cabLeng, arrInstTime)!
+  max1--;
+  out.cab1Leng = c.fixed ?
+    (c.arrayY*c.rotorD + c.waterD * 2)*(out.nTurbInter1 / 2)*(1 + c.exCabFac) :
+    (2 * c.freeCabLeng + c.fixCabLeng)*(out.nTurbInter1 / 2)*(1 + c.exCabFac);
+
+  out.cab2Leng = c.fixed ?
+    (((c.arrayY*c.rotorD + c.waterD * 2)*(max1*fullStrings + max2)) + c.nSubstation *
+     ((stringFac * ((c.rotorD*c.arrayY) + sqrt(pow(((c.rotorD*c.arrayX)*(stringFac - 1)), 2) + pow((c.rotorD*c.arrayY), 2)))) / 2 + stringFac*c.waterD))*(c.exCabFac + 1) :
+    (((2 * c.freeCabLeng + c.fixCabLeng)*max1*fullStrings + max2) + c.nSubstation *
+     (stringFac*((2 * c.freeCabLeng + c.fixCabLeng) + sqrt(pow(((stringFac - 1) *((2 * c.freeCabLeng) + (c.arrayX*c.rotorD) - (2 * ((tan(c.systAngle*(M_PI / 180))*c.waterD) + 70)))), 2)
+							 + pow((2 * c.freeCabLeng + c.fixCabLeng), 2)))) / 2)*(c.exCabFac + 1);
+  max1++;
+  out.max1 = max1;
+  out.max2 = max2;
+
+  //check if a partial string exists
+  out.fac2 = (nTurbPS == 0) ? (fullStrings*(fullStrings + 1)) / 2 : ((fullStrings + 1)*((fullStrings + 1) + 1)) / 2.0;
+  out.cab2Sections = out.max1*out.fullStrings + out.max2 + out.fac2;
+
+  return out;
+}
+
+
+// Cost in dollars of array cable 1 including interface costs
+template <class T> T array_cable1_cost(const cable_context_t<T> &c, const array_cable_layout_t<T> &layout, T cab1CR, T cab1TurbInterCR) {
+  return c.floating ?
+    c.dynCabFac*layout.cab1Leng*cab1CR + cab1TurbInterCR*layout.nTurbInter1 :
+    layout.cab1Leng*cab1CR + cab1TurbInterCR*layout.nTurbInter1;
+}
+
+
+// Cost in dollars of array cable 2 including interface costs
+template <class T> T array_cable2_cost(const cable_context_t<T> &c, const array_cable_layout_t<T> &layout, T cab2CR, T cab2TurbInterCR,
+				       T cab2SubsInterCR) {
+  return c.floating ?
+    c.dynCabFac*layout.cab2Leng*cab2CR + layout.nTurbInter2*cab2TurbInterCR + layout.nSubsInter*cab2SubsInterCR :
+    layout.cab2Leng*cab2CR + layout.nTurbInter2*cab2TurbInterCR + layout.nSubsInter*cab2SubsInterCR;
+}
+
+
+// Number of cable lay vessel trips for array cable 1 plus array cable 2
+template <class T> T array_cable_vessel_trips(const array_cable_layout_t<T> &layout, T cab1SecPerTrip, T cab2SecPerTrip) {
+  return ceil(((layout.nTurbInter1*0.5) / cab1SecPerTrip)) +
+    ceil((layout.cab2Sections / cab2SecPerTrip));
+}
+
+
+// Duration in days to install the array cabling, nTrips is the number of cable lay vessel trips
+template <class T> T array_cable_install_time(const cable_context_t<T> &c, const array_cable_layout_t<T> &layout, T nTrips) {
+  //check if cable is buried or not
+  T fac1 = (c.buryDepth > 0) ? 1 / c.buryRate : 0.0;
+
+  T nInter = layout.nTurbInter1 + layout.nTurbInter2 + layout.nSubsInter;
+  return ceil((1 + ((((layout.cab1Leng + layout.cab2Leng - (c.waterD*nInter)*(1 + c.exCabFac)) * (fac1 + 1 / c.surfLayRate) +
+		      (c.cabPullIn + c.cabTerm)*nInter) +
+		     nTrips * (c.cabLoadout + c.distPort / (c.arrTransitSpeed * 1.852)))*(1 / (1 - c.elecCont)) / 24)));
+}
+
+
+template <class T>
+array_cable_result_t<T> array_cable_cost(const cable_context_t<T> &c, T cab1CurrRating, T cab2CurrRating, T arrVoltage,
+					 T arrCab1Mass, T arrCab2Mass, T cab1CR, T cab2CR,
+					 T cab1TurbInterCR, T cab2TurbInterCR, T cab2SubsInterCR) {
+  array_cable_result_t<T> out;
+
+  // Calculate the number of turbines that can fit onto array cable 1/2 given power transfer limits
+  T nTurbCab1 = array_cable_turbines(c, cab1CurrRating, arrVoltage);
+  T nTurbCab2 = array_cable_turbines(c, cab2CurrRating, arrVoltage);
+
+  // String counts, interfaces and cable lengths
+  array_cable_layout_t<T> layout = calculate_array_cable_layout(c, nTurbCab1, nTurbCab2);
+  out.cab1Leng = layout.cab1Leng;
+  out.cab2Leng = layout.cab2Leng;
+
+  // Calculate the total cost in dollars of array cable 1/2 including interface costs
+  out.arrCab1Cost = array_cable1_cost(c, layout, cab1CR, cab1TurbInterCR);
+  out.arrCab2Cost = array_cable2_cost(c, layout, cab2CR, cab2TurbInterCR, cab2SubsInterCR);
+
+  // Calculate the total duration in days required to install the array cabling
+  T nTrips = array_cable_vessel_trips(layout, array_cable_sections_per_trip(c, arrCab1Mass), array_cable_sections_per_trip(c, arrCab2Mass));
+  out.arrInstTime = array_cable_install_time(c, layout, nTrips);
+
+  // Total cost includes material and installation costs- only used in optimization routine
+  out.totalCost = out.arrCab1Cost + out.arrCab2Cost + out.arrInstTime*c.arrDayRate + (out.cab1Leng + out.cab2Leng)*c.cabSurveyCR;
+
+  return out;
+}
+
+
+// Kernels used by wobos_t<double> and wobos_t<wobos_dual>
+#define WOBOS_CABLE_COST_TEMPLATES(T)					\
+  template export_cable_result_t<T> export_cable_cost(const cable_context_t<T>&, T, T, T, T, T); \
+  template array_cable_result_t<T> array_cable_cost(const cable_context_t<T>&, T, T, T, T, T, T, T, T, T, T); \
+  template T array_cable_turbines(const cable_context_t<T>&, T, T); \
+  template T array_cable_sections_per_trip(const cable_context_t<T>&, T); \
+  template array_cable_layout_t<T> calculate_array_cable_layout(const cable_context_t<T>&, T, T); \
+  template T array_cable1_cost(const cable_context_t<T>&, const array_cable_layout_t<T>&, T, T); \
+  template T array_cable2_cost(const cable_context_t<T>&, const array_cable_layout_t<T>&, T, T, T); \
+  template T array_cable_vessel_trips(const array_cable_layout_t<T>&, T, T); \
+  template T array_cable_install_time(const cable_context_t<T>&, const array_cable_layout_t<T>&, T);
+
+WOBOS_CABLE_COST_TEMPLATES(double)
+WOBOS_CABLE_COST_TEMPLATES(wobos_dual)
+#undef WOBOS_CABLE_COST_TEMPLATES
+
+
+//*******************************************************************************************
+// Evaluation of whole cable families, with SSE4.1/AVX2 versions picked at run time
+//*******************************************************************************************
+
+cable_columns::cable_columns(const cableFamily &family) {
+  voltage = family.voltage;
+  size_t n = family.cables.size();
+  cost.resize(n);
+  mass.resize(n);
+  currRating.resize(n);
+  turbInterfaceCost.resize(n);
+  subsInterfaceCost.resize(n);
+  for (size_t i=0; i<n; i++) {
+    cost[i]              = family.cables[i].cost;
+    mass[i]              = family.cables[i].mass;
+    currRating[i]        = family.cables[i].currRating;
+    turbInterfaceCost[i] = family.cables[i].turbInterfaceCost;
+    subsInterfaceCost[i] = family.cables[i].subsInterfaceCost;
+  }
+}
+
+
+void array_cable_row::resize(size_t n) {
+  cab1Leng.resize(n);
+  cab2Leng.resize(n);
+  nTurbInter1.resize(n);
+  nTurbInter2.resize(n);
+  nSubsInter.resize(n);
+  cab2Sections.resize(n);
+}
+
+
+void array_cable_row::set(size_t j, const array_cable_layout &layout) {
+  cab1Leng[j]     = layout.cab1Leng;
+  cab2Leng[j]     = layout.cab2Leng;
+  nTurbInter1[j]  = layout.nTurbInter1;
+  nTurbInter2[j]  = layout.nTurbInter2;
+  nSubsInter[j]   = layout.nSubsInter;
+  cab2Sections[j] = layout.cab2Sections;
+}
+
+
+// Candidate independent terms, grouped exactly as in export_cable_cost and array_cable_install_time
+struct cable_family_terms {
+  // Export cable
+  double expPower;      // turbR*nTurb
+  double expBuryFac;    // 1 - (buryDepth - 1)*buryFac
+  double expLengFac;    // length per export cable before the 1.1 factor
+  double expDynCost;    // dynCabFac*(500 + freeCabLeng)
+  double expTripTime;   // hours per vessel trip
+  double expLayTime;    // hours laying cable
+  double expPullTime;   // hours per cable for pull-in and termination
+  double contFac;       // 1 / (1 - elecCont)
+  // Array cable
+  double arrLayFac;     // fac1 + 1 / surfLayRate
+  double arrPullTime;   // cabPullIn + cabTerm
+  double arrTripTime;   // hours per vessel trip
+};
+
+static cable_family_terms get_family_terms(const cable_context &c) {
+  cable_family_terms t;
+  t.expPower    = c.turbR*c.nTurb;
+  t.expBuryFac  = 1 - (c.buryDepth - 1)*c.buryFac;
+  t.expLengFac  = c.fixed ? (c.distShore * 1000 + c.waterD) : (c.distShore * 1000 + c.freeCabLeng + 500);
+  t.expDynCost  = c.dynCabFac*(500 + c.freeCabLeng);
+  double fac    = (c.buryDepth > 0) ? 1 / c.buryRate : 0;
+  t.expTripTime = c.distPort / (c.expTransitSpeed * 1.852) + c.expCabLoad;
+  t.expLayTime  = (1 + c.exCabFac)*(c.distShore * 1000)*(1 / c.surfLayRate + fac);
+  t.expPullTime = c.subsPullIn + c.shorePullIn + c.cabTerm;
+  t.contFac     = 1 / (1 - c.elecCont);
+  double fac1   = (c.buryDepth > 0) ? 1 / c.buryRate : 0.0;
+  t.arrLayFac   = fac1 + 1 / c.surfLayRate;
+  t.arrPullTime = c.cabPullIn + c.cabTerm;
+  t.arrTripTime = c.cabLoadout + c.distPort / (c.arrTransitSpeed * 1.852);
+  return t;
+}
+
+
+static void export_cable_cost_family_scalar(const cable_context &c, const cable_columns &f, size_t start, size_t stop, double *totalCost) {
+  for (size_t i=start; i<stop; i++)
+    totalCost[i] = export_cable_cost(c, f.currRating[i], f.voltage, f.mass[i], f.subsInterfaceCost[i], f.cost[i]).totalCost;
+}
+
+
+static void array_cable_cost_pairs_scalar(const cable_context &c, double cab1CR, double cab1TurbInterCR, double cab1SecPerTrip,
+					  const array_cable_row &r, const cable_columns &f, const double *cab2SecPerTrip,
+					  size_t start, size_t stop, double *totalCost) {
+  array_cable_layout layout;
+  for (size_t j=start; j<stop; j++) {
+    layout.cab1Leng    = r.cab1Leng[j];
+    layout.cab2Leng    = r.cab2Leng[j];
+    layout.nTurbInter1 = r.nTurbInter1[j];
+    layout.nTurbInter2 = r.nTurbInter2[j];
+    layout.nSubsInter  = r.nSubsInter[j];
+
+    double nTrips   = ceil(((r.nTurbInter1[j]*0.5) / cab1SecPerTrip)) + ceil((r.cab2Sections[j] / cab2SecPerTrip[j]));
+    double instTime = array_cable_install_time(c, layout, nTrips);
+    totalCost[j] = array_cable1_cost(c, layout, cab1CR, cab1TurbInterCR) +
+      array_cable2_cost(c, layout, f.cost[j], f.turbInterfaceCost[j], f.subsInterfaceCost[j]) +
+      instTime*c.arrDayRate + (layout.cab1Leng + layout.cab2Leng)*c.cabSurveyCR;
+  }
+}
+
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define WOBOS_X86_SIMD
+#include <immintrin.h>
+
+// The vector versions below spell out export_cable_cost and array_cable_cost with 2 (SSE4.1) or 4 (AVX2)
+// candidates per instruction.  Keep the order of operations in step with the scalar code.
+
+__attribute__((target("avx2")))
+static void export_cable_cost_family_avx2(const cable_context &c, const cable_family_terms &t, const cable_columns &f,
+					  size_t stop, double *totalCost) {
+  const __m256d sqrt3     = _mm256_set1_pd(sqrt(3));
+  const __m256d voltage   = _mm256_set1_pd(f.voltage);
+  const __m256d pwrFac    = _mm256_set1_pd(c.pwrFac);
+  const __m256d buryFac   = _mm256_set1_pd(t.expBuryFac);
+  const __m256d power     = _mm256_set1_pd(t.expPower);
+  const __m256d lengFac   = _mm256_set1_pd(t.expLengFac);
+  const __m256d freeLeng  = _mm256_set1_pd(c.freeCabLeng);
+  const __m256d dynCost   = _mm256_set1_pd(t.expDynCost);
+  const __m256d carousel  = _mm256_set1_pd(c.expCarouselWeight);
+  const __m256d tripTime  = _mm256_set1_pd(t.expTripTime);
+  const __m256d layTime   = _mm256_set1_pd(t.expLayTime);
+  const __m256d pullTime  = _mm256_set1_pd(t.expPullTime);
+  const __m256d landTime  = _mm256_set1_pd(c.landConstruct);
+  const __m256d contFac   = _mm256_set1_pd(t.contFac);
+  const __m256d dayRate   = _mm256_set1_pd(c.expDayRate);
+  const __m256d surveyCR  = _mm256_set1_pd(c.cabSurveyCR);
+  const __m256d c1000     = _mm256_set1_pd(1000.0);
+  const __m256d c500      = _mm256_set1_pd(500.0);
+  const __m256d c24       = _mm256_set1_pd(24.0);
+  const __m256d c1p1      = _mm256_set1_pd(1.1);
+
+  for (size_t i=0; i+4<=stop; i+=4) {
+    __m256d rating = _mm256_loadu_pd(&f.currRating[i]);
+    __m256d cabCR  = _mm256_loadu_pd(&f.cost[i]);
+    __m256d subsCR = _mm256_loadu_pd(&f.subsInterfaceCost[i]);
+    __m256d mass   = _mm256_loadu_pd(&f.mass[i]);
+
+    __m256d capacity = _mm256_div_pd(_mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(sqrt3, rating), voltage), pwrFac), buryFac), c1000);
+    __m256d nExpCab  = _mm256_ceil_pd(_mm256_div_pd(power, capacity));
+    __m256d leng     = _mm256_mul_pd(_mm256_mul_pd(lengFac, nExpCab), c1p1);
+    __m256d cost     = c.floating ?
+      _mm256_add_pd(_mm256_mul_pd(cabCR, _mm256_add_pd(_mm256_sub_pd(_mm256_sub_pd(leng, c500), freeLeng), dynCost)), _mm256_mul_pd(subsCR, nExpCab)) :
+      _mm256_add_pd(_mm256_mul_pd(cabCR, leng), _mm256_mul_pd(subsCR, nExpCab));
+    __m256d secM     = _mm256_div_pd(_mm256_div_pd(_mm256_mul_pd(mass, leng), nExpCab), c1000);
+    __m256d trips    = _mm256_ceil_pd(_mm256_div_pd(nExpCab, _mm256_div_pd(carousel, secM)));
+    __m256d hours    = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(trips, tripTime), layTime), _mm256_mul_pd(pullTime, nExpCab));
+    __m256d days     = _mm256_ceil_pd(_mm256_mul_pd(_mm256_ceil_pd(_mm256_add_pd(_mm256_div_pd(hours, c24), landTime)), contFac));
+    __m256d total    = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(days, dayRate), cost), _mm256_mul_pd(leng, surveyCR));
+    _mm256_storeu_pd(&totalCost[i], total);
+  }
+}
+
+
+__attribute__((target("sse4.1")))
+static void export_cable_cost_family_sse41(const cable_context &c, const cable_family_terms &t, const cable_columns &f,
+					   size_t stop, double *totalCost) {
+  const __m128d sqrt3     = _mm_set1_pd(sqrt(3));
+  const __m128d voltage   = _mm_set1_pd(f.voltage);
+  const __m128d pwrFac    = _mm_set1_pd(c.pwrFac);
+  const __m128d buryFac   = _mm_set1_pd(t.expBuryFac);
+  const __m128d power     = _mm_set1_pd(t.expPower);
+  const __m128d lengFac   = _mm_set1_pd(t.expLengFac);
+  const __m128d freeLeng  = _mm_set1_pd(c.freeCabLeng);
+  const __m128d dynCost   = _mm_set1_pd(t.expDynCost);
+  const __m128d carousel  = _mm_set1_pd(c.expCarouselWeight);
+  const __m128d tripTime  = _mm_set1_pd(t.expTripTime);
+  const __m128d layTime   = _mm_set1_pd(t.expLayTime);
+  const __m128d pullTime  = _mm_set1_pd(t.expPullTime);
+  const __m128d landTime  = _mm_set1_pd(c.landConstruct);
+  const __m128d contFac   = _mm_set1_pd(t.contFac);
+  const __m128d dayRate   = _mm_set1_pd(c.expDayRate);
+  const __m128d surveyCR  = _mm_set1_pd(c.cabSurveyCR);
+  const __m128d c1000     = _mm_set1_pd(1000.0);
+  const __m128d c500      = _mm_set1_pd(500.0);
+  const __m128d c24       = _mm_set1_pd(24.0);
+  const __m128d c1p1      = _mm_set1_pd(1.1);
+
+  for (size_t i=0; i+2<=stop; i+=2) {
+    __m128d rating = _mm_loadu_pd(&f.currRating[i]);
+    __m128d cabCR  = _mm_loadu_pd(&f.cost[i]);
+    __m128d subsCR = _mm_loadu_pd(&f.subsInterfaceCost[i]);
+    __m128d mass   = _mm_loadu_pd(&f.mass[i]);
+
+    __m128d capacity = _mm_div_pd(_mm_mul_pd(_mm_mul_pd(_mm_mul_pd(_mm_mul_pd(sqrt3, rating), voltage), pwrFac), buryFac), c1000);
+    __m128d nExpCab  = _mm_ceil_pd(_mm_div_pd(power, capacity));
+    __m128d leng     = _mm_mul_pd(_mm_mul_pd(lengFac, nExpCab), c1p1);
+    __m128d cost     = c.floating ?
+      _mm_add_pd(_mm_mul_pd(cabCR, _mm_add_pd(_mm_sub_pd(_mm_sub_pd(leng, c500), freeLeng), dynCost)), _mm_mul_pd(subsCR, nExpCab)) :
+      _mm_add_pd(_mm_mul_pd(cabCR, leng), _mm_mul_pd(subsCR, nExpCab));
+    __m128d secM     = _mm_div_pd(_mm_div_pd(_mm_mul_pd(mass, leng), nExpCab), c1000);
+    __m128d trips    = _mm_ceil_pd(_mm_div_pd(nExpCab, _mm_div_pd(carousel, secM)));
+    __m128d hours    = _mm_add_pd(_mm_add_pd(_mm_mul_pd(trips, tripTime), layTime), _mm_mul_pd(pullTime, nExpCab));
+    __m128d days     = _mm_ceil_pd(_mm_mul_pd(_mm_ceil_pd(_mm_add_pd(_mm_div_pd(hours, c24), landTime)), contFac));
+    __m128d total    = _mm_add_pd(_mm_add_pd(_mm_mul_pd(days, dayRate), cost), _mm_mul_pd(leng, surveyCR));
+    _mm_storeu_pd(&totalCost[i], total);
+  }
+}
+
+
+__attribute__((target("avx2")))
+static void array_cable_cost_pairs_avx2(const cable_context &c, const cable_family_terms &t, double cab1CR, double cab1TurbInterCR,
+					double cab1SecPerTrip, const array_cable_row &r, const cable_columns &f,
+					const double *cab2SecPerTrip, size_t start, size_t stop, double *totalCost) {
+  const __m256d cr1       = _mm256_set1_pd(cab1CR);
+  const __m256d ti1       = _mm256_set1_pd(cab1TurbInterCR);
+  const __m256d sec1      = _mm256_set1_pd(cab1SecPerTrip);
+  const __m256d dynFac    = _mm256_set1_pd(c.dynCabFac);
+  const __m256d waterD    = _mm256_set1_pd(c.waterD);
+  const __m256d exFac     = _mm256_set1_pd(1 + c.exCabFac);
+  const __m256d layFac    = _mm256_set1_pd(t.arrLayFac);
+  const __m256d pullTime  = _mm256_set1_pd(t.arrPullTime);
+  const __m256d tripTime  = _mm256_set1_pd(t.arrTripTime);
+  const __m256d contFac   = _mm256_set1_pd(t.contFac);
+  const __m256d dayRate   = _mm256_set1_pd(c.arrDayRate);
+  const __m256d surveyCR  = _mm256_set1_pd(c.cabSurveyCR);
+  const __m256d half      = _mm256_set1_pd(0.5);
+  const __m256d one       = _mm256_set1_pd(1.0);
+  const __m256d c24       = _mm256_set1_pd(24.0);
+
+  for (size_t j=start; j+4<=stop; j+=4) {
+    __m256d leng1  = _mm256_loadu_pd(&r.cab1Leng[j]);
+    __m256d leng2  = _mm256_loadu_pd(&r.cab2Leng[j]);
+    __m256d inter1 = _mm256_loadu_pd(&r.nTurbInter1[j]);
+    __m256d inter2 = _mm256_loadu_pd(&r.nTurbInter2[j]);
+    __m256d subs   = _mm256_loadu_pd(&r.nSubsInter[j]);
+    __m256d sects2 = _mm256_loadu_pd(&r.cab2Sections[j]);
+    __m256d cr2    = _mm256_loadu_pd(&f.cost[j]);
+    __m256d ti2    = _mm256_loadu_pd(&f.turbInterfaceCost[j]);
+    __m256d si2    = _mm256_loadu_pd(&f.subsInterfaceCost[j]);
+    __m256d sec2   = _mm256_loadu_pd(&cab2SecPerTrip[j]);
+
+    __m256d cost1 = c.floating ?
+      _mm256_add_pd(_mm256_mul_pd(_mm256_mul_pd(dynFac, leng1), cr1), _mm256_mul_pd(ti1, inter1)) :
+      _mm256_add_pd(_mm256_mul_pd(leng1, cr1), _mm256_mul_pd(ti1, inter1));
+    __m256d cost2 = c.floating ?
+      _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_mul_pd(dynFac, leng2), cr2), _mm256_mul_pd(inter2, ti2)), _mm256_mul_pd(subs, si2)) :
+      _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(leng2, cr2), _mm256_mul_pd(inter2, ti2)), _mm256_mul_pd(subs, si2));
+
+    __m256d trips  = _mm256_add_pd(_mm256_ceil_pd(_mm256_div_pd(_mm256_mul_pd(inter1, half), sec1)), _mm256_ceil_pd(_mm256_div_pd(sects2, sec2)));
+    __m256d nInter = _mm256_add_pd(_mm256_add_pd(inter1, inter2), subs);
+    __m256d leng   = _mm256_add_pd(leng1, leng2);
+    __m256d hours  = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(leng, _mm256_mul_pd(_mm256_mul_pd(waterD, nInter), exFac)), layFac),
+					       _mm256_mul_pd(pullTime, nInter)), _mm256_mul_pd(trips, tripTime));
+    __m256d days   = _mm256_ceil_pd(_mm256_add_pd(one, _mm256_div_pd(_mm256_mul_pd(hours, contFac), c24)));
+    __m256d total  = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(cost1, cost2), _mm256_mul_pd(days, dayRate)), _mm256_mul_pd(leng, surveyCR));
+    _mm256_storeu_pd(&totalCost[j], total);
+  }
+}
+
+
+__attribute__((target("sse4.1")))
+static void array_cable_cost_pairs_sse41(const cable_context &c, const cable_family_terms &t, double cab1CR, double cab1TurbInterCR,
+					 double cab1SecPerTrip, const array_cable_row &r, const cable_columns &f,
+					 const double *cab2SecPerTrip, size_t start, size_t stop, double *totalCost) {
+  const __m128d cr1       = _mm_set1_pd(cab1CR);
+  const __m128d ti1       = _mm_set1_pd(cab1TurbInterCR);
+  const __m128d sec1      = _mm_set1_pd(cab1SecPerTrip);
+  const __m128d dynFac    = _mm_set1_pd(c.dynCabFac);
+  const __m128d waterD    = _mm_set1_pd(c.waterD);
+  const __m128d exFac     = _mm_set1_pd(1 + c.exCabFac);
+  const __m128d layFac    = _mm_set1_pd(t.arrLayFac);
+  const __m128d pullTime  = _mm_set1_pd(t.arrPullTime);
+  const __m128d tripTime  = _mm_set1_pd(t.arrTripTime);
+  const __m128d contFac   = _mm_set1_pd(t.contFac);
+  const __m128d dayRate   = _mm_set1_pd(c.arrDayRate);
+  const __m128d surveyCR  = _mm_set1_pd(c.cabSurveyCR);
+  const __m128d half      = _mm_set1_pd(0.5);
+  const __m128d one       = _mm_set1_pd(1.0);
+  const __m128d c24       = _mm_set1_pd(24.0);
+
+  for (size_t j=start; j+2<=stop; j+=2) {
+    __m128d leng1  = _mm_loadu_pd(&r.cab1Leng[j]);
+    __m128d leng2  = _mm_loadu_pd(&r.cab2Leng[j]);
+    __m128d inter1 = _mm_loadu_pd(&r.nTurbInter1[j]);
+    __m128d inter2 = _mm_loadu_pd(&r.nTurbInter2[j]);
+    __m128d subs   = _mm_loadu_pd(&r.nSubsInter[j]);
+    __m128d sects2 = _mm_loadu_pd(&r.cab2Sections[j]);
+    __m128d cr2    = _mm_loadu_pd(&f.cost[j]);
+    __m128d ti2    = _mm_loadu_pd(&f.turbInterfaceCost[j]);
+    __m128d si2    = _mm_loadu_pd(&f.subsInterfaceCost[j]);
+    __m128d sec2   = _mm_loadu_pd(&cab2SecPerTrip[j]);
+
+    __m128d cost1 = c.floating ?
+      _mm_add_pd(_mm_mul_pd(_mm_mul_pd(dynFac, leng1), cr1), _mm_mul_pd(ti1, inter1)) :
+      _mm_add_pd(_mm_mul_pd(leng1, cr1), _mm_mul_pd(ti1, inter1));
+    __m128d cost2 = c.floating ?
+      _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_mul_pd(dynFac, leng2), cr2), _mm_mul_pd(inter2, ti2)), _mm_mul_pd(subs, si2)) :
+      _mm_add_pd(_mm_add_pd(_mm_mul_pd(leng2, cr2), _mm_mul_pd(inter2, ti2)), _mm_mul_pd(subs, si2));
+
+    __m128d trips  = _mm_add_pd(_mm_ceil_pd(_mm_div_pd(_mm_mul_pd(inter1, half), sec1)), _mm_ceil_pd(_mm_div_pd(sects2, sec2)));
+    __m128d nInter = _mm_add_pd(_mm_add_pd(inter1, inter2), subs);
+    __m128d leng   = _mm_add_pd(leng1, leng2);
+    __m128d hours  = _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_sub_pd(leng, _mm_mul_pd(_mm_mul_pd(waterD, nInter), exFac)), layFac),
+				       _mm_mul_pd(pullTime, nInter)), _mm_mul_pd(trips, tripTime));
+    __m128d days   = _mm_ceil_pd(_mm_add_pd(one, _mm_div_pd(_mm_mul_pd(hours, contFac), c24)));
+    __m128d total  = _mm_add_pd(_mm_add_pd(_mm_add_pd(cost1, cost2), _mm_mul_pd(days, dayRate)), _mm_mul_pd(leng, surveyCR));
+    _mm_storeu_pd(&totalCost[j], total);
+  }
+}
+#endif
+
+
+static int detect_cable_simd() {
+#ifdef WOBOS_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return CABLE_SIMD_AVX2;
+  if (__builtin_cpu_supports("sse4.1")) return CABLE_SIMD_SSE41;
+#endif
+  return CABLE_SIMD_SCALAR;
+}
+
+// Atomic, so that set_cable_simd may be called while other threads run the kernels
+static atomic<int>& cable_simd() {
+  static atomic<int> level(detect_cable_simd());
+  return level;
+}
+
+int get_cable_simd() {return cable_simd();}
+
+int set_cable_simd(int level) {
+  cable_simd() = min(max(level, (int)CABLE_SIMD_SCALAR), detect_cable_simd());
+  return cable_simd().load();
+}
+
+
+void export_cable_cost_family(const cable_context &c, const cable_columns &family, double *totalCost) {
+  size_t n = family.size();
+  size_t done = 0;
+#ifdef WOBOS_X86_SIMD
+  cable_family_terms t = get_family_terms(c);
+  if (cable_simd() == CABLE_SIMD_AVX2) {
+    export_cable_cost_family_avx2(c, t, family, n, totalCost);
+    done = n - n%4;
+  }
+  else if (cable_simd() == CABLE_SIMD_SSE41) {
+    export_cable_cost_family_sse41(c, t, family, n, totalCost);
+    done = n - n%2;
+  }
+#endif
+  // Remainder that does not fill a vector
+  export_cable_cost_family_scalar(c, family, done, n, totalCost);
+}
+
+
+void array_cable_cost_pairs(const cable_context &c, double cab1CR, double cab1TurbInterCR, double cab1SecPerTrip,
+			    const array_cable_row &row, const cable_columns &family, const double *cab2SecPerTrip,
+			    size_t start, size_t stop, double *totalCost) {
+  size_t done = start;
+#ifdef WOBOS_X86_SIMD
+  cable_family_terms t = get_family_terms(c);
+  if (cable_simd() == CABLE_SIMD_AVX2) {
+    array_cable_cost_pairs_avx2(c, t, cab1CR, cab1TurbInterCR, cab1SecPerTrip, row, family, cab2SecPerTrip, start, stop, totalCost);
+    done = (stop > start) ? stop - (stop-start)%4 : start;
+  }
+  else if (cable_simd() == CABLE_SIMD_SSE41) {
+    array_cable_cost_pairs_sse41(c, t, cab1CR, cab1TurbInterCR, cab1SecPerTrip, row, family, cab2SecPerTrip, start, stop, totalCost);
+    done = (stop > start) ? stop - (stop-start)%2 : start;
+  }
+#endif
+  // Remainder that does not fill a vector
+  array_cable_cost_pairs_scalar(c, cab1CR, cab1TurbInterCR, cab1SecPerTrip, row, family, cab2SecPerTrip, done, stop, totalCost);
+}
@@ -0,0 +1,203 @@
+#ifndef __wind_obos_cable_cost_h
+#define __wind_obos_cable_cost_h
+
+// Export and array cable cost kernels.  These are free functions of an immutable plant context and a
+// candidate cable (or pair of cables): they never write to a wobos object, so the cable optimizers can
+// evaluate candidates in any order or in parallel.  wobos::calculate_export_cable_cost and
+// wobos::calculate_array_cable_cost wrap them and store the results in the class variables.
+
+#include "lib_wind_obos_cable_vessel.h"
+#include "lib_wind_obos_array_layout.h"
+#include "lib_wind_obos_dual.h"
+#include <vector>
+#include <cstddef>
+
+// Plant values that the cable costs depend on.  The kernels are templates on the scalar type so that
+// wobos_t<wobos_dual> can carry derivatives through them; they are instantiated for double and wobos_dual.
+template <class T> struct cable_context_t {
+  bool fixed;     // monopile or jacket
+  bool floating;  // spar or semisubmersible
+  T turbR;
+  T nTurb;
+  T rotorD;
+  T waterD;
+  T distShore;
+  T distPort;
+  T arrayX;
+  T arrayY;
+  T buryDepth;
+  T elecCont;
+  T pwrFac;
+  T buryFac;
+  T exCabFac;
+  T dynCabFac;
+  T systAngle;
+  T freeCabLeng;
+  T fixCabLeng;
+  T nSubstation;
+  T surfLayRate;
+  T cabPullIn;
+  T cabTerm;
+  T cabLoadout;
+  T buryRate;
+  T subsPullIn;
+  T shorePullIn;
+  T landConstruct;
+  T expCabLoad;
+  T cabSurveyCR;
+  // Cable lay vessels
+  double arrCarouselWeight;
+  double arrTransitSpeed;
+  double arrDayRate;
+  double expCarouselWeight;
+  double expTransitSpeed;
+  double expDayRate;
+  // Turbine and substation positions, NULL for the arrayX by arrayY grid
+  const wobos_array_layout *arrayLayout;
+};
+typedef cable_context_t<double> cable_context;
+
+template <class T> struct export_cable_result_t {
+  T nExpCab;
+  T expCabLeng;
+  T expCabCost;
+  T expInstTime;
+  T totalCost;    // material and installation costs, as used by the optimizer
+};
+typedef export_cable_result_t<double> export_cable_result;
+
+template <class T> struct array_cable_result_t {
+  T cab1Leng;
+  T cab2Leng;
+  T arrCab1Cost;
+  T arrCab2Cost;
+  T arrInstTime;
+  T totalCost;    // material and installation costs, as used by the optimizer
+};
+typedef array_cable_result_t<double> array_cable_result;
+
+// Array cable counts and lengths, which only depend on how many turbines fit on array cable 1 and 2
+template <class T> struct array_cable_layout_t {
+  T fullStrings;  // number of full strings
+  T nTurbPS;      // number of turbines on the partial string
+  T max1, max2;
+  T nTurbInter1;  // turbine interfaces on array cable 1
+  T nTurbInter2;  // turbine interfaces on array cable 2
+  T nSubsInter;   // substation interfaces
+  T fac2;
+  T cab1Leng;
+  T cab2Leng;
+  T cab2Sections; // sections of array cable 2 to carry, max1*fullStrings + max2 + fac2 on the grid
+};
+typedef array_cable_layout_t<double> array_cable_layout;
+
+// Plain values of a context, e.g. for the optimizers of a wobos_t<wobos_dual>
+template <class T> cable_context primal(const cable_context_t<T> &c) {
+  cable_context out;
+  out.fixed         = c.fixed;
+  out.floating      = c.floating;
+  out.turbR         = primal(c.turbR);
+  out.nTurb         = primal(c.nTurb);
+  out.rotorD        = primal(c.rotorD);
+  out.waterD        = primal(c.waterD);
+  out.distShore     = primal(c.distShore);
+  out.distPort      = primal(c.distPort);
+  out.arrayX        = primal(c.arrayX);
+  out.arrayY        = primal(c.arrayY);
+  out.buryDepth     = primal(c.buryDepth);
+  out.elecCont      = primal(c.elecCont);
+  out.pwrFac        = primal(c.pwrFac);
+  out.buryFac       = primal(c.buryFac);
+  out.exCabFac      = primal(c.exCabFac);
+  out.dynCabFac     = primal(c.dynCabFac);
+  out.systAngle     = primal(c.systAngle);
+  out.freeCabLeng   = primal(c.freeCabLeng);
+  out.fixCabLeng    = primal(c.fixCabLeng);
+  out.nSubstation   = primal(c.nSubstation);
+  out.surfLayRate   = primal(c.surfLayRate);
+  out.cabPullIn     = primal(c.cabPullIn);
+  out.cabTerm       = primal(c.cabTerm);
+  out.cabLoadout    = primal(c.cabLoadout);
+  out.buryRate      = primal(c.buryRate);
+  out.subsPullIn    = primal(c.subsPullIn);
+  out.shorePullIn   = primal(c.shorePullIn);
+  out.landConstruct = primal(c.landConstruct);
+  out.expCabLoad    = primal(c.expCabLoad);
+  out.cabSurveyCR   = primal(c.cabSurveyCR);
+  out.arrCarouselWeight = c.arrCarouselWeight;
+  out.arrTransitSpeed   = c.arrTransitSpeed;
+  out.arrDayRate        = c.arrDayRate;
+  out.expCarouselWeight = c.expCarouselWeight;
+  out.expTransitSpeed   = c.expTransitSpeed;
+  out.expDayRate        = c.expDayRate;
+  out.arrayLayout       = c.arrayLayout;
+  return out;
+}
+
+template <class T>
+export_cable_result_t<T> export_cable_cost(const cable_context_t<T> &c, T expCurrRating, T expVoltage, T expCabMass,
+					   T expSubsInterCR, T expCabCR);
+
+template <class T>
+array_cable_result_t<T> array_cable_cost(const cable_context_t<T> &c, T cab1CurrRating, T cab2CurrRating, T arrVoltage,
+					 T arrCab1Mass, T arrCab2Mass, T cab1CR, T cab2CR,
+					 T cab1TurbInterCR, T cab2TurbInterCR, T cab2SubsInterCR);
+
+// Building blocks of array_cable_cost, for optimizers that reuse terms across candidates.  With an arrayLayout,
+// calculate_array_cable_layout takes the lengths and interfaces from its strings (see lib_wind_obos_array_layout.h):
+// sections that carry at most nTurbCab1 turbines are array cable 1, the others and the links to the
+// substations array cable 2.  fullStrings and nTurbPS count the full strings and the turbines on the others;
+// max1, max2 and fac2 are 0.
+template <class T> T array_cable_turbines(const cable_context_t<T> &c, T currRating, T arrVoltage);
+template <class T> T array_cable_sections_per_trip(const cable_context_t<T> &c, T arrCabMass);
+template <class T> array_cable_layout_t<T> calculate_array_cable_layout(const cable_context_t<T> &c, T nTurbCab1, T nTurbCab2);
+template <class T> T array_cable1_cost(const cable_context_t<T> &c, const array_cable_layout_t<T> &layout, T cab1CR, T cab1TurbInterCR);
+template <class T> T array_cable2_cost(const cable_context_t<T> &c, const array_cable_layout_t<T> &layout, T cab2CR, T cab2TurbInterCR,
+				       T cab2SubsInterCR);
+template <class T> T array_cable_vessel_trips(const array_cable_layout_t<T> &layout, T cab1SecPerTrip, T cab2SecPerTrip);
+template <class T> T array_cable_install_time(const cable_context_t<T> &c, const array_cable_layout_t<T> &layout, T nTrips);
+
+
+// Structure-of-arrays copy of a cableFamily, so that every cable in a family can be evaluated at once
+struct cable_columns {
+  double voltage;
+  std::vector<double> cost;
+  std::vector<double> mass;
+  std::vector<double> currRating;
+  std::vector<double> turbInterfaceCost;
+  std::vector<double> subsInterfaceCost;
+
+  size_t size() const {return cost.size();}
+  cable_columns(const cableFamily &family);
+};
+
+// Layout terms for one array cable 1 against every array cable 2 candidate of a family
+struct array_cable_row {
+  std::vector<double> cab1Leng;
+  std::vector<double> cab2Leng;
+  std::vector<double> nTurbInter1;
+  std::vector<double> nTurbInter2;
+  std::vector<double> nSubsInter;
+  std::vector<double> cab2Sections;  // the sections of array cable 2 to carry
+
+  void resize(size_t n);
+  void set(size_t j, const array_cable_layout &layout);
+};
+
+// Total cost (as export_cable_cost) of every cable in the family
+void export_cable_cost_family(const cable_context &c, const cable_columns &family, double *totalCost);
+
+// Total cost (as array_cable_cost) of one array cable 1 paired with the array cable 2 candidates start to stop-1
+// of the family.  totalCost, cab2SecPerTrip and the row are indexed by the array cable 2 candidate.
+void array_cable_cost_pairs(const cable_context &c, double cab1CR, double cab1TurbInterCR, double cab1SecPerTrip,
+			    const array_cable_row &row, const cable_columns &family, const double *cab2SecPerTrip,
+			    size_t start, size_t stop, double *totalCost);
+
+// Instruction set used by the family/pair evaluators above.  The best one the processor supports is picked
+// at run time; set_cable_simd can lower it (e.g. for comparisons) and returns the level actually in use.
+// All levels perform the same floating point operations in the same order, so results are identical.
+enum {CABLE_SIMD_SCALAR, CABLE_SIMD_SSE41, CABLE_SIMD_AVX2};
+int get_cable_simd();
+int set_cable_simd(int level);
+
+#endif
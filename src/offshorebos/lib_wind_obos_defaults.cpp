@@ -7,14 +7,20 @@
 #include <fstream>
 #include <sstream>
 #include <regex>
+#include <cmath>
+#include <cstdlib>
 
 using namespace std;
 
-double dnull = -99999.0;
+// Marks variables without a numeric value; read-only, so wobos objects on different threads can share it
+static const double dnull = -99999.0;
+
+// Uses dnull for values that are not numbers
+#include "lib_wind_obos_defaults_table.h"
 
 
 // Helper for string parsing
-string trim(const string& str, const string& whitespace = "# \t") {
+string trim(const string& str, const string& whitespace = "# \t\r") {
     const auto strBegin = str.find_first_not_of(whitespace);
     if (strBegin == std::string::npos) return ""; // no content
     const auto strEnd   = str.find_last_not_of(whitespace);
@@ -34,16 +40,16 @@ public:
     string line, cell;
     getline(str, line);
 
-    // Truncate line after comment character
-    string::size_type n = line.find("#");
-    if (n != string::npos) line.erase(n);
+    // Skip comment lines, which start with '#' as in make_defaults_table.py; '#' anywhere else is text, as in
+    // the descriptions "Array Cable #1 Length" and "Array Cable #2 Length"
+    if (trim(line, " \t\r").compare(0, 1, "#") == 0) line.clear();
 
     stringstream lineStream(line);
 
     m_data.clear();
     while(getline(lineStream, cell, ',')) {
       // Cleanup entry: remove leading and trailing spaces
-      string myString = trim(cell);
+      string myString = trim(cell, " \t\r");
       // For data field, use all caps
       if (m_data.size() >= 4)
 	std::transform(myString.begin(), myString.end(), myString.begin(), ::toupper);
@@ -81,18 +87,36 @@ variable::variable(vector<string> indata) {
   constraints = regex_replace(indata[6],regex("_"),",");
 }
 
-bool variable::isInput() {return (inout==INPUT);}
-bool variable::isOutput() {return (inout==OUTPUT);}
-bool variable::isDouble() {return (value!=dnull);}
+// Built-in rows are parsed already
+variable::variable(const variable_row &row) : inout(row.inout), name(row.name), description(row.description),
+  units_openmdao(row.units_openmdao), units_sam(row.units_sam), value(row.value), valueStr(row.valueStr),
+  constraints(row.constraints) {}
+
+bool variable::isInput() const {return (inout==INPUT);}
+bool variable::isOutput() const {return (inout==OUTPUT);}
+bool variable::isDouble() const {return (value!=dnull);}
 
 
 
 
-// Default constructor loads values from text file
+// Default constructor uses the table generated from wind_obos_defaults.csv at build time
 wind_obos_defaults::wind_obos_defaults() {
+  variables.reserve(NDEFAULTS);
+  for (int i=0; i<NDEFAULTS; i++)
+    variables.push_back( variable(wobos_defaults_table[i]) );
+}
+
+
+// Start from the built-in table and apply the entries in a csv-file on top
+wind_obos_defaults::wind_obos_defaults(const string &fname) : wind_obos_defaults() {
+  load(fname);
+}
 
+
+void wind_obos_defaults::load(const string &fname) {
   // File with variable defaults listed
-  ifstream infile("wind_obos_defaults.csv"); //.dat
+  ifstream infile(fname.c_str());
+  if (!infile.is_open()) throw runtime_error("Cannot open wind_obos defaults file: " + fname);
 
   // Read in row by row
   CSVRow row;
@@ -100,6 +124,27 @@ wind_obos_defaults::wind_obos_defaults() {
     // Check for empty or improper lines
     if (row.size() != 7) continue;
 
-    variables.push_back( variable(row.get()) );
+    variable newvar(row.get());
+    size_t k;
+    for (k=0; k<variables.size(); k++)
+      if (variables[k].name == newvar.name) break;
+    if (k < variables.size()) variables[k] = newvar;
+    else variables.push_back(newvar);
   }
 }
+
+
+const wind_obos_defaults& wind_obos_defaults::instance() {
+  // Function-local static, so initialization is thread-safe and happens only once per process
+  static const wind_obos_defaults defaults = [] () {
+    const char* fname = getenv("WIND_OBOS_DEFAULTS");
+    if (fname == NULL || fname[0] == '\0') return wind_obos_defaults();
+    try {
+      return wind_obos_defaults(string(fname));
+    } catch(exception& e) {
+      cout << e.what() << ", using built-in defaults" << endl;
+      return wind_obos_defaults();
+    }
+  }();
+  return defaults;
+}
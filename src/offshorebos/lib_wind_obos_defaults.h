@@ -6,6 +6,17 @@
 
 enum {INPUT, OUTPUT};
 
+// A row of the table compiled into the library, parsed when it was generated (see make_defaults_table.py)
+struct variable_row {
+  int inout;
+  const char *name;
+  const char *description;
+  const char *units_openmdao;
+  const char *units_sam;
+  double value;
+  const char *valueStr;
+  const char *constraints;
+};
 
 class variable {
  public:
@@ -19,15 +30,28 @@ class variable {
   std::string constraints;
   
   variable(std::vector<std::string> indata);
-  bool isInput();
-  bool isOutput();
-  bool isDouble();
+  variable(const variable_row &row);
+  bool isInput() const;
+  bool isOutput() const;
+  bool isDouble() const;
 };
 
+// Variable defaults.  The values in wind_obos_defaults.csv are compiled into the library (see
+// make_defaults_table.py), so no file has to be found or parsed at run time.  Setting the environment
+// variable WIND_OBOS_DEFAULTS to a csv-file in the same format overrides individual entries.
 class wind_obos_defaults {
  public:
   std::vector<variable> variables;
+
+  // Process-wide defaults (compiled-in table plus any override file), built once on first use
+  static const wind_obos_defaults& instance();
+
+  // Update or add the entries listed in a csv-file, throws if the file cannot be read
+  void load(const std::string &fname);
+
+  // Constructors
   wind_obos_defaults();
+  wind_obos_defaults(const std::string &fname);
 };
 
 #endif
@@ -0,0 +1,271 @@
+// Generated by make_defaults_table.py from wind_obos_defaults.csv, do not edit by hand
+// Columns: IN/OUT, Variable, Description, Units (OpenMDAO), Units (SAM), Value, Value as text, Constraints
+#define NDEFAULTS 266
+static const variable_row wobos_defaults_table[NDEFAULTS] = {
+  {INPUT, "turbCapEx", "Turbine Capital Cost", "USD/kW", "$/KW", 1605.0, "1605", ""},
+  {INPUT, "nTurb", "Number of Turbines", "", "", 20.0, "20", "MIN=2,MAX=200"},
+  {INPUT, "turbR", "Turbine Rating", "MW", "MW", 5.0, "5", "MIN=1,MAX=10"},
+  {INPUT, "rotorD", "Rotor Diameter", "m", "M", 120.0, "120", ""},
+  {INPUT, "hubH", "Hub Height", "m", "M", 90.0, "90", ""},
+  {INPUT, "waterD", "Max Water Depth", "m", "M", 30.0, "30", "MIN=3,MAX=1000"},
+  {INPUT, "distShore", "Distance to Landfall", "km", "KM", 90.0, "90", "MIN=5,MAX=1000"},
+  {INPUT, "distPort", "Distance from Installation Port to Site", "km", "KM", 90.0, "90", "MIN=5,MAX=1000"},
+  {INPUT, "distPtoA", "Distance from Installation Port to Inshore Assembly Area", "km", "KM", 90.0, "90", "MIN=5,MAX=1000"},
+  {INPUT, "distAtoS", "Distance form Inshore Assembly Area to Site", "km", "KM", 90.0, "90", "MIN=5,MAX=1000"},
+  {INPUT, "substructure", "Substructure Type", "", "", dnull, "MONOPILE", "INTEGER"},
+  {INPUT, "anchor", "Anchor Type", "", "", dnull, "DRAGEMBEDMENT", "INTEGER"},
+  {INPUT, "turbInstallMethod", "Turbine Installation Method", "", "", dnull, "INDIVIDUAL", "INTEGER"},
+  {INPUT, "towerInstallMethod", "Tower Installation Method", "", "", dnull, "ONEPIECE", "INTEGER"},
+  {INPUT, "installStrategy", "Installation Vessel Strategy", "", "", dnull, "PRIMARYVESSEL", "INTEGER"},
+  {INPUT, "cableOptimizer", "Electrical Cable Cost Optimization", "", "", dnull, "FALSE", "INTEGER"},
+  {INPUT, "installSimulation", "Simulate Installation Schedule", "", "", dnull, "FALSE", "INTEGER"},
+  {INPUT, "moorLines", "Number Of Mooring Lines", "", "", 3.0, "3", ""},
+  {INPUT, "buryDepth", "Electrical Cable Burial Depth", "m", "M", 2.0, "2", "MIN=0,MAX=15"},
+  {INPUT, "arrayY", "Spacing Between Turbines in Rows", "rotor diameters", "ROTOR DIAMETERS", 9.0, "9", "MIN=1"},
+  {INPUT, "arrayX", "Spacing Between Turbine Rows", "rotor diameters", "ROTOR DIAMETERS", 9.0, "9", "MIN=1"},
+  {INPUT, "substructCont", "Substructure Install Weather Contingency", "", "%", 0.3, "0.3", ""},
+  {INPUT, "turbCont", "Turbine Install Weather Contingency", "", "%", 0.3, "0.3", ""},
+  {INPUT, "elecCont", "Electrical Install Weather Contingency", "", "%", 0.3, "0.3", ""},
+  {INPUT, "interConVolt", "Grid Interconnect Voltage", "kV", "KV", 345.0, "345", ""},
+  {INPUT, "distInterCon", "Distance Over Land to Grid Interconnect", "miles", "MILES", 3.0, "3", ""},
+  {INPUT, "scrapVal", "Total Scrap Value of Decommissioned Components", "USD", "$", 0.0, "0", ""},
+  {INPUT, "projLife", "Project Economic Life", "year", "YEARS", 20.0, "20", ""},
+  {INPUT, "inspectClear", "Inspection Clearance", "m", "M", 2.0, "2", ""},
+  {INPUT, "plantComm", "Plant Commissioning Cost Factor", "", "", 0.01, "0.01", ""},
+  {INPUT, "procurement_contingency", "Procurement Contingency", "", "", 0.05, "0.05", ""},
+  {INPUT, "install_contingency", "Installation Contingency", "", "", 0.3, "0.3", ""},
+  {INPUT, "construction_insurance", "Insurance During Construction (% of ICC)", "", "", 0.01, "0.01", ""},
+  {INPUT, "capital_cost_year_0", "Capital cost spent in year 0", "", "", 0.2, "0.2", ""},
+  {INPUT, "capital_cost_year_1", "Capital cost spent in year 1", "", "", 0.6, "0.6", ""},
+  {INPUT, "capital_cost_year_2", "Capital cost spent in year 2", "", "", 0.1, "0.1", ""},
+  {INPUT, "capital_cost_year_3", "Capital cost spent in year 3", "", "", 0.1, "0.1", ""},
+  {INPUT, "capital_cost_year_4", "Capital cost spent in year 4", "", "", 0.0, "0", ""},
+  {INPUT, "capital_cost_year_5", "Capital cost spent in year 5", "", "", 0.0, "0", ""},
+  {INPUT, "tax_rate", "Effective Tax Rate", "", "", 0.4, "0.4", ""},
+  {INPUT, "interest_during_construction", "Interest During Construction", "", "", 0.08, "0.08", ""},
+  {INPUT, "mpileCR", "Monopile Cost Rate", "USD/t", "$/TONNE", 2250.0, "2250", ""},
+  {INPUT, "mtransCR", "Monopile Transition Piece Cost Rate", "USD/t", "$/TONNE", 3230.0, "3230", ""},
+  {INPUT, "mpileD", "Monopile Diameter", "m", "M", 0.0, "0", "MIN=0.01"},
+  {INPUT, "mpileL", "Monopile Length", "m", "M", 0.0, "0", "MIN=0.01"},
+  {INPUT, "mpEmbedL", "Monopile Embedment Length", "m", "M", 30.0, "30", ""},
+  {INPUT, "jlatticeCR", "Jacket Main Lattice Cost Rate", "USD/t", "$/TONNE", 4680.0, "4680", ""},
+  {INPUT, "jtransCR", "Jacket Transition Piece Cost Rate", "USD/t", "$/TONNE", 4500.0, "4500", ""},
+  {INPUT, "jpileCR", "Jacket Pile Cost Rate", "USD/t", "$/TONNE", 2250.0, "2250", ""},
+  {INPUT, "jlatticeA", "Jacket Main Lattice Footprint Area", "m**2", "M^2", 26.0, "26", ""},
+  {INPUT, "jpileL", "Jacket Pile Length", "m", "M", 47.5, "47.5", ""},
+  {INPUT, "jpileD", "Jacket Pile Diameter", "m", "M", 1.6, "1.6", ""},
+  {INPUT, "spStifColCR", "Spar Stiffened Column Cost Rate", "USD/t", "$/TONNE", 3120.0, "3120", ""},
+  {INPUT, "spTapColCR", "Spar Tapered Column Cost Rate", "USD/t", "$/TONNE", 4220.0, "4220", ""},
+  {INPUT, "ballCR", "Floating Ballast Cost Rate", "USD/t", "$/TONNE", 100.0, "100", ""},
+  {INPUT, "deaFixLeng", "Fixed Mooring Length for Drag Embedment Anchors", "m", "M", 500.0, "500", ""},
+  {INPUT, "ssStifColCR", "Semi-submersible Stiffened Column Cost Rate", "USD/t", "$/TONNE", 3120.0, "3120", ""},
+  {INPUT, "ssTrussCR", "Semi-submersible Truss Cost Rate", "USD/t", "$/TONNE", 6250.0, "6250", ""},
+  {INPUT, "ssHeaveCR", "Semi-submersible Heave Plate Cost Rate", "USD/t", "$/TONNE", 6250.0, "6250", ""},
+  {INPUT, "sSteelCR", "Secondary/Outfitting Steel Cost Rate", "USD/t", "$/TONNE", 7250.0, "7250", ""},
+  {INPUT, "moorDia", "Mooring Line Diameter", "m", "M", 0.0, "0", "MIN=0.09"},
+  {INPUT, "moorCR", "Mooring Line Cost Rate", "USD/m", "$/M", 0.0, "0", "MIN=399"},
+  {INPUT, "scourMat", "Scour Protection Material Cost", "USD/location", "$/LOCATION", 250000.0, "250000", ""},
+  {INPUT, "number_install_seasons", "Number of Installation Seasons", "", "", 1.0, "1", ""},
+  {INPUT, "installSeasonLength", "Installation Season Length", "d", "DAYS", 0.0, "0", "MIN=0"},
+  {INPUT, "installStartHour", "Installation Start Hour in Site Weather", "h", "HOURS", 0.0, "0", "MIN=0"},
+  {INPUT, "pwrFac", "Power Transfer Efficiency Factor", "", "", 0.95, "0.95", ""},
+  {INPUT, "buryFac", "Cable Burial Depth Factor", "1/m", "1/M", 0.1, "0.1", ""},
+  {INPUT, "catLengFac", "Catenary Cable Length Factor", "", "", 0.04, "0.04", ""},
+  {INPUT, "exCabFac", "Excess Cable Factor", "", "", 0.1, "0.1", ""},
+  {INPUT, "subsTopFab", "Offshore Substation Fabrication Cost", "USD/t", "$/TONNE", 14500.0, "14500", ""},
+  {INPUT, "subsTopDes", "Offshore Substation Design Cost", "USD", "$", 4500000.0, "4500000", ""},
+  {INPUT, "topAssemblyFac", "Offshore Substation Land-based Assembly Factor", "", "", 0.075, "0.075", ""},
+  {INPUT, "subsJackCR", "Offshore Substation Jacket Lattice Cost Rate", "USD/t", "$/TONNE", 6250.0, "6250", ""},
+  {INPUT, "subsPileCR", "Offshore Substation Jacket Pile Cost Rate", "USD/t", "$/TONNE", 2250.0, "2250", ""},
+  {INPUT, "dynCabFac", "Dynamic Cable Cost Premium Factor", "", "", 2.0, "2", ""},
+  {INPUT, "shuntCR", "Shunt Reactor Cost Rate", "USD/MVA", "$/MVA", 35000.0, "35000", ""},
+  {INPUT, "highVoltSG", "High Voltage Switchgear Cost", "USD", "$", 950000.0, "950000", ""},
+  {INPUT, "medVoltSG", "Medium Voltage Switchgear Cost", "USD", "$", 500000.0, "500000", ""},
+  {INPUT, "backUpGen", "Back up Diesel Generator Cost", "USD", "$", 1000000.0, "1000000", ""},
+  {INPUT, "workSpace", "Offshore Substation Workspace & Accommodations Cost", "USD", "$", 2000000.0, "2000000", ""},
+  {INPUT, "otherAncillary", "Other Ancillary Systems Costs", "USD", "$", 3000000.0, "3000000", ""},
+  {INPUT, "mptCR", "Main Power Transformer Cost Rate", "USD/MVA", "$/MVA", 12500.0, "12500", ""},
+  {INPUT, "arrVoltage", "Array cable voltage", "kV", "KV", 33.0, "33", ""},
+  {INPUT, "cab1CR", "Array cable 1 Cost Rate", "USD/m", "$/M", 185.889, "185.889", ""},
+  {INPUT, "cab2CR", "Array cable 2 Cost Rate", "USD/m", "$/M", 202.788, "202.788", ""},
+  {INPUT, "cab1CurrRating", "Array cable 1 current rating", "A", "A", 300.0, "300", ""},
+  {INPUT, "cab2CurrRating", "Array cable 2 current rating", "A", "A", 340.0, "340", ""},
+  {INPUT, "arrCab1Mass", "Array cable 1 mass", "kg/m", "KG/M", 20.384, "20.384", ""},
+  {INPUT, "arrCab2Mass", "Array cable 2 mass", "kg/m", "KG/M", 21.854, "21.854", ""},
+  {INPUT, "cab1TurbInterCR", "Cable 1 turbine interface cost", "USD/interface", "$/INTERFACE", 8410.0, "8410", ""},
+  {INPUT, "cab2TurbInterCR", "Cable 2 turbine interface cost", "USD/interface", "$/INTERFACE", 8615.0, "8615", ""},
+  {INPUT, "cab2SubsInterCR", "Cable 2 substation interface cost", "USD/interface", "$/INTERFACE", 19815.0, "19815", ""},
+  {INPUT, "expVoltage", "Export cable voltage", "kV", "KV", 220.0, "220", ""},
+  {INPUT, "expCurrRating", "Export cable current rating", "A", "A", 530.0, "530", ""},
+  {INPUT, "expCabMass", "Export cable mass", "kg/m", "KG/M", 71.9, "71.9", ""},
+  {INPUT, "expCabCR", "Export cable cost rate", "USD/m", "$/M", 495.411, "495.411", ""},
+  {INPUT, "expSubsInterCR", "Export cable substation interface cost", "USD/interface", "$/INTERFACE", 57500.0, "57500", ""},
+  {INPUT, "arrayCables", "Inter-array cables to consider by voltage", "kV", "KV", 33.0, "33 66", ""},
+  {INPUT, "exportCables", "Export cables to consider by voltage", "kV", "KV", 132.0, "132 220", ""},
+  {INPUT, "moorTimeFac", "Anchor & Mooring Water Depth Time Factor", "", "", 0.005, "0.005", ""},
+  {INPUT, "moorLoadout", "Anchor & Mooring Loadout Time", "h", "HOURS", 5.0, "5", ""},
+  {INPUT, "moorSurvey", "Survey Mooring Lines & Anchor Positions Time", "h", "HOURS", 4.0, "4", ""},
+  {INPUT, "prepAA", "Prepare Inshore Assembly Area For Turbine Installation", "h", "HOURS", 168.0, "168", ""},
+  {INPUT, "prepSpar", "Prepare Spar for Tow to Inshore Assembly Area", "h", "HOURS", 18.0, "18", ""},
+  {INPUT, "upendSpar", "Upend and Ballast Spar", "h", "HOURS", 36.0, "36", ""},
+  {INPUT, "prepSemi", "Prepare Semi-submersible for Turbine Installation", "h", "HOURS", 12.0, "12", ""},
+  {INPUT, "turbFasten", "Prepare and Fasten Turbine for Transport", "h/turbine", "HOURS/TURBINE", 8.0, "8", ""},
+  {INPUT, "boltTower", "Lift and Bolt Tower Section", "h", "HOURS", 7.0, "7", ""},
+  {INPUT, "boltNacelle1", "Lift and Bolt Nacelle Individual Components Method", "h", "HOURS", 7.0, "7", ""},
+  {INPUT, "boltNacelle2", "Lift and Bolt Nacelle Bunny Ears Method", "h", "HOURS", 7.0, "7", ""},
+  {INPUT, "boltNacelle3", "Lift and Bolt Nacelle Fully Assembled Rotor Method", "h", "HOURS", 7.0, "7", ""},
+  {INPUT, "boltBlade1", "Lift and Bolt Blade Individual Components Method", "h", "HOURS", 3.5, "3.5", ""},
+  {INPUT, "boltBlade2", "Lift and Bolt Blade Bunny Ears Method", "h", "HOURS", 3.5, "3.5", ""},
+  {INPUT, "boltRotor", "Lift and Bolt Rotor Fully Assembled Rotor Method", "h", "HOURS", 7.0, "7", ""},
+  {INPUT, "vesselPosTurb", "Vessel Positioning Time Turbine Installation", "h", "HOURS", 2.0, "2", ""},
+  {INPUT, "vesselPosJack", "Vessel Positioning Time Jacket Installation", "h", "HOURS", 8.0, "8", ""},
+  {INPUT, "vesselPosMono", "Vessel Positioning Time Monopile Installation", "h", "HOURS", 3.0, "3", ""},
+  {INPUT, "subsVessPos", "Vessel Positioning Time Offshore Substation Installation", "h", "HOURS", 6.0, "6", ""},
+  {INPUT, "monoFasten", "Prepare and Fasten Monopile for Transport", "h/unit", "HOURS/UNIT", 12.0, "12", ""},
+  {INPUT, "jackFasten", "Prepare and Fasten Jacket for Transport", "h/unit", "HOURS/UNIT", 20.0, "20", ""},
+  {INPUT, "prepGripperMono", "Prepare Monopile Gripper and Upender", "h", "HOURS", 1.5, "1.5", ""},
+  {INPUT, "prepGripperJack", "Prepare Jacket Gripper and Upender", "h", "HOURS", 8.0, "8", ""},
+  {INPUT, "placePiles", "Place Jacket Piles", "h", "HOURS", 12.0, "12", ""},
+  {INPUT, "prepHamMono", "Prepare Hammer for Monopile Installation", "h", "HOURS", 2.0, "2", ""},
+  {INPUT, "prepHamJack", "Prepare Hammer for jacket Piles Installation", "h", "HOURS", 2.0, "2", ""},
+  {INPUT, "removeHamMono", "Remove Hammer for Monopile Installation", "h", "HOURS", 2.0, "2", ""},
+  {INPUT, "removeHamJack", "Remove Hammer for Jacket Piles Installation", "h", "HOURS", 4.0, "4", ""},
+  {INPUT, "placeTemplate", "Place Jacket Pile Template on Seabed", "h", "HOURS", 4.0, "4", ""},
+  {INPUT, "placeJack", "Place Jacket Main Lattice onto Piles", "h", "HOURS", 12.0, "12", ""},
+  {INPUT, "levJack", "Level Jacket Main Lattice", "h", "HOURS", 24.0, "24", ""},
+  {INPUT, "hamRate", "Pile Hammer Rate", "m/h", "M/HOUR", 20.0, "20", ""},
+  {INPUT, "placeMP", "Lift and Place Monopile for Hammering", "h", "HOURS", 3.0, "3", ""},
+  {INPUT, "instScour", "Install Scour Protection Around Monopile Base", "h", "HOURS", 6.0, "6", ""},
+  {INPUT, "placeTP", "Place Transition Piece onto Monopile", "h", "HOURS", 3.0, "3", ""},
+  {INPUT, "groutTP", "Grout Transition Piece/Monopile Interface", "h", "HOURS", 8.0, "8", ""},
+  {INPUT, "tpCover", "Install Transition Piece Cover", "h", "HOURS", 1.5, "1.5", ""},
+  {INPUT, "prepTow", "Prepare Floating Substructure for Tow to Site", "h", "HOURS", 12.0, "12", ""},
+  {INPUT, "spMoorCon", "Connect Mooring Lines to Spar", "h", "HOURS", 20.0, "20", ""},
+  {INPUT, "ssMoorCon", "Connect Mooring Lines to Semi-Submersible", "h", "HOURS", 22.0, "22", ""},
+  {INPUT, "spMoorCheck", "Survey Spar Mooring Lines and Connections", "h", "HOURS", 16.0, "16", ""},
+  {INPUT, "ssMoorCheck", "Survey Semi-submersible Mooing Lines and Connections", "h", "HOURS", 12.0, "12", ""},
+  {INPUT, "ssBall", "Ballast Semi-submersible", "h", "HOURS", 6.0, "6", ""},
+  {INPUT, "surfLayRate", "Cable Surface Lay Rate", "m/h", "M/HOUR", 375.0, "375", ""},
+  {INPUT, "cabPullIn", "Array Cable Pull in to Interfaces", "h", "HOURS", 5.5, "5.5", ""},
+  {INPUT, "cabTerm", "Cable Termination and Testing", "h", "HOURS", 5.5, "5.5", ""},
+  {INPUT, "cabLoadout", "Array Cable Loadout for Installation", "h", "HOURS", 14.0, "14", ""},
+  {INPUT, "buryRate", "Cable Burial Rate", "m/h", "M/HOUR", 125.0, "125", ""},
+  {INPUT, "subsPullIn", "Cable Pull in to Offshore Substation", "h", "HOURS", 48.0, "48", ""},
+  {INPUT, "shorePullIn", "Cable Pull in to Onshore Infrastructure", "h", "HOURS", 96.0, "96", ""},
+  {INPUT, "landConstruct", "Onshore Infrastructure Construction", "d", "DAYS", 7.0, "7", ""},
+  {INPUT, "expCabLoad", "Export Cable Loadout for Installation", "h", "HOURS", 24.0, "24", ""},
+  {INPUT, "subsLoad", "Offshore Substation Loadout for Installation", "h", "HOURS", 60.0, "60", ""},
+  {INPUT, "placeTop", "Lift and Place Offshore Substation Topside", "h", "HOURS", 24.0, "24", ""},
+  {INPUT, "pileSpreadDR", "Piling Spread Day Rate", "USD/day", "$/DAY", 2500.0, "2500", ""},
+  {INPUT, "pileSpreadMob", "Piling Spread Mobilization Cost", "USD", "$", 750000.0, "750000", ""},
+  {INPUT, "groutSpreadDR", "Grouting Spread Day Rate", "USD/day", "$/DAY", 3000.0, "3000", ""},
+  {INPUT, "groutSpreadMob", "Grouting Spread Mobilization Cost", "USD", "$", 1000000.0, "1000000", ""},
+  {INPUT, "seaSpreadDR", "Suction Pile Anchor Spread Day Rate", "USD/day", "$/DAY", 165000.0, "165000", ""},
+  {INPUT, "seaSpreadMob", "Suction Pile Anchor Spread Mobilization Cost", "USD", "$", 4500000.0, "4500000", ""},
+  {INPUT, "compRacks", "Component Racks Cost", "USD", "$", 1000000.0, "1000000", ""},
+  {INPUT, "cabSurveyCR", "Cable Route Survey Cost", "USD/m", "$/M", 240.0, "240", ""},
+  {INPUT, "cabDrillDist", "Horizontal Drilling distance for Cable Landfall", "m", "M", 500.0, "500", ""},
+  {INPUT, "cabDrillCR", "Cost Rate for Horizontal Drilling", "USD/m", "$/M", 3200.0, "3200", ""},
+  {INPUT, "mpvRentalDR", "MPV Rental Day Rate", "USD/day", "$/DAY", 72000.0, "72000", ""},
+  {INPUT, "diveTeamDR", "Cable Landfall Dive Team Day Rate", "USD/day", "$/DAY", 3200.0, "3200", ""},
+  {INPUT, "winchDR", "Cable Landfall Winch Day Rate", "USD/day", "$/DAY", 1000.0, "1000", ""},
+  {INPUT, "civilWork", "Onshore Infrastructure Civil Work Cost", "USD", "$", 40000.0, "40000", ""},
+  {INPUT, "elecWork", "Onshore Infrastructure Electrical Work Cost", "USD", "$", 25000.0, "25000", ""},
+  {INPUT, "nCrane600", "Number of 600 t Crawler Cranes", "", "", 0.0, "0", ""},
+  {INPUT, "nCrane1000", "Number of 1000 t Crawler Cranes", "", "", 0.0, "0", ""},
+  {INPUT, "crane600DR", "600 t Crawler Crane Day Rate", "USD/day", "$/DAY", 5000.0, "5000", ""},
+  {INPUT, "crane1000DR", "1000 t Crawler Crane Day Rate", "USD/day", "$/DAY", 8000.0, "8000", ""},
+  {INPUT, "craneMobDemob", "Port Crane Mobilization/Demobilization Cost", "USD", "$", 150000.0, "150000", ""},
+  {INPUT, "entranceExitRate", "Port Entrance and Exit Cost Rate", "USD/occurrence", "$/OCCURRENCE", 0.525, "0.525", ""},
+  {INPUT, "dockRate", "Quayside Docking Cost Rate", "USD/day", "$/DAY", 3000.0, "3000", ""},
+  {INPUT, "wharfRate", "Wharf Loading and Unloading Cost Rate", "USD/t", "$/TONNE", 2.75, "2.75", ""},
+  {INPUT, "laydownCR", "Laydown and Storage Cost Rate", "USD/m**2/day", "$/M^2/DAY", 0.25, "0.25", ""},
+  {INPUT, "estEnMFac", "Estimated Engineering & Management Cost Factor", "", "", 0.04, "0.04", ""},
+  {INPUT, "preFEEDStudy", "Pre-FEED study Cost", "USD", "$", 5000000.0, "5000000", ""},
+  {INPUT, "feedStudy", "FEED Study Cost", "USD", "$", 10000000.0, "10000000", ""},
+  {INPUT, "stateLease", "State Leasing and Permitting Cost", "USD", "$", 250000.0, "250000", ""},
+  {INPUT, "outConShelfLease", "Outer Continental Shelf Lease Cost", "USD", "$", 1000000.0, "1000000", ""},
+  {INPUT, "saPlan", "Site Assessment Plan Cost", "USD", "$", 500000.0, "500000", ""},
+  {INPUT, "conOpPlan", "Construction Operations Plan Cost", "USD", "$", 1000000.0, "1000000", ""},
+  {INPUT, "nepaEisMet", "NEPA Environmental Impact Statement Met Tower Cost", "USD", "$", 2000000.0, "2000000", ""},
+  {INPUT, "physResStudyMet", "Physical Resource Study Met Tower Cost", "USD", "$", 1500000.0, "1500000", ""},
+  {INPUT, "bioResStudyMet", "Biological Resource Study Met Tower Cost", "USD", "$", 1500000.0, "1500000", ""},
+  {INPUT, "socEconStudyMet", "Socioeconomic and Land use Study Met Tower Cost", "USD", "$", 500000.0, "500000", ""},
+  {INPUT, "navStudyMet", "Navigation and Transport Study Met Tower Cost", "USD", "$", 500000.0, "500000", ""},
+  {INPUT, "nepaEisProj", "NEPA Environmental Impact Study Project Cost", "USD", "$", 5000000.0, "5000000", ""},
+  {INPUT, "physResStudyProj", "Physical Resource Study Project Cost", "USD", "$", 500000.0, "500000", ""},
+  {INPUT, "bioResStudyProj", "Biological Resource Study Porject Cost", "USD", "$", 500000.0, "500000", ""},
+  {INPUT, "socEconStudyProj", "Socioeconomic and Land use Study Project Cost", "USD", "$", 200000.0, "200000", ""},
+  {INPUT, "navStudyProj", "Navigation and Transport Study Project Cost", "USD", "$", 250000.0, "250000", ""},
+  {INPUT, "coastZoneManAct", "Coastal Zone Management Act Compliance Cost", "USD", "$", 100000.0, "100000", ""},
+  {INPUT, "rivsnHarbsAct", "Rivers & Harbors Act Section 10 Compliance Cost", "USD", "$", 100000.0, "100000", ""},
+  {INPUT, "cleanWatAct402", "Clean Water Act Section 402 Compliance Cost", "USD", "$", 100000.0, "100000", ""},
+  {INPUT, "cleanWatAct404", "Clean Water Act Section 404 Compliance Cost", "USD", "$", 100000.0, "100000", ""},
+  {INPUT, "faaPlan", "Federal Aviation Administration Plans & Mitigation Cost", "USD", "$", 10000.0, "10000", ""},
+  {INPUT, "endSpecAct", "Endangered Species Act Compliance Cost", "USD", "$", 500000.0, "500000", ""},
+  {INPUT, "marMamProtAct", "Marine Mammal Protection Act Compliance Cost", "USD", "$", 500000.0, "500000", ""},
+  {INPUT, "migBirdAct", "Migratory Bird Treaty Compliance Cost", "USD", "$", 500000.0, "500000", ""},
+  {INPUT, "natHisPresAct", "National Historic Preservation Act Compliance Cost", "USD", "$", 250000.0, "250000", ""},
+  {INPUT, "addLocPerm", "Additional State and Local Permitting Cost", "USD", "$", 200000.0, "200000", ""},
+  {INPUT, "metTowCR", "Meteorological (Met Tower Fabrication & Install Cost", "USD/MW", "$/MW", 11518.0, "11518", ""},
+  {INPUT, "decomDiscRate", "Decommissioning Cost Discount Rate", "", "", 0.03, "0.03", ""},
+  {INPUT, "hubD", "Hub Diameter", "m", "M", 0.0, "0", ""},
+  {INPUT, "bladeL", "Blade Length", "m", "M", 0.0, "0", ""},
+  {INPUT, "max_chord", "Blade Max Chord", "m", "M", 0.0, "0", ""},
+  {INPUT, "nacelleW", "Nacelle Width", "m", "M", 0.0, "0", ""},
+  {INPUT, "nacelleL", "Nacelle Length", "m", "M", 0.0, "0", ""},
+  {INPUT, "rnaM", "Rotor-Nacelle Assembly Mass", "t", "TONNE", 0.0, "0", ""},
+  {INPUT, "towerD", "Tower Base Diameter", "m", "M", 0.0, "0", ""},
+  {INPUT, "towerM", "Tower Mass", "t", "TONNE", 0.0, "0", ""},
+  {INPUT, "subTotM", "Total Substructure Mass per Turbine", "t", "TONNE", 0.0, "0", ""},
+  {INPUT, "subTotCost", "Substructure & Foundation Total Cost", "USD", "$", 0.0, "0", ""},
+  {INPUT, "moorCost", "Capital cost of mooring lines and anchors", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "systAngle", "Floating System Angle", "degrees", "DEGREES", 0.0, "0", ""},
+  {OUTPUT, "freeCabLeng", "Free Hanging Cable Length", "m", "M", 0.0, "0", ""},
+  {OUTPUT, "fixCabLeng", "Fixed Cable Length", "m", "M", 0.0, "0", ""},
+  {OUTPUT, "nExpCab", "Number of Export Cables", "", "", 0.0, "0", ""},
+  {OUTPUT, "cab1Leng", "Array Cable #1 Length", "m", "M", 0.0, "0", ""},
+  {OUTPUT, "cab2Leng", "Array Cabel #2 Length", "m", "M", 0.0, "0", ""},
+  {OUTPUT, "expCabLeng", "Export Cable Length", "m", "M", 0.0, "0", ""},
+  {OUTPUT, "subsTopM", "Substation Topside Mass", "t", "TONNE", 0.0, "0", ""},
+  {OUTPUT, "arrCab1Cost", "Array Cable #1 and Ancillary Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "arrCab2Cost", "Array Cable #2 and Ancillary Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "expCabCost", "Export Cable and Ancillary Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "subsSubM", "Offshore Substation Substructure Mass", "t", "TONNE", 0.0, "0", ""},
+  {OUTPUT, "subsPileM", "Offshore Substation Jacket Piles Mass", "t", "TONNE", 0.0, "0", ""},
+  {OUTPUT, "totElecCost", "Total Electrical Infrastructure Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "moorTime", "Mooring and Anchor System Installation Time", "d", "DAYS", 0.0, "0", ""},
+  {OUTPUT, "floatPrepTime", "Floating Preparation Time", "d", "DAYS", 0.0, "0", ""},
+  {OUTPUT, "turbDeckArea", "Deck Area Required per Turbine", "m**2", "M^2", 0.0, "0", ""},
+  {OUTPUT, "nTurbPerTrip", "Maximum Number of Turbines per Vessel Trip", "", "", 0.0, "0", ""},
+  {OUTPUT, "turbInstTime", "Turbine Installation Time", "d", "DAYS", 0.0, "0", ""},
+  {OUTPUT, "subDeckArea", "Deck Area Required per Substructure", "m**2", "M^2", 0.0, "0", ""},
+  {OUTPUT, "nSubPerTrip", "Maximum Number of Substructures per Vessel Trip", "", "", 0.0, "0", ""},
+  {OUTPUT, "subInstTime", "Substructure Installation Time", "d", "DAYS", 0.0, "0", ""},
+  {OUTPUT, "arrInstTime", "Array Cable System Installation Time", "d", "DAYS", 0.0, "0", ""},
+  {OUTPUT, "expInstTime", "Export Cable Installation Time", "d", "DAYS", 0.0, "0", ""},
+  {OUTPUT, "subsInstTime", "Offshore Substation Installation Time", "d", "DAYS", 0.0, "0", ""},
+  {OUTPUT, "totInstTime", "Total Installation Time", "d", "DAYS", 0.0, "0", ""},
+  {OUTPUT, "totAnICost", "Total Assembly & Installation Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "cabSurvey", "Cable Route Survey Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "turbine_install_cost", "Turbine Install Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "substructure_install_cost", "Substructure Install Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "electrical_install_cost", "Electrical Install Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "mob_demob_cost", "Mobilization/Demobilization Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "installSeasons", "Installation Seasons Mobilized For", "", "", 0.0, "0", ""},
+  {OUTPUT, "array_cable_install_cost", "Array Cable Installation Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "export_cable_install_cost", "Export Cable Installation Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "substation_install_cost", "Substation Installation Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "totPnSCost", "Total Port & Staging Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "totEnMCost", "Total Engineering & Management Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "totDevCost", "Total Development Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "commissioning", "Plant Commissioning Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "decomCost", "Plant Decommissioning Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "bos_capex", "BOS Capital Expenditures", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "soft_costs", "Soft Costs", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "total_contingency_cost", "Total Contingency Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "construction_insurance_cost", "Construction Insurance Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "construction_finance_cost", "Construction Finance Cost", "USD", "$", 0.0, "0", ""},
+  {OUTPUT, "construction_finance_factor", "Construction Finance Factor", "", "", 0.0, "0", ""},
+  {OUTPUT, "total_bos_cost", "Total Balance of System Cost", "USD", "$", 0.0, "0", ""},
+};
@@ -0,0 +1,150 @@
+#ifndef __wind_obos_dual_h
+#define __wind_obos_dual_h
+
+// Dual numbers for forward mode automatic differentiation of the wobos model.  A wobos_dual holds a value
+// and its derivatives along NDUAL tangent directions, so running wobos_t<wobos_dual> once gives every
+// output together with its derivatives with respect to up to NDUAL inputs (see lib_wind_obos_jacobian.h).
+//
+// ceil, floor, fmod and roundf are step functions: their derivative is zero between the steps and does
+// not exist at them.  The derivative they return is that zero, and every direction whose tangent was
+// non-zero going in is flagged in steps.  The flags propagate through all further arithmetic, so an
+// output with a flagged direction has a derivative that ignores at least one discontinuity.
+
+#include <cmath>
+#include <algorithm>
+
+#define NDUAL 16
+
+struct wobos_dual {
+  double v;            // value
+  double d[NDUAL];     // derivative along each tangent direction
+  unsigned int steps;  // bit k set when direction k went through a step function
+
+  // Uninitialized like a double, so wobos_t<wobos_dual> behaves like wobos_t<double>
+  wobos_dual() = default;
+  wobos_dual(double x) : v(x), steps(0) {for (int k=0; k<NDUAL; k++) d[k] = 0.0;}
+
+  // Bit mask of the directions with a non-zero derivative
+  unsigned int directions() const {
+    unsigned int mask = 0;
+    for (int k=0; k<NDUAL; k++) if (d[k] != 0.0) mask |= 1u << k;
+    return mask;
+  }
+
+  wobos_dual& operator+=(const wobos_dual &y) {v += y.v; for (int k=0; k<NDUAL; k++) d[k] += y.d[k]; steps |= y.steps; return *this;}
+  wobos_dual& operator-=(const wobos_dual &y) {v -= y.v; for (int k=0; k<NDUAL; k++) d[k] -= y.d[k]; steps |= y.steps; return *this;}
+  wobos_dual& operator*=(const wobos_dual &y) {
+    for (int k=0; k<NDUAL; k++) d[k] = d[k]*y.v + v*y.d[k];
+    v *= y.v;
+    steps |= y.steps;
+    return *this;
+  }
+  wobos_dual& operator/=(const wobos_dual &y) {
+    v /= y.v;
+    for (int k=0; k<NDUAL; k++) d[k] = (d[k] - v*y.d[k]) / y.v;
+    steps |= y.steps;
+    return *this;
+  }
+  wobos_dual& operator+=(double y) {v += y; return *this;}
+  wobos_dual& operator-=(double y) {v -= y; return *this;}
+  wobos_dual& operator*=(double y) {v *= y; for (int k=0; k<NDUAL; k++) d[k] *= y; return *this;}
+  wobos_dual& operator/=(double y) {v /= y; for (int k=0; k<NDUAL; k++) d[k] /= y; return *this;}
+
+  wobos_dual& operator++() {v += 1.0; return *this;}
+  wobos_dual& operator--() {v -= 1.0; return *this;}
+  wobos_dual operator++(int) {wobos_dual x(*this); v += 1.0; return x;}
+  wobos_dual operator--(int) {wobos_dual x(*this); v -= 1.0; return x;}
+};
+
+static_assert(NDUAL <= 32, "wobos_dual::steps holds one bit per tangent direction");
+
+// Value of a model quantity, whether or not it carries derivatives
+inline double primal(double x) {return x;}
+inline double primal(const wobos_dual &x) {return x.v;}
+
+// Flag x as a step function of y, e.g. a choice made by comparing quantities that depend on y
+inline void mark_steps(double &, double) {}
+inline void mark_steps(wobos_dual &x, const wobos_dual &y) {x.steps |= y.steps | y.directions();}
+
+// Arithmetic
+inline wobos_dual operator+(const wobos_dual &x) {return x;}
+inline wobos_dual operator-(const wobos_dual &x) {wobos_dual y(x); y.v = -x.v; for (int k=0; k<NDUAL; k++) y.d[k] = -x.d[k]; return y;}
+inline wobos_dual operator+(wobos_dual x, const wobos_dual &y) {return x += y;}
+inline wobos_dual operator-(wobos_dual x, const wobos_dual &y) {return x -= y;}
+inline wobos_dual operator*(wobos_dual x, const wobos_dual &y) {return x *= y;}
+inline wobos_dual operator/(wobos_dual x, const wobos_dual &y) {return x /= y;}
+inline wobos_dual operator+(wobos_dual x, double y) {return x += y;}
+inline wobos_dual operator-(wobos_dual x, double y) {return x -= y;}
+inline wobos_dual operator*(wobos_dual x, double y) {return x *= y;}
+inline wobos_dual operator/(wobos_dual x, double y) {return x /= y;}
+inline wobos_dual operator+(double x, wobos_dual y) {return y += x;}
+inline wobos_dual operator-(double x, const wobos_dual &y) {return -y + x;}
+inline wobos_dual operator*(double x, wobos_dual y) {return y *= x;}
+inline wobos_dual operator/(double x, const wobos_dual &y) {return wobos_dual(x) /= y;}
+
+// Comparisons only look at the value
+inline bool operator==(const wobos_dual &x, const wobos_dual &y) {return x.v == y.v;}
+inline bool operator!=(const wobos_dual &x, const wobos_dual &y) {return x.v != y.v;}
+inline bool operator< (const wobos_dual &x, const wobos_dual &y) {return x.v <  y.v;}
+inline bool operator<=(const wobos_dual &x, const wobos_dual &y) {return x.v <= y.v;}
+inline bool operator> (const wobos_dual &x, const wobos_dual &y) {return x.v >  y.v;}
+inline bool operator>=(const wobos_dual &x, const wobos_dual &y) {return x.v >= y.v;}
+inline bool operator==(const wobos_dual &x, double y) {return x.v == y;}
+inline bool operator!=(const wobos_dual &x, double y) {return x.v != y;}
+inline bool operator< (const wobos_dual &x, double y) {return x.v <  y;}
+inline bool operator<=(const wobos_dual &x, double y) {return x.v <= y;}
+inline bool operator> (const wobos_dual &x, double y) {return x.v >  y;}
+inline bool operator>=(const wobos_dual &x, double y) {return x.v >= y;}
+inline bool operator==(double x, const wobos_dual &y) {return x == y.v;}
+inline bool operator!=(double x, const wobos_dual &y) {return x != y.v;}
+inline bool operator< (double x, const wobos_dual &y) {return x <  y.v;}
+inline bool operator<=(double x, const wobos_dual &y) {return x <= y.v;}
+inline bool operator> (double x, const wobos_dual &y) {return x >  y.v;}
+inline bool operator>=(double x, const wobos_dual &y) {return x >= y.v;}
+
+// Same tie breaking as std::max and std::min: the first argument wins
+inline wobos_dual max(const wobos_dual &x, const wobos_dual &y) {return (x < y) ? y : x;}
+inline wobos_dual min(const wobos_dual &x, const wobos_dual &y) {return (y < x) ? y : x;}
+inline wobos_dual max(double x, const wobos_dual &y) {return max(wobos_dual(x), y);}
+inline wobos_dual min(double x, const wobos_dual &y) {return min(wobos_dual(x), y);}
+inline wobos_dual max(const wobos_dual &x, double y) {return max(x, wobos_dual(y));}
+inline wobos_dual min(const wobos_dual &x, double y) {return min(x, wobos_dual(y));}
+
+// Chain rule for f(x) with derivative fx.  Directions that x does not depend on stay exactly zero, even
+// where fx is infinite (e.g. sqrt or pow at zero).
+inline wobos_dual dual_chain(double f, double fx, const wobos_dual &x) {
+  wobos_dual y(f);
+  for (int k=0; k<NDUAL; k++) if (x.d[k] != 0.0) y.d[k] = fx*x.d[k];
+  y.steps = x.steps;
+  return y;
+}
+
+inline wobos_dual sqrt(const wobos_dual &x) {double f = std::sqrt(x.v); return dual_chain(f, 0.5/f, x);}
+inline wobos_dual exp(const wobos_dual &x) {double f = std::exp(x.v); return dual_chain(f, f, x);}
+inline wobos_dual log(const wobos_dual &x) {return dual_chain(std::log(x.v), 1.0/x.v, x);}
+inline wobos_dual cos(const wobos_dual &x) {return dual_chain(std::cos(x.v), -std::sin(x.v), x);}
+inline wobos_dual tan(const wobos_dual &x) {double f = std::tan(x.v); return dual_chain(f, 1.0 + f*f, x);}
+inline wobos_dual pow(const wobos_dual &x, double p) {return dual_chain(std::pow(x.v, p), p*std::pow(x.v, p - 1.0), x);}
+inline wobos_dual pow(double x, const wobos_dual &p) {double f = std::pow(x, p.v); return dual_chain(f, f*std::log(x), p);}
+inline wobos_dual pow(const wobos_dual &x, const wobos_dual &p) {
+  wobos_dual y = pow(x, p.v);
+  for (int k=0; k<NDUAL; k++) if (p.d[k] != 0.0) y.d[k] += y.v*std::log(x.v)*p.d[k];
+  y.steps |= p.steps;
+  return y;
+}
+
+// Step functions
+inline wobos_dual dual_step(double f, const wobos_dual &x) {wobos_dual y(f); y.steps = x.steps | x.directions(); return y;}
+inline wobos_dual ceil(const wobos_dual &x) {return dual_step(std::ceil(x.v), x);}
+inline wobos_dual floor(const wobos_dual &x) {return dual_step(std::floor(x.v), x);}
+inline wobos_dual roundf(const wobos_dual &x) {return dual_step(::roundf(x.v), x);}
+// fmod(x, y) = x - n*y with n = trunc(x/y) constant between the steps
+inline wobos_dual fmod(const wobos_dual &x, const wobos_dual &y) {
+  double n = std::trunc(x.v / y.v);
+  wobos_dual r = x - n*y;
+  r.v = std::fmod(x.v, y.v);
+  r.steps |= x.directions() | y.directions();
+  return r;
+}
+
+#endif
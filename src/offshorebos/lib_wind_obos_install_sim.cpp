@@ -0,0 +1,228 @@
+#include "lib_wind_obos_install_sim.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+// Events: a vessel is done loading, arrives at the site, is back in port, or the installation vessel is done
+// with a unit
+enum {VESSEL_LOADED, VESSEL_AT_SITE, VESSEL_IN_PORT, UNIT_DONE, BARGE_LOADED, BARGE_AT_SITE, BARGE_IN_PORT};
+
+
+static inline bool earlier(double t1, uint64_t s1, double t2, uint64_t s2) {
+  return (t1 < t2) || ((t1 == t2) && (s1 < s2));
+}
+
+
+void install_simulator::clear() {
+  pool.clear();
+  freeIds.clear();
+  heap.clear();
+  nextSeq = 0;
+  siteQueue.clear();
+  bargeUnits.clear();
+  bargeArrival.clear();
+}
+
+
+void install_simulator::schedule(double time, int resource, int kind) {
+  uint32_t id;
+  if (freeIds.empty()) {
+    id = (uint32_t)pool.size();
+    pool.push_back(event());
+  }
+  else {
+    id = freeIds.back();
+    freeIds.pop_back();
+  }
+  pool[id].time     = time;
+  pool[id].resource = resource;
+  pool[id].kind     = kind;
+
+  // Sift the new entry up from the end
+  heap_entry e = {time, nextSeq++, id};
+  size_t k = heap.size();
+  heap.push_back(e);
+  while (k > 0) {
+    size_t parent = (k - 1) / 2;
+    if (!earlier(e.time, e.seq, heap[parent].time, heap[parent].seq)) break;
+    heap[k] = heap[parent];
+    k = parent;
+  }
+  heap[k] = e;
+}
+
+
+install_simulator::event install_simulator::next() {
+  uint32_t id = heap[0].id;
+  heap_entry last = heap.back();
+  heap.pop_back();
+
+  // Sift the last entry down from the top
+  size_t n = heap.size(), k = 0;
+  if (n > 0) {
+    while (true) {
+      size_t child = 2*k + 1;
+      if (child >= n) break;
+      if ((child + 1 < n) && earlier(heap[child+1].time, heap[child+1].seq, heap[child].time, heap[child].seq)) child++;
+      if (!earlier(heap[child].time, heap[child].seq, last.time, last.seq)) break;
+      heap[k] = heap[child];
+      k = child;
+    }
+    heap[k] = last;
+  }
+
+  freeIds.push_back(id);
+  return pool[id];
+}
+
+
+double install_simulator::finish(const install_campaign &c, int kind, double start, double hours) const {
+  const weather_windows *w = (kind == INSTALL_BARGE_TRANSIT) ? c.bargeWeather : c.weather;
+  if (w == NULL) return start + hours * c.weatherFactor;
+
+  // Loadout is in port, everything else waits for a window
+  if (kind == INSTALL_LOADOUT) return start + hours;
+  return w->next_window(c.startHour + start, hours) - c.startHour + hours;
+}
+
+
+install_schedule install_simulator::simulate(const install_campaign &c) {
+  if (c.passes.empty()) throw invalid_argument("Installation campaign without passes");
+  clear();
+
+  install_schedule s;
+  s.hours           = 0.0;
+  s.vesselIdleHours = 0.0;
+  s.bargeIdleHours  = 0.0;
+  s.trips           = 0;
+  s.events          = 0;
+  if (c.nUnits == 0) return s;
+
+  const size_t perLoad = max(c.unitsPerLoad, (size_t)1);
+  const size_t nPasses = c.passes.size();
+  size_t notLoaded = c.nUnits;
+
+  if (c.nBarges == 0) {
+    // The installation vessel loads, goes out, visits every position of the load once per pass (going back to
+    // port to load the next pass), and comes back for the next load
+    size_t load = min(perLoad, notLoaded), pass = 0, done = 0;
+    notLoaded -= load;
+    schedule(finish(c, INSTALL_LOADOUT, 0.0, load * c.passes[0].loadHours), 0, VESSEL_LOADED);
+
+    while (!heap.empty()) {
+      event e = next();
+      s.events++;
+      const install_pass &p = c.passes[pass];
+      switch (e.kind) {
+      case VESSEL_LOADED:
+	schedule(finish(c, INSTALL_TRANSIT, e.time, c.transitHours), 0, VESSEL_AT_SITE);
+	break;
+      case VESSEL_AT_SITE:
+	done = 0;
+	schedule(finish(c, INSTALL_WORK, e.time, p.installHours), 0, UNIT_DONE);
+	break;
+      case UNIT_DONE:
+	if (++done < load) {
+	  double start = finish(c, INSTALL_MOVE, e.time, c.moveHours);
+	  schedule(finish(c, INSTALL_WORK, start, p.installHours), 0, UNIT_DONE);
+	}
+	else {
+	  s.trips++;
+	  schedule(finish(c, INSTALL_TRANSIT, e.time, c.transitHours), 0, VESSEL_IN_PORT);
+	}
+	break;
+      case VESSEL_IN_PORT:
+	if (++pass < nPasses) {
+	  schedule(finish(c, INSTALL_LOADOUT, e.time, load * c.passes[pass].loadHours), 0, VESSEL_LOADED);
+	}
+	else if (notLoaded > 0) {
+	  pass = 0;
+	  load = min(perLoad, notLoaded);
+	  notLoaded -= load;
+	  schedule(finish(c, INSTALL_LOADOUT, e.time, load * c.passes[0].loadHours), 0, VESSEL_LOADED);
+	}
+	else {
+	  s.hours = e.time;
+	}
+	break;
+      }
+    }
+    return s;
+  }
+
+  // Feeder barges load in port side by side and queue at the site in order of arrival.  The installation
+  // vessel goes out once, does every pass of a unit in one visit, moving between positions, and waits when no
+  // barge is there.  A barge goes back when it is empty.
+  double loadHours = 0.0, installHours = 0.0;
+  for (size_t k=0; k<nPasses; k++) {
+    loadHours    += c.passes[k].loadHours;
+    installHours += c.passes[k].installHours;
+  }
+  bargeUnits.assign(c.nBarges + 1, 0);
+  bargeArrival.assign(c.nBarges + 1, -1.0);
+  siteQueue.reserve(c.nUnits / perLoad + 1);
+  size_t head = 0, installed = 0;
+  bool busy = true;        // the installation vessel is on its way or installing
+  double idleSince = 0.0;
+
+  schedule(finish(c, INSTALL_TRANSIT, 0.0, c.transitHours), 0, VESSEL_AT_SITE);
+  for (size_t b=1; (b <= c.nBarges) && (notLoaded > 0); b++) {
+    bargeUnits[b] = min(perLoad, notLoaded);
+    notLoaded -= bargeUnits[b];
+    schedule(finish(c, INSTALL_LOADOUT, 0.0, bargeUnits[b] * loadHours), (int)b, BARGE_LOADED);
+  }
+
+  while (!heap.empty() && (installed < c.nUnits)) {
+    event e = next();
+    s.events++;
+    size_t b = (size_t)e.resource;
+    switch (e.kind) {
+    case BARGE_LOADED:
+      schedule(finish(c, INSTALL_BARGE_TRANSIT, e.time, c.bargeTransitHours), e.resource, BARGE_AT_SITE);
+      break;
+    case BARGE_AT_SITE:
+      bargeArrival[b] = e.time;
+      siteQueue.push_back(b);
+      break;
+    case VESSEL_AT_SITE:
+      busy = false;
+      idleSince = e.time;
+      break;
+    case UNIT_DONE:
+      busy = false;
+      idleSince = e.time;
+      installed++;
+      b = siteQueue[head];
+      if (--bargeUnits[b] == 0) {
+	head++;
+	s.trips++;
+	schedule(finish(c, INSTALL_BARGE_TRANSIT, e.time, c.bargeTransitHours), (int)b, BARGE_IN_PORT);
+      }
+      if (installed == c.nUnits) s.hours = e.time;
+      break;
+    case BARGE_IN_PORT:
+      if (notLoaded > 0) {
+	bargeUnits[b] = min(perLoad, notLoaded);
+	notLoaded -= bargeUnits[b];
+	schedule(finish(c, INSTALL_LOADOUT, e.time, bargeUnits[b] * loadHours), e.resource, BARGE_LOADED);
+      }
+      break;
+    }
+
+    // Start on the next unit if the installation vessel is free and a barge is waiting
+    if (!busy && (head < siteQueue.size()) && (installed < c.nUnits)) {
+      size_t front = siteQueue[head];
+      s.vesselIdleHours += e.time - idleSince;
+      if (bargeArrival[front] >= 0.0) {
+	s.bargeIdleHours += e.time - bargeArrival[front];
+	bargeArrival[front] = -1.0;
+      }
+      double start = (installed == 0) ? e.time : finish(c, INSTALL_MOVE, e.time, c.moveHours);
+      schedule(finish(c, INSTALL_WORK, start, installHours), 0, UNIT_DONE);
+      busy = true;
+    }
+  }
+  return s;
+}
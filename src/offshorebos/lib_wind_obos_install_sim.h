@@ -0,0 +1,92 @@
+#ifndef __wind_obos_install_sim_h
+#define __wind_obos_install_sim_h
+
+// Discrete-event simulation of an installation campaign: one installation vessel puts nUnits units
+// (turbines or substructures) in place, and brings them out itself in loads of unitsPerLoad, or has them
+// brought by feeder barges while it stays at the site.  Every vessel is a resource that goes through
+// loadout, transit, positioning and installation activities; the simulation steps from one event (a vessel
+// finishing an activity) to the next, so barges that cannot keep up show up as waiting time of the
+// installation vessel, which the closed-form installation times of wobos leave out.
+//
+// With weather windows (see lib_wind_obos_weather.h), every activity at sea waits for enough workable hours
+// of its vessel in a row instead of being stretched by weatherFactor.
+//
+// Events come from a pool that is reused between runs, ordered by a binary heap on time (ties in the order
+// they were scheduled, so runs are deterministic), so a simulator object allocates nothing once warm.
+
+#include "lib_wind_obos_weather.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Activities, for the time they take (see install_simulator::finish)
+enum {INSTALL_LOADOUT, INSTALL_TRANSIT, INSTALL_MOVE, INSTALL_WORK, INSTALL_BARGE_TRANSIT};
+
+// One visit of the installation vessel to every position of a load, e.g. jacket piles and then jackets
+struct install_pass {
+  double loadHours;     // port loadout per unit
+  double installHours;  // at each position: positioning, jacking up and down, lifting, hammering, ...
+};
+
+struct install_campaign {
+  size_t nUnits;
+  size_t unitsPerLoad;               // per trip of the installation vessel, or per barge
+  std::vector<install_pass> passes;  // in order; with barges, all passes of a unit are done in one visit
+  double transitHours;               // installation vessel, port to site
+  double moveHours;                  // installation vessel, from one position to the next
+  size_t nBarges;                    // 0 for trips of the installation vessel itself
+  double bargeTransitHours;          // port to site
+  double weatherFactor;              // every activity takes this many times longer, 1/(1 - contingency)
+  const weather_windows *weather;       // workable hours of the installation vessel, NULL for weatherFactor
+  const weather_windows *bargeWeather;  // and of the barges
+  double startHour;                     // hour of the weather record at which the campaign starts
+
+  install_campaign() : nUnits(0), unitsPerLoad(1), transitHours(0.0), moveHours(0.0), nBarges(0),
+    bargeTransitHours(0.0), weatherFactor(1.0), weather(NULL), bargeWeather(NULL), startHour(0.0) {}
+};
+
+struct install_schedule {
+  double hours;            // until the installation vessel is back in port, or with barges, the last unit is in place
+  double vesselIdleHours;  // installation vessel waiting for barges
+  double bargeIdleHours;   // barges waiting at the site for the installation vessel, all barges together
+  size_t trips;            // round trips of the installation vessel or of the barges
+  size_t events;           // events processed
+};
+
+class install_simulator {
+ public:
+  install_schedule simulate(const install_campaign &c);
+
+  install_simulator() : nextSeq(0) {}
+
+ private:
+  struct event {
+    double time;
+    int resource;  // 0 for the installation vessel, 1.. for the barges
+    int kind;
+  };
+  struct heap_entry {
+    double time;
+    uint64_t seq;
+    uint32_t id;   // in pool
+  };
+
+  std::vector<event> pool;
+  std::vector<uint32_t> freeIds;
+  std::vector<heap_entry> heap;
+  uint64_t nextSeq;
+
+  // Barges at the site in order of arrival, and the units left on each barge
+  std::vector<size_t> siteQueue;
+  std::vector<size_t> bargeUnits;
+  std::vector<double> bargeArrival;
+
+  void schedule(double time, int resource, int kind);
+  event next();
+  void clear();
+
+  // End of an activity of the given kind that is ready to start at start and takes hours in good weather
+  double finish(const install_campaign &c, int kind, double start, double hours) const;
+};
+
+#endif
@@ -0,0 +1,85 @@
+#include "lib_wind_obos_jacobian.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+using namespace std;
+
+// For Python wrapping with c_types
+extern "C" {
+  wobos_jacobian* pywobos_jacobian_new(const char** inNames, int nIn, const char** outNames, int nOut) {
+    try {
+      return new wobos_jacobian(vector<string>(inNames, inNames+nIn), vector<string>(outNames, outNames+nOut));
+    } catch(exception& e) {
+      cout << e.what() << endl;
+      return NULL;
+    }
+  }
+  void pywobos_jacobian_run(wobos_jacobian* jac, wobos* obos, double* outputs, double* jacobian, unsigned char* steps) {
+    jac->run(*obos, outputs, jacobian, steps);
+  }
+  void pywobos_jacobian_delete(wobos_jacobian* jac) {delete jac;}
+}
+
+
+wobos_jacobian::wobos_jacobian(vector<string> inNames, vector<string> outNames) {
+  inputNames  = inNames;
+  outputNames = outNames;
+
+  // Resolve names once here so that every run works on indices only
+  for (size_t k=0; k<inputNames.size(); k++) {
+    inputIds.push_back( wobos::variable_index(inputNames[k]) );
+    if (inputIds.back() < 0) throw invalid_argument("Unknown input variable: " + inputNames[k]);
+    if (!worker.variable_member(inputIds.back())) throw invalid_argument("Cannot differentiate with respect to: " + inputNames[k]);
+  }
+  for (size_t k=0; k<outputNames.size(); k++) {
+    outputIds.push_back( wobos::variable_index(outputNames[k]) );
+    if (outputIds.back() < 0) throw invalid_argument("Unknown output variable: " + outputNames[k]);
+  }
+}
+
+
+void wobos_jacobian::run(const wobos &obos, double* outputs, double* jacobian, unsigned char* steps) {
+  const size_t nIn  = nInputs();
+  const size_t nOut = nOutputs();
+
+  // Enumerated and boolean outputs have no derivatives
+  fill(jacobian, jacobian + nOut*nIn, 0.0);
+  if (steps) fill(steps, steps + nOut*nIn, 0);
+
+  // One model run per NDUAL inputs (and one run for the outputs if there are no inputs at all)
+  for (size_t start=0; (start == 0) || (start < nIn); start += NDUAL) {
+    const size_t stop = min(start + NDUAL, nIn);
+
+    // Same starting point and sequence as the Python wrapper
+    copy(obos.varValues, obos.varValues + NVARIABLES, worker.varValues);
+    worker.templates = obos.templates;
+    worker.arrCables = obos.arrCables;
+    worker.expCables = obos.expCables;
+    worker.arrayLayout = obos.arrayLayout;
+    worker.weather = obos.weather;
+    worker.map2variables();
+    worker.set_vessel_defaults();
+
+    // Input k moves along tangent direction k-start
+    for (size_t k=start; k<stop; k++)
+      worker.variable_member(inputIds[k])->d[k-start] += 1.0;
+
+    worker.run();
+    worker.variables2map();
+
+    for (size_t i=0; i<nOut; i++) {
+      if (start == 0) outputs[i] = worker.varValues[outputIds[i]];
+
+      const wobos_dual *y = worker.variable_member(outputIds[i]);
+      if (!y) continue;
+      for (size_t k=start; k<stop; k++) {
+	jacobian[i*nIn + k] = y->d[k-start];
+	if (steps) steps[i*nIn + k] = (y->steps >> (k-start)) & 1u;
+      }
+    }
+  }
+}
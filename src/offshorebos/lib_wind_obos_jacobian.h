@@ -0,0 +1,43 @@
+#ifndef __wind_obos_jacobian_h
+#define __wind_obos_jacobian_h
+
+#include "lib_wind_obos.h"
+#include <vector>
+#include <string>
+
+// Derivatives of wobos outputs with respect to wobos inputs by forward mode automatic differentiation.
+// The model runs on wobos_dual numbers (lib_wind_obos_dual.h), which carry the derivatives with respect to
+// NDUAL inputs through every calculation, so n inputs take ceil(n/NDUAL) runs instead of the 2n runs of
+// central finite differences, and the derivatives have no truncation error.
+//
+// run() evaluates from the variable table of a wobos object, in the same sequence as the Python wrapper
+// (map2variables, set_vessel_defaults, run).  The object itself is not modified.  Derivatives are with
+// respect to the values in the table, i.e. fractions rather than percentages for the VAR_PERCENT inputs.
+// Inputs that run() fills in when they are left at zero (e.g. hubD, mpileL or nCrane600) have no effect,
+// and therefore a zero derivative, while they are zero.
+//
+// Where an output depends on an input through ceil, floor, fmod, roundf or a cable optimizer choice, the
+// derivative is that of the smooth pieces only: the output jumps at the steps, which the derivative does
+// not account for.  Those entries are reported in the steps table.
+class wobos_jacobian {
+ public:
+  vector<string> inputNames;
+  vector<string> outputNames;
+
+  size_t nInputs() {return inputNames.size();}
+  size_t nOutputs() {return outputNames.size();}
+
+  // Evaluate nOutputs() outputs and the nOutputs() x nInputs() row-major Jacobian d(output)/d(input).
+  // If steps is given, it receives 1 for every Jacobian entry that ignores a discontinuity and 0 otherwise.
+  void run(const wobos &obos, double* outputs, double* jacobian, unsigned char* steps=NULL);
+
+  // Constructors
+  wobos_jacobian(vector<string> inNames, vector<string> outNames);
+
+ private:
+  wobos_t<wobos_dual> worker;
+  vector<int> inputIds;
+  vector<int> outputIds;
+};
+
+#endif
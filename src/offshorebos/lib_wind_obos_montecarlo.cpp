@@ -0,0 +1,158 @@
+#include "lib_wind_obos_montecarlo.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846264338327
+#endif
+
+// For Python wrapping with c_types
+extern "C" {
+  wobos_montecarlo* pywobos_mc_new(const char** inNames, const int* types, const double* params, const double* bounds, int nIn,
+				   const char** outNames, int nOut) {
+    try {
+      vector<wobos_distribution> dists;
+      for (int k=0; k<nIn; k++)
+	dists.push_back( wobos_distribution(types[k], params[3*k], params[3*k+1], params[3*k+2], bounds[2*k], bounds[2*k+1]) );
+      return new wobos_montecarlo(vector<string>(inNames, inNames+nIn), dists, vector<string>(outNames, outNames+nOut));
+    } catch(exception& e) {
+      cout << e.what() << endl;
+      return NULL;
+    }
+  }
+  void pywobos_mc_set_baseline(wobos_montecarlo* mc, wobos* obos) {mc->set_baseline(*obos);}
+  void pywobos_mc_run(wobos_montecarlo* mc, double nSamples, double seed, int nthreads) {
+    mc->run((size_t)nSamples, (uint64_t)seed, nthreads);
+  }
+  double pywobos_mc_samples(wobos_montecarlo* mc) {return (double)mc->samples();}
+  // count, NaN count, mean, standard deviation, min, max and infinite count of output k
+  void pywobos_mc_stats(wobos_montecarlo* mc, int k, double* out) {
+    const wobos_stats &st = mc->stats(k);
+    out[0] = st.count;
+    out[1] = st.nans;
+    out[2] = st.mean;
+    out[3] = st.stddev();
+    out[4] = st.min;
+    out[5] = st.max;
+    out[6] = st.infs;
+  }
+  double pywobos_mc_quantile(wobos_montecarlo* mc, int k, double q) {return mc->stats(k).quantile(q);}
+  void pywobos_mc_histogram(wobos_montecarlo* mc, int k, int nBins, double* edges, double* counts) {
+    vector<double> e, c;
+    mc->stats(k).histogram((size_t)nBins, e, c);
+    copy(e.begin(), e.end(), edges);
+    copy(c.begin(), c.end(), counts);
+  }
+  void pywobos_mc_reset(wobos_montecarlo* mc) {mc->reset();}
+  void pywobos_mc_delete(wobos_montecarlo* mc) {delete mc;}
+}
+
+
+// Uniform in (0,1) from the top 53 bits, never exactly 0 or 1 so that log() and the inverse CDFs stay finite
+static double uniform01(mt19937_64 &rng) {
+  return ((double)(rng() >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+
+// Box-Muller, spelled out rather than std::normal_distribution so that samples are the same with every standard library
+static double standard_normal(mt19937_64 &rng) {
+  double u1 = uniform01(rng);
+  double u2 = uniform01(rng);
+  return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+
+wobos_distribution::wobos_distribution(int type, double a, double b, double c, double lower, double upper) :
+  type(type), a(a), b(b), c(c), lower(lower), upper(upper) {
+  bool valid = (lower <= upper);
+  switch (type) {
+  case UNIFORM:    valid = valid && (a <= b); break;
+  case NORMAL:
+  case LOGNORMAL:  valid = valid && (b >= 0.0); break;
+  case TRIANGULAR: valid = valid && (a <= b) && (b <= c); break;
+  default:         valid = false;
+  }
+  if (!valid) throw invalid_argument("Invalid distribution parameters");
+}
+
+
+double wobos_distribution::sample(mt19937_64 &rng) const {
+  // Truncation by rejection; give up after many tries (bounds far out in a tail) and clamp instead
+  double x = 0.0;
+  for (int tries=0; tries<1000; tries++) {
+    switch (type) {
+    case UNIFORM:
+      x = a + (b - a) * uniform01(rng);
+      break;
+    case NORMAL:
+      x = a + b * standard_normal(rng);
+      break;
+    case TRIANGULAR: {
+      // Inverse CDF
+      double u = uniform01(rng);
+      double f = (c > a) ? (b - a) / (c - a) : 0.5;
+      x = (u < f) ? a + sqrt(u * (c - a) * (b - a)) : c - sqrt((1.0 - u) * (c - a) * (c - b));
+      break;
+    }
+    case LOGNORMAL:
+      x = exp(a + b * standard_normal(rng));
+      break;
+    }
+    if ((x >= lower) && (x <= upper)) return x;
+  }
+  return min(max(x, lower), upper);
+}
+
+
+const size_t wobos_montecarlo::BLOCK;
+
+
+wobos_montecarlo::wobos_montecarlo(vector<string> inNames, vector<wobos_distribution> dists, vector<string> outNames) :
+  inputNames(inNames), distributions(dists), outputNames(outNames), batch(inNames, outNames) {
+  if (distributions.size() != inputNames.size()) throw invalid_argument("Need one distribution per input variable");
+  reset();
+}
+
+
+void wobos_montecarlo::reset() {
+  outputStats.assign(nOutputs(), wobos_stats());
+  nSamples = 0;
+}
+
+
+void wobos_montecarlo::run_block(wobos_batch &worker, uint64_t seed, size_t first, size_t n,
+				 vector<double> &inputs, vector<double> &outputs, vector<wobos_stats> &blockStats) {
+  // The stream of a block depends on nothing but the seed and where the block starts
+  seed_seq seq = {(uint32_t)seed, (uint32_t)(seed >> 32), (uint32_t)first, (uint32_t)((uint64_t)first >> 32)};
+  mt19937_64 rng(seq);
+
+  for (size_t i=0; i<n; i++)
+    for (size_t k=0; k<nInputs(); k++)
+      inputs[i*nInputs() + k] = distributions[k].sample(rng);
+
+  worker.run(&inputs[0], n, &outputs[0]);
+
+  for (size_t i=0; i<n; i++)
+    for (size_t k=0; k<nOutputs(); k++)
+      blockStats[k].add(outputs[i*nOutputs() + k]);
+}
+
+
+void wobos_montecarlo::run(size_t n, uint64_t seed, int nthreads) {
+  const size_t first = nSamples;
+  auto scratch = [&] () {return wobos_batch_scratch(batch, BLOCK);};
+  auto work = [&] (wobos_batch_scratch &s, size_t b, vector<wobos_stats> &blockStats) {
+    size_t start = b * BLOCK;
+    run_block(s.worker, seed, first + start, min(BLOCK, n - start), s.inputs, s.outputs, blockStats);
+  };
+  auto merge = [&] (const vector<wobos_stats> &blockStats) {
+    for (size_t k=0; k<nOutputs(); k++) outputStats[k].merge(blockStats[k]);
+  };
+  run_blocks((n + BLOCK - 1) / BLOCK, nthreads, scratch, vector<wobos_stats>(nOutputs()), work, merge);
+  nSamples += n;
+}
@@ -0,0 +1,77 @@
+#ifndef __wind_obos_montecarlo_h
+#define __wind_obos_montecarlo_h
+
+#include "lib_wind_obos_batch.h"
+#include "lib_wind_obos_stats.h"
+#include <vector>
+#include <string>
+#include <random>
+#include <limits>
+#include <cstdint>
+
+// Distribution of one uncertain input.  Parameters by type:
+//   UNIFORM     a = lower, b = upper
+//   NORMAL      a = mean, b = standard deviation
+//   TRIANGULAR  a = lower, b = mode, c = upper
+//   LOGNORMAL   a = mean, b = standard deviation of the log of the value
+// Samples outside [lower, upper] are drawn again, so e.g. a normal water depth can be kept positive.
+// Values are in the units of set_map_variable(), i.e. percents as percents.
+struct wobos_distribution {
+  enum {UNIFORM, NORMAL, TRIANGULAR, LOGNORMAL};
+
+  int type;
+  double a, b, c;
+  double lower, upper;
+
+  double sample(std::mt19937_64 &rng) const;
+
+  wobos_distribution(int type=UNIFORM, double a=0.0, double b=1.0, double c=0.0,
+		     double lower=-std::numeric_limits<double>::infinity(),
+		     double upper=std::numeric_limits<double>::infinity());
+};
+
+
+// Monte Carlo propagation of input uncertainty through wobos.  Every sample draws all inputs from
+// their distributions, runs the plant through a wobos_batch (so from the defaults, or the baseline set
+// with set_baseline(), every time) and adds the outputs to one wobos_stats per output.  No sample is
+// kept, so memory does not grow with the number of samples.
+//
+// Samples are drawn in blocks of BLOCK, each with its own random stream seeded from the seed and the
+// index of its first sample.  Blocks are spread over threads like the rows of run_parallel(), and their
+// statistics are merged in block order, so results do not depend on the number of threads.  Further
+// calls to run() carry on with new samples and add to the same statistics until reset().
+class wobos_montecarlo {
+ public:
+  static const size_t BLOCK = 256;
+
+  vector<string> inputNames;
+  vector<wobos_distribution> distributions;
+  vector<string> outputNames;
+
+  size_t nInputs() {return inputNames.size();}
+  size_t nOutputs() {return outputNames.size();}
+
+  // Draw and evaluate nSamples more samples over nthreads threads (all hardware threads if nthreads <= 0)
+  void run(size_t nSamples, uint64_t seed=0, int nthreads=0);
+
+  // Statistics of output k over all samples so far
+  const wobos_stats& stats(size_t k) const {return outputStats[k];}
+  size_t samples() const {return nSamples;}
+  void reset();
+
+  // Start every sample from the variables of obos instead of the defaults
+  void set_baseline(const wobos &obos) {batch.set_baseline(obos);}
+
+  // Constructors
+  wobos_montecarlo(vector<string> inNames, vector<wobos_distribution> dists, vector<string> outNames);
+
+ private:
+  wobos_batch batch;
+  vector<wobos_stats> outputStats;
+  size_t nSamples;
+
+  void run_block(wobos_batch &worker, uint64_t seed, size_t first, size_t n,
+		 vector<double> &inputs, vector<double> &outputs, vector<wobos_stats> &blockStats);
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef __wind_obos_profile_h
+#define __wind_obos_profile_h
+
+// Opt-in instrumentation of wobos::run().  When the library is built with WOBOS_PROFILE defined
+// (make WOBOS_PROFILE=1, or WOBOS_PROFILE=1 python setup.py ...), every stage of run() and both cable
+// optimizers record their call count and wall time in the profile of the wobos object, and the optimizers
+// also count the cables (or pairs of cables) they evaluate.  Without it the profiling macros expand to
+// nothing and the profile stays at zero.
+//
+// Stage times are inclusive: the optimizers run inside calculate_electrical_infrastructure_cost.
+
+#include <chrono>
+
+enum {STAGE_SET_TURBINE_PARAMETERS, STAGE_SUBSTRUCTURE_MASS_COST, STAGE_ELECTRICAL_INFRASTRUCTURE_COST,
+      STAGE_ASSEMBLY_AND_INSTALLATION, STAGE_PORT_AND_STAGING_COSTS, STAGE_ENGINEERING_MANAGEMENT_COST,
+      STAGE_DEVELOPMENT_COST, STAGE_BOS_COST, STAGE_ARRAY_CABLE_OPTIMIZER, STAGE_EXPORT_CABLE_OPTIMIZER,
+      NSTAGES};
+
+struct wobos_profile {
+  double calls[NSTAGES];
+  double seconds[NSTAGES];
+  double candidates[NSTAGES];  // cables or cable pairs evaluated by the optimizers
+
+  void reset() {
+    for (int k=0; k<NSTAGES; k++) calls[k] = seconds[k] = candidates[k] = 0.0;
+  }
+  void merge(const wobos_profile &other) {
+    for (int k=0; k<NSTAGES; k++) {
+      calls[k]      += other.calls[k];
+      seconds[k]    += other.seconds[k];
+      candidates[k] += other.candidates[k];
+    }
+  }
+
+  static const char* stage_name(int stage) {
+    static const char* names[NSTAGES] = {"set_turbine_parameters", "calculate_substructure_mass_cost",
+					 "calculate_electrical_infrastructure_cost", "calculate_assembly_and_installation",
+					 "calculate_port_and_staging_costs", "calculate_engineering_management_cost",
+					 "calculate_development_cost", "calculate_bos_cost",
+					 "ArrayCabCostOptimizer", "ExportCabCostOptimizer"};
+    return ((stage >= 0) && (stage < NSTAGES)) ? names[stage] : "";
+  }
+
+  // Whether the library was built with WOBOS_PROFILE
+  static bool enabled() {
+#ifdef WOBOS_PROFILE
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  wobos_profile() {reset();}
+};
+
+
+#ifdef WOBOS_PROFILE
+// Adds the time until the end of the enclosing scope to a stage
+class wobos_profile_timer {
+ public:
+  wobos_profile_timer(wobos_profile &prof, int stage) : profile(prof), stage(stage), start(std::chrono::steady_clock::now()) {}
+  ~wobos_profile_timer() {
+    profile.calls[stage]   += 1.0;
+    profile.seconds[stage] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+ private:
+  wobos_profile &profile;
+  int stage;
+  std::chrono::steady_clock::time_point start;
+};
+
+#define WOBOS_PROFILE_STAGE(prof, stage) wobos_profile_timer wobos_profile_timer_(prof, stage)
+#define WOBOS_PROFILE_CANDIDATES(prof, stage, n) ((prof).candidates[stage] += (double)(n))
+#else
+#define WOBOS_PROFILE_STAGE(prof, stage)
+#define WOBOS_PROFILE_CANDIDATES(prof, stage, n)
+#endif
+
+#endif
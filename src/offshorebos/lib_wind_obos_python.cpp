@@ -0,0 +1,337 @@
+// Native CPython module of the library (python setup.py builds lib_wind_obos as an extension with this
+// file; the plain library from make leaves it out and wind_obos.py falls back to ctypes).
+//
+// lib_wind_obos.wobos owns one wobos object:
+//   w.run(incremental=False)  map2variables, set_vessel_defaults, run (or run_incremental), variables2map
+//   w.nTurb, w.nTurb = 40     any variable of lib_wind_obos_variables.h by name (setting applies set_map_variable)
+//   w.get(id), w.set(id, v)   the same by index
+//   w.run_batch(inNames, inputs, outNames, outputs, nthreads=1)
+//                             one scenario per row of inputs, each starting from the current state of w
+//   w.address                 the wobos pointer, for the ctypes entry points of the same library
+// The object also exports its variable table through the buffer protocol (e.g. numpy.asarray(w)), without
+// copying.  run() and run_batch() release the GIL while the model computes, so threads with their own
+// objects run in parallel.  Calls on the same object from several threads take turns on a per-object lock;
+// only writes through the buffer are not covered by it.
+
+#include <Python.h>
+
+#include "lib_wind_obos.h"
+#include "lib_wind_obos_batch.h"
+
+#include <stdexcept>
+#include <vector>
+#include <string>
+#include <mutex>
+
+using namespace std;
+
+#if PY_MAJOR_VERSION >= 3
+#define PYWOBOS_STRING(obj) PyUnicode_AsUTF8(obj)
+#else
+#define PYWOBOS_STRING(obj) PyString_AsString(obj)
+#endif
+
+typedef struct {
+  PyObject_HEAD
+  wobos *obos;
+  mutex *lock;
+  Py_ssize_t shape;
+} pywobos_object;
+
+
+// Holds the lock of an object for the enclosing scope.  Waiting for it releases the GIL, as the thread
+// holding it may be computing without the GIL and must not be kept from finishing.
+class pywobos_guard {
+ public:
+  pywobos_guard(pywobos_object *self) : m(*self->lock) {
+    if (!m.try_lock()) {
+      Py_BEGIN_ALLOW_THREADS
+      m.lock();
+      Py_END_ALLOW_THREADS
+    }
+  }
+  ~pywobos_guard() {m.unlock();}
+ private:
+  mutex &m;
+};
+
+
+static PyObject* pywobos_new_object(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+  pywobos_object *self = (pywobos_object*)type->tp_alloc(type, 0);
+  if (self == NULL) return NULL;
+  try {
+    self->obos  = new wobos();
+    self->lock  = new mutex();
+    self->shape = NVARIABLES;
+  } catch(exception& e) {
+    Py_DECREF(self);
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+    return NULL;
+  }
+  return (PyObject*)self;
+}
+
+
+static void pywobos_dealloc(pywobos_object *self) {
+  delete self->obos;
+  delete self->lock;
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+
+// Variable index of an attribute name, -1 if it is not a variable
+static int pywobos_attribute_index(PyObject *name) {
+  const char *key = PYWOBOS_STRING(name);
+  if (key == NULL) {
+    PyErr_Clear();
+    return -1;
+  }
+  return wobos::variable_index(string(key));
+}
+
+
+static PyObject* pywobos_getattro(pywobos_object *self, PyObject *name) {
+  int id = pywobos_attribute_index(name);
+  if (id >= 0) {
+    pywobos_guard guard(self);
+    return PyFloat_FromDouble(self->obos->get_map_variable(id));
+  }
+  return PyObject_GenericGetAttr((PyObject*)self, name);
+}
+
+
+static int pywobos_setattro(pywobos_object *self, PyObject *name, PyObject *value) {
+  int id = pywobos_attribute_index(name);
+  if (id < 0) return PyObject_GenericSetAttr((PyObject*)self, name, value);
+  if (value == NULL) {
+    PyErr_SetString(PyExc_AttributeError, "wobos variables cannot be deleted");
+    return -1;
+  }
+  double val = PyFloat_AsDouble(value);
+  if ((val == -1.0) && PyErr_Occurred()) return -1;
+  pywobos_guard guard(self);
+  self->obos->set_map_variable(id, val);
+  return 0;
+}
+
+
+static PyObject* pywobos_run(pywobos_object *self, PyObject *args, PyObject *kwds) {
+  static const char *kwlist[] = {"incremental", NULL};
+  int incremental = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|i", (char**)kwlist, &incremental)) return NULL;
+
+  pywobos_guard guard(self);
+  wobos *obos = self->obos;
+  Py_BEGIN_ALLOW_THREADS
+  obos->map2variables();
+  obos->set_vessel_defaults();
+  if (incremental) obos->run_incremental();
+  else obos->run();
+  obos->variables2map();
+  Py_END_ALLOW_THREADS
+  Py_RETURN_NONE;
+}
+
+
+static PyObject* pywobos_get(pywobos_object *self, PyObject *arg) {
+  long id = PyLong_AsLong(arg);
+  if ((id == -1) && PyErr_Occurred()) return NULL;
+  pywobos_guard guard(self);
+  return PyFloat_FromDouble(self->obos->get_map_variable((int)id));
+}
+
+
+static PyObject* pywobos_set(pywobos_object *self, PyObject *args) {
+  int id;
+  double val;
+  if (!PyArg_ParseTuple(args, "id", &id, &val)) return NULL;
+  pywobos_guard guard(self);
+  self->obos->set_map_variable(id, val);
+  Py_RETURN_NONE;
+}
+
+
+// Strings of a sequence of names
+static bool pywobos_names(PyObject *seq, vector<string> &names) {
+  PyObject *fast = PySequence_Fast(seq, "variable names must be a sequence of strings");
+  if (fast == NULL) return false;
+  Py_ssize_t n = PySequence_Fast_GET_SIZE(fast);
+  for (Py_ssize_t k=0; k<n; k++) {
+    const char *name = PYWOBOS_STRING(PySequence_Fast_GET_ITEM(fast, k));
+    if (name == NULL) {
+      Py_DECREF(fast);
+      return false;
+    }
+    names.push_back(string(name));
+  }
+  Py_DECREF(fast);
+  return true;
+}
+
+
+// Contiguous buffer of doubles
+static bool pywobos_buffer(PyObject *obj, Py_buffer *view, int flags, const char *what) {
+  if (PyObject_GetBuffer(obj, view, flags | PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) return false;
+  if ((view->itemsize != sizeof(double)) || (view->format == NULL) || (string(view->format) != "d")) {
+    PyBuffer_Release(view);
+    PyErr_Format(PyExc_TypeError, "%s must be a contiguous array of float64", what);
+    return false;
+  }
+  return true;
+}
+
+
+static PyObject* pywobos_run_batch(pywobos_object *self, PyObject *args, PyObject *kwds) {
+  static const char *kwlist[] = {"input_names", "inputs", "output_names", "outputs", "nthreads", NULL};
+  PyObject *inNamesObj, *inObj, *outNamesObj, *outObj;
+  int nthreads = 1;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOOO|i", (char**)kwlist, &inNamesObj, &inObj, &outNamesObj, &outObj, &nthreads))
+    return NULL;
+
+  vector<string> inNames, outNames;
+  if (!pywobos_names(inNamesObj, inNames) || !pywobos_names(outNamesObj, outNames)) return NULL;
+
+  Py_buffer inView, outView;
+  if (!pywobos_buffer(inObj, &inView, PyBUF_SIMPLE, "inputs")) return NULL;
+  if (!pywobos_buffer(outObj, &outView, PyBUF_WRITABLE, "outputs")) {
+    PyBuffer_Release(&inView);
+    return NULL;
+  }
+
+  PyObject *result = NULL;
+  try {
+    // The scenarios run on copies, so the object is only locked while it is copied
+    wobos_batch batch(inNames, outNames);
+    {
+      pywobos_guard guard(self);
+      batch.set_baseline(*self->obos);
+    }
+
+    size_t nIn  = inNames.size();
+    size_t nOut = outNames.size();
+    size_t nValues = (size_t)inView.len / sizeof(double);
+    size_t nScenarios = (nIn > 0) ? nValues / nIn : 0;
+    if ( (nIn == 0) || (nScenarios*nIn != nValues) || ((size_t)outView.len != nScenarios*nOut*sizeof(double)) )
+      throw length_error("inputs and outputs must hold one row of input_names and output_names per scenario");
+
+    const double *inputs = (const double*)inView.buf;
+    double *outputs = (double*)outView.buf;
+    Py_BEGIN_ALLOW_THREADS
+    if (nthreads == 1) batch.run(inputs, nScenarios, outputs);
+    else batch.run_parallel(inputs, nScenarios, outputs, nthreads);
+    Py_END_ALLOW_THREADS
+    Py_INCREF(Py_None);
+    result = Py_None;
+  } catch(invalid_argument& e) {
+    PyErr_SetString(PyExc_KeyError, e.what());
+  } catch(length_error& e) {
+    PyErr_SetString(PyExc_ValueError, e.what());
+  } catch(exception& e) {
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+  }
+  PyBuffer_Release(&inView);
+  PyBuffer_Release(&outView);
+  return result;
+}
+
+
+static PyObject* pywobos_address(pywobos_object *self, void *closure) {
+  return PyLong_FromVoidPtr(self->obos);
+}
+
+
+// Buffer protocol: the variable table as a writable 1-D array of doubles
+static int pywobos_getbuffer(pywobos_object *self, Py_buffer *view, int flags) {
+  int ret = PyBuffer_FillInfo(view, (PyObject*)self, self->obos->variable_values(), NVARIABLES*sizeof(double), 0, flags);
+  if (ret < 0) return ret;
+  view->itemsize = sizeof(double);
+  view->format   = ((flags & PyBUF_FORMAT) == PyBUF_FORMAT) ? (char*)"d" : NULL;
+  view->ndim     = 1;
+  view->shape    = ((flags & PyBUF_ND) == PyBUF_ND) ? &self->shape : NULL;
+  view->strides  = NULL;
+  return 0;
+}
+
+
+static PyMethodDef pywobos_methods[] = {
+  {"run", (PyCFunction)pywobos_run, METH_VARARGS | METH_KEYWORDS,
+   "run(incremental=False): evaluate the model from the variable table and store the outputs there"},
+  {"get", (PyCFunction)pywobos_get, METH_O, "get(id): value of a variable by index"},
+  {"set", (PyCFunction)pywobos_set, METH_VARARGS, "set(id, value): set a variable by index, as set_map_variable"},
+  {"run_batch", (PyCFunction)pywobos_run_batch, METH_VARARGS | METH_KEYWORDS,
+   "run_batch(input_names, inputs, output_names, outputs, nthreads=1): evaluate one scenario per row of inputs"},
+  {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef pywobos_getset[] = {
+  {(char*)"address", (getter)pywobos_address, NULL, (char*)"address of the wobos object, for the ctypes interface", NULL},
+  {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyBufferProcs pywobos_as_buffer;
+static PyTypeObject pywobos_type = {PyVarObject_HEAD_INIT(NULL, 0)};
+
+
+static PyObject* pywobos_variable_names(PyObject *module, PyObject *unused) {
+  PyObject *out = PyList_New(NVARIABLES);
+  if (out == NULL) return NULL;
+  for (int k=0; k<NVARIABLES; k++) {
+#if PY_MAJOR_VERSION >= 3
+    PyObject *name = PyUnicode_FromString(wobos::variable_name(k));
+#else
+    PyObject *name = PyString_FromString(wobos::variable_name(k));
+#endif
+    if (name == NULL) {
+      Py_DECREF(out);
+      return NULL;
+    }
+    PyList_SET_ITEM(out, k, name);
+  }
+  return out;
+}
+
+static PyMethodDef pywobos_module_methods[] = {
+  {"variable_names", (PyCFunction)pywobos_variable_names, METH_NOARGS, "Names of the variable table, in table order"},
+  {NULL, NULL, 0, NULL}
+};
+
+
+static PyObject* pywobos_init_module() {
+  pywobos_as_buffer.bf_getbuffer = (getbufferproc)pywobos_getbuffer;
+
+  pywobos_type.tp_name      = "lib_wind_obos.wobos";
+  pywobos_type.tp_basicsize = sizeof(pywobos_object);
+  pywobos_type.tp_dealloc   = (destructor)pywobos_dealloc;
+  pywobos_type.tp_getattro  = (getattrofunc)pywobos_getattro;
+  pywobos_type.tp_setattro  = (setattrofunc)pywobos_setattro;
+  pywobos_type.tp_as_buffer = &pywobos_as_buffer;
+  pywobos_type.tp_flags     = Py_TPFLAGS_DEFAULT;
+  pywobos_type.tp_doc       = "Offshore balance of station model";
+  pywobos_type.tp_methods   = pywobos_methods;
+  pywobos_type.tp_getset    = pywobos_getset;
+  pywobos_type.tp_new       = pywobos_new_object;
+  if (PyType_Ready(&pywobos_type) < 0) return NULL;
+
+#if PY_MAJOR_VERSION >= 3
+  static PyModuleDef moduledef = {PyModuleDef_HEAD_INIT, "lib_wind_obos", "Offshore balance of station model", -1,
+				  pywobos_module_methods};
+  PyObject *module = PyModule_Create(&moduledef);
+#else
+  PyObject *module = Py_InitModule3("lib_wind_obos", pywobos_module_methods, "Offshore balance of station model");
+#endif
+  if (module == NULL) return NULL;
+
+  Py_INCREF(&pywobos_type);
+  if (PyModule_AddObject(module, "wobos", (PyObject*)&pywobos_type) < 0) {
+    Py_DECREF(&pywobos_type);
+    Py_DECREF(module);
+    return NULL;
+  }
+  return module;
+}
+
+#if PY_MAJOR_VERSION >= 3
+PyMODINIT_FUNC PyInit_lib_wind_obos() {return pywobos_init_module();}
+#else
+PyMODINIT_FUNC initlib_wind_obos() {pywobos_init_module();}
+#endif
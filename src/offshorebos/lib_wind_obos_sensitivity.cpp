@@ -0,0 +1,285 @@
+#include "lib_wind_obos_sensitivity.h"
+#include "lib_wind_obos_montecarlo.h"
+#include "lib_wind_obos_defaults.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+// For Python wrapping with c_types
+extern "C" {
+  wobos_sensitivity* pywobos_sa_new(const char** inNames, const double* lo, const double* hi, int nIn, const char** outNames, int nOut) {
+    try {
+      return new wobos_sensitivity(vector<string>(inNames, inNames+nIn), vector<double>(lo, lo+nIn), vector<double>(hi, hi+nIn),
+				   vector<string>(outNames, outNames+nOut));
+    } catch(exception& e) {
+      cout << e.what() << endl;
+      return NULL;
+    }
+  }
+  int pywobos_sa_default_bounds(const char* name, double spread, double* lo, double* hi) {
+    return wobos_sensitivity::default_bounds(string(name), spread, *lo, *hi) ? 1 : 0;
+  }
+  void pywobos_sa_set_baseline(wobos_sensitivity* sa, wobos* obos) {sa->set_baseline(*obos);}
+  void pywobos_sa_sobol(wobos_sensitivity* sa, double nBase, double seed, int nthreads, double* first, double* total) {
+    sa->sobol((size_t)nBase, (uint64_t)seed, nthreads, first, total);
+  }
+  int pywobos_sa_morris(wobos_sensitivity* sa, double nTrajectories, int levels, double seed, int nthreads,
+			double* mu, double* muStar, double* sigma) {
+    try {
+      sa->morris((size_t)nTrajectories, levels, (uint64_t)seed, nthreads, mu, muStar, sigma);
+      return 1;
+    } catch(exception& e) {
+      cout << e.what() << endl;
+      return 0;
+    }
+  }
+  void pywobos_sa_delete(wobos_sensitivity* sa) {delete sa;}
+}
+
+
+const size_t wobos_sensitivity::BLOCK;
+
+
+void wobos_sensitivity::moments::add(double x) {
+  n += 1.0;
+  double delta = x - mean;
+  mean += delta / n;
+  m2   += delta * (x - mean);
+}
+
+
+void wobos_sensitivity::moments::merge(const moments &other) {
+  if (other.n == 0.0) return;
+  double total = n + other.n;
+  double delta = other.mean - mean;
+  mean += delta * other.n / total;
+  m2   += other.m2 + delta * delta * n * other.n / total;
+  n     = total;
+}
+
+
+bool wobos_sensitivity::default_bounds(const string &name, double spread, double &lo, double &hi) {
+  int id = wobos::variable_index(name);
+  if (id < 0) return false;
+  const vector<variable> &vars = wind_obos_defaults::instance().variables;
+  for (size_t k=0; k<vars.size(); k++) {
+    const variable &var = vars[k];
+    if (var.name != name) continue;
+    if (!var.isInput() || !var.isDouble() || (var.constraints == "INTEGER")) return false;
+
+    // Constraints look like MIN=2,MAX=200 (underscores are read as commas)
+    bool hasMin = false, hasMax = false;
+    stringstream ss(var.constraints);
+    string item;
+    while (getline(ss, item, ',')) {
+      if (item.compare(0, 4, "MIN=") == 0) {lo = atof(item.c_str() + 4); hasMin = true;}
+      if (item.compare(0, 4, "MAX=") == 0) {hi = atof(item.c_str() + 4); hasMax = true;}
+    }
+    if ((var.value == 0.0) && !(hasMin && hasMax)) return false;
+    if (!hasMin) lo = var.value - spread * fabs(var.value);
+    if (!hasMax) hi = var.value + spread * fabs(var.value);
+    // set_map_variable reads percent values above 1 as percentages
+    if (wobos::variable_flags(id) & VAR_PERCENT) hi = min(hi, 1.0);
+    return lo < hi;
+  }
+  return false;
+}
+
+
+wobos_sensitivity::wobos_sensitivity(vector<string> inNames, vector<double> lo, vector<double> hi, vector<string> outNames) :
+  inputNames(inNames), lower(lo), upper(hi), outputNames(outNames), batch(inNames, outNames) {
+  if ((lower.size() != inputNames.size()) || (upper.size() != inputNames.size()))
+    throw invalid_argument("Need lower and upper bounds for every input variable");
+  for (size_t k=0; k<inputNames.size(); k++)
+    if (!(lower[k] <= upper[k])) throw invalid_argument("Lower bound above upper bound for " + inputNames[k]);
+}
+
+
+// The stream of a block depends on nothing but the seed and its first sample
+static void seed_block(mt19937_64 &rng, uint64_t seed, size_t first) {
+  seed_seq seq = {(uint32_t)seed, (uint32_t)(seed >> 32), (uint32_t)first, (uint32_t)((uint64_t)first >> 32)};
+  rng.seed(seq);
+}
+
+
+void wobos_sensitivity::sobol_block(wobos_batch &worker, uint64_t seed, size_t first, size_t n,
+				    vector<double> &inputs, vector<double> &outputs, vector<sobol_sums> &sums) {
+  const size_t d    = nInputs();
+  const size_t nOut = nOutputs();
+  const size_t rows = d + 2;  // A, B, then AB_i for every input
+  mt19937_64 rng;
+  seed_block(rng, seed, first);
+
+  vector<wobos_distribution> ranges;
+  for (size_t i=0; i<d; i++) ranges.push_back( wobos_distribution(wobos_distribution::UNIFORM, lower[i], upper[i]) );
+
+  vector<double> a(d), b(d);
+  for (size_t j=0; j<n; j++) {
+    for (size_t i=0; i<d; i++) a[i] = ranges[i].sample(rng);
+    for (size_t i=0; i<d; i++) b[i] = ranges[i].sample(rng);
+    double* block = &inputs[j*rows*d];
+    copy(a.begin(), a.end(), block);
+    copy(b.begin(), b.end(), block + d);
+    for (size_t i=0; i<d; i++) {
+      double* row = block + (2+i)*d;
+      copy(a.begin(), a.end(), row);
+      row[i] = b[i];
+    }
+  }
+
+  worker.run(&inputs[0], n*rows, &outputs[0]);
+
+  for (size_t j=0; j<n; j++) {
+    const double* out = &outputs[j*rows*nOut];
+    for (size_t k=0; k<nOut; k++) {
+      bool finite = true;
+      for (size_t r=0; r<rows; r++) finite = finite && std::isfinite(out[r*nOut + k]);
+      if (!finite) continue;
+
+      double fA = out[k];
+      double fB = out[nOut + k];
+      sobol_sums &s = sums[k];
+      s.f.add(fA);
+      s.f.add(fB);
+      s.n += 1.0;
+      s.sumB += fB;
+      for (size_t i=0; i<d; i++) {
+	double fAB = out[(2+i)*nOut + k];
+	s.sumD[i]  += fAB - fA;
+	s.first[i] += fB * (fAB - fA);
+	s.total[i] += (fA - fAB) * (fA - fAB);
+      }
+    }
+  }
+}
+
+
+void wobos_sensitivity::sobol(size_t nBase, uint64_t seed, int nthreads, double* first, double* total) {
+  const size_t d = nInputs();
+  sobol_sums zeroSums;
+  zeroSums.n = 0.0;
+  zeroSums.sumB = 0.0;
+  zeroSums.sumD.assign(d, 0.0);
+  zeroSums.first.assign(d, 0.0);
+  zeroSums.total.assign(d, 0.0);
+  vector<sobol_sums> zero(nOutputs(), zeroSums), sums(zero);
+
+  auto scratch = [&] () {return wobos_batch_scratch(batch, BLOCK*(d+2));};
+  auto work = [&] (wobos_batch_scratch &s, size_t b, vector<sobol_sums> &blockSums) {
+    size_t start = b * BLOCK;
+    sobol_block(s.worker, seed, start, min(BLOCK, nBase - start), s.inputs, s.outputs, blockSums);
+  };
+  auto merge = [&] (const vector<sobol_sums> &blockSums) {
+    for (size_t k=0; k<sums.size(); k++) {
+      sums[k].f.merge(blockSums[k].f);
+      sums[k].n += blockSums[k].n;
+      sums[k].sumB += blockSums[k].sumB;
+      for (size_t i=0; i<d; i++) {
+	sums[k].sumD[i]  += blockSums[k].sumD[i];
+	sums[k].first[i] += blockSums[k].first[i];
+	sums[k].total[i] += blockSums[k].total[i];
+      }
+    }
+  };
+  run_blocks((nBase + BLOCK - 1) / BLOCK, nthreads, scratch, zero, work, merge);
+
+  for (size_t k=0; k<sums.size(); k++) {
+    double variance = (sums[k].f.n > 0.0) ? sums[k].f.m2 / sums[k].f.n : 0.0;
+    double n = sums[k].n;
+    for (size_t i=0; i<d; i++) {
+      bool valid = (variance > 0.0) && (n > 0.0);
+      double covariance = sums[k].first[i] / n - (sums[k].sumB / n) * (sums[k].sumD[i] / n);
+      first[k*d + i] = valid ? covariance / variance : 0.0;
+      total[k*d + i] = valid ? 0.5 * sums[k].total[i] / sums[k].n / variance : 0.0;
+    }
+  }
+}
+
+
+void wobos_sensitivity::morris_block(wobos_batch &worker, int levels, uint64_t seed, size_t first, size_t n,
+				     vector<double> &inputs, vector<double> &outputs, vector<morris_sums> &sums) {
+  const size_t d    = nInputs();
+  const size_t nOut = nOutputs();
+  const size_t rows = d + 1;
+  const double delta = levels / (2.0 * (levels - 1));
+  mt19937_64 rng;
+  seed_block(rng, seed, first);
+
+  // Every trajectory starts on a random grid point and moves one input at a time, in random order, by delta
+  vector<size_t> order(n*d);
+  vector<double> step(n*d);
+  vector<double> x(d);
+  for (size_t t=0; t<n; t++) {
+    size_t* perm = &order[t*d];
+    for (size_t i=0; i<d; i++) {
+      x[i] = (double)(rng() % levels) / (levels - 1);
+      perm[i] = i;
+    }
+    for (size_t i=d; i-- > 1; ) swap(perm[i], perm[rng() % (i+1)]);
+
+    double* block = &inputs[t*rows*d];
+    for (size_t r=0; r<rows; r++) {
+      if (r > 0) {
+	size_t i = perm[r-1];
+	step[t*d + r-1] = (x[i] + delta <= 1.0 + 1e-12) ? delta : -delta;
+	x[i] += step[t*d + r-1];
+      }
+      for (size_t i=0; i<d; i++) block[r*d + i] = lower[i] + x[i] * (upper[i] - lower[i]);
+    }
+  }
+
+  worker.run(&inputs[0], n*rows, &outputs[0]);
+
+  for (size_t t=0; t<n; t++) {
+    const double* out = &outputs[t*rows*nOut];
+    for (size_t k=0; k<nOut; k++)
+      for (size_t r=1; r<rows; r++) {
+	double f0 = out[(r-1)*nOut + k];
+	double f1 = out[r*nOut + k];
+	if (!std::isfinite(f0) || !std::isfinite(f1)) continue;
+	size_t i = order[t*d + r-1];
+	double effect = (f1 - f0) / step[t*d + r-1];
+	sums[k].effects[i].add(effect);
+	sums[k].absEffects[i].add(fabs(effect));
+      }
+  }
+}
+
+
+void wobos_sensitivity::morris(size_t nTrajectories, int levels, uint64_t seed, int nthreads, double* mu, double* muStar, double* sigma) {
+  // With an odd number of levels, some grid points could step neither up nor down by delta
+  if ((levels < 2) || (levels % 2 != 0)) throw invalid_argument("Morris levels must be even and at least 2");
+
+  const size_t d = nInputs();
+  morris_sums zeroSums;
+  zeroSums.effects.assign(d, moments());
+  zeroSums.absEffects.assign(d, moments());
+  vector<morris_sums> zero(nOutputs(), zeroSums), sums(zero);
+
+  auto scratch = [&] () {return wobos_batch_scratch(batch, BLOCK*(d+1));};
+  auto work = [&] (wobos_batch_scratch &s, size_t b, vector<morris_sums> &blockSums) {
+    size_t start = b * BLOCK;
+    morris_block(s.worker, levels, seed, start, min(BLOCK, nTrajectories - start), s.inputs, s.outputs, blockSums);
+  };
+  auto merge = [&] (const vector<morris_sums> &blockSums) {
+    for (size_t k=0; k<sums.size(); k++)
+      for (size_t i=0; i<d; i++) {
+	sums[k].effects[i].merge(blockSums[k].effects[i]);
+	sums[k].absEffects[i].merge(blockSums[k].absEffects[i]);
+      }
+  };
+  run_blocks((nTrajectories + BLOCK - 1) / BLOCK, nthreads, scratch, zero, work, merge);
+
+  for (size_t k=0; k<sums.size(); k++)
+    for (size_t i=0; i<d; i++) {
+      const moments &e = sums[k].effects[i];
+      mu[k*d + i]     = e.mean;
+      muStar[k*d + i] = sums[k].absEffects[i].mean;
+      sigma[k*d + i]  = (e.n > 1.0) ? sqrt(e.m2 / (e.n - 1.0)) : 0.0;
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef __wind_obos_sensitivity_h
+#define __wind_obos_sensitivity_h
+
+#include "lib_wind_obos_batch.h"
+#include <vector>
+#include <string>
+#include <random>
+#include <cstdint>
+
+// Global sensitivity of wobos outputs to inputs varied uniformly between lower and upper bounds.
+//
+// sobol() estimates variance-based indices from N base samples with the Saltelli scheme: two independent
+// sample matrices A and B, and for every input i the matrix AB_i of A with column i taken from B, which is
+// N*(d+2) runs for d inputs.  First-order indices use the Saltelli (2010) estimator, centered as the
+// covariance of f(B) and f(AB_i) - f(A) (same expectation, far less noise when the mean of the output is
+// large next to its spread), and total indices the Jansen estimator.  The sample matrices are
+// pseudo-random rather than a Sobol sequence.
+//
+// morris() screens inputs with Morris elementary effects: r one-at-a-time trajectories of d+1 runs on a
+// grid of p levels.  Effects are per full range of each input, so mu* ranks inputs on the same scale.
+//
+// Runs go through wobos_batch workers, one per thread, in blocks of base samples (or trajectories) with
+// their own random streams, merged in block order, so results do not depend on the number of threads
+// (see wobos_montecarlo).  Samples where an output is NaN are left out of that output's indices.
+class wobos_sensitivity {
+ public:
+  static const size_t BLOCK = 8;
+
+  vector<string> inputNames;
+  vector<double> lower, upper;
+  vector<string> outputNames;
+
+  size_t nInputs() {return inputNames.size();}
+  size_t nOutputs() {return outputNames.size();}
+
+  // Indices are nOutputs() x nInputs(), row-major
+  void sobol(size_t nBase, uint64_t seed, int nthreads, double* first, double* total);
+  void morris(size_t nTrajectories, int levels, uint64_t seed, int nthreads, double* mu, double* muStar, double* sigma);
+
+  // Start every run from the variables of obos instead of the defaults
+  void set_baseline(const wobos &obos) {batch.set_baseline(obos);}
+
+  // Bounds of a continuous input from the Constraints column of the defaults (MIN=.._MAX=..), with a
+  // missing bound at the default value -/+ spread times its magnitude.  Percent inputs stay fractions.
+  // False for outputs, enumerated inputs and inputs that run() fills in when zero (zero default, no bounds).
+  static bool default_bounds(const string &name, double spread, double &lo, double &hi);
+
+  // Constructors
+  wobos_sensitivity(vector<string> inNames, vector<double> lo, vector<double> hi, vector<string> outNames);
+
+ private:
+  wobos_batch batch;
+
+  // Count, mean and sum of squared deviations, merged with Chan's formula
+  struct moments {
+    double n, mean, m2;
+    void add(double x);
+    void merge(const moments &other);
+    moments() : n(0.0), mean(0.0), m2(0.0) {}
+  };
+
+  // Per-output sums of one block of samples
+  struct sobol_sums {
+    moments f;                   // model values of A and B, for the total variance
+    double n;                    // base samples with every run finite
+    double sumB;                 // sum of f(B)
+    vector<double> sumD;         // sums of f(AB_i) - f(A)
+    vector<double> first, total; // sums of f(B) * (f(AB_i) - f(A)) and (f(A) - f(AB_i))^2
+  };
+  struct morris_sums {
+    vector<moments> effects, absEffects;
+  };
+
+  void sobol_block(wobos_batch &worker, uint64_t seed, size_t first, size_t n,
+		   vector<double> &inputs, vector<double> &outputs, vector<sobol_sums> &sums);
+  void morris_block(wobos_batch &worker, int levels, uint64_t seed, size_t first, size_t n,
+		    vector<double> &inputs, vector<double> &outputs, vector<morris_sums> &sums);
+};
+
+#endif
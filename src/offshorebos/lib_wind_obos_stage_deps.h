@@ -0,0 +1,73 @@
+// Generated by make_stage_deps.py from lib_wind_obos.cpp, do not edit by hand
+// Variables that each stage of wobos::run() uses, indexed like the STAGE_ enum in lib_wind_obos_profile.h
+#define NRUNSTAGES 8
+static const int wobos_stage_variables[] = {
+  // set_turbine_parameters
+  VAR_rotorD, VAR_turbR, VAR_hubH, VAR_hubD, VAR_bladeL, VAR_max_chord,
+  VAR_nacelleW, VAR_nacelleL, VAR_rnaM, VAR_towerD, VAR_towerM,
+  // calculate_substructure_mass_cost
+  VAR_substructure, VAR_anchor, VAR_nTurb, VAR_turbR, VAR_hubH, VAR_waterD,
+  VAR_moorLines, VAR_mpileCR, VAR_mtransCR, VAR_mpileD, VAR_mpileL, VAR_jlatticeCR,
+  VAR_jtransCR, VAR_jpileCR, VAR_spStifColCR, VAR_spTapColCR, VAR_ballCR, VAR_deaFixLeng,
+  VAR_ssStifColCR, VAR_ssTrussCR, VAR_ssHeaveCR, VAR_sSteelCR, VAR_moorDia, VAR_moorCR,
+  VAR_mpEmbedL, VAR_rnaM, VAR_subTotM, VAR_subTotCost, VAR_moorCost,
+  // calculate_electrical_infrastructure_cost
+  VAR_substructure, VAR_cableOptimizer, VAR_nTurb, VAR_rotorD, VAR_turbR, VAR_waterD,
+  VAR_distShore, VAR_distPort, VAR_buryDepth, VAR_arrayY, VAR_arrayX, VAR_elecCont,
+  VAR_interConVolt, VAR_distInterCon, VAR_ssStifColCR, VAR_ssTrussCR, VAR_ssHeaveCR, VAR_sSteelCR,
+  VAR_pwrFac, VAR_buryFac, VAR_arrVoltage, VAR_arrCab1Mass, VAR_cab1CurrRating, VAR_cab1CR,
+  VAR_cab1TurbInterCR, VAR_arrCab2Mass, VAR_cab2CurrRating, VAR_cab2CR, VAR_cab2TurbInterCR, VAR_cab2SubsInterCR,
+  VAR_catLengFac, VAR_exCabFac, VAR_subsTopFab, VAR_subsTopDes, VAR_topAssemblyFac, VAR_subsJackCR,
+  VAR_subsPileCR, VAR_dynCabFac, VAR_shuntCR, VAR_highVoltSG, VAR_medVoltSG, VAR_backUpGen,
+  VAR_workSpace, VAR_otherAncillary, VAR_mptCR, VAR_expVoltage, VAR_expCabMass, VAR_expCabCR,
+  VAR_expCurrRating, VAR_expSubsInterCR, VAR_surfLayRate, VAR_cabPullIn, VAR_cabTerm, VAR_cabLoadout,
+  VAR_buryRate, VAR_subsPullIn, VAR_shorePullIn, VAR_landConstruct, VAR_expCabLoad, VAR_cabSurveyCR,
+  VAR_moorCost, VAR_systAngle, VAR_freeCabLeng, VAR_fixCabLeng, VAR_nExpCab, VAR_expCabLeng,
+  VAR_expCabCost, VAR_nSubstation, VAR_cab1Leng, VAR_cab2Leng, VAR_arrCab1Cost, VAR_arrCab2Cost,
+  VAR_subsSubM, VAR_subsPileM, VAR_subsTopM, VAR_totElecCost, VAR_arrInstTime, VAR_expInstTime,
+  // calculate_assembly_and_installation
+  VAR_substructure, VAR_anchor, VAR_turbInstallMethod, VAR_towerInstallMethod, VAR_installStrategy, VAR_installSimulation,
+  VAR_nTurb, VAR_rotorD, VAR_waterD, VAR_distPort, VAR_distPtoA, VAR_distAtoS,
+  VAR_moorLines, VAR_arrayY, VAR_arrayX, VAR_substructCont, VAR_turbCont, VAR_elecCont,
+  VAR_number_install_seasons, VAR_installSeasonLength, VAR_installStartHour, VAR_inspectClear, VAR_mpileD, VAR_mpileL,
+  VAR_jlatticeA, VAR_jpileL, VAR_jpileD, VAR_mpEmbedL, VAR_scourMat, VAR_moorTimeFac,
+  VAR_moorLoadout, VAR_moorSurvey, VAR_prepAA, VAR_prepSpar, VAR_upendSpar, VAR_prepSemi,
+  VAR_turbFasten, VAR_boltTower, VAR_boltNacelle1, VAR_boltNacelle2, VAR_boltNacelle3, VAR_boltBlade1,
+  VAR_boltBlade2, VAR_boltRotor, VAR_vesselPosTurb, VAR_vesselPosJack, VAR_vesselPosMono, VAR_subsVessPos,
+  VAR_monoFasten, VAR_jackFasten, VAR_prepGripperMono, VAR_prepGripperJack, VAR_placePiles, VAR_prepHamMono,
+  VAR_removeHamMono, VAR_prepHamJack, VAR_removeHamJack, VAR_placeJack, VAR_levJack, VAR_placeTemplate,
+  VAR_hamRate, VAR_placeMP, VAR_instScour, VAR_placeTP, VAR_groutTP, VAR_tpCover,
+  VAR_prepTow, VAR_spMoorCon, VAR_ssMoorCon, VAR_spMoorCheck, VAR_ssMoorCheck, VAR_ssBall,
+  VAR_landConstruct, VAR_subsLoad, VAR_placeTop, VAR_pileSpreadDR, VAR_pileSpreadMob, VAR_groutSpreadDR,
+  VAR_groutSpreadMob, VAR_seaSpreadDR, VAR_seaSpreadMob, VAR_compRacks, VAR_cabSurveyCR, VAR_cabDrillDist,
+  VAR_cabDrillCR, VAR_mpvRentalDR, VAR_diveTeamDR, VAR_winchDR, VAR_civilWork, VAR_elecWork,
+  VAR_hubD, VAR_bladeL, VAR_max_chord, VAR_nacelleW, VAR_nacelleL, VAR_rnaM,
+  VAR_towerD, VAR_towerM, VAR_subTotM, VAR_expCabLeng, VAR_cab1Leng, VAR_cab2Leng,
+  VAR_moorTime, VAR_floatPrepTime, VAR_turbDeckArea, VAR_nTurbPerTrip, VAR_turbInstTime, VAR_subDeckArea,
+  VAR_nSubPerTrip, VAR_subInstTime, VAR_arrInstTime, VAR_expInstTime, VAR_subsInstTime, VAR_totInstTime,
+  VAR_cabSurvey, VAR_array_cable_install_cost, VAR_export_cable_install_cost, VAR_substation_install_cost, VAR_turbine_install_cost, VAR_substructure_install_cost,
+  VAR_electrical_install_cost, VAR_mob_demob_cost, VAR_installSeasons, VAR_totAnICost,
+  // calculate_port_and_staging_costs
+  VAR_substructure, VAR_installStrategy, VAR_nTurb, VAR_placeTop, VAR_nCrane600, VAR_nCrane1000,
+  VAR_crane600DR, VAR_crane1000DR, VAR_craneMobDemob, VAR_entranceExitRate, VAR_dockRate, VAR_wharfRate,
+  VAR_laydownCR, VAR_rnaM, VAR_towerM, VAR_subTotM, VAR_subsSubM, VAR_subsPileM,
+  VAR_subsTopM, VAR_moorTime, VAR_floatPrepTime, VAR_turbDeckArea, VAR_nTurbPerTrip, VAR_turbInstTime,
+  VAR_subDeckArea, VAR_nSubPerTrip, VAR_subInstTime, VAR_subsInstTime, VAR_totPnSCost,
+  // calculate_engineering_management_cost
+  VAR_estEnMFac, VAR_subTotCost, VAR_totElecCost, VAR_totPnSCost, VAR_totAnICost, VAR_totEnMCost,
+  // calculate_development_cost
+  VAR_nTurb, VAR_turbR, VAR_preFEEDStudy, VAR_feedStudy, VAR_stateLease, VAR_outConShelfLease,
+  VAR_saPlan, VAR_conOpPlan, VAR_nepaEisMet, VAR_physResStudyMet, VAR_bioResStudyMet, VAR_socEconStudyMet,
+  VAR_navStudyMet, VAR_nepaEisProj, VAR_physResStudyProj, VAR_bioResStudyProj, VAR_socEconStudyProj, VAR_navStudyProj,
+  VAR_coastZoneManAct, VAR_rivsnHarbsAct, VAR_cleanWatAct402, VAR_cleanWatAct404, VAR_faaPlan, VAR_endSpecAct,
+  VAR_marMamProtAct, VAR_migBirdAct, VAR_natHisPresAct, VAR_addLocPerm, VAR_metTowCR, VAR_totDevCost,
+  // calculate_bos_cost
+  VAR_substructure, VAR_turbCapEx, VAR_nTurb, VAR_turbR, VAR_scrapVal, VAR_projLife,
+  VAR_plantComm, VAR_procurement_contingency, VAR_install_contingency, VAR_construction_insurance, VAR_capital_cost_year_0, VAR_capital_cost_year_1,
+  VAR_capital_cost_year_2, VAR_capital_cost_year_3, VAR_capital_cost_year_4, VAR_capital_cost_year_5, VAR_tax_rate, VAR_interest_during_construction,
+  VAR_decomDiscRate, VAR_subTotCost, VAR_totElecCost, VAR_moorTime, VAR_turbInstTime, VAR_subInstTime,
+  VAR_arrInstTime, VAR_expInstTime, VAR_subsInstTime, VAR_totInstTime, VAR_totPnSCost, VAR_totDevCost,
+  VAR_bos_capex, VAR_construction_insurance_cost, VAR_total_contingency_cost, VAR_construction_finance_cost, VAR_construction_finance_factor, VAR_soft_costs,
+  VAR_totAnICost, VAR_totEnMCost, VAR_commissioning, VAR_decomCost, VAR_total_bos_cost,
+};
+static const int wobos_stage_offsets[NRUNSTAGES+1] = {0, 11, 40, 118, 242, 271, 277, 307, 348};
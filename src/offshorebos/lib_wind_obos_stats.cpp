@@ -0,0 +1,312 @@
+#include "lib_wind_obos_stats.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+
+
+wobos_quantile_sketch::wobos_quantile_sketch(double alpha, size_t maxBuckets) : alpha(alpha), maxBuckets(max(maxBuckets, (size_t)2)) {
+  gamma    = (1.0 + alpha) / (1.0 - alpha);
+  logGamma = log(gamma);
+  // Smallest magnitude with a bucket of its own; anything closer to zero counts as zero
+  minValue = numeric_limits<double>::min() * gamma;
+  zeros    = negInfs = posInfs = 0.0;
+}
+
+
+int wobos_quantile_sketch::key(double x) const {
+  return (int)ceil(log(x) / logGamma);
+}
+
+
+double wobos_quantile_sketch::value(int key) const {
+  // Value within alpha of everything in (gamma^(key-1), gamma^key]
+  return 2.0 * pow(gamma, key) / (gamma + 1.0);
+}
+
+
+void wobos_quantile_sketch::store::add(int key, double weight, size_t maxBuckets) {
+  if (counts.empty()) {
+    offset = key;
+    counts.push_back(0.0);
+  }
+
+  // Keys that no longer fit below the highest maxBuckets keys go into the lowest bucket that does
+  int top = offset + (int)counts.size() - 1;
+  int lo  = min(key, offset);
+  int hi  = max(key, top);
+  if (hi - lo >= (int)maxBuckets) lo = hi - (int)maxBuckets + 1;
+  if ((lo != offset) || (hi != top)) {
+    vector<double> grown(hi - lo + 1, 0.0);
+    for (size_t k=0; k<counts.size(); k++) grown[max(offset + (int)k, lo) - lo] += counts[k];
+    counts.swap(grown);
+    offset = lo;
+  }
+  counts[max(key, lo) - lo] += weight;
+}
+
+
+void wobos_quantile_sketch::add(double x, double weight) {
+  if (std::isnan(x)) return;
+  if (std::isinf(x)) (x > 0.0 ? posInfs : negInfs) += weight;
+  else if (x > minValue) positive.add(key(x), weight, maxBuckets);
+  else if (x < -minValue) negative.add(key(-x), weight, maxBuckets);
+  else zeros += weight;
+}
+
+
+void wobos_quantile_sketch::merge(const wobos_quantile_sketch &other) {
+  for (size_t k=0; k<other.positive.counts.size(); k++)
+    if (other.positive.counts[k] > 0.0) positive.add(other.positive.offset + (int)k, other.positive.counts[k], maxBuckets);
+  for (size_t k=0; k<other.negative.counts.size(); k++)
+    if (other.negative.counts[k] > 0.0) negative.add(other.negative.offset + (int)k, other.negative.counts[k], maxBuckets);
+  zeros   += other.zeros;
+  negInfs += other.negInfs;
+  posInfs += other.posInfs;
+}
+
+
+void wobos_quantile_sketch::clear() {
+  positive = store();
+  negative = store();
+  zeros    = negInfs = posInfs = 0.0;
+}
+
+
+double wobos_quantile_sketch::count() const {
+  double n = zeros + negInfs + posInfs;
+  for (size_t k=0; k<positive.counts.size(); k++) n += positive.counts[k];
+  for (size_t k=0; k<negative.counts.size(); k++) n += negative.counts[k];
+  return n;
+}
+
+
+void wobos_quantile_sketch::buckets(vector<double> &values, vector<double> &counts) const {
+  values.clear();
+  counts.clear();
+  if (negInfs > 0.0) {
+    values.push_back(-numeric_limits<double>::infinity());
+    counts.push_back(negInfs);
+  }
+  for (size_t k=negative.counts.size(); k-- > 0; )
+    if (negative.counts[k] > 0.0) {
+      values.push_back(-value(negative.offset + (int)k));
+      counts.push_back(negative.counts[k]);
+    }
+  if (zeros > 0.0) {
+    values.push_back(0.0);
+    counts.push_back(zeros);
+  }
+  for (size_t k=0; k<positive.counts.size(); k++)
+    if (positive.counts[k] > 0.0) {
+      values.push_back(value(positive.offset + (int)k));
+      counts.push_back(positive.counts[k]);
+    }
+  if (posInfs > 0.0) {
+    values.push_back(numeric_limits<double>::infinity());
+    counts.push_back(posInfs);
+  }
+}
+
+
+double wobos_quantile_sketch::quantile(double q) const {
+  vector<double> values, counts;
+  buckets(values, counts);
+  if (values.empty()) return numeric_limits<double>::quiet_NaN();
+
+  double total = 0.0;
+  for (size_t k=0; k<counts.size(); k++) total += counts[k];
+  double rank = min(max(q, 0.0), 1.0) * (total - 1.0);
+  double seen = 0.0;
+  for (size_t k=0; k<counts.size(); k++) {
+    seen += counts[k];
+    if (seen > rank) return values[k];
+  }
+  return values.back();
+}
+
+
+// Floor of key / 2^n for negative keys as well
+static int64_t floor_shift(int64_t key, int n) {
+  if (n >= 63) return (key < 0) ? -1 : 0;
+  return (key >= 0) ? (key >> n) : -(((-key) - 1) >> n) - 1;
+}
+
+
+wobos_histogram::wobos_histogram(size_t maxBins) : maxBins(max(maxBins, (size_t)2)) {
+  clear();
+}
+
+
+void wobos_histogram::clear() {
+  exponent = numeric_limits<double>::min_exponent - numeric_limits<double>::digits;
+  offset   = 0;
+  counts.clear();
+}
+
+
+double wobos_histogram::width() const {
+  return ldexp(1.0, exponent);
+}
+
+
+double wobos_histogram::lower() const {
+  return ldexp((double)offset, exponent);
+}
+
+
+void wobos_histogram::coarsen(int steps) {
+  if (steps <= 0) return;
+  exponent += steps;
+  if (counts.empty()) return;
+  int64_t lo = floor_shift(offset, steps);
+  int64_t hi = floor_shift(offset + (int64_t)counts.size() - 1, steps);
+  vector<double> merged(hi - lo + 1, 0.0);
+  for (size_t k=0; k<counts.size(); k++) merged[floor_shift(offset + (int64_t)k, steps) - lo] += counts[k];
+  counts.swap(merged);
+  offset = lo;
+}
+
+
+bool wobos_histogram::place(int64_t key, double weight) {
+  if (counts.empty()) {
+    offset = key;
+    counts.assign(1, weight);
+    return true;
+  }
+  int64_t top = offset + (int64_t)counts.size() - 1;
+  int64_t lo  = min(key, offset);
+  int64_t hi  = max(key, top);
+  if (hi - lo >= (int64_t)maxBins) return false;
+  if ((lo != offset) || (hi != top)) {
+    vector<double> grown(hi - lo + 1, 0.0);
+    copy(counts.begin(), counts.end(), grown.begin() + (offset - lo));
+    counts.swap(grown);
+    offset = lo;
+  }
+  counts[key - offset] += weight;
+  return true;
+}
+
+
+void wobos_histogram::add(double x, double weight) {
+  if (!std::isfinite(x)) return;
+  // The first value sets the finest width that keeps keys of its magnitude well within 64 bits
+  if (counts.empty() && (x != 0.0)) exponent = max(exponent, ilogb(x) - numeric_limits<double>::digits);
+  double scaled = ldexp(x, -exponent);
+  if (fabs(scaled) >= ldexp(1.0, 62)) coarsen(ilogb(scaled) - 61);
+  while (!place((int64_t)floor(ldexp(x, -exponent)), weight)) coarsen(1);
+}
+
+
+void wobos_histogram::merge(const wobos_histogram &other) {
+  if (other.counts.empty()) return;
+  if (counts.empty()) {
+    exponent = other.exponent;
+    offset   = other.offset;
+    counts   = other.counts;
+    return;
+  }
+  coarsen(other.exponent - exponent);
+  for (size_t k=0; k<other.counts.size(); k++)
+    if (other.counts[k] > 0.0)
+      while (!place(floor_shift(other.offset + (int64_t)k, exponent - other.exponent), other.counts[k])) coarsen(1);
+}
+
+
+wobos_stats::wobos_stats(double alpha, size_t maxBuckets) : sketch(alpha, maxBuckets) {
+  clear();
+}
+
+
+void wobos_stats::clear() {
+  count = nans = infs = mean = m2 = 0.0;
+  min   = numeric_limits<double>::infinity();
+  max   = -numeric_limits<double>::infinity();
+  sketch.clear();
+  bins.clear();
+}
+
+
+void wobos_stats::add(double x) {
+  if (std::isnan(x)) {
+    nans += 1.0;
+    return;
+  }
+  count += 1.0;
+  min    = std::min(min, x);
+  max    = std::max(max, x);
+  sketch.add(x);
+  if (std::isinf(x)) {
+    infs += 1.0;
+    return;
+  }
+  double delta = x - mean;
+  mean += delta / (count - infs);
+  m2   += delta * (x - mean);
+  bins.add(x);
+}
+
+
+void wobos_stats::merge(const wobos_stats &other) {
+  if (other.count > 0.0) {
+    // Chan et al. pairwise update of the finite values
+    double finite = count - infs, otherFinite = other.count - other.infs;
+    if (otherFinite > 0.0) {
+      double n     = finite + otherFinite;
+      double delta = other.mean - mean;
+      mean += delta * otherFinite / n;
+      m2   += other.m2 + delta * delta * finite * otherFinite / n;
+    }
+    count += other.count;
+    infs  += other.infs;
+    min   = std::min(min, other.min);
+    max   = std::max(max, other.max);
+    sketch.merge(other.sketch);
+    bins.merge(other.bins);
+  }
+  nans += other.nans;
+}
+
+
+double wobos_stats::variance() const {
+  return (count - infs > 1.0) ? m2 / (count - infs - 1.0) : 0.0;
+}
+
+
+double wobos_stats::stddev() const {
+  return sqrt(variance());
+}
+
+
+double wobos_stats::quantile(double q) const {
+  if (count == 0.0) return numeric_limits<double>::quiet_NaN();
+  // The exact extremes are known, and no bucket value should fall outside of them
+  if (q <= 0.0) return min;
+  if (q >= 1.0) return max;
+  return std::min(std::max(sketch.quantile(q), min), max);
+}
+
+
+void wobos_stats::histogram(size_t nBins, vector<double> &edges, vector<double> &counts) const {
+  edges.assign(nBins + 1, 0.0);
+  counts.assign(nBins, 0.0);
+  const vector<double> &fine = bins.bins();
+  if ((nBins == 0) || fine.empty()) return;
+
+  double lo = std::isinf(min) ? bins.lower() : min;
+  double hi = std::isinf(max) ? bins.lower() + fine.size() * bins.width() : max;
+  double width = (hi - lo) / nBins;
+  for (size_t k=0; k<=nBins; k++) edges[k] = lo + k*width;
+  edges[nBins] = hi;
+
+  // Every fine bin goes where its center falls
+  for (size_t k=0; k<fine.size(); k++) {
+    if (fine[k] == 0.0) continue;
+    double v = std::min(std::max(bins.lower() + (k + 0.5) * bins.width(), lo), hi);
+    size_t bin = (width > 0.0) ? (size_t)((v - lo) / width) : 0;
+    counts[std::min(bin, nBins - 1)] += fine[k];
+  }
+}
@@ -0,0 +1,110 @@
+#ifndef __wind_obos_stats_h
+#define __wind_obos_stats_h
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Streaming statistics of one quantity in constant memory, e.g. a wobos output over Monte Carlo samples.
+// Nothing is kept per sample: count, mean and variance are updated with Welford's method, and quantiles
+// and histograms come from fixed-size summaries.  Statistics gathered separately (e.g. on different
+// threads) can be merged.
+
+// Quantile sketch with logarithmically spaced buckets (as in DDSketch): every value falls into a bucket
+// whose bounds are within a relative accuracy alpha of the value, so quantiles have a relative error of
+// at most alpha, whatever the distribution.  When a sign needs more than maxBuckets buckets, the buckets
+// closest to zero are merged into one, which only costs accuracy for the quantiles of those smallest values.
+// Infinities are counted apart, below and above every bucket, and NaN is left out.
+class wobos_quantile_sketch {
+ public:
+  double alpha;
+
+  void add(double x, double weight=1.0);
+  void merge(const wobos_quantile_sketch &other);
+  void clear();
+
+  double count() const;
+  // Value at quantile q (0 <= q <= 1), NaN if empty
+  double quantile(double q) const;
+
+  // Representative value and count of every non-empty bucket, in increasing order of value
+  void buckets(std::vector<double> &values, std::vector<double> &counts) const;
+
+  wobos_quantile_sketch(double alpha=0.005, size_t maxBuckets=2048);
+
+ private:
+  // Buckets of one sign, keyed by ceil(log(|x|)/log(gamma)); counts[k] holds the bucket of key offset+k
+  struct store {
+    int offset;
+    std::vector<double> counts;
+    void add(int key, double weight, size_t maxBuckets);
+    store() : offset(0) {}
+  };
+
+  double gamma, logGamma, minValue;
+  size_t maxBuckets;
+  store positive, negative;
+  double zeros;
+  double negInfs, posInfs;
+
+  int key(double x) const;
+  double value(int key) const;
+};
+
+
+// Histogram with bins of width 2^exponent aligned on multiples of the width, so that histograms of the
+// same quantity always share bin edges and merge exactly.  The width starts at the resolution of the first
+// value and doubles (merging pairs of bins) whenever the values no longer fit in maxBins bins, so the bins
+// end up between maxBins/2 and maxBins to the range of the values.
+class wobos_histogram {
+ public:
+  void add(double x, double weight=1.0);
+  void merge(const wobos_histogram &other);
+  void clear();
+
+  // Bin width, lower edge of the first bin and the counts of the bins from the lowest to the highest non-empty one
+  double width() const;
+  double lower() const;
+  const std::vector<double>& bins() const {return counts;}
+
+  wobos_histogram(size_t maxBins=1024);
+
+ private:
+  size_t maxBins;
+  int exponent;
+  int64_t offset;               // counts[k] holds the values in [(offset+k)*width, (offset+k+1)*width)
+  std::vector<double> counts;
+
+  bool place(int64_t key, double weight);
+  void coarsen(int steps);
+};
+
+
+class wobos_stats {
+ public:
+  double count;      // values added, not counting NaN
+  double nans;       // NaN values, which are left out of everything else
+  double infs;       // infinite values, in count, min, max and the quantiles but not in the rest
+  double mean;       // of the finite values
+  double m2;         // sum of squared deviations from the mean
+  double min, max;
+  wobos_quantile_sketch sketch;
+  wobos_histogram bins;
+
+  void add(double x);
+  void merge(const wobos_stats &other);
+  void clear();
+
+  double variance() const;  // sample variance (n-1) of the finite values
+  double stddev() const;
+  double quantile(double q) const;
+
+  // Histogram of nBins equal bins between min and max, gathered from the finer bins of wobos_histogram,
+  // so a value may be counted in a neighbouring bin when it is within one of those of a bin edge.  Only
+  // finite values are counted; when min or max is infinite, the bins end at the outermost finer bins.
+  void histogram(size_t nBins, std::vector<double> &edges, std::vector<double> &counts) const;
+
+  wobos_stats(double alpha=0.005, size_t maxBuckets=2048);
+};
+
+#endif
@@ -0,0 +1,311 @@
+#include "lib_wind_obos_substructure.h"
+#include "lib_wind_obos.h"
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <atomic>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+
+using namespace std;
+
+// The kernels below are written once for a "lane" type D: a double, or with GCC/clang a vector of 2 or 4
+// doubles (vector extensions), with I the matching 64-bit integers.  Arithmetic, comparisons and ?: then
+// act on every lane, so each instruction set runs exactly the same operations.  The helpers are forced
+// inline so that they are compiled with the instruction set of the function that uses them.
+#if defined(__GNUC__) || defined(__clang__)
+#define WOBOS_LANES inline __attribute__((always_inline))
+#else
+#define WOBOS_LANES inline
+#endif
+
+// Vectors are only returned from forced inline helpers, never through a call, so the ABI warning is moot
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+static const double  LANES_MAGIC      = 6755399441055744.0;  // 1.5*2^52: adding it rounds to an integer
+static const int64_t LANES_MAGIC_BITS = 0x4338000000000000LL;
+static const double  LN2_HI           = 6.93147180369123816490e-01;  // 32 bits, so that k*LN2_HI is exact
+static const double  LN2_LO           = 1.90821492927058770002e-10;
+static const double  EXP_MAX          = 7.09782712893383973096e+02;  // log(DBL_MAX)
+static const double  EXP_MIN          = -707.7;                      // 2^(k-1) stays normal above this
+
+
+template <class D> static WOBOS_LANES D splat(double c) {return D() + c;}
+
+template <class I, class D> static WOBOS_LANES I as_bits(const D &x) {I i; memcpy(&i, &x, sizeof i); return i;}
+template <class D, class I> static WOBOS_LANES D from_bits(const I &i) {D x; memcpy(&x, &i, sizeof x); return x;}
+
+
+// exp(x) = 2^k exp(r) with |r| <= ln2/2, exp(r) by its Taylor series to r^13 (truncation below 1e-17).
+// The polynomials here and in log_lanes are evaluated with Estrin's scheme (in powers of r^2, r^4, r^8),
+// which has half the dependent operations of Horner's, for less waiting on each multiply and add.
+template <class D, class I>
+static WOBOS_LANES D exp_lanes(const D &x) {
+  D xc = (x > splat<D>(EXP_MAX)) ? splat<D>(EXP_MAX) : x;
+  xc   = (xc < splat<D>(EXP_MIN)) ? splat<D>(EXP_MIN) : xc;
+
+  D t  = xc*1.44269504088896340736 + LANES_MAGIC;
+  D kd = t - LANES_MAGIC;
+  I k  = as_bits<I>(t) - LANES_MAGIC_BITS;
+  D r  = (xc - kd*LN2_HI) - kd*LN2_LO;
+
+  D r2 = r*r;
+  D r4 = r2*r2;
+  D r8 = r4*r4;
+  D p01   = r + 1.0;
+  D p23   = r*(1.0/6.0) + 0.5;
+  D p45   = r*(1.0/120.0) + (1.0/24.0);
+  D p67   = r*(1.0/5040.0) + (1.0/720.0);
+  D p89   = r*(1.0/362880.0) + (1.0/40320.0);
+  D p1011 = r*(1.0/39916800.0) + (1.0/3628800.0);
+  D p1213 = r*(1.0/6227020800.0) + (1.0/479001600.0);
+  D p03   = p23*r2 + p01;
+  D p47   = p67*r2 + p45;
+  D p811  = p1011*r2 + p89;
+  D p07   = p47*r4 + p03;
+  D p813  = p1213*r4 + p811;
+  D p     = p813*r8 + p07;
+
+  // 2^k as 2^(k-1)*2, so that k = 1024 (x next to log(DBL_MAX)) needs no special case
+  D y = (p * from_bits<D>((k + 1022) << 52)) * 2.0;
+  y = (x > splat<D>(EXP_MAX)) ? splat<D>(numeric_limits<double>::infinity()) : y;
+  y = (x < splat<D>(EXP_MIN)) ? splat<D>(0.0) : y;
+  return y;
+}
+
+
+// log(x) = e*ln2 + log(m) with sqrt(1/2) < m <= sqrt(2), log(m) = 2 atanh(s) with s = (m-1)/(m+1) and
+// |s| < 0.172, by its series to s^23 (truncation below 1e-18)
+template <class D, class I>
+static WOBOS_LANES D log_lanes(const D &x) {
+  const double minNormal = numeric_limits<double>::min();
+  D xs = (x < splat<D>(minNormal)) ? x*18014398509481984.0 : x;  // subnormals times 2^54
+  I es = (x < splat<D>(minNormal)) ? I() + 54 : I();
+
+  I b = as_bits<I>(xs);
+  I e = ((b >> 52) & 0x7ff) - 1023 - es;
+  D m = from_bits<D>((b & 0x000fffffffffffffLL) | 0x3ff0000000000000LL);
+  e = (m > splat<D>(1.41421356237309504880)) ? e + 1 : e;
+  m = (m > splat<D>(1.41421356237309504880)) ? m*0.5 : m;
+  D ed = from_bits<D>(e + LANES_MAGIC_BITS) - LANES_MAGIC;
+
+  D s = (m - 1.0) / (m + 1.0);
+  D z = s*s;
+  D z2 = z*z;
+  D z4 = z2*z2;
+  D z8 = z4*z4;
+  D q01 = z*(1.0/5.0) + (1.0/3.0);
+  D q23 = z*(1.0/9.0) + (1.0/7.0);
+  D q45 = z*(1.0/13.0) + (1.0/11.0);
+  D q67 = z*(1.0/17.0) + (1.0/15.0);
+  D q89 = z*(1.0/21.0) + (1.0/19.0);
+  D q03 = q23*z2 + q01;
+  D q47 = q67*z2 + q45;
+  D q07 = q47*z4 + q03;
+  D q   = (q89 + z2*(1.0/23.0))*z8 + q07;
+  D f = s*2.0;
+  D y = ed*LN2_HI + ((f*z)*q + f + ed*LN2_LO);
+
+  const double inf = numeric_limits<double>::infinity();
+  y = (x == splat<D>(inf)) ? x : y;
+  y = (x == splat<D>(0.0)) ? splat<D>(-inf) : y;
+  y = ((x < splat<D>(0.0)) | (x != x)) ? splat<D>(numeric_limits<double>::quiet_NaN()) : y;
+  return y;
+}
+
+
+// pow(x, y) from log(x), which the formulas below compute once per input and share between powers
+template <class D, class I>
+static WOBOS_LANES D pow_lanes(const D &logX, double y) {return exp_lanes<D, I>(logX * y);}
+
+// Square root of every lane, correctly rounded like the C library's, for the powers 0.5 and 1.5: pow_lanes
+// would add |y*log(x)| ulp, which the exponential of the monopile transition piece multiplies by up to 40
+// in deep water
+static WOBOS_LANES double sqrt_lanes(double x) {return sqrt(x);}
+template <class D>
+static WOBOS_LANES D sqrt_lanes(const D &x) {
+  D y = x;
+  for (size_t k=0; k<sizeof(D)/sizeof(double); k++) y[k] = sqrt(y[k]);
+  return y;
+}
+
+
+// One vector of rows of substructure_mass_cost.  Same formulas, in the same order, as the wobos stages.
+template <int SUB, class D, class I>
+static WOBOS_LANES void substructure_lanes(const substructure_rates &c, const D &turbR, const D &waterD, const D &hubH,
+					   const D &rnaM, D &mass, D &cost) {
+  D sSteelM;
+  switch (SUB) {
+  case MONOPILE: {
+    D rnaMSet = (rnaM <= splat<D>(0.0)) ? (turbR*turbR)*2.082 + turbR*44.59 + 22.48 : rnaM;
+    D turbRk    = turbR * 1000.0;
+    D logW      = log_lanes<D, I>(waterD);
+    D mpileM  = (turbRk*sqrt_lanes(turbRk) + (pow_lanes<D, I>(log_lanes<D, I>(hubH), 3.7) / 10.0) +
+		 2100.0 * pow_lanes<D, I>(logW, 2.25) + pow_lanes<D, I>(log_lanes<D, I>(rnaMSet * 1000.0), 1.13)) / 10000.0;
+    D mtransM = exp_lanes<D, I>(2.77 + 1.04*sqrt_lanes(turbR) + 0.00127*(waterD*sqrt_lanes(waterD)));
+    mass = mpileM + mtransM;
+    cost = mpileM*c.mpileCR + mtransM*c.mtransCR;
+    break;
+  }
+  case JACKET: {
+    D logR      = log_lanes<D, I>(turbR);
+    D jlatticeM = exp_lanes<D, I>(3.71 + 0.00176*pow_lanes<D, I>(logR, 2.5) + 0.645*log_lanes<D, I>(waterD));
+    D jtransM   = 1.0 / (-0.0131 + 0.0381 / logR - 0.00000000227*(waterD*waterD*waterD));
+    D jpileM    = 8.0 * pow_lanes<D, I>(log_lanes<D, I>(jlatticeM), 0.5574);
+    mass = jlatticeM + jtransM + jpileM;
+    cost = jlatticeM*c.jlatticeCR + jtransM*c.jtransCR + jpileM*c.jpileCR;
+    break;
+  }
+  case SPAR: {
+    D logR       = log_lanes<D, I>(turbR);
+    D logW       = log_lanes<D, I>(waterD);
+    D spStifColM = 535.93 + 17.664*(turbR*turbR) + 0.02328*waterD*logW;
+    D spTapColM  = 125.81*logR + 58.712;
+    D ballM      = -16.536*(turbR*turbR) + 1261.8*turbR - 1554.6;
+    mass = spStifColM + spTapColM + ballM;
+    cost = spStifColM*c.spStifColCR + spTapColM*c.spTapColCR + ballM*c.ballCR;
+    sSteelM = exp_lanes<D, I>(3.58 + 0.196*sqrt_lanes(turbR)*logR + 0.00001*waterD*logW);
+    break;
+  }
+  case SEMISUBMERSIBLE: {
+    D ssStifColM = -0.9571*(turbR*turbR) + 40.89*turbR + 802.09;
+    D ssTrussM   = 2.7894*(turbR*turbR) + 15.591*turbR + 266.03;
+    D ssHeaveM   = -0.4397*(turbR*turbR) + 21.545*turbR + 177.42;
+    mass = ssStifColM + ssTrussM + ssHeaveM;
+    cost = ssStifColM*c.ssStifColCR + ssTrussM*c.ssTrussCR + ssHeaveM*c.ssHeaveCR;
+    sSteelM = -0.153*(turbR*turbR) + 6.54*turbR + 128.34;
+    break;
+  }
+  }
+  if ((SUB == MONOPILE) || (SUB == JACKET))
+    sSteelM = (turbR <= splat<D>(4.0)) ? 35.0 + (0.8*(18.0 + waterD)) : 40.0 + (0.8*(18.0 + waterD));
+
+  mass = mass + sSteelM;
+  cost = cost + sSteelM*c.sSteelCR;
+}
+
+
+template <class D>
+static WOBOS_LANES void load_lanes(const substructure_column &col, size_t j, D &x) {
+  if (col.values) memcpy(&x, col.values + j, sizeof x);
+  else x = splat<D>(col.value);
+}
+
+
+template <int SUB, class D, class I>
+static WOBOS_LANES void substructure_rows(const substructure_rates &c, size_t start, size_t stop,
+					  const substructure_column &turbR, const substructure_column &waterD,
+					  const substructure_column &hubH, const substructure_column &rnaM,
+					  double *mass, double *cost) {
+  const size_t lanes = sizeof(D) / sizeof(double);
+  for (size_t j=start; j+lanes<=stop; j+=lanes) {
+    D r, w, h, a, m, k;
+    load_lanes(turbR, j, r);
+    load_lanes(waterD, j, w);
+    load_lanes(hubH, j, h);
+    load_lanes(rnaM, j, a);
+    substructure_lanes<SUB, D, I>(c, r, w, h, a, m, k);
+    memcpy(mass + j, &m, sizeof m);
+    memcpy(cost + j, &k, sizeof k);
+  }
+}
+
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define WOBOS_X86_SIMD
+
+typedef double  substructure_v2d __attribute__((vector_size(16)));
+typedef int64_t substructure_v2i __attribute__((vector_size(16)));
+typedef double  substructure_v4d __attribute__((vector_size(32)));
+typedef int64_t substructure_v4i __attribute__((vector_size(32)));
+
+template <int SUB>
+__attribute__((target("avx2")))
+static void substructure_rows_avx2(const substructure_rates &c, size_t n, const substructure_column &turbR,
+				   const substructure_column &waterD, const substructure_column &hubH,
+				   const substructure_column &rnaM, double *mass, double *cost) {
+  substructure_rows<SUB, substructure_v4d, substructure_v4i>(c, 0, n, turbR, waterD, hubH, rnaM, mass, cost);
+}
+
+template <int SUB>
+__attribute__((target("sse4.1")))
+static void substructure_rows_sse41(const substructure_rates &c, size_t n, const substructure_column &turbR,
+				    const substructure_column &waterD, const substructure_column &hubH,
+				    const substructure_column &rnaM, double *mass, double *cost) {
+  substructure_rows<SUB, substructure_v2d, substructure_v2i>(c, 0, n, turbR, waterD, hubH, rnaM, mass, cost);
+}
+#endif
+
+
+static int detect_substructure_simd() {
+#ifdef WOBOS_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return SUBSTRUCTURE_SIMD_AVX2;
+  if (__builtin_cpu_supports("sse4.1")) return SUBSTRUCTURE_SIMD_SSE41;
+#endif
+  return SUBSTRUCTURE_SIMD_SCALAR;
+}
+
+// Atomic, so that set_substructure_simd may be called while other threads run the kernels
+static atomic<int>& substructure_simd() {
+  static atomic<int> level(detect_substructure_simd());
+  return level;
+}
+
+int get_substructure_simd() {return substructure_simd();}
+
+int set_substructure_simd(int level) {
+  substructure_simd() = min(max(level, (int)SUBSTRUCTURE_SIMD_SCALAR), detect_substructure_simd());
+  return substructure_simd().load();
+}
+
+
+template <int SUB>
+static void substructure_mass_cost(const substructure_rates &c, size_t n, const substructure_column &turbR,
+				   const substructure_column &waterD, const substructure_column &hubH,
+				   const substructure_column &rnaM, double *mass, double *cost) {
+  size_t done = 0;
+#ifdef WOBOS_X86_SIMD
+  if (substructure_simd() == SUBSTRUCTURE_SIMD_AVX2) {
+    substructure_rows_avx2<SUB>(c, n, turbR, waterD, hubH, rnaM, mass, cost);
+    done = n - n%4;
+  }
+  else if (substructure_simd() == SUBSTRUCTURE_SIMD_SSE41) {
+    substructure_rows_sse41<SUB>(c, n, turbR, waterD, hubH, rnaM, mass, cost);
+    done = n - n%2;
+  }
+#endif
+  // Remainder that does not fill a vector
+  substructure_rows<SUB, double, int64_t>(c, done, n, turbR, waterD, hubH, rnaM, mass, cost);
+}
+
+
+void substructure_mass_cost(int substructure, const substructure_rates &rates, size_t n,
+			    substructure_column turbR, substructure_column waterD, substructure_column hubH,
+			    substructure_column rnaM, double *mass, double *cost) {
+  switch (substructure) {
+  case MONOPILE:
+    substructure_mass_cost<MONOPILE>(rates, n, turbR, waterD, hubH, rnaM, mass, cost);
+    break;
+  case JACKET:
+    substructure_mass_cost<JACKET>(rates, n, turbR, waterD, hubH, rnaM, mass, cost);
+    break;
+  case SPAR:
+    substructure_mass_cost<SPAR>(rates, n, turbR, waterD, hubH, rnaM, mass, cost);
+    break;
+  case SEMISUBMERSIBLE:
+    substructure_mass_cost<SEMISUBMERSIBLE>(rates, n, turbR, waterD, hubH, rnaM, mass, cost);
+    break;
+  default:
+    throw invalid_argument("Unknown substructure type: " + to_string(substructure));
+  }
+}
+
+
+double substructure_exp(double x) {return exp_lanes<double, int64_t>(x);}
+double substructure_log(double x) {return log_lanes<double, int64_t>(x);}
@@ -0,0 +1,59 @@
+#ifndef __wind_obos_substructure_h
+#define __wind_obos_substructure_h
+
+// Substructure mass and cost over columns of turbines and sites, e.g. a grid of water depths across a lease
+// area.  The formulas are those of wobos::calculate_monopile, calculate_jacket, calculate_spar,
+// calculate_ballast, calculate_semi and calculate_secondary_steel, evaluated several rows at a time with
+// polynomial exp and log (see substructure_exp and substructure_log) instead of the C library.
+
+#include <cstddef>
+
+// Cost rates of the substructure components ($/tonne), as the wobos variables of the same names
+struct substructure_rates {
+  double mpileCR;
+  double mtransCR;
+  double jlatticeCR;
+  double jtransCR;
+  double jpileCR;
+  double spStifColCR;
+  double spTapColCR;
+  double ballCR;
+  double ssStifColCR;
+  double ssTrussCR;
+  double ssHeaveCR;
+  double sSteelCR;
+};
+
+// n values, or the same value for every row when values is NULL
+struct substructure_column {
+  const double *values;
+  double value;
+
+  substructure_column(const double *values, double value=0.0) : values(values), value(value) {}
+};
+
+// Mass (tonnes) and cost ($) of one substructure of the given type (MONOPILE ... SEMISUBMERSIBLE) for each of
+// the n rows, secondary steel and spar ballast included.  That is calculate_substructure_mass_cost before
+// mooring and the multiplication by nTurb.  hubH and rnaM are only used by monopiles, and an rnaM <= 0 is
+// estimated from turbR like set_turbine_parameters does.  Throws invalid_argument for an unknown substructure.
+void substructure_mass_cost(int substructure, const substructure_rates &rates, size_t n,
+			    substructure_column turbR, substructure_column waterD, substructure_column hubH,
+			    substructure_column rnaM, double *mass, double *cost);
+
+// The exp and log used above, on one value.  Within 2 ulp of the C library, except that exp flushes results
+// below 5e-308 to zero.  pow(x, y) is exp(y*log(x)), which adds about |y*log(x)| ulp, and powers 0.5 and 1.5
+// use the square root.  Mass and cost stay within 1e-14 (relative) of the wobos stages in water up to 500 m,
+// except where the formulas themselves cancel (the jacket transition piece when its denominator nears zero).
+// The monopile transition piece is the exponential of a term that grows as waterD^1.5, which magnifies the
+// last bit of that term: the difference grows to about 1.5e-14 at 1000 m and 6e-14 at 3000 m.
+double substructure_exp(double x);
+double substructure_log(double x);
+
+// Instruction set used by substructure_mass_cost, as for the cable kernels: the best one the processor
+// supports is picked at run time, set_substructure_simd can lower it and returns the level in use.  Every
+// level performs the same floating point operations, so results do not depend on it.
+enum {SUBSTRUCTURE_SIMD_SCALAR, SUBSTRUCTURE_SIMD_SSE41, SUBSTRUCTURE_SIMD_AVX2};
+int get_substructure_simd();
+int set_substructure_simd(int level);
+
+#endif
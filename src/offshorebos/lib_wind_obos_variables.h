@@ -0,0 +1,312 @@
+#ifndef __wind_obos_variables_h
+#define __wind_obos_variables_h
+
+// Master list of every variable that can be exchanged with the wobos class through
+// set_map_variable/get_map_variable (and therefore with SAM, WISDEM and the Python wrapper).
+// Each entry is X(name, flags), where name is both the external key and the wobos class member.
+//
+// The list is expanded at compile time into the wobos_var index enum below and into the
+// member binding table in lib_wind_obos.cpp, so variables are stored and accessed by integer
+// index.  String names are only needed once to look up that index.
+//
+// Flags:
+//   VAR_PERCENT - value is a fraction; set_map_variable scales values > 1 by 1e-2
+enum { VAR_PERCENT = 1 };
+
+#define WOBOS_VARIABLES(X) \
+  /* Main inputs */                                       \
+  X(substructure, 0)                                      \
+  X(anchor, 0)                                            \
+  X(turbInstallMethod, 0)                                 \
+  X(towerInstallMethod, 0)                                \
+  X(installStrategy, 0)                                   \
+  X(cableOptimizer, 0)                                    \
+  X(installSimulation, 0)                                 \
+  X(turbCapEx, 0)                                         \
+  X(nTurb, 0)                                             \
+  X(rotorD, 0)                                            \
+  X(turbR, 0)                                             \
+  X(hubH, 0)                                              \
+  X(waterD, 0)                                            \
+  X(distShore, 0)                                         \
+  X(distPort, 0)                                          \
+  X(distPtoA, 0)                                          \
+  X(distAtoS, 0)                                          \
+  X(moorLines, 0)                                         \
+  X(buryDepth, 0)                                         \
+  X(arrayY, 0)                                            \
+  X(arrayX, 0)                                            \
+  X(substructCont, VAR_PERCENT)                           \
+  X(turbCont, VAR_PERCENT)                                \
+  X(elecCont, VAR_PERCENT)                                \
+  X(interConVolt, 0)                                      \
+  X(distInterCon, 0)                                      \
+  X(scrapVal, 0)                                          \
+  X(number_install_seasons, 0)                            \
+  X(installSeasonLength, 0)                               \
+  X(installStartHour, 0)                                  \
+  /* General */                                           \
+  X(projLife, 0)                                          \
+  X(inspectClear, 0)                                      \
+  X(plantComm, VAR_PERCENT)                               \
+  X(procurement_contingency, VAR_PERCENT)                 \
+  X(install_contingency, VAR_PERCENT)                     \
+  X(construction_insurance, VAR_PERCENT)                  \
+  X(capital_cost_year_0, VAR_PERCENT)                     \
+  X(capital_cost_year_1, VAR_PERCENT)                     \
+  X(capital_cost_year_2, VAR_PERCENT)                     \
+  X(capital_cost_year_3, VAR_PERCENT)                     \
+  X(capital_cost_year_4, VAR_PERCENT)                     \
+  X(capital_cost_year_5, VAR_PERCENT)                     \
+  X(tax_rate, VAR_PERCENT)                                \
+  X(interest_during_construction, VAR_PERCENT)            \
+  /* Substructure & Foundation */                         \
+  X(mpileCR, 0)                                           \
+  X(mtransCR, 0)                                          \
+  X(mpileD, 0)                                            \
+  X(mpileL, 0)                                            \
+  X(jlatticeCR, 0)                                        \
+  X(jtransCR, 0)                                          \
+  X(jpileCR, 0)                                           \
+  X(jlatticeA, 0)                                         \
+  X(jpileL, 0)                                            \
+  X(jpileD, 0)                                            \
+  X(spStifColCR, 0)                                       \
+  X(spTapColCR, 0)                                        \
+  X(ballCR, 0)                                            \
+  X(deaFixLeng, 0)                                        \
+  X(ssStifColCR, 0)                                       \
+  X(ssTrussCR, 0)                                         \
+  X(ssHeaveCR, 0)                                         \
+  X(sSteelCR, 0)                                          \
+  X(moorDia, 0)                                           \
+  X(moorCR, 0)                                            \
+  X(mpEmbedL, 0)                                          \
+  X(scourMat, 0)                                          \
+  /* Electrical Infrastructure */                         \
+  X(pwrFac, 0)                                            \
+  X(buryFac, 0)                                           \
+  X(arrVoltage, 0)                                        \
+  X(arrCab1Size, 0)                                       \
+  X(arrCab1Mass, 0)                                       \
+  X(cab1CurrRating, 0)                                    \
+  X(cab1CR, 0)                                            \
+  X(cab1TurbInterCR, 0)                                   \
+  X(arrCab2Size, 0)                                       \
+  X(arrCab2Mass, 0)                                       \
+  X(cab2CurrRating, 0)                                    \
+  X(cab2CR, 0)                                            \
+  X(cab2TurbInterCR, 0)                                   \
+  X(cab2SubsInterCR, 0)                                   \
+  X(catLengFac, 0)                                        \
+  X(exCabFac, 0)                                          \
+  X(subsTopFab, 0)                                        \
+  X(subsTopDes, 0)                                        \
+  X(topAssemblyFac, 0)                                    \
+  X(subsJackCR, 0)                                        \
+  X(subsPileCR, 0)                                        \
+  X(dynCabFac, 0)                                         \
+  X(shuntCR, 0)                                           \
+  X(highVoltSG, 0)                                        \
+  X(medVoltSG, 0)                                         \
+  X(backUpGen, 0)                                         \
+  X(workSpace, 0)                                         \
+  X(otherAncillary, 0)                                    \
+  X(mptCR, 0)                                             \
+  X(expVoltage, 0)                                        \
+  X(expCabSize, 0)                                        \
+  X(expCabMass, 0)                                        \
+  X(expCabCR, 0)                                          \
+  X(expCurrRating, 0)                                     \
+  X(expSubsInterCR, 0)                                    \
+  /* Assembly & Installation */                           \
+  X(moorTimeFac, 0)                                       \
+  X(moorLoadout, 0)                                       \
+  X(moorSurvey, 0)                                        \
+  X(prepAA, 0)                                            \
+  X(prepSpar, 0)                                          \
+  X(upendSpar, 0)                                         \
+  X(prepSemi, 0)                                          \
+  X(turbFasten, 0)                                        \
+  X(boltTower, 0)                                         \
+  X(boltNacelle1, 0)                                      \
+  X(boltNacelle2, 0)                                      \
+  X(boltNacelle3, 0)                                      \
+  X(boltBlade1, 0)                                        \
+  X(boltBlade2, 0)                                        \
+  X(boltRotor, 0)                                         \
+  X(vesselPosTurb, 0)                                     \
+  X(vesselPosJack, 0)                                     \
+  X(vesselPosMono, 0)                                     \
+  X(subsVessPos, 0)                                       \
+  X(monoFasten, 0)                                        \
+  X(jackFasten, 0)                                        \
+  X(prepGripperMono, 0)                                   \
+  X(prepGripperJack, 0)                                   \
+  X(placePiles, 0)                                        \
+  X(prepHamMono, 0)                                       \
+  X(removeHamMono, 0)                                     \
+  X(prepHamJack, 0)                                       \
+  X(removeHamJack, 0)                                     \
+  X(placeJack, 0)                                         \
+  X(levJack, 0)                                           \
+  X(placeTemplate, 0)                                     \
+  X(hamRate, 0)                                           \
+  X(placeMP, 0)                                           \
+  X(instScour, 0)                                         \
+  X(placeTP, 0)                                           \
+  X(groutTP, 0)                                           \
+  X(tpCover, 0)                                           \
+  X(prepTow, 0)                                           \
+  X(spMoorCon, 0)                                         \
+  X(ssMoorCon, 0)                                         \
+  X(spMoorCheck, 0)                                       \
+  X(ssMoorCheck, 0)                                       \
+  X(ssBall, 0)                                            \
+  X(surfLayRate, 0)                                       \
+  X(cabPullIn, 0)                                         \
+  X(cabTerm, 0)                                           \
+  X(cabLoadout, 0)                                        \
+  X(buryRate, 0)                                          \
+  X(subsPullIn, 0)                                        \
+  X(shorePullIn, 0)                                       \
+  X(landConstruct, 0)                                     \
+  X(expCabLoad, 0)                                        \
+  X(subsLoad, 0)                                          \
+  X(placeTop, 0)                                          \
+  X(pileSpreadDR, 0)                                      \
+  X(pileSpreadMob, 0)                                     \
+  X(groutSpreadDR, 0)                                     \
+  X(groutSpreadMob, 0)                                    \
+  X(seaSpreadDR, 0)                                       \
+  X(seaSpreadMob, 0)                                      \
+  X(compRacks, 0)                                         \
+  X(cabSurveyCR, 0)                                       \
+  X(cabDrillDist, 0)                                      \
+  X(cabDrillCR, 0)                                        \
+  X(mpvRentalDR, 0)                                       \
+  X(diveTeamDR, 0)                                        \
+  X(winchDR, 0)                                           \
+  X(civilWork, 0)                                         \
+  X(elecWork, 0)                                          \
+  /* Port & Staging */                                    \
+  X(nCrane600, 0)                                         \
+  X(nCrane1000, 0)                                        \
+  X(crane600DR, 0)                                        \
+  X(crane1000DR, 0)                                       \
+  X(craneMobDemob, 0)                                     \
+  X(entranceExitRate, 0)                                  \
+  X(dockRate, 0)                                          \
+  X(wharfRate, 0)                                         \
+  X(laydownCR, 0)                                         \
+  /* Engineering & Management */                          \
+  X(estEnMFac, 0)                                         \
+  /* Development */                                       \
+  X(preFEEDStudy, 0)                                      \
+  X(feedStudy, 0)                                         \
+  X(stateLease, 0)                                        \
+  X(outConShelfLease, 0)                                  \
+  X(saPlan, 0)                                            \
+  X(conOpPlan, 0)                                         \
+  X(nepaEisMet, 0)                                        \
+  X(physResStudyMet, 0)                                   \
+  X(bioResStudyMet, 0)                                    \
+  X(socEconStudyMet, 0)                                   \
+  X(navStudyMet, 0)                                       \
+  X(nepaEisProj, 0)                                       \
+  X(physResStudyProj, 0)                                  \
+  X(bioResStudyProj, 0)                                   \
+  X(socEconStudyProj, 0)                                  \
+  X(navStudyProj, 0)                                      \
+  X(coastZoneManAct, 0)                                   \
+  X(rivsnHarbsAct, 0)                                     \
+  X(cleanWatAct402, 0)                                    \
+  X(cleanWatAct404, 0)                                    \
+  X(faaPlan, 0)                                           \
+  X(endSpecAct, 0)                                        \
+  X(marMamProtAct, 0)                                     \
+  X(migBirdAct, 0)                                        \
+  X(natHisPresAct, 0)                                     \
+  X(addLocPerm, 0)                                        \
+  X(metTowCR, 0)                                          \
+  X(decomDiscRate, 0)                                     \
+  /* INPUTS/OUTPUTS, depending on how module is called */ \
+  /* Turbine outputs */                                   \
+  X(hubD, 0)                                              \
+  X(bladeL, 0)                                            \
+  X(max_chord, 0)                                         \
+  X(nacelleW, 0)                                          \
+  X(nacelleL, 0)                                          \
+  X(rnaM, 0)                                              \
+  X(towerD, 0)                                            \
+  X(towerM, 0)                                            \
+  /* Substructure & Foundation outputs */                 \
+  X(subTotM, 0)                                           \
+  X(subTotCost, 0)                                        \
+  X(moorCost, 0)                                          \
+  /* OUTPUTS */                                           \
+  /* Electrical Infrastructure outputs */                 \
+  X(systAngle, 0)                                         \
+  X(freeCabLeng, 0)                                       \
+  X(fixCabLeng, 0)                                        \
+  X(nExpCab, 0)                                           \
+  X(expCabLeng, 0)                                        \
+  X(expCabCost, 0)                                        \
+  X(nSubstation, 0)                                       \
+  X(cab1Leng, 0)                                          \
+  X(cab2Leng, 0)                                          \
+  X(arrCab1Cost, 0)                                       \
+  X(arrCab2Cost, 0)                                       \
+  X(subsSubM, 0)                                          \
+  X(subsPileM, 0)                                         \
+  X(subsTopM, 0)                                          \
+  X(totElecCost, 0)                                       \
+  /* Assembly & Installation outputs */                   \
+  X(moorTime, 0)                                          \
+  X(floatPrepTime, 0)                                     \
+  X(turbDeckArea, 0)                                      \
+  X(nTurbPerTrip, 0)                                      \
+  X(turbInstTime, 0)                                      \
+  X(subDeckArea, 0)                                       \
+  X(nSubPerTrip, 0)                                       \
+  X(subInstTime, 0)                                       \
+  X(arrInstTime, 0)                                       \
+  X(expInstTime, 0)                                       \
+  X(subsInstTime, 0)                                      \
+  X(totInstTime, 0)                                       \
+  X(cabSurvey, 0)                                         \
+  X(array_cable_install_cost, 0)                          \
+  X(export_cable_install_cost, 0)                         \
+  X(substation_install_cost, 0)                           \
+  X(turbine_install_cost, 0)                              \
+  X(substructure_install_cost, 0)                         \
+  X(electrical_install_cost, 0)                           \
+  X(mob_demob_cost, 0)                                    \
+  X(installSeasons, 0)                                    \
+  /* Port & Staging outputs */                            \
+  X(totPnSCost, 0)                                        \
+  /* Development outputs */                               \
+  X(totDevCost, 0)                                        \
+  /* Main Cost Outputs */                                 \
+  X(bos_capex, 0)                                         \
+  X(construction_insurance_cost, 0)                       \
+  X(total_contingency_cost, 0)                            \
+  X(construction_finance_cost, 0)                         \
+  X(construction_finance_factor, 0)                       \
+  X(soft_costs, 0)                                        \
+  X(totAnICost, 0)                                        \
+  X(totEnMCost, 0)                                        \
+  X(commissioning, 0)                                     \
+  X(decomCost, 0)                                         \
+  X(total_bos_cost, 0)
+
+
+// Index of each variable in the table above
+enum wobos_var {
+#define WOBOS_VARIABLE_INDEX(name, flags) VAR_##name,
+  WOBOS_VARIABLES(WOBOS_VARIABLE_INDEX)
+#undef WOBOS_VARIABLE_INDEX
+  NVARIABLES
+};
+
+#endif
@@ -0,0 +1,363 @@
+#include "lib_wind_obos_weather.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+
+weather_windows::weather_windows(const double *wind, const double *wave, size_t n, double maxWind, double maxWave)
+  : n(n), longestRun(0) {
+  vector<char> good(n);
+  size_t nGood = 0;
+  for (size_t h=0; h<n; h++) {
+    good[h] = ((maxWind <= 0.0) || (wind[h] <= maxWind)) && ((maxWave <= 0.0) || (wave[h] <= maxWave));
+    nGood += good[h];
+  }
+
+  storage.assign(n, (nGood == n) ? (int32_t)n : 0);
+  runs = storage.empty() ? NULL : &storage[0];
+  if ((nGood == 0) || (nGood == n)) {
+    longestRun = nGood;
+    return;
+  }
+
+  // Runs at the end of the record carry on into the one at its start, and the wait at the end of the
+  // record into the wait at its start
+  size_t firstBad = 0, firstGood = 0;
+  while (good[firstBad]) firstBad++;
+  while (!good[firstGood]) firstGood++;
+  int32_t run = (int32_t)firstBad, wait = (int32_t)firstGood;
+  for (size_t h=n; h-- > 0; ) {
+    if (good[h]) {
+      storage[h] = ++run;
+      wait = 0;
+      longestRun = max(longestRun, (size_t)run);
+    }
+    else {
+      storage[h] = -(++wait);
+      run = 0;
+    }
+  }
+}
+
+
+weather_windows::weather_windows(const int32_t *runs, size_t n, size_t longest, shared_ptr<const void> owner)
+  : owner(owner), runs(runs), n(n), longestRun(longest) {}
+
+
+bool weather_windows::workable(size_t start, size_t length) const {
+  if (length == 0) return true;
+  if ((n > 0) && (longestRun == n)) return true;
+  if ((n == 0) || (length > longestRun)) return false;
+  return runs[start % n] >= (int64_t)length;
+}
+
+
+double weather_windows::next_window(double t, double length) const {
+  if ((length <= 0.0) || std::isinf(t)) return t;
+  if ((n > 0) && (longestRun == n)) return t;
+  size_t need = (size_t)ceil(length);
+  if ((n == 0) || (need > longestRun)) return numeric_limits<double>::infinity();
+
+  // Now, if the hours from the current one through the end of the activity are workable
+  size_t pos = (size_t)floor(t);
+  if (runs[pos % n] >= (int64_t)(ceil(t + length) - pos)) return t;
+
+  // Otherwise on the hour, from one workable run to the next
+  pos++;
+  while (true) {
+    int32_t run = runs[pos % n];
+    if (run >= (int64_t)need) return (double)pos;
+    pos += (run < 0) ? -run : run;
+  }
+}
+
+
+weather_delay weather_windows::delays(double length) const {
+  const double inf = numeric_limits<double>::infinity();
+  weather_delay out;
+  out.hours = length;
+  out.mean = out.p50 = out.p90 = out.max = 0.0;
+  out.contingency = 0.0;
+  if ((length <= 0.0) || ((n > 0) && (longestRun == n))) return out;
+  size_t need = (size_t)ceil(length);
+  if ((n == 0) || (need > longestRun)) {
+    out.mean = out.p50 = out.p90 = out.max = inf;
+    out.contingency = 1.0;
+    return out;
+  }
+
+  // Start of the next window from every hour, twice around the record so that the ones at its end see the
+  // windows at its start
+  vector<uint32_t> wait(n);
+  size_t next = 0;
+  for (size_t h=2*n; h-- > 0; ) {
+    if (runs[h % n] >= (int64_t)need) next = h;
+    if (h < n) wait[h] = (uint32_t)(next - h);
+  }
+
+  double sum = 0.0;
+  for (size_t h=0; h<n; h++) sum += wait[h];
+  out.mean = sum / n;
+
+  // Nearest-rank percentiles
+  size_t k50 = (size_t)ceil(0.5*n) - 1, k90 = (size_t)ceil(0.9*n) - 1;
+  nth_element(wait.begin(), wait.begin() + k90, wait.end());
+  out.p90 = wait[k90];
+  out.max = *max_element(wait.begin() + k90, wait.end());
+  nth_element(wait.begin(), wait.begin() + k50, wait.begin() + k90);
+  out.p50 = wait[k50];
+  out.contingency = out.mean / (length + out.mean);
+  return out;
+}
+
+
+wobos_weather::wobos_weather(vector<double> wind, vector<double> wave) : windData(wind), waveData(wave) {
+  if (windData.size() != waveData.size()) throw invalid_argument("Need one wave height per wind speed");
+  n       = windData.size();
+  windCol = windData.empty() ? NULL : &windData[0];
+  waveCol = waveData.empty() ? NULL : &waveData[0];
+}
+
+
+shared_ptr<const weather_windows> wobos_weather::windows(double maxWind, double maxWave) const {
+  lock_guard<mutex> guard(lock);
+  shared_ptr<const weather_windows> &index = indexes[make_pair(maxWind, maxWave)];
+  if (!index) index = make_shared<weather_windows>(windCol, waveCol, n, maxWind, maxWave);
+  return index;
+}
+
+
+static string lower_trim(const string &str) {
+  const string whitespace = " \t\r\"";
+  size_t begin = str.find_first_not_of(whitespace);
+  if (begin == string::npos) return "";
+  string out = str.substr(begin, str.find_last_not_of(whitespace) - begin + 1);
+  transform(out.begin(), out.end(), out.begin(), ::tolower);
+  return out;
+}
+
+
+shared_ptr<const wobos_weather> wobos_weather::read_csv(const string &fname) {
+  ifstream infile(fname.c_str());
+  if (!infile.is_open()) throw runtime_error("Cannot open weather file: " + fname);
+
+  vector<double> wind, wave;
+  int windCol = -1, waveCol = -1, nCols = 0;
+  size_t lineNo = 0;
+  string line;
+  while (getline(infile, line)) {
+    lineNo++;
+    string::size_type n = line.find("#");
+    if (n != string::npos) line.erase(n);
+    if (lower_trim(line).empty()) continue;
+
+    // Column names from the header
+    if (nCols == 0) {
+      size_t begin = 0;
+      while (true) {
+	size_t end = line.find(',', begin);
+	string name = lower_trim(line.substr(begin, (end == string::npos) ? string::npos : end - begin));
+	if ((windCol < 0) && (name.compare(0, 4, "wind") == 0)) windCol = nCols;
+	if ((waveCol < 0) && ((name.compare(0, 4, "wave") == 0) || (name == "hs"))) waveCol = nCols;
+	nCols++;
+	if (end == string::npos) break;
+	begin = end + 1;
+      }
+      if ((windCol < 0) || (waveCol < 0)) throw runtime_error("No wind and wave columns in weather file: " + fname);
+      continue;
+    }
+
+    // Values, with no copies of the fields
+    double values[2];
+    int found = 0, col = 0;
+    const char *p = line.c_str();
+    while (found < 2) {
+      if ((col == windCol) || (col == waveCol)) {
+	char *end;
+	double x = strtod(p, &end);
+	while ((*end == ' ') || (*end == '\t') || (*end == '\r')) end++;
+	if ((end == p) || ((*end != ',') && (*end != '\0')))
+	  throw runtime_error("Cannot read line " + to_string(lineNo) + " of weather file: " + fname);
+	values[(col == windCol) ? 0 : 1] = x;
+	found++;
+      }
+      p = strchr(p, ',');
+      if (p == NULL) break;
+      p++;
+      col++;
+    }
+    if (found < 2) throw runtime_error("Missing values on line " + to_string(lineNo) + " of weather file: " + fname);
+    wind.push_back(values[0]);
+    wave.push_back(values[1]);
+  }
+  return make_shared<const wobos_weather>(wind, wave);
+}
+
+
+// Weather store layout (see lib_wind_obos_weather.h)
+static const char storeMagic[8] = {'W', 'O', 'B', 'O', 'S', 'W', 'X', '1'};
+static const uint32_t storeByteOrder = 0x01020304;
+static const size_t storeAlign = 64;
+
+struct store_header {
+  char magic[8];
+  uint32_t byteOrder;
+  uint32_t nIndexes;
+  uint64_t hours;
+  uint64_t windOffset, waveOffset, indexOffset;
+  uint64_t fileSize;
+};
+
+struct store_index {
+  double maxWind, maxWave;
+  uint64_t longest;
+  uint64_t runsOffset;
+};
+
+static uint64_t align_up(uint64_t offset) {return (offset + storeAlign - 1) / storeAlign * storeAlign;}
+
+
+void wobos_weather::write_store(const string &fname, const vector<pair<double, double> > &limits) const {
+  vector<pair<double, double> > unique(limits);
+  sort(unique.begin(), unique.end());
+  unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+  store_header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, storeMagic, sizeof(storeMagic));
+  header.byteOrder   = storeByteOrder;
+  header.nIndexes    = (uint32_t)unique.size();
+  header.hours       = n;
+  header.windOffset  = align_up(sizeof(header));
+  header.waveOffset  = align_up(header.windOffset + n*sizeof(double));
+  header.indexOffset = align_up(header.waveOffset + n*sizeof(double));
+  uint64_t offset    = align_up(header.indexOffset + unique.size()*sizeof(store_index));
+
+  vector<store_index> table(unique.size());
+  vector<shared_ptr<const weather_windows> > runs(unique.size());
+  for (size_t k=0; k<unique.size(); k++) {
+    runs[k] = windows(unique[k].first, unique[k].second);
+    table[k].maxWind    = unique[k].first;
+    table[k].maxWave    = unique[k].second;
+    table[k].longest    = runs[k]->longest();
+    table[k].runsOffset = offset;
+    offset = align_up(offset + n*sizeof(int32_t));
+  }
+  header.fileSize = offset;
+
+  ofstream out(fname.c_str(), ios::binary | ios::trunc);
+  if (!out.is_open()) throw runtime_error("Cannot write weather store: " + fname);
+  auto write_at = [&out] (uint64_t at, const void *data, size_t size) {
+    static const char zeros[storeAlign] = {0};
+    uint64_t pos = (uint64_t)out.tellp();
+    while (pos < at) {
+      size_t k = (size_t)min<uint64_t>(at - pos, storeAlign);
+      out.write(zeros, k);
+      pos += k;
+    }
+    if (size > 0) out.write((const char*)data, size);
+  };
+  write_at(0, &header, sizeof(header));
+  write_at(header.windOffset, windCol, n*sizeof(double));
+  write_at(header.waveOffset, waveCol, n*sizeof(double));
+  write_at(header.indexOffset, table.empty() ? NULL : &table[0], table.size()*sizeof(store_index));
+  for (size_t k=0; k<runs.size(); k++) write_at(table[k].runsOffset, runs[k]->run_column(), n*sizeof(int32_t));
+  write_at(header.fileSize, NULL, 0);
+  if (!out.good()) throw runtime_error("Cannot write weather store: " + fname);
+}
+
+
+// Read-only mapping of a whole file, released with the last reference
+static shared_ptr<const void> map_file(const string &fname, uint64_t &size) {
+#ifdef _WIN32
+  // Read into memory instead; still no parsing
+  ifstream in(fname.c_str(), ios::binary | ios::ate);
+  if (!in.is_open()) throw runtime_error("Cannot open weather store: " + fname);
+  size = (uint64_t)in.tellg();
+  shared_ptr<vector<uint64_t> > data = make_shared<vector<uint64_t> >(size / sizeof(uint64_t) + 1);
+  in.seekg(0);
+  in.read((char*)&(*data)[0], size);
+  if (!in) throw runtime_error("Cannot read weather store: " + fname);
+  return shared_ptr<const void>(data, &(*data)[0]);
+#else
+  int fd = ::open(fname.c_str(), O_RDONLY);
+  if (fd < 0) throw runtime_error("Cannot open weather store: " + fname);
+  struct stat st;
+  if ((fstat(fd, &st) != 0) || (st.st_size == 0)) {
+    ::close(fd);
+    throw runtime_error("Cannot read weather store: " + fname);
+  }
+  size = (uint64_t)st.st_size;
+  void *p = mmap(NULL, (size_t)size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED) throw runtime_error("Cannot map weather store: " + fname);
+  size_t length = (size_t)size;
+  return shared_ptr<const void>(p, [length] (const void *q) {munmap(const_cast<void*>(q), length);});
+#endif
+}
+
+
+shared_ptr<const wobos_weather> wobos_weather::open_store(const string &fname) {
+  // Stores open in this process, so that every caller shares one mapping and the windows indexed on it
+  static mutex openLock;
+  static map<string, weak_ptr<const wobos_weather> > open;
+  lock_guard<mutex> guard(openLock);
+  shared_ptr<const wobos_weather> existing = open[fname].lock();
+  if (existing) return existing;
+
+  uint64_t size;
+  shared_ptr<const void> mapping = map_file(fname, size);
+  const char *base = (const char*)mapping.get();
+  const string bad = "Not a weather store of this machine, or damaged: " + fname;
+
+  store_header header;
+  if (size < sizeof(header)) throw runtime_error(bad);
+  memcpy(&header, base, sizeof(header));
+  const uint64_t n = header.hours;
+  if ( (memcmp(header.magic, storeMagic, sizeof(storeMagic)) != 0) || (header.byteOrder != storeByteOrder) ||
+       (header.fileSize != size) || (n > (uint64_t)INT32_MAX) ||
+       (header.windOffset + n*sizeof(double) > size) || (header.waveOffset + n*sizeof(double) > size) ||
+       (header.indexOffset + header.nIndexes*sizeof(store_index) > size) ||
+       (header.windOffset % sizeof(double) != 0) || (header.waveOffset % sizeof(double) != 0) )
+    throw runtime_error(bad);
+
+  shared_ptr<wobos_weather> weather(new wobos_weather());
+  weather->mapping = mapping;
+  weather->n       = (size_t)n;
+  weather->windCol = (const double*)(base + header.windOffset);
+  weather->waveCol = (const double*)(base + header.waveOffset);
+  for (uint32_t k=0; k<header.nIndexes; k++) {
+    store_index index;
+    memcpy(&index, base + header.indexOffset + k*sizeof(store_index), sizeof(index));
+    if ((index.runsOffset + n*sizeof(int32_t) > size) || (index.runsOffset % sizeof(int32_t) != 0) || (index.longest > n))
+      throw runtime_error(bad);
+    weather->indexes[make_pair(index.maxWind, index.maxWave)] =
+      make_shared<weather_windows>((const int32_t*)(base + index.runsOffset), (size_t)n, (size_t)index.longest, mapping);
+  }
+  open[fname] = weather;
+  return weather;
+}
+
+
+shared_ptr<const wobos_weather> wobos_weather::open(const string &fname) {
+  char magic[sizeof(storeMagic)] = {0};
+  ifstream in(fname.c_str(), ios::binary);
+  if (!in.is_open()) throw runtime_error("Cannot open weather file: " + fname);
+  in.read(magic, sizeof(magic));
+  in.close();
+  return (memcmp(magic, storeMagic, sizeof(storeMagic)) == 0) ? open_store(fname) : read_csv(fname);
+}
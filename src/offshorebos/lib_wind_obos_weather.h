@@ -0,0 +1,114 @@
+#ifndef __wind_obos_weather_h
+#define __wind_obos_weather_h
+
+// Hourly weather at a site, e.g. decades of hindcast wind speed and significant wave height, and the workable
+// windows that a vessel with a wind and a wave limit finds in it.  An activity of d hours needs d hours in a
+// row within both limits; the wait for such a window replaces the flat weather contingencies of wobos.
+//
+// weather_windows indexes one pair of limits once, in O(hours of record), as a single column of runs: at a
+// workable hour the number of workable hours in a row from it, at an unworkable one minus the number of hours
+// to the next workable one.  Whether a window is workable is then one comparison, finding the next window
+// skips whole runs, and the delays over every start hour of the record for one activity length take one more
+// pass.  The record is treated as repeating, so times past its end wrap around to its start.
+//
+// A weather store keeps the columns and the runs of chosen limits in one binary file (see make_weather_store)
+// that is memory-mapped rather than read: opening it parses nothing, and every wobos run and process on the
+// machine shares one copy of it in the page cache.  Layout, in the byte order of the machine that wrote it
+// (checked when opened), with every block at a multiple of 64 bytes:
+//   header     "WOBOSWX1", uint32 byte order mark 0x01020304, uint32 number of indexes, uint64 hours,
+//              uint64 offsets of the wind column, the wave column and the index table, uint64 file size
+//   wind       hours doubles, m/s
+//   wave       hours doubles, m
+//   indexes    per index: double maxWind, double maxWave, uint64 longest run, uint64 offset of its runs
+//   runs       hours int32 per index
+
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+// Wait for a window of one activity length over every start hour of the record, in hours
+struct weather_delay {
+  double hours;        // activity length
+  double mean;
+  double p50;
+  double p90;
+  double max;
+  double contingency;  // mean / (hours + mean), so that hours / (1 - contingency) = hours + mean
+};
+
+class weather_windows {
+ public:
+  // Hours within maxWind (m/s) and maxWave (m); a limit <= 0 means none
+  weather_windows(const double *wind, const double *wave, size_t n, double maxWind, double maxWave);
+
+  // Runs indexed before, e.g. in a weather store, that owner keeps in memory
+  weather_windows(const int32_t *runs, size_t n, size_t longest, std::shared_ptr<const void> owner);
+
+  size_t hours() const {return n;}
+  size_t longest() const {return longestRun;}
+  const int32_t* run_column() const {return runs;}
+
+  // Every hour in [start, start+length) workable
+  bool workable(size_t start, size_t length) const;
+
+  // Earliest time >= t (hours since the start of the record) at which an activity of the given length can
+  // start and run in workable hours.  Activities start at t if its hours are workable and on the hour
+  // otherwise.  Infinity if the record has no window that long.
+  double next_window(double t, double length) const;
+
+  // Delays over every start hour of the record.  Mean and maximum are infinite if there is no window.
+  weather_delay delays(double length) const;
+
+ private:
+  std::vector<int32_t> storage;
+  std::shared_ptr<const void> owner;
+  const int32_t *runs;
+  size_t n;
+  size_t longestRun;
+};
+
+class wobos_weather {
+ public:
+  size_t hours() const {return n;}
+  const double* wind() const {return windCol;}  // wind speed (m/s), one value per hour
+  const double* wave() const {return waveCol;}  // significant wave height (m)
+
+  // Windows for a pair of limits, from the weather store if it has them and indexed on first use otherwise,
+  // shared by all users of this object (thread-safe)
+  std::shared_ptr<const weather_windows> windows(double maxWind, double maxWave) const;
+
+  // Hourly csv-file with a header line, read a line at a time.  The wind speed and wave height columns are
+  // the first whose names start with "wind" and with "wave" or are "hs" (any case); other columns, e.g. time
+  // stamps, are skipped.  Text after '#' is a comment.  Throws runtime_error if the file cannot be read or a
+  // value cannot be parsed.
+  static std::shared_ptr<const wobos_weather> read_csv(const std::string &fname);
+
+  // Write this weather as a store with the runs of the given limits (maxWind, maxWave) indexed, and map one.
+  // Opening a store that is already open in this process gives the same object.  Both throw runtime_error.
+  void write_store(const std::string &fname, const std::vector<std::pair<double, double> > &limits) const;
+  static std::shared_ptr<const wobos_weather> open_store(const std::string &fname);
+
+  // A weather store or a csv-file, whichever the file is
+  static std::shared_ptr<const wobos_weather> open(const std::string &fname);
+
+  // Constructors
+  wobos_weather(std::vector<double> wind, std::vector<double> wave);
+
+ private:
+  std::vector<double> windData, waveData;
+  std::shared_ptr<const void> mapping;  // of a weather store, which the columns and stored runs point into
+  const double *windCol, *waveCol;
+  size_t n;
+
+  mutable std::mutex lock;
+  mutable std::map<std::pair<double, double>, std::shared_ptr<const weather_windows> > indexes;
+
+  wobos_weather() : windCol(NULL), waveCol(NULL), n(0) {}
+};
+
+#endif
@@ -0,0 +1,91 @@
+#include "lib_wind_obos_weather_sweep.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+// For Python wrapping with c_types
+extern "C" {
+  wobos_weather_sweep* pywobos_sweep_new(const char** outNames, int nOut) {
+    try {
+      return new wobos_weather_sweep(vector<string>(outNames, outNames+nOut));
+    } catch(exception& e) {
+      cout << e.what() << endl;
+      return NULL;
+    }
+  }
+  int pywobos_sweep_run(wobos_weather_sweep* sweep, wobos* obos, double stepHours, int nthreads) {
+    try {
+      sweep->run(*obos, stepHours, nthreads);
+      return 1;
+    } catch(exception& e) {
+      cout << e.what() << endl;
+      return 0;
+    }
+  }
+  double pywobos_sweep_starts(wobos_weather_sweep* sweep) {return (double)sweep->starts();}
+  // count, NaN count, mean, standard deviation, min, max and infinite count of output k
+  void pywobos_sweep_stats(wobos_weather_sweep* sweep, int k, double* out) {
+    const wobos_stats &st = sweep->stats(k);
+    out[0] = st.count;
+    out[1] = st.nans;
+    out[2] = st.mean;
+    out[3] = st.stddev();
+    out[4] = st.min;
+    out[5] = st.max;
+    out[6] = st.infs;
+  }
+  double pywobos_sweep_quantile(wobos_weather_sweep* sweep, int k, double q) {return sweep->stats(k).quantile(q);}
+  void pywobos_sweep_delete(wobos_weather_sweep* sweep) {delete sweep;}
+}
+
+
+const size_t wobos_weather_sweep::BLOCK;
+
+
+wobos_weather_sweep::wobos_weather_sweep(vector<string> outNames) : outputNames(outNames), nStarts(0) {
+  if (outputNames.empty())
+    outputNames = {"totInstTime", "turbine_install_cost", "substructure_install_cost", "mob_demob_cost", "installSeasons"};
+  for (size_t k=0; k<outputNames.size(); k++) {
+    outputIds.push_back( wobos::variable_index(outputNames[k]) );
+    if (outputIds.back() < 0) throw invalid_argument("Unknown output variable: " + outputNames[k]);
+  }
+  outputStats.assign(nOutputs(), wobos_stats());
+}
+
+
+void wobos_weather_sweep::run(const wobos &obos, double stepHours, int nthreads) {
+  if (!obos.weather || (obos.weather->hours() == 0)) throw runtime_error("No weather to start the installation in");
+  if (!(stepHours > 0.0)) throw invalid_argument("Need a positive step between installation starts");
+
+  // Same sequence as the Python wrapper, with the schedule simulated
+  wobos base(obos);
+  base.set_map_variable("installSimulation", "TRUE");
+  base.map2variables();
+  base.set_vessel_defaults();
+  baseline.assign(base.varValues, base.varValues + NVARIABLES);
+
+  const size_t n = (size_t)ceil(base.weather->hours() / stepHours);
+
+  // Every thread starts its own plant at the starts of a block, the statistics of blocks are merged in order
+  auto plant = [&base] () {return wobos(base);};
+  auto work = [&] (wobos &worker, size_t b, vector<wobos_stats> &blockStats) {
+    for (size_t i=b*BLOCK; i<min((b + 1)*BLOCK, n); i++) {
+      copy(baseline.begin(), baseline.end(), worker.varValues);
+      worker.varValues[VAR_installStartHour] = i * stepHours;
+      worker.map2variables();
+      worker.run_incremental();
+      worker.variables2map();
+      for (size_t k=0; k<nOutputs(); k++) blockStats[k].add(worker.varValues[outputIds[k]]);
+    }
+  };
+  outputStats.assign(nOutputs(), wobos_stats());
+  auto merge = [&] (const vector<wobos_stats> &blockStats) {
+    for (size_t k=0; k<nOutputs(); k++) outputStats[k].merge(blockStats[k]);
+  };
+  run_blocks((n + BLOCK - 1) / BLOCK, nthreads, plant, vector<wobos_stats>(nOutputs()), work, merge);
+  nStarts = n;
+}
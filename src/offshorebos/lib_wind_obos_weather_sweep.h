@@ -0,0 +1,49 @@
+#ifndef __wind_obos_weather_sweep_h
+#define __wind_obos_weather_sweep_h
+
+#include "lib_wind_obos_batch.h"
+#include "lib_wind_obos_stats.h"
+#include <vector>
+#include <string>
+
+// Installation of one plant started at every hour stepHours apart of its site weather, e.g. every day of
+// decades of hindcast, or every year with stepHours = 8760: how much installation times and costs vary with
+// the weather of the season the installation falls in, where the plant's own outputs only show one start.
+//
+// Every start runs the plant from the variables of obos (like a scenario of wobos_batch) with installSimulation
+// on and installStartHour set to the start, so fixed substructures and turbines are installed in the weather
+// windows from that hour on (see lib_wind_obos_install_sim.h), and with installSeasonLength > 0 a longer
+// installation mobilizes for more seasons.  Floating substructures keep the closed-form times and so do not
+// vary.  Only the stages that depend on the start are recomputed (see run_incremental()).
+//
+// Starts are run in blocks of BLOCK over threads (see run_blocks in lib_wind_obos_batch.h); every thread keeps
+// its own plant, and the statistics of the blocks are merged in block order, so results do not depend on the
+// number of threads.
+class wobos_weather_sweep {
+ public:
+  static const size_t BLOCK = 32;
+
+  vector<string> outputNames;
+
+  size_t nOutputs() {return outputNames.size();}
+
+  // Start obos every stepHours hours of its weather over nthreads threads (all hardware threads if nthreads <= 0),
+  // replacing the statistics of any earlier run.  Throws runtime_error if obos has no weather.
+  void run(const wobos &obos, double stepHours=24.0, int nthreads=0);
+
+  // Statistics of output k over all starts, e.g. stats(k).quantile(0.9) for its P90
+  const wobos_stats& stats(size_t k) const {return outputStats[k];}
+  size_t starts() const {return nStarts;}
+
+  // Constructors: totInstTime, turbine_install_cost, substructure_install_cost, mob_demob_cost and
+  // installSeasons if no outputs are named
+  wobos_weather_sweep(vector<string> outNames=vector<string>());
+
+ private:
+  vector<int> outputIds;
+  vector<double> baseline;
+  vector<wobos_stats> outputStats;
+  size_t nStarts;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+Convert wind_obos_defaults.csv into a C++ header so the defaults are compiled into lib_wind_obos.
+Rows are cleaned up the same way lib_wind_obos_defaults.cpp treats a user-supplied defaults file:
+a line that starts with '#' is a comment ('#' anywhere else is text, as in "Cable #1"), cells are
+trimmed, and units/value/constraints are upper-cased.  Rows are then parsed the way the variable
+class parses the rows of such a file, so that building the defaults at run time parses nothing:
+the value is the number at the start of its cell (dnull if there is none, as std::stod), and '_'
+in the constraints stands for ','.
+
+Usage: python make_defaults_table.py [wind_obos_defaults.csv] [lib_wind_obos_defaults_table.h]
+"""
+import math
+import os
+import re
+import sys
+
+NCOLUMNS = 7
+
+# Decimal number or infinity at the start of a cell, as strtod reads it
+NUMBER = re.compile(r'[+-]?(?:(?:\d+\.?\d*|\.\d+)(?:E[+-]?\d+)?|INF(?:INITY)?|NAN)', re.IGNORECASE)
+
+def cpp_string(s):
+    return '"' + s.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+def cpp_value(s):
+    m = NUMBER.match(s)
+    if m is None: return 'dnull'
+    x = float(m.group(0))
+    if math.isnan(x): return 'NAN'
+    if math.isinf(x):
+        # Out of range for stod unless spelled out
+        if not m.group(0).lstrip('+-').upper().startswith('INF'): return 'dnull'
+        return '-HUGE_VAL' if x < 0 else 'HUGE_VAL'
+    return repr(x)
+
+def read_rows(fcsv):
+    rows = []
+    with open(fcsv) as f:
+        for line in f:
+            line = line.rstrip('\r\n')
+            if line.lstrip(' \t\r').startswith('#'): continue
+            cells = [c.strip(' \t\r') for c in line.split(',')]
+            if len(cells) != NCOLUMNS: continue
+            cells = cells[:4] + [c.upper() for c in cells[4:]]
+            rows.append(cells)
+    return rows
+
+def write_header(rows, fheader, fcsv):
+    with open(fheader, 'w') as f:
+        f.write('// Generated by make_defaults_table.py from %s, do not edit by hand\n' % os.path.basename(fcsv))
+        f.write('// Columns: IN/OUT, Variable, Description, Units (OpenMDAO), Units (SAM), Value, Value as text, Constraints\n')
+        f.write('#define NDEFAULTS %d\n' % len(rows))
+        f.write('static const variable_row wobos_defaults_table[NDEFAULTS] = {\n')
+        for r in rows:
+            inout = 'INPUT' if r[0] == 'INPUT' else 'OUTPUT'
+            cells = [inout] + [cpp_string(c) for c in r[1:5]] + [cpp_value(r[5]), cpp_string(r[5]), cpp_string(r[6].replace('_', ','))]
+            f.write('  {' + ', '.join(cells) + '},\n')
+        f.write('};\n')
+
+if __name__ == '__main__':
+    mydir   = os.path.dirname(os.path.abspath(__file__))
+    fcsv    = sys.argv[1] if len(sys.argv) > 1 else os.path.join(mydir, 'wind_obos_defaults.csv')
+    fheader = sys.argv[2] if len(sys.argv) > 2 else os.path.join(mydir, 'lib_wind_obos_defaults_table.h')
+    write_header(read_rows(fcsv), fheader, fcsv)
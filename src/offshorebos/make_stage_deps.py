@@ -0,0 +1,104 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+List the class variables that each stage of wobos::run() uses, for run_incremental() in lib_wind_obos.cpp.
+A stage uses every variable of lib_wind_obos_variables.h that its member function, or any member function it
+calls, mentions.  Every mention counts as use, so the lists can only be too long, never too short.
+
+Stages must not use any other class member, apart from the cable and vessel members that run_incremental()
+checks separately; the script fails if one does, since run_incremental() could then reuse a stale result.
+
+Usage: python make_stage_deps.py [lib_wind_obos_stage_deps.h]
+"""
+import io
+import os
+import re
+import sys
+
+# Stages of wobos::run(), in order (same as the STAGE_ enum in lib_wind_obos_profile.h)
+STAGES = ['set_turbine_parameters', 'calculate_substructure_mass_cost', 'calculate_electrical_infrastructure_cost',
+          'calculate_assembly_and_installation', 'calculate_port_and_staging_costs',
+          'calculate_engineering_management_cost', 'calculate_development_cost', 'calculate_bos_cost']
+
+# Members outside of the variable table that stages may read, all set up before run(), and scratch space
+CONTEXT = ['arrCables', 'expCables', 'templates',
+           'turbInstVessel', 'turbFeederBarge', 'subInstVessel', 'subFeederBarge', 'scourProtVessel',
+           'arrCabInstVessel', 'expCabInstVessel', 'substaInstVessel',
+           'turbSupportVessels', 'subSupportVessels', 'elecTugs', 'elecSupportVessels',
+           'profile', 'installSim', 'weather', 'arrayLayout']
+
+def strip_comments_strings(src):
+    # One pass, so that comment markers inside comments or strings are left alone
+    token = re.compile(r'//[^\n]*|/\*.*?\*/|"(?:\\.|[^"\\\n])*"', flags=re.S)
+    return token.sub(lambda m: '""' if m.group(0).startswith('"') else ' ', src)
+
+def read_variables(fname):
+    with io.open(fname) as f:
+        return re.findall(r'^\s*X\((\w+),', f.read(), flags=re.M)
+
+def read_members(fname):
+    # Data and function members declared in the wobos_t class body
+    with io.open(fname, encoding='latin-1') as f:
+        src = strip_comments_strings(f.read())
+    body = src[re.search(r'class wobos_t\s*\{', src).start():]
+    body = body[:body.index('\n};')]
+    data = re.findall(r'^\s*(?:const\s+)?[\w:<>, ]+?[\s\*&]+(\w+)\s*(?:\[[^\]]*\])?\s*;', body, flags=re.M)
+    funcs = re.findall(r'(\w+)\s*\([^;{]*\)\s*(?:const\s*)?[;{]', body)
+    return set(data), set(funcs)
+
+def read_functions(fname):
+    # Body of every wobos_t member function definition
+    with io.open(fname, encoding='latin-1') as f:
+        src = strip_comments_strings(f.read())
+    bodies = {}
+    for m in re.finditer(r'wobos_t<T>::(\w+)\s*\([^;{]*\)\s*(?:const\s*)?\{', src):
+        depth, k = 1, m.end()
+        while depth > 0:
+            depth += {'{': 1, '}': -1}.get(src[k], 0)
+            k += 1
+        bodies[m.group(1)] = bodies.get(m.group(1), '') + src[m.end():k]
+    return bodies
+
+def stage_members(stage, bodies, funcs):
+    # Identifiers of a stage and of everything it calls
+    seen, todo, names = set(), [stage], set()
+    while todo:
+        fn = todo.pop()
+        if fn in seen or fn not in bodies: continue
+        seen.add(fn)
+        ids = set(re.findall(r'\b[A-Za-z_]\w*\b', bodies[fn]))
+        names |= ids
+        todo += [f for f in ids if f in funcs]
+    return names
+
+def write_header(fheader, stageVars):
+    with open(fheader, 'w') as f:
+        f.write('// Generated by make_stage_deps.py from lib_wind_obos.cpp, do not edit by hand\n')
+        f.write('// Variables that each stage of wobos::run() uses, indexed like the STAGE_ enum in lib_wind_obos_profile.h\n')
+        f.write('#define NRUNSTAGES %d\n' % len(STAGES))
+        f.write('static const int wobos_stage_variables[] = {\n')
+        offsets = [0]
+        for stage, names in zip(STAGES, stageVars):
+            f.write('  // %s\n' % stage)
+            for k in range(0, len(names), 6):
+                f.write('  ' + ' '.join('VAR_%s,' % n for n in names[k:k+6]) + '\n')
+            offsets.append(offsets[-1] + len(names))
+        f.write('};\n')
+        f.write('static const int wobos_stage_offsets[NRUNSTAGES+1] = {%s};\n' % ', '.join(str(k) for k in offsets))
+
+if __name__ == '__main__':
+    mydir   = os.path.dirname(os.path.abspath(__file__))
+    fheader = sys.argv[1] if len(sys.argv) > 1 else os.path.join(mydir, 'lib_wind_obos_stage_deps.h')
+
+    variables   = read_variables(os.path.join(mydir, 'lib_wind_obos_variables.h'))
+    data, funcs = read_members(os.path.join(mydir, 'lib_wind_obos.h'))
+    bodies      = read_functions(os.path.join(mydir, 'lib_wind_obos.cpp'))
+
+    stageVars = []
+    for stage in STAGES:
+        if stage not in bodies: sys.exit('make_stage_deps.py: no definition of wobos_t<T>::%s' % stage)
+        names = stage_members(stage, bodies, funcs)
+        other = sorted((names & data) - set(variables) - set(CONTEXT))
+        if other: sys.exit('make_stage_deps.py: %s uses class members outside of the variable table: %s' % (stage, ', '.join(other)))
+        stageVars.append([v for v in variables if v in names])
+    write_header(fheader, stageVars)
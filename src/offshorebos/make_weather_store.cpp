@@ -0,0 +1,65 @@
+// Converts an hourly weather csv-file into a weather store (see lib_wind_obos_weather.h) once, so that later
+// runs map it instead of parsing the csv-file (make weather_store).
+//
+// Usage: make_weather_store.exe [-l maxWind,maxWave ...] weather.csv weather.wmet
+//   -l  also index these limits (m/s, m), e.g. of vessels set with set_vessel_template; may be repeated
+//
+// The limits of every built-in vessel are always indexed.  Other limits still work with the store, they are
+// indexed on first use in each process instead.
+
+#include "lib_wind_obos.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cstdio>
+
+using namespace std;
+
+
+int main(int argc, char** argv) {
+  vector<pair<double, double> > limits = wobos_templates::builtin()->weather_limits();
+  vector<string> files;
+
+  for (int k=1; k<argc; k++) {
+    string arg(argv[k]);
+    if (arg == "-l") {
+      double maxWind, maxWave;
+      if ((k+1 >= argc) || (sscanf(argv[++k], "%lf,%lf", &maxWind, &maxWave) != 2)) {
+	cout << "Need -l maxWind,maxWave" << endl;
+	return 1;
+      }
+      limits.push_back(make_pair(maxWind, maxWave));
+    }
+    else files.push_back(arg);
+  }
+  if (files.size() != 2) {
+    cout << "Usage: make_weather_store.exe [-l maxWind,maxWave ...] weather.csv weather.wmet" << endl;
+    return 1;
+  }
+
+  try {
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    shared_ptr<const wobos_weather> weather = wobos_weather::read_csv(files[0]);
+    weather->write_store(files[1], limits);
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+    // Check that it maps, and how long that takes compared to the csv-file
+    shared_ptr<const wobos_weather> store = wobos_weather::open_store(files[1]);
+    chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+    if (store->hours() != weather->hours()) throw runtime_error("Weather store does not read back: " + files[1]);
+
+    cout << weather->hours() << " hours, " << limits.size() << " vessel limits" << endl;
+    cout << fixed << setprecision(3)
+	 << "read and indexed in " << chrono::duration<double>(t1 - t0).count() << " s, mapped in "
+	 << chrono::duration<double>(t2 - t1).count() << " s" << endl;
+  } catch(exception& e) {
+    cout << e.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,66 @@
+#ifndef __wind_obos_test_h
+#define __wind_obos_test_h
+
+// Checks shared by the test programs (make test).  A failed check prints where and why, and the program
+// continues with the next check; test_result() reports the number of failures and is the exit code.
+
+#include "lib_wind_obos_weather.h"
+
+#include <vector>
+#include <random>
+#include <memory>
+#include <cstdint>
+#include <cmath>
+#include <cstdio>
+
+static int nChecks = 0, nFailures = 0;
+
+#define CHECK(cond) do {                                                            \
+    nChecks++;                                                                      \
+    if (!(cond)) {                                                                  \
+      nFailures++;                                                                  \
+      printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #cond);                     \
+    }                                                                               \
+  } while (0)
+
+// |a - b| <= tol * max(|a|, |b|, 1)
+#define CHECK_CLOSE(a, b, tol) do {                                                 \
+    double ca_ = (a), cb_ = (b);                                                    \
+    nChecks++;                                                                      \
+    if (!(std::fabs(ca_ - cb_) <= (tol) * std::fmax(std::fmax(std::fabs(ca_), std::fabs(cb_)), 1.0))) { \
+      nFailures++;                                                                  \
+      printf("%s:%d: failed: %s = %.12g, %s = %.12g\n", __FILE__, __LINE__, #a, ca_, #b, cb_); \
+    }                                                                               \
+  } while (0)
+
+#define CHECK_THROWS(expr) do {                                                     \
+    bool threw_ = false;                                                            \
+    try {expr;} catch (...) {threw_ = true;}                                        \
+    nChecks++;                                                                      \
+    if (!threw_) {                                                                  \
+      nFailures++;                                                                  \
+      printf("%s:%d: failed: %s did not throw\n", __FILE__, __LINE__, #expr);       \
+    }                                                                               \
+  } while (0)
+
+static int test_result(const char* name) {
+  printf("%s: %d checks, %d failed\n", name, nChecks, nFailures);
+  return nFailures ? 1 : 0;
+}
+
+// Hourly weather with persistent spells, like a hindcast series
+static std::shared_ptr<const wobos_weather> site_weather(size_t hours, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::normal_distribution<double> noise(0.0, 1.0);
+  std::vector<double> wind(hours), wave(hours);
+  double x = 8.0, y = 1.5;
+  for (size_t h=0; h<hours; h++) {
+    x = 8.0 + 0.97*(x - 8.0) + 1.2*noise(rng);
+    y = 1.5 + 0.98*(y - 1.5) + 0.15*noise(rng);
+    wind[h] = std::fabs(x);
+    wave[h] = std::fabs(y);
+  }
+  return std::make_shared<const wobos_weather>(wind, wave);
+}
+
+#endif
@@ -0,0 +1,168 @@
+// Tests of the array layout strings (lib_wind_obos_array_layout.h) against the same rule applied by a search
+// over all turbines, and of the array cable lengths of wobos runs with a layout attached.
+
+#include "lib_wind_obos.h"
+#include "test_wind_obos.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+
+// Strings by the rule of the header, looking at every turbine for the next one
+static vector<vector<size_t> > strings_by_search(const wobos_array_layout &lay, size_t capacity) {
+  const vector<double> &tx = lay.turbine_x(), &ty = lay.turbine_y();
+  const vector<double> &sx = lay.substation_x(), &sy = lay.substation_y();
+  const size_t n = lay.turbines();
+  vector<size_t> subs(n);
+  vector<double> dist(n, numeric_limits<double>::infinity());
+  for (size_t i=0; i<n; i++)
+    for (size_t s=0; s<lay.substations(); s++) {
+      double d = hypot(tx[i] - sx[s], ty[i] - sy[s]);
+      if (d < dist[i]) {
+	dist[i] = d;
+	subs[i] = s;
+      }
+    }
+  vector<size_t> outsideIn(n);
+  for (size_t i=0; i<n; i++) outsideIn[i] = i;
+  stable_sort(outsideIn.begin(), outsideIn.end(), [&dist] (size_t a, size_t b) {return dist[a] > dist[b];});
+
+  vector<vector<size_t> > out;
+  vector<char> isFree(n, 1);
+  for (size_t first : outsideIn) {
+    if (!isFree[first]) continue;
+    vector<size_t> str(1, first);
+    isFree[first] = 0;
+    while (str.size() < capacity) {
+      size_t from = str.back(), found = n;
+      double best = dist[from] * dist[from];
+      for (size_t p=0; p<n; p++) {
+	double dx = tx[p] - tx[from], dy = ty[p] - ty[from], d2 = dx*dx + dy*dy;
+	if (isFree[p] && (subs[p] == subs[from]) && (dist[p] < dist[from]) && (d2 < best)) {
+	  best  = d2;
+	  found = p;
+	}
+      }
+      if (found == n) break;
+      str.push_back(found);
+      isFree[found] = 0;
+    }
+    out.push_back(str);
+  }
+  return out;
+}
+
+
+// Counts and section lengths that go with the turbines of the strings
+static void check_strings(const wobos_array_layout &lay, const array_strings &s, size_t capacity) {
+  const vector<double> &tx = lay.turbine_x(), &ty = lay.turbine_y();
+  const vector<double> &sx = lay.substation_x(), &sy = lay.substation_y();
+  capacity = min(capacity, lay.turbines());
+  CHECK(s.capacity == capacity && s.substation.size() == s.turbines.size());
+  vector<double> length(capacity + 1, 0.0), count(capacity + 1, 0.0);
+  double link = 0.0;
+  size_t full = 0, partial = 0, total = 0;
+  for (size_t k=0; k<s.turbines.size(); k++) {
+    const vector<size_t> &str = s.turbines[k];
+    for (size_t j=1; j<str.size(); j++) {
+      length[j] += hypot(tx[str[j]] - tx[str[j-1]], ty[str[j]] - ty[str[j-1]]);
+      count[j]  += 1.0;
+    }
+    link += hypot(tx[str.back()] - sx[s.substation[k]], ty[str.back()] - sy[s.substation[k]]);
+    if (str.size() == capacity) full++;
+    else partial += str.size();
+    total += str.size();
+  }
+  CHECK(s.fullStrings == full && s.partialTurbines == partial && total == lay.turbines());
+  CHECK_CLOSE(s.linkLength, link, 1e-12);
+  for (size_t k=1; k<=capacity; k++) {
+    length[k] += length[k-1];
+    count[k]  += count[k-1];
+    CHECK_CLOSE(s.sectionLength[k], length[k], 1e-12);
+    CHECK(s.sectionCount[k] == count[k]);
+  }
+  CHECK(s.sectionLength[0] == 0.0 && s.sectionCount[0] == 0.0);
+}
+
+
+static shared_ptr<const wobos_array_layout> random_layout(mt19937_64 &rng, size_t n, size_t nSubs, bool grid) {
+  uniform_real_distribution<double> u(0.0, 12000.0);
+  vector<double> tx, ty, sx, sy;
+  const size_t side = (size_t)ceil(sqrt((double)n));
+  for (size_t i=0; i<n; i++) {
+    tx.push_back(grid ? 800.0 * (i % side) : u(rng));
+    ty.push_back(grid ? 800.0 * (i / side) : u(rng));
+  }
+  for (size_t s=0; s<nSubs; s++) {
+    sx.push_back(grid ? 800.0 * (rng() % side) : u(rng));
+    sy.push_back(grid ? 800.0 * (rng() % side) + 400.0 : u(rng));
+  }
+  return make_shared<const wobos_array_layout>(tx, ty, sx, sy);
+}
+
+
+static void test_strings() {
+  mt19937_64 rng(9);
+  for (int trial=0; trial<60; trial++) {
+    size_t n = 1 + rng() % 300, nSubs = 1 + rng() % 3;
+    shared_ptr<const wobos_array_layout> lay = random_layout(rng, n, nSubs, trial % 3 == 0);
+
+    // The first capacity comes from the tree only, later ones from the successors of every turbine as well
+    for (size_t capacity : {(size_t)5, (size_t)1, (size_t)3, (size_t)12, n, n + 4}) {
+      shared_ptr<const array_strings> s = lay->strings(capacity);
+      CHECK(s == lay->strings(capacity));
+      CHECK(s->turbines == strings_by_search(*lay, min(capacity, n)));
+      check_strings(*lay, *s, capacity);
+    }
+  }
+
+  vector<double> one(1, 0.0), none;
+  CHECK_THROWS(wobos_array_layout(none, none, one, one));
+  CHECK_THROWS(wobos_array_layout(one, one, none, none));
+  CHECK_THROWS(wobos_array_layout(one, none, one, one));
+  CHECK_THROWS(wobos_array_layout(one, one, one, one).strings(0));
+}
+
+
+// Horizontal cable lengths of a fixed plant are those of the strings of one capacity: every turbine has one
+// section towards its substation, and every section goes down to the seabed and up again
+static void test_wobos() {
+  mt19937_64 rng(4);
+  const size_t n = 60;
+  shared_ptr<const wobos_array_layout> lay = random_layout(rng, n, 2, false);
+  for (double optimizer : {0.0, 1.0}) {
+    wobos obos, grid;
+    for (wobos* w : {&obos, &grid}) {
+      w->set_map_variable("nTurb", (double)n);
+      w->set_map_variable("cableOptimizer", optimizer);
+      w->map2variables();
+      w->set_vessel_defaults();
+    }
+    obos.arrayLayout = lay;
+    obos.run();
+    grid.run();
+    CHECK(obos.nSubstation >= 2.0);
+    CHECK(obos.cab1Leng + obos.cab2Leng != grid.cab1Leng + grid.cab2Leng);
+
+    double horizontal = (obos.cab1Leng + obos.cab2Leng) / (1 + obos.exCabFac) - 2*obos.waterD*n;
+    size_t matches = 0;
+    for (size_t capacity=1; capacity<=n; capacity++) {
+      shared_ptr<const array_strings> s = lay->strings(capacity);
+      matches += fabs(s->sectionLength[s->capacity] + s->linkLength - horizontal) <= 1e-9 * horizontal;
+    }
+    CHECK(matches >= 1);
+  }
+}
+
+
+int main() {
+  test_strings();
+  test_wobos();
+  return test_result("test_wind_obos_array_layout");
+}
@@ -0,0 +1,346 @@
+// Tests of the array cable optimizer (wobos::ArrayCabCostOptimizer) against a search over every pair of cables
+// of random catalogs, with many cables that tie, at every instruction set of the cable kernels, and of the
+// family and pair kernels (lib_wind_obos_cable_cost.h) against export_cable_cost and array_cable_cost, and of
+// the choice cache (lib_wind_obos_cable_cache.h): its keys and its least recently used eviction.
+
+#include "lib_wind_obos.h"
+#include "lib_wind_obos_cable_cache.h"
+#include "test_wind_obos.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+
+using namespace std;
+
+
+// The private cable stages of wobos
+class wobos_test {
+ public:
+  static cable_context context(const wobos &obos) {return obos.get_cable_context();}
+
+  static double array_cable_cost(wobos &obos, double voltage, const cable &c1, const cable &c2) {
+    return obos.calculate_array_cable_cost(c1.currRating, c2.currRating, voltage, c1.mass, c2.mass, c1.cost, c2.cost,
+					   c1.turbInterfaceCost, c2.turbInterfaceCost, c2.subsInterfaceCost);
+  }
+};
+
+
+// Current rating that carries nTurb turbines and a fraction of one at the voltage
+static double rating_for(const cable_context &c, double voltage, double nTurb) {
+  return nTurb * 1000.0 * c.turbR / (sqrt(3) * voltage * c.pwrFac * (1 - (c.buryDepth - 1)*c.buryFac));
+}
+
+
+// n cables drawn from nTypes types.  Cables of one type only differ in their current rating, which still
+// carries the same number of turbines, so they cost the same and only the rating tells them apart.
+static cableFamily random_family(mt19937_64 &rng, const cable_context &c, double voltage, size_t n, size_t nTypes) {
+  uniform_real_distribution<double> u(0.0, 1.0);
+  vector<double> typeCost(nTypes), typeMass(nTypes), typeTurbInter(nTypes), typeSubsInter(nTypes), typeTurbines(nTypes);
+  for (size_t t=0; t<nTypes; t++) {
+    typeTurbines[t]  = (double)(1 + rng() % 12);
+    typeCost[t]      = 150.0 + 60.0*typeTurbines[t]*(0.5 + u(rng));
+    typeMass[t]      = 20.0 + 50.0*u(rng);
+    typeTurbInter[t] = 8000.0 + 9000.0*u(rng);
+    typeSubsInter[t] = 19000.0 + 10000.0*u(rng);
+  }
+  vector<double> cost(n), area(n), mass(n), rating(n), turbInter(n), subsInter(n);
+  for (size_t k=0; k<n; k++) {
+    size_t t = rng() % nTypes;
+    cost[k]      = typeCost[t];
+    area[k]      = 100.0 + k;
+    mass[k]      = typeMass[t];
+    rating[k]    = rating_for(c, voltage, typeTurbines[t] + 0.05 + 0.9*u(rng));
+    turbInter[k] = typeTurbInter[t];
+    subsInter[k] = typeSubsInter[t];
+  }
+  cableFamily f;
+  f.set_all_cost(cost);
+  f.set_all_area(area);
+  f.set_all_mass(mass);
+  f.set_all_current_rating(rating);
+  f.set_all_turbine_interface_cost(turbInter);
+  f.set_all_substation_interface_cost(subsInter);
+  f.set_voltage(voltage);
+  return f;
+}
+
+
+static wobos plant(const string &substructure, double nTurb) {
+  wobos obos;
+  obos.set_map_variable("substructure", substructure);
+  obos.set_map_variable("nTurb", nTurb);
+  obos.set_map_variable("cableOptimizer", 1.0);
+  obos.map2variables();
+  obos.set_vessel_defaults();
+  return obos;
+}
+
+
+// First cheapest pair in catalog order: families, then array cable 1, then array cable 2 after it
+static void check_choice(const wobos &obos, size_t &ties) {
+  wobos search(obos);
+  double best = 1e30;
+  size_t nBest = 0;
+  const cable *c1 = NULL, *c2 = NULL;
+  double voltage = 0.0;
+  for (const cableFamily &f : obos.arrCables)
+    for (size_t i=0; i<f.cables.size(); i++)
+      for (size_t j=i+1; j<f.cables.size(); j++) {
+	double cost = wobos_test::array_cable_cost(search, f.voltage, f.cables[i], f.cables[j]);
+	if (cost < best) {
+	  best    = cost;
+	  nBest   = 0;
+	  c1      = &f.cables[i];
+	  c2      = &f.cables[j];
+	  voltage = f.voltage;
+	}
+	nBest += (cost == best);
+      }
+  ties += (nBest > 1);
+  CHECK(c1 && c2);
+  if (!c1 || !c2) return;
+  CHECK(obos.arrVoltage == voltage);
+  CHECK(obos.cab1CR == c1->cost && obos.cab2CR == c2->cost);
+  CHECK(obos.cab1CurrRating == c1->currRating && obos.cab2CurrRating == c2->currRating);
+  CHECK(obos.arrCab1Mass == c1->mass && obos.arrCab2Mass == c2->mass);
+  CHECK(obos.cab1TurbInterCR == c1->turbInterfaceCost && obos.cab2TurbInterCR == c2->turbInterfaceCost);
+  CHECK(obos.cab2SubsInterCR == c2->subsInterfaceCost);
+}
+
+
+static void test_optimizer() {
+  const int best = get_cable_simd();
+  const size_t capacity = cable_choice_cache::shared().capacity();
+  cable_choice_cache::shared().set_capacity(0);
+  mt19937_64 rng(6);
+  size_t ties = 0;
+  for (int trial=0; trial<30; trial++) {
+    wobos base = plant((trial % 3 == 2) ? "SPAR" : "MONOPILE", (double)(10 + rng() % 150));
+    if (trial % 3 == 2) base.set_map_variable("waterD", 300.0);
+    base.map2variables();
+    const cable_context c = wobos_test::context(base);
+
+    // Three families, one of them large, with few or many types of cable
+    base.arrCables.clear();
+    for (size_t size : {(size_t)11, (size_t)120, (size_t)(2 + rng() % 30)}) {
+      double voltage = (rng() % 2) ? 33.0 : 66.0;
+      size_t nTypes  = (rng() % 2) ? 3 : size;
+      base.arrCables.push_back(random_family(rng, c, voltage, size, nTypes));
+    }
+    for (int level : {best, (int)CABLE_SIMD_SCALAR}) {
+      set_cable_simd(level);
+      wobos obos(base);
+      obos.run();
+      check_choice(obos, ties);
+    }
+  }
+  CHECK(ties > 10);
+
+  // Families that tie as a whole: the first one in the catalog is chosen
+  wobos base = plant("MONOPILE", 80.0);
+  const cable_context c = wobos_test::context(base);
+  cableFamily first = random_family(rng, c, 33.0, 11, 11), second(first);
+  for (cable &cab : second.cables) cab.currRating = rating_for(c, 33.0, floor(cab.currRating / rating_for(c, 33.0, 1.0)) + 0.5);
+  base.arrCables = {first, second};
+  for (int level : {best, (int)CABLE_SIMD_SCALAR}) {
+    set_cable_simd(level);
+    wobos obos(base);
+    obos.run();
+    size_t found = 0;
+    for (size_t i=0; i<first.cables.size(); i++) {
+      found += (obos.cab1CurrRating == first.cables[i].currRating);
+      found += (obos.cab2CurrRating == first.cables[i].currRating);
+    }
+    CHECK(found == 2);
+    check_choice(obos, ties);
+  }
+
+  set_cable_simd(best);
+  cable_choice_cache::shared().set_capacity(capacity);
+}
+
+
+// Every candidate of every family size, odd ones included so that the vectors leave a remainder, and pair
+// ranges that start anywhere.  Candidates outside the range are not written.
+static void test_kernels() {
+  const int best = get_cable_simd();
+  mt19937_64 rng(8);
+  for (const char *sub : {"MONOPILE", "JACKET", "SPAR"}) {
+    wobos obos = plant(sub, 60.0);
+    if (string(sub) == "SPAR") obos.set_map_variable("waterD", 300.0);
+    obos.map2variables();
+    obos.run();
+    const cable_context c = wobos_test::context(obos);
+
+    for (size_t n : {1, 2, 3, 4, 5, 7, 8, 9, 13, 37, 121}) {
+      const cableFamily array = random_family(rng, c, (n % 2) ? 33.0 : 66.0, n, n);
+      const cableFamily exported = random_family(rng, c, (n % 2) ? 132.0 : 220.0, n, n);
+      const cable_columns arrayCols(array), exportCols(exported);
+      vector<double> nTurbCab(n), secPerTrip(n);
+      for (size_t j=0; j<n; j++) {
+	nTurbCab[j]   = array_cable_turbines(c, arrayCols.currRating[j], arrayCols.voltage);
+	secPerTrip[j] = array_cable_sections_per_trip(c, arrayCols.mass[j]);
+      }
+
+      for (int level=best; level>=CABLE_SIMD_SCALAR; level--) {
+	CHECK(set_cable_simd(level) == level);
+	vector<double> cost(n);
+	export_cable_cost_family(c, exportCols, &cost[0]);
+	for (size_t i=0; i<n; i++) {
+	  const cable &e = exported.cables[i];
+	  CHECK(cost[i] == export_cable_cost(c, e.currRating, exported.voltage, e.mass, e.subsInterfaceCost, e.cost).totalCost);
+	}
+
+	for (size_t i=0; i<n; i++) {
+	  array_cable_row row;
+	  row.resize(n);
+	  for (size_t j=i+1; j<n; j++) row.set(j, calculate_array_cable_layout(c, nTurbCab[i], nTurbCab[j]));
+	  const cable &c1 = array.cables[i];
+	  vector<double> pairCost(n, -1.0);
+	  array_cable_cost_pairs(c, c1.cost, c1.turbInterfaceCost, secPerTrip[i], row, arrayCols, &secPerTrip[0], i + 1, n, &pairCost[0]);
+	  for (size_t j=0; j<=i; j++) CHECK(pairCost[j] == -1.0);
+	  for (size_t j=i+1; j<n; j++) {
+	    const cable &c2 = array.cables[j];
+	    CHECK(pairCost[j] == array_cable_cost(c, c1.currRating, c2.currRating, array.voltage, c1.mass, c2.mass, c1.cost, c2.cost,
+						  c1.turbInterfaceCost, c2.turbInterfaceCost, c2.subsInterfaceCost).totalCost);
+	  }
+	}
+      }
+    }
+  }
+  set_cable_simd(best);
+}
+
+
+// Plants that only differ in one cable of a custom template have keys of their own, and each gets the choice
+// that the optimizer makes without the cache
+static void test_cache_keys() {
+  cable_choice_cache &cache = cable_choice_cache::shared();
+  const size_t capacity = cache.capacity();
+  cache.set_capacity(1024);
+  cache.clear();
+  mt19937_64 rng(10);
+
+  wobos a = plant("MONOPILE", 100.0);
+  const cable_context c = wobos_test::context(a);
+  const cableFamily family = random_family(rng, c, 33.0, 11, 11);
+  a.set_cable_template(33, family);
+  a.set_map_variable("arrayCables", string("33"));
+  const wobos a0(a);
+  a.run();
+
+  // Array cable 1 of the first plant costs ten times more in the second
+  cableFamily changed(family);
+  for (cable &cab : changed.cables)
+    if (cab.currRating == a.cab1CurrRating) cab.cost *= 10.0;
+  wobos b = plant("MONOPILE", 100.0);
+  b.set_cable_template(33, changed);
+  b.set_map_variable("arrayCables", string("33"));
+  const wobos b0(b);
+  b.run();
+  CHECK(b.cab1CurrRating != a.cab1CurrRating);
+  CHECK(cache.size() == 3);  // one export cable choice, two array cable choices
+
+  // Again from the cache, then without it, which empties it
+  unsigned long long hits, misses;
+  for (const wobos *w : {&a, &b}) {
+    wobos again(w == &a ? a0 : b0);
+    again.run();
+    CHECK(again.cab1CurrRating == w->cab1CurrRating && again.cab2CurrRating == w->cab2CurrRating);
+    CHECK(again.total_bos_cost == w->total_bos_cost);
+  }
+  cache.stats(hits, misses);
+  CHECK(hits == 5 && misses == 3 && cache.size() == 3);
+  cache.set_capacity(0);
+  for (const wobos *w : {&a, &b}) {
+    wobos uncached(w == &a ? a0 : b0);
+    uncached.run();
+    CHECK(uncached.cab1CurrRating == w->cab1CurrRating && uncached.cab2CurrRating == w->cab2CurrRating);
+    CHECK(uncached.total_bos_cost == w->total_bos_cost);
+  }
+  CHECK(cache.size() == 0);
+
+  // Every value of a cable that the optimizer reads is part of the key
+  vector<double> key, other;
+  cable_choice_cache::make_key(CABLE_CACHE_ARRAY, c, {family}, key);
+  cable_choice_cache::make_key(CABLE_CACHE_EXPORT, c, {family}, other);
+  CHECK(key != other);
+  for (double cable::*field : {&cable::cost, &cable::mass, &cable::currRating, &cable::turbInterfaceCost,
+			       &cable::subsInterfaceCost}) {
+    cableFamily f(family);
+    f.cables[5].*field *= 1.0 + 1e-15;
+    cable_choice_cache::make_key(CABLE_CACHE_ARRAY, c, {f}, other);
+    CHECK(key != other);
+  }
+  cableFamily f(family);
+  f.cables[5].area *= 2.0;
+  cable_choice_cache::make_key(CABLE_CACHE_ARRAY, c, {f}, other);
+  CHECK(key == other);
+
+  cache.clear();
+  cache.set_capacity(capacity);
+}
+
+
+// Keys of plants with 1 ... n turbines
+static vector<vector<double> > cache_keys(size_t n) {
+  wobos obos = plant("MONOPILE", 10.0);
+  vector<vector<double> > keys(n);
+  for (size_t k=0; k<n; k++) {
+    obos.nTurb = (double)(k + 1);
+    cable_choice_cache::make_key(CABLE_CACHE_ARRAY, wobos_test::context(obos), obos.arrCables, keys[k]);
+  }
+  return keys;
+}
+
+
+static void test_cache_eviction() {
+  const vector<vector<double> > keys = cache_keys(6);
+  cable_choice_cache cache(3);
+  cable_choice choice;
+  for (size_t k=0; k<3; k++) cache.insert(keys[k], cable_choice{k, k + 1, k + 2});
+
+  // A lookup makes an entry the most recently used: 0, 2, 1, and the next insert evicts 1
+  CHECK(cache.find(keys[0], choice) && choice.voltIndex == 0 && choice.cabIndex1 == 1 && choice.cabIndex2 == 2);
+  cache.insert(keys[3], cable_choice{3, 4, 5});
+  CHECK(cache.size() == 3);
+  CHECK(!cache.find(keys[1], choice));
+  CHECK(cache.find(keys[2], choice) && choice.voltIndex == 2);
+  CHECK(cache.find(keys[3], choice) && choice.voltIndex == 3);
+  CHECK(cache.find(keys[0], choice) && choice.voltIndex == 0);
+
+  // Inserting a key again replaces its choice.  A lower capacity evicts the least recently used: 2, then 3
+  cache.insert(keys[3], cable_choice{7, 8, 9});
+  cache.set_capacity(2);
+  CHECK(cache.size() == 2 && cache.capacity() == 2);
+  CHECK(!cache.find(keys[2], choice));
+  CHECK(cache.find(keys[3], choice) && choice.voltIndex == 7 && choice.cabIndex2 == 9);
+  cache.set_capacity(1);
+  CHECK(!cache.find(keys[0], choice) && cache.find(keys[3], choice));
+
+  unsigned long long hits, misses;
+  cache.stats(hits, misses);
+  CHECK(hits == 6 && misses == 3);
+
+  // Capacity 0 switches the cache off
+  cache.set_capacity(0);
+  cache.insert(keys[4], cable_choice{4, 4, 4});
+  CHECK(cache.size() == 0 && !cache.find(keys[3], choice) && !cache.find(keys[4], choice));
+  cache.set_capacity(4);
+  cache.insert(keys[5], cable_choice{5, 5, 5});
+  CHECK(cache.size() == 1 && cache.find(keys[5], choice));
+  cache.clear();
+  cache.stats(hits, misses);
+  CHECK(cache.size() == 0 && hits == 0 && misses == 0);
+}
+
+
+int main() {
+  test_optimizer();
+  test_kernels();
+  test_cache_keys();
+  test_cache_eviction();
+  return test_result("test_wind_obos_cable");
+}
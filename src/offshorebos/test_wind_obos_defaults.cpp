@@ -0,0 +1,75 @@
+// Tests of the variable defaults (lib_wind_obos_defaults.h): the table compiled into the library holds what
+// reading wind_obos_defaults.csv as a defaults file gives, and files follow the same comment rule.
+
+#include "lib_wind_obos_defaults.h"
+#include "test_wind_obos.h"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+
+static bool same(const variable &a, const variable &b) {
+  return (a.inout == b.inout) && (a.name == b.name) && (a.description == b.description) &&
+    (a.units_openmdao == b.units_openmdao) && (a.units_sam == b.units_sam) &&
+    (memcmp(&a.value, &b.value, sizeof(double)) == 0) && (a.valueStr == b.valueStr) &&
+    (a.constraints == b.constraints);
+}
+
+
+static const variable* find(const wind_obos_defaults &d, const string &name) {
+  for (const variable &v : d.variables) if (v.name == name) return &v;
+  return NULL;
+}
+
+
+static void test_table() {
+  wind_obos_defaults builtin, file;
+  file.load("wind_obos_defaults.csv");
+  CHECK(builtin.variables.size() == file.variables.size());
+  for (size_t k=0; k<builtin.variables.size(); k++) CHECK(same(builtin.variables[k], file.variables[k]));
+
+  // '#' in a description is text
+  const variable *cab1 = find(builtin, "cab1Leng");
+  CHECK(cab1 && cab1->description == "Array Cable #1 Length" && cab1->isOutput() && cab1->value == 0.0);
+
+  // Parsed when the table was generated: numbers at the start of the value, ',' for '_' in the constraints
+  const variable *nTurb = find(builtin, "nTurb"), *sub = find(builtin, "substructure");
+  const variable *exportCables = find(builtin, "exportCables");
+  CHECK(nTurb && nTurb->isInput() && nTurb->value == 20.0 && nTurb->constraints == "MIN=2,MAX=200");
+  CHECK(sub && !sub->isDouble() && sub->valueStr == "MONOPILE");
+  CHECK(exportCables && exportCables->value == 132.0 && exportCables->valueStr == "132 220");
+}
+
+
+static void test_load() {
+  const char* fname = "test_wind_obos_defaults.csv";
+  {
+    ofstream f(fname);
+    f << "#IN/OUT,Variable,Description,Units (OpenMDAO),Units (SAM),Value,Constraints\n"
+      << "  # indented comment,,,,,,\n"
+      << "INPUT, nTurb ,Turbines #,,, 60 ,min=2_max=300\n"
+      << "OUTPUT,myOutput,Cable #3,m,m,,\n"
+      << "INPUT,short,row\n";
+  }
+  wind_obos_defaults d(fname);
+  wind_obos_defaults builtin;
+  CHECK(d.variables.size() == builtin.variables.size() + 1);
+  const variable *nTurb = find(d, "nTurb"), *out = find(d, "myOutput");
+  CHECK(nTurb && nTurb->value == 60.0 && nTurb->description == "Turbines #" && nTurb->constraints == "MIN=2,MAX=300");
+  CHECK(out && out->description == "Cable #3" && !out->isDouble());
+  CHECK(!find(d, "short") && !find(d, "indented comment"));
+  remove(fname);
+  CHECK_THROWS(wind_obos_defaults(string(fname)));
+}
+
+
+int main() {
+  test_table();
+  test_load();
+  return test_result("test_wind_obos_defaults");
+}
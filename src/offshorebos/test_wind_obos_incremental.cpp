@@ -0,0 +1,77 @@
+// Tests of wobos::run_incremental: every variable is bit for bit that of run() on an object that went through
+// the same changes, whether the calls change nothing, one input every time or several inputs at random.
+
+#include "lib_wind_obos.h"
+#include "test_wind_obos.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <cstring>
+
+using namespace std;
+
+
+// Variables of a and b with different bits
+static int differences(wobos &a, wobos &b) {
+  a.variables2map();
+  b.variables2map();
+  int n = 0;
+  for (int i=0; i<NVARIABLES; i++) {
+    double x = a.get_map_variable(i), y = b.get_map_variable(i);
+    if (memcmp(&x, &y, sizeof(double)) != 0) {
+      if (n == 0) printf("%s: %.17g != %.17g\n", wobos::variable_name(i), x, y);
+      n++;
+    }
+  }
+  return n;
+}
+
+
+int main() {
+  mt19937 rng(7);
+  const int enums[] = {VAR_substructure, VAR_anchor, VAR_turbInstallMethod, VAR_towerInstallMethod, VAR_installStrategy};
+
+  for (int trial=0; trial<16; trial++) {
+    wobos incremental, full;
+    vector<double> table(NVARIABLES);
+    for (int i=0; i<NVARIABLES; i++) table[i] = full.get_map_variable(i);
+    table[VAR_substructure]   = trial % 4;
+    table[VAR_cableOptimizer] = (trial / 4) % 2;
+    table[VAR_installStrategy] = (trial / 8) % 2;
+
+    for (int step=0; step<200; step++) {
+      // Runs of no change, of a sweep of one input, and of random changes
+      const int phase = (step / 20) % 3;
+      if (phase == 1) {
+	const int id = (step / 60) % 2 ? VAR_distPort : VAR_waterD;
+	table[id] *= (step % 2) ? 1.01 : 1.0/1.01;
+      }
+      else if (phase == 2) {
+	for (int c=1+rng()%2; c>0; c--) {
+	  int id = rng() % NVARIABLES;
+	  double v = table[id];
+	  bool isEnum = false;
+	  for (int e : enums) isEnum = isEnum || (id == e);
+	  if (isEnum) v = rng() % ((id == VAR_substructure) ? 4 : 2);
+	  else if (id == VAR_cableOptimizer) v = 1.0 - v;
+	  else if (rng() % 5 == 0) v = 0.0;
+	  else v = ((v == 0.0) ? 1.0 : v) * (0.8 + 0.4*(rng() % 1000)/1000.0);
+	  table[id] = v;
+	}
+      }
+
+      for (wobos* w : {&incremental, &full}) {
+	for (int i=0; i<NVARIABLES; i++) w->set_map_variable(i, table[i]);
+	if (step % 50 == 17) w->set_map_variable("arrayCables", string((step % 100 == 17) ? "66" : "33 66"));
+	w->map2variables();
+	w->set_vessel_defaults();
+      }
+      incremental.run_incremental();
+      full.run();
+      CHECK(differences(incremental, full) == 0);
+    }
+  }
+
+  return test_result("test_wind_obos_incremental");
+}
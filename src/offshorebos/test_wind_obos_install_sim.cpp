@@ -0,0 +1,175 @@
+// Tests of the installation simulation (lib_wind_obos_install_sim.h) against installation times in closed
+// form: without barges and weather windows the schedule is a sum of activities, with barges that keep up the
+// installation vessel never waits, and with one barge it waits for every load.
+
+#include "lib_wind_obos.h"
+#include "lib_wind_obos_install_sim.h"
+#include "test_wind_obos.h"
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+
+static install_campaign campaign(size_t nUnits, size_t perLoad, double weatherFactor) {
+  install_campaign c;
+  c.nUnits        = nUnits;
+  c.unitsPerLoad  = perLoad;
+  c.passes        = {install_pass{2.0, 20.0}, install_pass{1.5, 9.0}};
+  c.transitHours  = 8.0;
+  c.moveHours     = 0.75;
+  c.weatherFactor = weatherFactor;
+  return c;
+}
+
+
+// Loadout, transit out, work at every position and moves between them, transit back, per pass of every load
+static double vessel_hours(const install_campaign &c) {
+  double hours = 0.0;
+  for (size_t done=0; done<c.nUnits; done+=c.unitsPerLoad) {
+    double load = min(c.unitsPerLoad, c.nUnits - done);
+    for (const install_pass &p : c.passes)
+      hours += load*p.loadHours + 2*c.transitHours + load*p.installHours + (load - 1)*c.moveHours;
+  }
+  return hours * c.weatherFactor;
+}
+
+
+static void test_vessel() {
+  install_simulator sim;
+  for (size_t n : {1, 2, 7, 20, 101})
+    for (size_t perLoad : {1, 3, 4})
+      for (double w : {1.0, 1.0/0.7}) {
+	install_campaign c = campaign(n, perLoad, w);
+	install_schedule s = sim.simulate(c);
+	CHECK_CLOSE(s.hours, vessel_hours(c), 1e-12);
+	CHECK(s.trips == (n + perLoad - 1) / perLoad * c.passes.size());
+	CHECK(s.vesselIdleHours == 0.0 && s.bargeIdleHours == 0.0);
+
+	// The same simulator gives the same schedule again
+	install_schedule again = sim.simulate(c);
+	CHECK(again.hours == s.hours && again.trips == s.trips && again.events == s.events);
+      }
+
+  install_campaign none = campaign(0, 4, 1.0);
+  install_schedule s = sim.simulate(none);
+  CHECK(s.hours == 0.0 && s.trips == 0 && s.events == 0);
+  none.passes.clear();
+  CHECK_THROWS(sim.simulate(none));
+}
+
+
+static void test_barges() {
+  install_simulator sim;
+  for (size_t n : {1, 6, 25})
+    for (double w : {1.0, 1.25}) {
+      // Enough barges for every unit, all at the site before the installation vessel
+      install_campaign c = campaign(n, 2, w);
+      c.nBarges           = n;
+      c.bargeTransitHours = 1.0;
+      double install = c.passes[0].installHours + c.passes[1].installHours;
+      install_schedule s = sim.simulate(c);
+      CHECK_CLOSE(s.hours, w * (c.transitHours + n*install + (n - 1)*c.moveHours), 1e-12);
+      CHECK(s.vesselIdleHours == 0.0 && s.bargeIdleHours > 0.0);
+      CHECK(s.trips == (n + 1) / 2);
+    }
+
+  // One barge far from port: the installation vessel waits for each load, the barge never waits
+  const size_t n = 9, perLoad = 2;
+  install_campaign c = campaign(n, perLoad, 1.0);
+  c.nBarges           = 1;
+  c.bargeTransitHours = 30.0;
+  const double loadHours = c.passes[0].loadHours + c.passes[1].loadHours;
+  const double install   = c.passes[0].installHours + c.passes[1].installHours;
+  double arrival = perLoad*loadHours + c.bargeTransitHours, free = c.transitHours, idle = 0.0;
+  for (size_t done=0; done<n; done+=perLoad) {
+    size_t load = min(perLoad, n - done);
+    idle += max(arrival - free, 0.0);
+    double t = max(arrival, free);
+    for (size_t k=0; k<load; k++) t += ((done + k > 0) ? c.moveHours : 0.0) + install;
+    free = t;
+    arrival = t + 2*c.bargeTransitHours + min(perLoad, n - done - load)*loadHours;
+  }
+  install_schedule s = sim.simulate(c);
+  CHECK_CLOSE(s.hours, free, 1e-12);
+  CHECK_CLOSE(s.vesselIdleHours, idle, 1e-12);
+  CHECK(s.bargeIdleHours == 0.0);
+  CHECK(s.trips == (n + perLoad - 1) / perLoad);
+
+  c.nBarges = n;
+  CHECK(sim.simulate(c).hours < s.hours);
+}
+
+
+static void test_weather() {
+  const size_t hours = 20000, stormHours = 100;
+  vector<double> calm(hours, 5.0), wave(hours, 1.0), storm(calm);
+  for (size_t h=0; h<stormHours; h++) storm[h] = 25.0;
+  weather_windows good(&calm[0], &wave[0], hours, 15.0, 2.0), stormy(&storm[0], &wave[0], hours, 15.0, 2.0);
+
+  // Always workable is the same as no contingency
+  install_simulator sim;
+  install_campaign c = campaign(20, 4, 1.0);
+  const double ref = sim.simulate(c).hours;
+  c.weatherFactor = 1.5;
+  c.weather = &good;
+  CHECK_CLOSE(sim.simulate(c).hours, ref, 1e-12);
+
+  // A storm at the start holds the first transit until it is over
+  c.weather = &stormy;
+  const double loadout = c.unitsPerLoad * c.passes[0].loadHours;
+  CHECK_CLOSE(sim.simulate(c).hours, ref + (stormHours - loadout), 1e-12);
+  c.startHour = stormHours;
+  CHECK_CLOSE(sim.simulate(c).hours, ref, 1e-12);
+}
+
+
+// Trips of the closed-form times, which let a trip carry part of a unit, and of the simulation
+static bool same_trips(double n, double perTrip) {
+  return ceil(n / perTrip) == ceil(n / floor(perTrip));
+}
+
+
+// Without barges and weather the simulated installation times of wobos are its closed-form times, when both
+// make the same number of trips, and longer when the simulation needs one more
+static void test_wobos() {
+  size_t compared = 0;
+  for (const char *sub : {"MONOPILE", "JACKET"})
+    for (double nTurb : {1.0, 7.0, 20.0, 53.0, 100.0})
+      for (double distPort : {5.0, 90.0}) {
+	wobos obos[2];
+	for (int simulate=0; simulate<2; simulate++) {
+	  obos[simulate].set_map_variable("substructure", string(sub));
+	  obos[simulate].set_map_variable("nTurb", nTurb);
+	  obos[simulate].set_map_variable("distPort", distPort);
+	  obos[simulate].set_map_variable("installSimulation", (double)simulate);
+	  obos[simulate].map2variables();
+	  obos[simulate].set_vessel_defaults();
+	  obos[simulate].run();
+	}
+	const wobos &closed = obos[0], &simulated = obos[1];
+	if (same_trips(nTurb, closed.nTurbPerTrip)) {
+	  CHECK(simulated.turbInstTime == closed.turbInstTime);
+	  compared++;
+	}
+	else CHECK(simulated.turbInstTime >= closed.turbInstTime);
+	if (same_trips(nTurb, closed.nSubPerTrip)) {
+	  CHECK(simulated.subInstTime == closed.subInstTime);
+	  compared++;
+	}
+	else CHECK(simulated.subInstTime >= closed.subInstTime);
+      }
+  CHECK(compared >= 30);
+}
+
+
+int main() {
+  test_vessel();
+  test_barges();
+  test_weather();
+  test_wobos();
+  return test_result("test_wind_obos_install_sim");
+}
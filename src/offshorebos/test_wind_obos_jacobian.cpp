@@ -0,0 +1,89 @@
+// Tests of wobos_jacobian (lib_wind_obos_jacobian.h): its outputs are those of run() and its
+// derivatives are those of central finite differences wherever no step is reported.
+
+#include "lib_wind_obos.h"
+#include "lib_wind_obos_jacobian.h"
+#include "test_wind_obos.h"
+
+#include <vector>
+#include <string>
+
+using namespace std;
+
+
+static const vector<string> inputs = {"turbR", "rotorD", "hubH", "waterD", "distShore", "distPort", "turbCont",
+                                      "exCabFac", "mpileCR", "ballCR", "plantComm"};
+static const vector<string> outputs = {"subTotM", "subTotCost", "expCabLeng", "expCabCost", "cab1Leng",
+                                       "totElecCost", "turbInstTime", "subInstTime", "totInstTime",
+                                       "array_cable_install_cost", "totPnSCost", "bos_capex", "soft_costs",
+                                       "total_bos_cost"};
+
+
+// A copy of obos evaluated in the sequence of wobos_jacobian::run
+static wobos evaluate(const wobos &obos) {
+  wobos w(obos);
+  w.map2variables();
+  w.set_vessel_defaults();
+  w.run();
+  w.variables2map();
+  return w;
+}
+
+
+// Outputs equal to run(), derivatives equal to central differences where they have no steps
+static void check_against_run(const wobos &obos) {
+  wobos_jacobian jac(inputs, outputs);
+  vector<double> out(outputs.size()), J(outputs.size() * inputs.size());
+  vector<unsigned char> steps(J.size());
+  jac.run(obos, out.data(), J.data(), steps.data());
+
+  wobos ref = evaluate(obos);
+  for (size_t i=0; i<outputs.size(); i++)
+    CHECK_CLOSE(out[i], ref.get_map_variable(outputs[i].c_str()), 1e-12);
+
+  int nSmooth = 0;
+  for (size_t k=0; k<inputs.size(); k++) {
+    wobos plus(obos), minus(obos);
+    double x = plus.get_map_variable(inputs[k].c_str());
+    double h = 1e-6 * (fabs(x) + 1e-3);
+    plus.set_map_variable(inputs[k].c_str(), x + h);
+    minus.set_map_variable(inputs[k].c_str(), x - h);
+    wobos a = evaluate(plus), b = evaluate(minus);
+
+    for (size_t i=0; i<outputs.size(); i++) {
+      if (steps[i*inputs.size() + k]) continue;
+      double fd = (a.get_map_variable(outputs[i].c_str()) - b.get_map_variable(outputs[i].c_str())) / (2*h);
+      double scale = fabs(ref.get_map_variable(outputs[i].c_str())) / (fabs(x) + 1e-3);
+      nSmooth++;
+      if (fabs(J[i*inputs.size() + k] - fd) > 1e-5 * (fabs(fd) + scale))
+        printf("d%s/d%s:\n", outputs[i].c_str(), inputs[k].c_str());
+      CHECK(fabs(J[i*inputs.size() + k] - fd) <= 1e-5 * (fabs(fd) + scale));
+    }
+  }
+  CHECK(nSmooth > 0);
+}
+
+
+int main() {
+  // Default monopile plant
+  wobos monopile;
+  check_against_run(monopile);
+
+  // Floating spar plant in deep water
+  wobos spar;
+  spar.set_map_variable("substructure", string("SPAR"));
+  spar.set_map_variable("waterD", 300.0);
+  check_against_run(spar);
+
+  // The object passed in is not modified
+  wobos untouched;
+  wobos_jacobian jac(inputs, outputs);
+  vector<double> out(outputs.size()), J(outputs.size() * inputs.size());
+  jac.run(untouched, out.data(), J.data());
+  CHECK(untouched.get_map_variable("total_bos_cost") == wobos().get_map_variable("total_bos_cost"));
+
+  // Unknown names throw
+  CHECK_THROWS(wobos_jacobian(vector<string>(1, "nope"), outputs));
+
+  return test_result("test_wind_obos_jacobian");
+}
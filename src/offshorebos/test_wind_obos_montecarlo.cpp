@@ -0,0 +1,249 @@
+// Tests of the streaming statistics (lib_wind_obos_stats.h) against the same values kept and sorted, and of
+// the Monte Carlo engine (lib_wind_obos_montecarlo.h) on an output that is linear in its uncertain input.
+
+#include "lib_wind_obos.h"
+#include "lib_wind_obos_montecarlo.h"
+#include "test_wind_obos.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <limits>
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+
+static bool same_bits(double a, double b) {return memcmp(&a, &b, sizeof(double)) == 0;}
+
+
+// Values spread over many magnitudes, of both signs and with zeros
+static vector<double> sample_values(mt19937_64 &rng, size_t n) {
+  normal_distribution<double> normal(1e6, 2e5);
+  lognormal_distribution<double> lognormal(3.0, 2.0);
+  vector<double> x(n);
+  for (size_t i=0; i<n; i++) {
+    switch (rng() % 4) {
+    case 0: x[i] = normal(rng); break;
+    case 1: x[i] = lognormal(rng); break;
+    case 2: x[i] = -lognormal(rng); break;
+    default: x[i] = (rng() % 10 == 0) ? 0.0 : (double)(rng() % 100);
+    }
+  }
+  return x;
+}
+
+
+// Counts, moments, extremes, quantiles and histogram of wobos_stats against the sorted values
+static void check_stats(const wobos_stats &st, vector<double> x) {
+  sort(x.begin(), x.end());
+  const double n = x.size();
+  double mean = 0.0, m2 = 0.0;
+  for (double v : x) mean += v / n;
+  for (double v : x) m2 += (v - mean) * (v - mean);
+
+  CHECK(st.count == n);
+  CHECK(st.min == x.front() && st.max == x.back());
+  CHECK_CLOSE(st.mean, mean, 1e-12);
+  CHECK_CLOSE(st.variance(), m2 / (n - 1), 1e-10);
+
+  // Within the relative accuracy of the sketch of the value of rank q*(n-1)
+  for (double q : {0.0, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 1.0}) {
+    double exact = x[(size_t)floor(q * (n - 1))];
+    CHECK(fabs(st.quantile(q) - exact) <= st.sketch.alpha * fabs(exact) * (1.0 + 1e-12));
+  }
+
+  // Every value counted in its bin, or in a neighbouring bin when within one finer bin of an edge
+  vector<double> edges, counts;
+  st.histogram(7, edges, counts);
+  const double fine = st.bins.width();
+  double total = 0.0;
+  for (size_t k=0; k<counts.size(); k++) {
+    total += counts[k];
+    double inside = 0.0, near = 0.0;
+    for (double v : x) {
+      inside += (v >= edges[k] + fine) && (v < edges[k + 1] - fine);
+      near   += (v >= edges[k] - fine) && (v <= edges[k + 1] + fine);
+    }
+    CHECK(inside <= counts[k] && counts[k] <= near);
+  }
+  CHECK(total == n);
+}
+
+
+static void test_stats() {
+  mt19937_64 rng(17);
+  for (int trial=0; trial<20; trial++) {
+    vector<double> x = sample_values(rng, 100 + rng() % 5000);
+    wobos_stats all;
+    for (double v : x) all.add(v);
+    check_stats(all, x);
+
+    // Merging the statistics of parts gives those of the whole
+    vector<wobos_stats> parts(3);
+    for (double v : x) parts[rng() % 3].add(v);
+    wobos_stats merged;
+    for (const wobos_stats &p : parts) merged.merge(p);
+    check_stats(merged, x);
+    for (double q : {0.05, 0.5, 0.95}) CHECK(merged.quantile(q) == all.quantile(q));
+    vector<double> e1, c1, e2, c2;
+    all.histogram(10, e1, c1);
+    merged.histogram(10, e2, c2);
+    CHECK(e1 == e2 && c1 == c2);
+  }
+
+  // Infinities are counted and ranked but left out of the moments and the histogram, NaN is left out of everything
+  const double inf = numeric_limits<double>::infinity();
+  vector<double> x = sample_values(rng, 1000);
+  wobos_stats st, withInfs;
+  for (double v : {inf, -inf, numeric_limits<double>::quiet_NaN()}) withInfs.add(v);
+  for (double v : x) {
+    st.add(v);
+    withInfs.add(v);
+  }
+  withInfs.add(inf);
+  CHECK(withInfs.count == x.size() + 3 && withInfs.infs == 3 && withInfs.nans == 1);
+  CHECK(same_bits(withInfs.mean, st.mean) && same_bits(withInfs.variance(), st.variance()));
+  CHECK(withInfs.min == -inf && withInfs.max == inf);
+  CHECK(withInfs.quantile(0.0) == -inf && withInfs.quantile(1.0) == inf);
+  vector<double> ranked(x);
+  ranked.insert(ranked.end(), {inf, -inf, inf});
+  sort(ranked.begin(), ranked.end());
+  for (double q : {0.1, 0.5, 0.9}) {
+    double exact = ranked[(size_t)floor(q * (ranked.size() - 1))];
+    CHECK(fabs(withInfs.quantile(q) - exact) <= withInfs.sketch.alpha * fabs(exact) * (1.0 + 1e-12));
+  }
+  vector<double> edges, counts;
+  withInfs.histogram(5, edges, counts);
+  double total = 0.0;
+  for (double c : counts) total += c;
+  CHECK(total == x.size() && isfinite(edges.front()) && isfinite(edges.back()));
+
+  wobos_stats empty;
+  CHECK(isnan(empty.quantile(0.5)));
+}
+
+
+static void test_distributions() {
+  mt19937_64 rng(3);
+  const size_t n = 200000;
+  auto moments = [&] (const wobos_distribution &d, double &mean, double &lo, double &hi) {
+    mean = 0.0;
+    lo = numeric_limits<double>::infinity();
+    hi = -lo;
+    for (size_t i=0; i<n; i++) {
+      double x = d.sample(rng);
+      mean += x / n;
+      lo = min(lo, x);
+      hi = max(hi, x);
+    }
+  };
+  double mean, lo, hi;
+
+  moments(wobos_distribution(wobos_distribution::UNIFORM, 2.0, 6.0), mean, lo, hi);
+  CHECK(fabs(mean - 4.0) < 4 * (4.0 / sqrt(12.0)) / sqrt((double)n));
+  CHECK(lo >= 2.0 && hi <= 6.0);
+
+  moments(wobos_distribution(wobos_distribution::TRIANGULAR, 1.0, 2.0, 7.0), mean, lo, hi);
+  CHECK(fabs(mean - 10.0/3.0) < 4 * sqrt((1 + 4 + 49 - 2 - 7 - 14) / 18.0) / sqrt((double)n));
+  CHECK(lo >= 1.0 && hi <= 7.0);
+
+  // Truncated on both sides, symmetric about the mean
+  moments(wobos_distribution(wobos_distribution::NORMAL, 30.0, 10.0, 0.0, 20.0, 40.0), mean, lo, hi);
+  CHECK(fabs(mean - 30.0) < 4 * 10.0 / sqrt((double)n));
+  CHECK(lo >= 20.0 && hi <= 40.0);
+
+  // The log of a lognormal value is normal
+  wobos_distribution logn(wobos_distribution::LOGNORMAL, 1.0, 0.5);
+  double logMean = 0.0;
+  for (size_t i=0; i<n; i++) logMean += log(logn.sample(rng)) / n;
+  CHECK(fabs(logMean - 1.0) < 4 * 0.5 / sqrt((double)n));
+
+  CHECK_THROWS(wobos_distribution(wobos_distribution::UNIFORM, 2.0, 1.0));
+  CHECK_THROWS(wobos_distribution(wobos_distribution::TRIANGULAR, 1.0, 3.0, 2.0));
+  CHECK_THROWS(wobos_distribution(wobos_distribution::NORMAL, 1.0, -1.0));
+  CHECK_THROWS(wobos_distribution(wobos_distribution::NORMAL, 1.0, 1.0, 0.0, 2.0, 1.0));
+  CHECK_THROWS(wobos_distribution(17));
+}
+
+
+// totDevCost of the default plant at a met tower cost rate
+static double development_cost(double metTowCR) {
+  wobos obos;
+  obos.set_map_variable("metTowCR", metTowCR);
+  obos.map2variables();
+  obos.set_vessel_defaults();
+  obos.run();
+  obos.variables2map();
+  return obos.get_map_variable("totDevCost");
+}
+
+
+static void test_montecarlo() {
+  // The development cost is linear in the met tower cost rate
+  const double base = development_cost(0.0), slope = development_cost(1.0) - base;
+  const double lo = 10000.0, hi = 14000.0;
+  const vector<string> in = {"metTowCR"}, out = {"totDevCost", "total_bos_cost"};
+  const size_t n = 3000;
+
+  wobos_montecarlo one(in, {wobos_distribution(wobos_distribution::UNIFORM, lo, hi)}, out);
+  wobos_montecarlo four(one);
+  one.run(n, 11, 1);
+  four.run(n, 11, 4);
+  CHECK(one.samples() == n);
+
+  // The same samples in the same order whatever the number of threads
+  for (size_t k=0; k<out.size(); k++) {
+    const wobos_stats &a = one.stats(k), &b = four.stats(k);
+    CHECK(same_bits(a.mean, b.mean) && same_bits(a.m2, b.m2) && a.min == b.min && a.max == b.max);
+    CHECK(a.quantile(0.1) == b.quantile(0.1) && a.quantile(0.9) == b.quantile(0.9));
+  }
+
+  const wobos_stats &dev = one.stats(0);
+  const double sd = slope * (hi - lo) / sqrt(12.0);
+  CHECK(dev.count == n && dev.nans == 0 && dev.infs == 0);
+  CHECK(fabs(dev.mean - (base + slope*0.5*(lo + hi))) < 4 * sd / sqrt((double)n));
+  CHECK(fabs(dev.stddev() - sd) < 0.05 * sd);
+  CHECK(dev.min >= base + slope*lo * (1 - 1e-12) && dev.max <= base + slope*hi * (1 + 1e-12));
+  CHECK(fabs(dev.quantile(0.5) - (base + slope*0.5*(lo + hi))) < 0.05 * slope * (hi - lo));
+
+  // A second call carries on with new samples, a seed gives the same samples again after reset()
+  wobos_stats first = one.stats(0);
+  one.run(n, 12, 2);
+  CHECK(one.samples() == 2*n && one.stats(0).count == 2*n);
+  CHECK(!same_bits(one.stats(0).mean, first.mean));
+  one.reset();
+  CHECK(one.samples() == 0 && one.stats(0).count == 0);
+  one.run(n, 11, 3);
+  CHECK(same_bits(one.stats(0).mean, first.mean));
+
+  // Without uncertainty every sample is the plant of the baseline
+  wobos baseline;
+  baseline.set_map_variable("substructure", string("JACKET"));
+  baseline.set_map_variable("waterD", 45.0);
+  wobos ref(baseline);
+  ref.set_map_variable("metTowCR", lo);
+  ref.map2variables();
+  ref.set_vessel_defaults();
+  ref.run();
+  ref.variables2map();
+  wobos_montecarlo fixed(in, {wobos_distribution(wobos_distribution::UNIFORM, lo, lo)}, out);
+  fixed.set_baseline(baseline);
+  fixed.run(300, 5, 2);
+  for (size_t k=0; k<out.size(); k++) {
+    double v = ref.get_map_variable(out[k].c_str());
+    CHECK(fixed.stats(k).min == v && fixed.stats(k).max == v && fixed.stats(k).variance() == 0.0);
+  }
+
+  CHECK_THROWS(wobos_montecarlo(in, {}, out));
+  CHECK_THROWS(wobos_montecarlo({"nope"}, {wobos_distribution()}, out));
+}
+
+
+int main() {
+  test_stats();
+  test_distributions();
+  test_montecarlo();
+  return test_result("test_wind_obos_montecarlo");
+}
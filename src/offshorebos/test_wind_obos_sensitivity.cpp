@@ -0,0 +1,118 @@
+// Tests of the Sobol and Morris estimators (lib_wind_obos_sensitivity.h) on the development cost, whose
+// indices and elementary effects are known in closed form: totDevCost is nTurb*turbR*metTowCR plus a sum
+// of study and permit costs.
+
+#include "lib_wind_obos.h"
+#include "lib_wind_obos_sensitivity.h"
+#include "test_wind_obos.h"
+
+#include <vector>
+#include <string>
+
+using namespace std;
+
+
+// Mean, variance and mean square of a uniform input
+struct uniform_input {
+  double lo, hi;
+  double mean() const {return 0.5 * (lo + hi);}
+  double var() const {return (hi - lo) * (hi - lo) / 12.0;}
+  double square() const {return var() + mean() * mean();}
+};
+
+
+// The product nTurb*turbR*metTowCR plus feedStudy: first-order and total indices of a product of independent
+// inputs, and of an input that is only added
+static void test_sobol() {
+  const vector<string> in = {"nTurb", "turbR", "metTowCR", "feedStudy"}, out = {"totDevCost", "total_bos_cost"};
+  const vector<uniform_input> u = {{20.0, 100.0}, {3.0, 10.0}, {5000.0, 15000.0}, {0.0, 4e6}};
+  vector<double> lo, hi;
+  for (const uniform_input &x : u) {
+    lo.push_back(x.lo);
+    hi.push_back(x.hi);
+  }
+  const size_t d = in.size();
+
+  double meanSquares = 1.0, squaredMeans = 1.0;
+  for (size_t i=0; i<3; i++) {
+    meanSquares *= u[i].square();
+    squaredMeans *= u[i].mean() * u[i].mean();
+  }
+  const double variance = meanSquares - squaredMeans + u[3].var();
+  vector<double> first(d), total(d);
+  for (size_t i=0; i<3; i++) {
+    first[i] = u[i].var() * squaredMeans / (u[i].mean() * u[i].mean()) / variance;
+    total[i] = u[i].var() * meanSquares / u[i].square() / variance;
+  }
+  first[3] = total[3] = u[3].var() / variance;
+
+  wobos_sensitivity sa(in, lo, hi, out);
+  vector<double> s1(d * out.size()), st(d * out.size()), s1b(s1.size()), stb(st.size());
+  sa.sobol(4000, 3, 1, &s1[0], &st[0]);
+  sa.sobol(4000, 3, 3, &s1b[0], &stb[0]);
+  CHECK(s1 == s1b && st == stb);
+
+  for (size_t i=0; i<d; i++) {
+    CHECK(fabs(s1[i] - first[i]) < 0.04);
+    CHECK(fabs(st[i] - total[i]) < 0.04);
+  }
+  // Interactions of the product
+  CHECK(st[0] > s1[0] + 0.02 && st[1] > s1[1] + 0.02);
+}
+
+
+// Effects per full range of each input of a sum are the coefficient times the range, on every trajectory
+static void test_morris() {
+  wobos obos;
+  obos.map2variables();
+  const double scale = obos.get_map_variable("nTurb") * obos.get_map_variable("turbR");
+  const vector<string> in = {"metTowCR", "feedStudy", "preFEEDStudy", "waterD"}, out = {"totDevCost"};
+  const vector<double> lo = {5000.0, 1e6, 0.0, 20.0}, hi = {15000.0, 3e6, 4e6, 40.0};
+  const vector<double> effects = {scale * (hi[0] - lo[0]), hi[1] - lo[1], hi[2] - lo[2], 0.0};
+  const size_t d = in.size();
+
+  wobos_sensitivity sa(in, lo, hi, out);
+  vector<double> mu(d), muStar(d), sigma(d), mu2(d), muStar2(d), sigma2(d);
+  sa.morris(50, 4, 7, 1, &mu[0], &muStar[0], &sigma[0]);
+  sa.morris(50, 4, 7, 4, &mu2[0], &muStar2[0], &sigma2[0]);
+  CHECK(mu == mu2 && muStar == muStar2 && sigma == sigma2);
+
+  for (size_t i=0; i<d; i++) {
+    CHECK(fabs(mu[i] - effects[i]) <= 1e-6 * effects[0]);
+    CHECK(fabs(muStar[i] - effects[i]) <= 1e-6 * effects[0]);
+    CHECK(sigma[i] <= 1e-6 * effects[0]);
+  }
+
+  // Effects of the inputs of a product depend on the other inputs
+  wobos_sensitivity product({"nTurb", "turbR", "feedStudy"}, {20.0, 3.0, 0.0}, {100.0, 10.0, 1e6}, out);
+  vector<double> pmu(3), pmuStar(3), psigma(3);
+  product.morris(50, 6, 1, 0, &pmu[0], &pmuStar[0], &psigma[0]);
+  CHECK(psigma[0] > 0.1 * pmuStar[0] && psigma[1] > 0.1 * pmuStar[1]);
+  CHECK(fabs(pmu[2] - 1e6) <= 1e-6 * pmuStar[0] && psigma[2] <= 1e-6 * pmuStar[0]);
+
+  CHECK_THROWS(sa.morris(10, 3, 1, 0, &mu[0], &muStar[0], &sigma[0]));
+  CHECK_THROWS(sa.morris(10, 0, 1, 0, &mu[0], &muStar[0], &sigma[0]));
+}
+
+
+static void test_bounds() {
+  double lo, hi;
+  wobos obos;
+  CHECK(wobos_sensitivity::default_bounds("waterD", 0.25, lo, hi));
+  CHECK(lo < obos.get_map_variable("waterD") && obos.get_map_variable("waterD") < hi);
+  CHECK(!wobos_sensitivity::default_bounds("substructure", 0.25, lo, hi));
+  CHECK(!wobos_sensitivity::default_bounds("total_bos_cost", 0.25, lo, hi));
+  CHECK(!wobos_sensitivity::default_bounds("nope", 0.25, lo, hi));
+
+  CHECK_THROWS(wobos_sensitivity({"waterD"}, {2.0}, {1.0}, {"totDevCost"}));
+  CHECK_THROWS(wobos_sensitivity({"waterD"}, {}, {}, {"totDevCost"}));
+  CHECK_THROWS(wobos_sensitivity({"nope"}, {0.0}, {1.0}, {"totDevCost"}));
+}
+
+
+int main() {
+  test_sobol();
+  test_morris();
+  test_bounds();
+  return test_result("test_wind_obos_sensitivity");
+}
@@ -0,0 +1,131 @@
+// Tests of the substructure kernels (lib_wind_obos_substructure.h): exp and log against the C library, at
+// random arguments and at the edges, and mass and cost against the wobos stage at every instruction set.
+
+#include "lib_wind_obos.h"
+#include "lib_wind_obos_substructure.h"
+#include "test_wind_obos.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <limits>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+using namespace std;
+
+
+// Number of doubles between two finite values of the same sign
+static uint64_t ulps(double a, double b) {
+  int64_t ia, ib;
+  memcpy(&ia, &a, sizeof a);
+  memcpy(&ib, &b, sizeof b);
+  return (ia > ib) ? ia - ib : ib - ia;
+}
+
+
+static bool same_bits(double a, double b) {return memcmp(&a, &b, sizeof(double)) == 0;}
+
+
+static void test_exp() {
+  const double inf = numeric_limits<double>::infinity();
+  mt19937_64 rng(1);
+  uniform_real_distribution<double> u(-745.0, 709.78);
+  for (int trial=0; trial<200000; trial++) {
+    double x = (trial % 2) ? u(rng) : u(rng) / 100.0, y = substructure_exp(x), ref = exp(x);
+    if (y == 0.0) CHECK(ref < 5e-308);
+    else CHECK(ulps(y, ref) <= 2);
+  }
+
+  // Overflow, the flush to zero, and exact values
+  CHECK(substructure_exp(709.79) == inf && substructure_exp(1e300) == inf && substructure_exp(inf) == inf);
+  CHECK(ulps(substructure_exp(709.78), exp(709.78)) <= 2);
+  CHECK(ulps(substructure_exp(-707.5), exp(-707.5)) <= 2);
+  CHECK(substructure_exp(-708.0) == 0.0 && substructure_exp(-745.2) == 0.0 && substructure_exp(-inf) == 0.0);
+  CHECK(substructure_exp(0.0) == 1.0 && substructure_exp(-0.0) == 1.0);
+  CHECK(substructure_exp(numeric_limits<double>::denorm_min()) == 1.0);
+  CHECK(std::isnan(substructure_exp(numeric_limits<double>::quiet_NaN())));
+}
+
+
+static void test_log() {
+  const double inf = numeric_limits<double>::infinity();
+  mt19937_64 rng(2);
+  uniform_real_distribution<double> mantissa(1.0, 2.0);
+  for (int trial=0; trial<200000; trial++) {
+    // Every exponent, subnormals included, and values next to 1 where the result nears zero
+    double x = ldexp(mantissa(rng), (int)(rng() % 2098) - 1074);
+    if (trial % 4 == 0) x = 1.0 + (mantissa(rng) - 1.5) * ldexp(1.0, -(int)(rng() % 50));
+    if (x == 0.0) continue;
+    CHECK(ulps(substructure_log(x), log(x)) <= 2);
+  }
+
+  const double tiny = numeric_limits<double>::denorm_min(), minNormal = numeric_limits<double>::min();
+  for (double x : {tiny, 3*tiny, minNormal / 3, minNormal, numeric_limits<double>::max(), 2.0, 0.5, 10.0})
+    CHECK(ulps(substructure_log(x), log(x)) <= 2);
+  CHECK(substructure_log(1.0) == 0.0);
+  CHECK(substructure_log(0.0) == -inf && substructure_log(-0.0) == -inf && substructure_log(inf) == inf);
+  CHECK(std::isnan(substructure_log(-1.0)) && std::isnan(substructure_log(-tiny)) && std::isnan(substructure_log(-inf)));
+  CHECK(std::isnan(substructure_log(numeric_limits<double>::quiet_NaN())));
+}
+
+
+// Rows of turbines and sites against plants of their own, with the stage of wobos.  The same rows at every
+// instruction set give the same bits; 103 rows leave some to the scalar remainder after the vectors.
+static void test_mass_cost() {
+  const int best = get_substructure_simd();
+  mt19937_64 rng(3);
+  const size_t n = 103;
+  const char *names[] = {"MONOPILE", "JACKET", "SPAR", "SEMISUBMERSIBLE"};
+  for (int sub : {MONOPILE, JACKET, SPAR, SEMISUBMERSIBLE}) {
+    const bool fixed = (sub == MONOPILE) || (sub == JACKET);
+    uniform_real_distribution<double> radius(3.0, 10.0), depth(fixed ? 5.0 : 100.0, fixed ? 100.0 : 500.0);
+    vector<double> turbR(n), waterD(n);
+    for (size_t j=0; j<n; j++) {
+      turbR[j]  = radius(rng);
+      waterD[j] = depth(rng);
+    }
+
+    wobos base;
+    base.set_map_variable("substructure", string(names[sub]));
+    base.map2variables();
+    vector<double> mass(n), cost(n), scalarMass(n), scalarCost(n);
+    set_substructure_simd(SUBSTRUCTURE_SIMD_SCALAR);
+    base.substructure_mass_cost(n, &turbR[0], &waterD[0], NULL, NULL, &scalarMass[0], &scalarCost[0]);
+    for (int level=best; level>=SUBSTRUCTURE_SIMD_SCALAR; level--) {
+      CHECK(set_substructure_simd(level) == level);
+      base.substructure_mass_cost(n, &turbR[0], &waterD[0], NULL, NULL, &mass[0], &cost[0]);
+      for (size_t j=0; j<n; j++) CHECK(same_bits(mass[j], scalarMass[j]) && same_bits(cost[j], scalarCost[j]));
+    }
+
+    // The jacket transition piece is the inverse of a difference, which loses about 100 times more
+    const double tol = (sub == JACKET) ? 1e-11 : 1e-13;
+    for (size_t j=0; j<n; j++) {
+      wobos obos(base);
+      obos.set_map_variable("turbR", turbR[j]);
+      obos.set_map_variable("waterD", waterD[j]);
+      obos.map2variables();
+      obos.set_vessel_defaults();
+      obos.run();
+      CHECK_CLOSE(scalarMass[j], obos.subTotM, tol);
+      CHECK_CLOSE(scalarCost[j], obos.subTotCost / obos.nTurb - obos.moorCost, tol);
+    }
+  }
+  CHECK(set_substructure_simd(best) == best);
+  CHECK(set_substructure_simd(best + 1) == best && set_substructure_simd(-1) == SUBSTRUCTURE_SIMD_SCALAR);
+  set_substructure_simd(best);
+
+  substructure_rates rates = substructure_rates();
+  double m, c;
+  CHECK_THROWS(substructure_mass_cost(7, rates, 1, substructure_column(NULL, 5.0), substructure_column(NULL, 30.0),
+				      substructure_column(NULL, 90.0), substructure_column(NULL, 0.0), &m, &c));
+}
+
+
+int main() {
+  test_exp();
+  test_log();
+  test_mass_cost();
+  return test_result("test_wind_obos_substructure");
+}
@@ -0,0 +1,122 @@
+// Tests of independent wobos objects and batches run from several threads at once: every thread gets the
+// results of a serial run, while the threads share the cable choice cache and one of them changes the cable
+// kernel level.  With make test WOBOS_PROFILE=1 the profiles of the objects and batches are checked as well.
+
+#include "lib_wind_obos.h"
+#include "lib_wind_obos_batch.h"
+#include "lib_wind_obos_cable_cost.h"
+#include "test_wind_obos.h"
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <cstring>
+
+using namespace std;
+
+
+static const vector<string> inputs = {"substructure", "nTurb", "turbR", "waterD", "distPort", "cableOptimizer"};
+static const vector<string> outputs = {"subTotCost", "totElecCost", "arrVoltage", "cab1CR", "cab2CR", "expCabCost",
+                                       "totAnICost", "totPnSCost", "total_bos_cost"};
+static const size_t nScenarios = 32;
+
+
+// Scenario table over the substructures, some with the cable optimizer switched on
+static vector<double> scenarios() {
+  vector<double> table;
+  for (size_t s=0; s<nScenarios; s++) {
+    double sub = s % 4;
+    double row[] = {sub, 20.0 + 10*(s % 5), 3.0 + 0.5*(s % 7), (sub < 2) ? 15.0 + 5*(s % 6) : 150.0 + 40*(s % 6),
+                    30.0 + 20*(s % 3), (double)((s / 4) % 2)};
+    table.insert(table.end(), row, row + inputs.size());
+  }
+  return table;
+}
+
+
+// Outputs of one scenario on its own object
+static void run_one(const double *in, double *out, wobos_profile *profile=NULL) {
+  wobos obos;
+  for (size_t i=0; i<inputs.size(); i++) obos.set_map_variable(inputs[i].c_str(), in[i]);
+  obos.map2variables();
+  obos.set_vessel_defaults();
+  obos.run();
+  obos.variables2map();
+  for (size_t i=0; i<outputs.size(); i++) out[i] = obos.get_map_variable(outputs[i].c_str());
+  if (profile) *profile = obos.profile;
+}
+
+
+static size_t differences(const vector<double> &a, const vector<double> &b) {
+  size_t n = 0;
+  for (size_t i=0; i<a.size(); i++) n += (memcmp(&a[i], &b[i], sizeof(double)) != 0);
+  return n;
+}
+
+
+int main() {
+  const vector<double> table = scenarios();
+  const size_t nOut = nScenarios * outputs.size();
+  vector<double> serial(nOut);
+  for (size_t s=0; s<nScenarios; s++) run_one(&table[s*inputs.size()], &serial[s*outputs.size()]);
+
+  // Threads of single runs in different orders and threads of parallel batches, all at once
+  const size_t nThreads = 8, nRounds = 4;
+  vector<size_t> mismatches(nThreads, 0), badProfiles(nThreads, 0);
+  vector<wobos_profile> batchProfiles(nThreads);
+  atomic<bool> done(false);
+  thread simd([&done] () {
+      for (int level=0; !done; level = (level + 1) % 3) {
+	set_cable_simd(level);
+	this_thread::yield();
+      }
+    });
+
+  vector<thread> pool;
+  for (size_t t=0; t<nThreads; t++)
+    pool.push_back(thread([&, t] () {
+	  vector<double> out(nOut);
+	  for (size_t r=0; r<nRounds; r++) {
+	    if (t % 2) {
+	      wobos_batch batch(inputs, outputs);
+	      batch.run_parallel(&table[0], nScenarios, &out[0], 3);
+	      batchProfiles[t].merge(batch.profile());
+	    }
+	    else {
+	      for (size_t k=0; k<nScenarios; k++) {
+		size_t s = (k*(t + 1) + r) % nScenarios;
+		wobos_profile profile;
+		run_one(&table[s*inputs.size()], &out[s*outputs.size()], &profile);
+		if (wobos_profile::enabled() ? (profile.calls[STAGE_BOS_COST] != 1.0) : (profile.seconds[STAGE_BOS_COST] != 0.0))
+		  badProfiles[t]++;
+	      }
+	    }
+	    mismatches[t] += differences(out, serial);
+	  }
+	}));
+  for (thread &p : pool) p.join();
+  done = true;
+  simd.join();
+
+  for (size_t t=0; t<nThreads; t++) {
+    CHECK(mismatches[t] == 0);
+    CHECK(badProfiles[t] == 0);
+  }
+
+  // Batch profiles count every scenario of every round, whichever thread of run_parallel ran it
+  for (size_t t=1; t<nThreads; t+=2) {
+    const wobos_profile &p = batchProfiles[t];
+    if (wobos_profile::enabled()) {
+      CHECK(p.calls[STAGE_SET_TURBINE_PARAMETERS] == nRounds*nScenarios);
+      CHECK(p.calls[STAGE_BOS_COST] == nRounds*nScenarios);
+      CHECK(p.calls[STAGE_ARRAY_CABLE_OPTIMIZER] == nRounds*nScenarios/2);
+      CHECK(p.seconds[STAGE_ELECTRICAL_INFRASTRUCTURE_COST] > 0.0);
+    }
+    else {
+      for (int k=0; k<NSTAGES; k++) CHECK(p.calls[k] == 0.0 && p.seconds[k] == 0.0 && p.candidates[k] == 0.0);
+    }
+  }
+
+  return test_result("test_wind_obos_threads");
+}
@@ -0,0 +1,105 @@
+#!/usr/bin/env python
+# encoding: utf-8
+
+# Tests of wobos objects and batches run from a pool of Python threads: every thread gets the results of a
+# serial run.  Runs against the CPython extension, or the ctypes interface with WOBOS_CTYPES=1 in the
+# environment (see make test).  Exits non-zero on failure.
+
+from __future__ import print_function
+import os, sys
+from concurrent.futures import ThreadPoolExecutor
+import numpy as np
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import wind_obos
+from wind_obos import wobos, wobos_batch
+
+inputs  = ['substructure', 'nTurb', 'turbR', 'waterD', 'distPort', 'cableOptimizer']
+outputs = ['subTotCost', 'totElecCost', 'arrVoltage', 'cab1CR', 'expCabCost', 'totAnICost', 'total_bos_cost']
+nrounds = 4
+
+def scenarios(n=32):
+    rows = []
+    for s in range(n):
+        sub = s % 4
+        rows.append([sub, 20 + 10*(s % 5), 3.0 + 0.5*(s % 7), 15.0 + 5*(s % 6) if sub < 2 else 150.0 + 40*(s % 6),
+                     30.0 + 20*(s % 3), (s // 4) % 2])
+    return np.array(rows, dtype=np.float64)
+
+
+def run_one(row):
+    w = wobos()
+    for k, v in zip(inputs, row):
+        w.variable_access(k, v)
+    w.run()
+    return [w.variable_access(k) for k in outputs]
+
+
+def spar():
+    w = wobos()
+    w.substructure('SPAR')
+    w.waterD(300.0)
+    w.nTurb(2)
+    return w
+
+
+def run_shared(w):
+    # Runs of one object from several threads take turns
+    w.run()
+    return w.total_bos_cost()
+
+
+def run_batch(table):
+    batch = wobos_batch(inputs, outputs)
+    out = [batch.run(table, nthreads=3) for r in range(nrounds)]
+    return out, batch.profile()
+
+
+def main():
+    table  = scenarios()
+    serial = np.array([run_one(row) for row in table])
+    failures = []
+
+    # A run starts from the subTotCost of the run before (doubled with two turbines), so each run of one object
+    # gives the next value of a sequence, whichever thread it comes from
+    nshared  = 512
+    twin     = spar()
+    sequence = [run_shared(twin) for r in range(nshared)]
+    shared   = spar()
+
+    with ThreadPoolExecutor(max_workers=8) as pool:
+        shares  = [pool.submit(run_shared, shared) for r in range(nshared)]
+        orders  = [np.roll(np.arange(len(table)), r) for r in range(8)]
+        singles = [pool.submit(lambda order: [run_one(row) for row in table[order]], order) for order in orders]
+        batches = [pool.submit(run_batch, table) for r in range(4)]
+        objects = [pool.submit(lambda: wobos().run_batch(inputs, table, outputs, nthreads=2)) for r in range(4)]
+
+        for order, f in zip(orders, singles):
+            if not np.array_equal(np.array(f.result()), serial[order]):
+                failures.append('single runs')
+        for f in shares:
+            if f.result() not in sequence:
+                failures.append('shared object')
+        for f in batches:
+            out, profile = f.result()
+            if not all(np.array_equal(o, serial) for o in out):
+                failures.append('batch')
+            calls = profile['calculate_bos_cost']['calls']
+            if calls != (nrounds*len(table) if wobos.profile_enabled() else 0):
+                failures.append('batch profile: %d calls' % calls)
+        for f in objects:
+            if not np.array_equal(f.result(), serial):
+                failures.append('run_batch')
+
+    if shared.total_bos_cost() != sequence[-1]:
+        failures.append('shared object after %d runs' % nshared)
+
+    interface = 'ctypes' if wind_obos.native is None else 'extension'
+    print('test_wind_obos_threads.py (%s): %d failed' % (interface, len(failures)))
+    for f in failures:
+        print('failed: ' + f)
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
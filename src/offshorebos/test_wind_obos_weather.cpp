@@ -0,0 +1,230 @@
+// Tests of the weather windows (lib_wind_obos_weather.h) against a search hour by hour, of weather stores
+// against the weather they were written from, and of wobos runs, contingencies and Jacobians with weather
+// attached.
+
+#include "lib_wind_obos.h"
+#include "lib_wind_obos_jacobian.h"
+#include "test_wind_obos.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <limits>
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+
+using namespace std;
+
+
+static void test_windows() {
+  mt19937_64 rng(5);
+  const double inf = numeric_limits<double>::infinity();
+  for (int trial=0; trial<200; trial++) {
+    size_t n = 1 + rng() % 200;
+    vector<double> wind(n), wave(n);
+    double p = (rng() % 100) / 100.0;
+    for (size_t h=0; h<n; h++) {
+      wind[h] = ((rng() % 1000) / 1000.0 < p) ? 5.0 : 20.0;
+      wave[h] = ((rng() % 1000) / 1000.0 < 0.9) ? 1.0 : 3.0;
+    }
+    weather_windows w(&wind[0], &wave[0], n, 10.0, 2.0);
+    auto good = [&] (size_t h) {return (wind[h % n] <= 10.0) && (wave[h % n] <= 2.0);};
+
+    for (int q=0; q<50; q++) {
+      size_t start = rng() % (3*n), length = rng() % (n + 3);
+      bool workable = true;
+      for (size_t k=0; k<length; k++) workable = workable && good(start + k);
+      CHECK(w.workable(start, length) == workable);
+
+      // Starts at t if it fits there and on the next hour that it fits from otherwise
+      double t = (rng() % (3000*n)) / 1000.0, len = (rng() % 10000) / 1000.0;
+      auto fits = [&] (double s) {
+        for (size_t h=(size_t)floor(s); h<(size_t)ceil(s + len); h++) if (!good(h)) return false;
+        return true;
+      };
+      double expected = inf;
+      if (fits(t)) expected = t;
+      else for (size_t h=(size_t)floor(t) + 1; h<(size_t)floor(t) + 2*n + 20; h++) if (fits((double)h)) {expected = h; break;}
+      CHECK(w.next_window(t, len) == expected);
+    }
+
+    // Delays over every start hour
+    double len = (rng() % 8000) / 1000.0 + 0.1;
+    vector<double> waits;
+    for (size_t h=0; h<n; h++) waits.push_back(w.next_window((double)h, ceil(len)) - h);
+    double mean = 0.0;
+    for (size_t h=0; h<n; h++) mean += waits[h] / n;
+    sort(waits.begin(), waits.end());
+    weather_delay d = w.delays(len);
+    if (isinf(mean)) CHECK(isinf(d.mean));
+    else CHECK_CLOSE(d.mean, mean, 1e-12);
+    CHECK(d.p50 == waits[(size_t)ceil(0.5*n) - 1]);
+    CHECK(d.p90 == waits[(size_t)ceil(0.9*n) - 1]);
+    CHECK(d.max == waits.back());
+  }
+}
+
+
+static void test_read_csv() {
+  const char* fname = "test_wind_obos_weather.csv";
+  {
+    ofstream f(fname);
+    f << "# comment\ntime, wave_height, wind_speed\n0,1,2\n1 , 2.5 ,3 # comment\n\n2,0.5,12\n";
+  }
+  shared_ptr<const wobos_weather> wx = wobos_weather::read_csv(fname);
+  CHECK(wx->hours() == 3);
+  CHECK(wx->wind()[0] == 2.0 && wx->wind()[1] == 3.0 && wx->wind()[2] == 12.0);
+  CHECK(wx->wave()[0] == 1.0 && wx->wave()[1] == 2.5 && wx->wave()[2] == 0.5);
+  {
+    ofstream f(fname);
+    f << "time,wind,hs\n0,1,x\n";
+  }
+  CHECK_THROWS(wobos_weather::read_csv(fname));
+  remove(fname);
+  CHECK_THROWS(wobos_weather::read_csv(fname));
+}
+
+
+// A weather store gives the columns and windows of the weather it was written from, with the stored runs read
+// from the mapping
+static void test_store() {
+  const char* fname = "test_wind_obos_weather.wmet";
+  const char* damaged = "test_wind_obos_weather_damaged.wmet";
+  shared_ptr<const wobos_weather> wx = site_weather(3*8760, 11);
+  const vector<pair<double, double> > limits = {{15.0, 2.5}, {12.0, 1.8}, {15.0, 2.5}, {0.0, 2.0}};
+  wx->write_store(fname, limits);
+
+  shared_ptr<const wobos_weather> store = wobos_weather::open(fname);
+  CHECK(store == wobos_weather::open_store(fname));
+  CHECK(store->hours() == wx->hours());
+  CHECK(equal(wx->wind(), wx->wind() + wx->hours(), store->wind()));
+  CHECK(equal(wx->wave(), wx->wave() + wx->hours(), store->wave()));
+
+  uint64_t size;
+  {
+    ifstream f(fname, ios::binary | ios::ate);
+    size = (uint64_t)f.tellg();
+  }
+  const char *begin = (const char*)store->wind() - 64, *end = begin + size;
+  vector<pair<double, double> > all(limits);
+  all.push_back(make_pair(10.0, 1.5));
+  for (const pair<double, double> &l : all) {
+    shared_ptr<const weather_windows> a = wx->windows(l.first, l.second), b = store->windows(l.first, l.second);
+    CHECK(b == store->windows(l.first, l.second));
+    CHECK(a->longest() == b->longest());
+    CHECK(equal(a->run_column(), a->run_column() + wx->hours(), b->run_column()));
+    bool stored = find(limits.begin(), limits.end(), l) != limits.end();
+    bool mapped = ((const char*)b->run_column() >= begin) && ((const char*)b->run_column() < end);
+    CHECK(mapped == stored);
+    for (double length : {3.0, 10.5, 30.0}) {
+      weather_delay x = a->delays(length), y = b->delays(length);
+      CHECK(x.mean == y.mean && x.p50 == y.p50 && x.p90 == y.p90 && x.max == y.max);
+      for (double t : {0.0, 17.25, 4000.5, 30000.0}) CHECK(a->next_window(t, length) == b->next_window(t, length));
+    }
+  }
+
+  // The same installation times with the weather in memory and from the store
+  wobos mem, mapped;
+  mem.weather = wx;
+  mapped.weather = store;
+  for (wobos* w : {&mem, &mapped}) {
+    w->set_map_variable("installSimulation", 1.0);
+    w->map2variables();
+    w->set_vessel_defaults();
+    w->run();
+  }
+  CHECK(mem.turbInstTime == mapped.turbInstTime && mem.subInstTime == mapped.subInstTime);
+  CHECK(mem.total_bos_cost == mapped.total_bos_cost);
+
+  // Truncated, of the other byte order, or with a wrong size in the header
+  vector<char> bytes(begin, end);
+  auto rewrite = [&] (const vector<char> &b) {
+    ofstream f(damaged, ios::binary | ios::trunc);
+    f.write(&b[0], b.size());
+  };
+  rewrite(vector<char>(bytes.begin(), bytes.begin() + 40));
+  CHECK_THROWS(wobos_weather::open_store(damaged));
+  vector<char> swapped(bytes);
+  reverse(swapped.begin() + 8, swapped.begin() + 12);
+  rewrite(swapped);
+  CHECK_THROWS(wobos_weather::open_store(damaged));
+  rewrite(vector<char>(bytes.begin(), bytes.end() - 64));
+  CHECK_THROWS(wobos_weather::open_store(damaged));
+  remove(damaged);
+  CHECK_THROWS(wobos_weather::open_store(damaged));
+
+  // A store without indexes indexes on first use
+  wx->write_store(damaged, {});
+  shared_ptr<const wobos_weather> bare = wobos_weather::open(damaged);
+  CHECK(bare->windows(15.0, 2.5)->longest() == wx->windows(15.0, 2.5)->longest());
+  remove(damaged);
+
+  // Released with the last reference, and mapped again when opened
+  store.reset();
+  mapped.weather.reset();
+  store = wobos_weather::open_store(fname);
+  CHECK(equal(wx->wind(), wx->wind() + wx->hours(), store->wind()));
+  remove(fname);
+}
+
+static void test_wobos() {
+  shared_ptr<const wobos_weather> wx = site_weather(5*8760, 7);
+
+  // Contingencies from the weather
+  wobos obos;
+  CHECK_THROWS(obos.set_weather_contingencies());
+  obos.weather = wx;
+  obos.map2variables();
+  obos.set_vessel_defaults();
+  weather_delay turbine, sub, cable;
+  obos.weather_delays(turbine, sub, cable);
+  obos.set_weather_contingencies();
+  CHECK(turbine.mean > 0.0 && sub.mean > 0.0 && cable.mean > 0.0);
+  CHECK_CLOSE(obos.turbCont, turbine.contingency, 1e-15);
+  CHECK_CLOSE(obos.substructCont, sub.contingency, 1e-15);
+  CHECK_CLOSE(obos.elecCont, cable.contingency, 1e-15);
+
+  // The installation simulation waits for windows in the weather instead of applying the contingencies
+  wobos calm, windy;
+  calm.set_map_variable("installSimulation", 1.0);
+  windy.set_map_variable("installSimulation", 1.0);
+  windy.weather = wx;
+  for (wobos* w : {&calm, &windy}) {
+    w->map2variables();
+    w->set_vessel_defaults();
+    w->run();
+  }
+  CHECK(windy.turbInstTime != calm.turbInstTime);
+
+  // The Jacobian runs with the same weather as run()
+  vector<string> inputs = {"distPort", "turbR", "waterD"};
+  vector<string> outputs = {"turbInstTime", "subInstTime", "turbine_install_cost", "substructure_install_cost",
+                            "total_bos_cost"};
+  for (double startHour : {0.0, 4000.0}) {
+    wobos w;
+    w.weather = wx;
+    w.set_map_variable("installSimulation", 1.0);
+    w.set_map_variable("installStartHour", startHour);
+    wobos ref(w);
+    ref.map2variables();
+    ref.set_vessel_defaults();
+    ref.run();
+    ref.variables2map();
+
+    wobos_jacobian jac(inputs, outputs);
+    vector<double> out(outputs.size()), J(outputs.size() * inputs.size());
+    jac.run(w, out.data(), J.data());
+    for (size_t i=0; i<outputs.size(); i++)
+      CHECK_CLOSE(out[i], ref.get_map_variable(outputs[i].c_str()), 1e-12);
+  }
+}
+
+
+int main() {
+  test_windows();
+  test_read_csv();
+  test_store();
+  test_wobos();
+  return test_result("test_wind_obos_weather");
+}
@@ -0,0 +1,115 @@
+// Tests of the weather sweep (lib_wind_obos_weather_sweep.h) against a plant of its own run at every start:
+// the statistics hold the same values, and are the same to the bit whatever the number of threads.
+
+#include "lib_wind_obos.h"
+#include "lib_wind_obos_weather_sweep.h"
+#include "test_wind_obos.h"
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+
+static wobos plant(const string &substructure, double seasonLength, shared_ptr<const wobos_weather> wx) {
+  wobos obos;
+  obos.set_map_variable("substructure", substructure);
+  obos.set_map_variable("installSeasonLength", seasonLength);
+  obos.weather = wx;
+  return obos;
+}
+
+
+// Statistics of the outputs of the plant run on its own at every start
+static vector<wobos_stats> starts_one_by_one(const wobos &obos, const vector<string> &out, double stepHours) {
+  vector<wobos_stats> st(out.size());
+  for (double start=0.0; start<obos.weather->hours(); start+=stepHours) {
+    wobos w(obos);
+    w.set_map_variable("installSimulation", 1.0);
+    w.set_map_variable("installStartHour", start);
+    w.map2variables();
+    w.set_vessel_defaults();
+    w.run();
+    w.variables2map();
+    for (size_t k=0; k<out.size(); k++) st[k].add(w.get_map_variable(out[k].c_str()));
+  }
+  return st;
+}
+
+
+// Same values, added in the same order or merged from other blocks
+static void check_close(const wobos_stats &a, const wobos_stats &b) {
+  CHECK(a.count == b.count && a.nans == b.nans && a.infs == b.infs);
+  CHECK(a.min == b.min && a.max == b.max);
+  CHECK_CLOSE(a.mean, b.mean, 1e-12);
+  CHECK_CLOSE(a.variance(), b.variance(), 1e-9);
+  for (double q : {0.0, 0.1, 0.5, 0.9, 1.0}) CHECK(a.quantile(q) == b.quantile(q));
+}
+
+
+static bool same_bits(double a, double b) {return memcmp(&a, &b, sizeof(double)) == 0;}
+
+
+// Same values merged in the same order
+static void check_same(const wobos_stats &a, const wobos_stats &b) {
+  CHECK(a.count == b.count && a.nans == b.nans && a.infs == b.infs);
+  CHECK(same_bits(a.min, b.min) && same_bits(a.max, b.max));
+  CHECK(same_bits(a.mean, b.mean) && same_bits(a.m2, b.m2));
+  for (double q : {0.0, 0.1, 0.5, 0.9, 1.0}) CHECK(same_bits(a.quantile(q), b.quantile(q)));
+  vector<double> e1, c1, e2, c2;
+  a.histogram(10, e1, c1);
+  b.histogram(10, e2, c2);
+  CHECK(e1 == e2 && c1 == c2);
+}
+
+
+static void test_sweep() {
+  shared_ptr<const wobos_weather> wx = site_weather(2*8760, 3);
+  const double step = 24.0;
+  for (const char *sub : {"MONOPILE", "JACKET"})
+    for (double seasonLength : {0.0, 60.0}) {
+      wobos obos = plant(sub, seasonLength, wx);
+      wobos_weather_sweep one, four;
+      one.run(obos, step, 1);
+      four.run(obos, step, 4);
+      vector<wobos_stats> ref = starts_one_by_one(obos, one.outputNames, step);
+      CHECK(one.starts() == 730 && four.starts() == 730);
+      for (size_t k=0; k<one.nOutputs(); k++) {
+	check_close(one.stats(k), ref[k]);
+	check_same(four.stats(k), one.stats(k));
+      }
+
+      // Installation times vary with the start, and with short seasons so does the number of seasons they take
+      const wobos_stats &time = one.stats(0), &seasons = one.stats(4);
+      CHECK(time.max > time.min);
+      if (seasonLength > 0.0) {
+	CHECK(seasons.min == ceil(time.min / seasonLength));
+	CHECK(seasons.max == ceil(time.max / seasonLength));
+      }
+      else CHECK(seasons.min == 1.0 && seasons.max == 1.0);
+
+      // Another run replaces the statistics
+      one.run(obos, 8760.0, 2);
+      CHECK(one.starts() == 2 && one.stats(0).count == 2);
+    }
+
+  // Floating substructures keep the closed-form times
+  wobos_weather_sweep floating({"subInstTime", "turbInstTime"});
+  wobos spar = plant("SPAR", 0.0, wx);
+  spar.set_map_variable("waterD", 300.0);
+  floating.run(spar, 48.0, 3);
+  CHECK(floating.starts() == 365);
+  for (size_t k=0; k<floating.nOutputs(); k++) CHECK(floating.stats(k).min == floating.stats(k).max);
+
+  CHECK_THROWS(wobos_weather_sweep({"nope"}));
+  CHECK_THROWS(floating.run(wobos(), 24.0, 1));
+  CHECK_THROWS(floating.run(spar, 0.0, 1));
+}
+
+
+int main() {
+  test_sweep();
+  return test_result("test_wind_obos_weather_sweep");
+}
@@ -2,6 +2,8 @@ from sys import platform
 import os
 from ctypes import *
 import csv
+import threading
+import numpy as np
 from distutils.sysconfig import get_config_var
 import six
 
@@ -56,6 +58,24 @@ flib = 'lib_wind_obos' + libext
 
 libpath = os.path.dirname(os.path.dirname(os.path.abspath(__file__))) + os.path.sep + flib
 
+# The library built by setup.py is also a CPython extension (lib_wind_obos_python.cpp), which skips the ctypes
+# argument conversion on the calls made for every run.  Libraries built by make, or WOBOS_CTYPES=1 in the
+# environment, use ctypes only.  Both interfaces share the library, so the ctypes entry points also work on
+# objects created by the extension.
+def load_native(path):
+    if os.environ.get('WOBOS_CTYPES'):
+        return None
+    try:
+        import importlib.util
+        spec   = importlib.util.spec_from_file_location('lib_wind_obos', path)
+        module = importlib.util.module_from_spec(spec)
+        spec.loader.exec_module(module)
+        return module
+    except (ImportError, AttributeError):
+        return None
+
+native = load_native(libpath)
+
 # Actual wobos class
 class wobos(object):
     # Load the library as a static class variable
@@ -68,6 +88,9 @@ class wobos(object):
     cpplib.pywobos_run.argtypes = [c_void_p]
     cpplib.pywobos_run.restype = None
     
+    cpplib.pywobos_run_incremental.argtypes = [c_void_p]
+    cpplib.pywobos_run_incremental.restype = None
+    
     cpplib.pywobos_set_vessel_defaults.argtypes = [c_void_p]
     cpplib.pywobos_set_vessel_defaults.restype = None
     
@@ -82,53 +105,350 @@ class wobos(object):
     
     cpplib.pywobos_get_map_variable.argtypes = [c_void_p, c_char_p]
     cpplib.pywobos_get_map_variable.restype = c_double
+
+    cpplib.pywobos_variable_index.argtypes = [c_char_p]
+    cpplib.pywobos_variable_index.restype = c_int
+
+    cpplib.pywobos_set_variable.argtypes = [c_void_p, c_int, c_double]
+    cpplib.pywobos_set_variable.restype = None
+
+    cpplib.pywobos_get_variable.argtypes = [c_void_p, c_int]
+    cpplib.pywobos_get_variable.restype = c_double
+
+    cpplib.pywobos_nvariables.argtypes = []
+    cpplib.pywobos_nvariables.restype = c_int
+
+    cpplib.pywobos_variable_name.argtypes = [c_int]
+    cpplib.pywobos_variable_name.restype = c_char_p
+
+    cpplib.pywobos_variable_flags.argtypes = [c_int]
+    cpplib.pywobos_variable_flags.restype = c_int
+
+    cpplib.pywobos_variable_percent_flag.argtypes = []
+    cpplib.pywobos_variable_percent_flag.restype = c_int
+
+    cpplib.pywobos_variables.argtypes = [c_void_p]
+    cpplib.pywobos_variables.restype = POINTER(c_double)
+
+    cpplib.pywobos_profile_enabled.argtypes = []
+    cpplib.pywobos_profile_enabled.restype = c_int
+
+    cpplib.pywobos_profile_nstages.argtypes = []
+    cpplib.pywobos_profile_nstages.restype = c_int
+
+    cpplib.pywobos_profile_stage_name.argtypes = [c_int]
+    cpplib.pywobos_profile_stage_name.restype = c_char_p
+
+    cpplib.pywobos_profile_get.argtypes = [c_void_p, POINTER(c_double), POINTER(c_double), POINTER(c_double)]
+    cpplib.pywobos_profile_get.restype = None
+
+    cpplib.pywobos_profile_reset.argtypes = [c_void_p]
+    cpplib.pywobos_profile_reset.restype = None
+    
+    cpplib.pywobos_cable_cache_clear.argtypes = []
+    cpplib.pywobos_cable_cache_clear.restype = None
+    
+    cpplib.pywobos_cable_cache_size.argtypes = []
+    cpplib.pywobos_cable_cache_size.restype = c_size_t
+    
+    cpplib.pywobos_cable_cache_capacity.argtypes = []
+    cpplib.pywobos_cable_cache_capacity.restype = c_size_t
+    
+    cpplib.pywobos_cable_cache_set_capacity.argtypes = [c_size_t]
+    cpplib.pywobos_cable_cache_set_capacity.restype = None
+    
+    cpplib.pywobos_cable_cache_stats.argtypes = [POINTER(c_ulonglong), POINTER(c_ulonglong)]
+    cpplib.pywobos_cable_cache_stats.restype = None
+
+    cpplib.pywobos_substructure_mass_cost.argtypes = [c_void_p, c_size_t] + [POINTER(c_double)]*6
+    cpplib.pywobos_substructure_mass_cost.restype = c_int
+
+    cpplib.pywobos_set_weather.argtypes = [c_void_p, c_size_t, POINTER(c_double), POINTER(c_double)]
+    cpplib.pywobos_set_weather.restype = c_int
+
+    cpplib.pywobos_read_weather.argtypes = [c_void_p, c_char_p]
+    cpplib.pywobos_read_weather.restype = c_int
+
+    cpplib.pywobos_weather_hours.argtypes = [c_void_p]
+    cpplib.pywobos_weather_hours.restype = c_size_t
+
+    cpplib.pywobos_weather_delays.argtypes = [c_void_p, POINTER(c_double)]
+    cpplib.pywobos_weather_delays.restype = c_int
+
+    cpplib.pywobos_set_weather_contingencies.argtypes = [c_void_p]
+    cpplib.pywobos_set_weather_contingencies.restype = c_int
+
+    cpplib.pywobos_set_array_layout.argtypes = [c_void_p, c_size_t, POINTER(c_double), POINTER(c_double),
+                                                c_size_t, POINTER(c_double), POINTER(c_double)]
+    cpplib.pywobos_set_array_layout.restype = c_int
+
+    # Library variable table (filled in below the class): names in table order, index of each name, and
+    # whether each variable is a percentage stored as a fraction.  The order is fixed for a library build.
+    var_names   = []
+    var_index   = {}
+    var_percent = None
     
     def __init__(self):
-        # Local wobos object
-        self.obj = wobos.cpplib.pywobos_new()
+        # Local wobos object, owned by the extension object if there is one
+        if native is not None:
+            self.nobj = native.wobos()
+            self.obj  = self.nobj.address
+        else:
+            self.nobj = None
+            self.obj  = wobos.cpplib.pywobos_new()
+
+        # ctypes releases the GIL during every library call, so the calls that make up a run are kept together
+        # (the extension locks its objects itself)
+        self.lock = threading.Lock()
+
+        # Variable table of the object as a NumPy array, sharing memory with the library
+        self.vals = np.ctypeslib.as_array(wobos.cpplib.pywobos_variables(self.obj), shape=(len(wobos.var_names),))
 
             
-    def run(self):
-        # Pull variables from map structure and store in class variables
-        wobos.cpplib.pywobos_map2variables(self.obj)
+    def run(self, incremental=False):
+        # With incremental=True, only the stages whose inputs changed since the last incremental run are
+        # recomputed (same results, faster when few inputs change between calls)
+        if self.nobj is not None:
+            # Same sequence in one call
+            self.nobj.run(incremental)
+            return
+
+        with self.lock:
+            # Pull variables from map structure and store in class variables
+            wobos.cpplib.pywobos_map2variables(self.obj)
 
-        # Since might have reset the substructure, reset the vessel defaults
-        wobos.cpplib.pywobos_set_vessel_defaults(self.obj)
+            # Since might have reset the substructure, reset the vessel defaults
+            wobos.cpplib.pywobos_set_vessel_defaults(self.obj)
 
-        # Run the BOS model
-        wobos.cpplib.pywobos_run(self.obj)
+            # Run the BOS model
+            if incremental:
+                wobos.cpplib.pywobos_run_incremental(self.obj)
+            else:
+                wobos.cpplib.pywobos_run(self.obj)
 
-        # Copy outputs to map structure for easier access
-        wobos.cpplib.pywobos_variables2map(self.obj)
+            # Copy outputs to map structure for easier access
+            wobos.cpplib.pywobos_variables2map(self.obj)
+
+
+    def index(self, key):
+        # Library index for a variable name (-1 if unknown)
+        return wobos.var_index.get(key, -1)
+
+
+    @staticmethod
+    def indices(keys):
+        # Library indices for a list of variable names, e.g. to index values() once per run
+        ids = np.array([wobos.var_index.get(k, -1) for k in keys], dtype=np.intp)
+        if (ids < 0).any():
+            raise KeyError('Unknown variables: ' + ', '.join(k for k, i in zip(keys, ids) if i < 0))
+        return ids
+
+
+    def values(self):
+        # The variable table of the library object, without copying: inputs written here are used by the next
+        # run(), and run() leaves the outputs here.  Writes bypass the percentage conversion of variable_access,
+        # so use set_values() unless percentages are already fractions.
+        return self.vals
+
+
+    def set_values(self, ids, vals):
+        # Same as variable_access(key, val) for every index in ids (see indices), with one NumPy operation
+        vals = np.asarray(vals, dtype=np.float64)
+        self.vals[ids] = np.where(wobos.var_percent[ids] & (vals > 1.0), vals * 1e-2, vals)
 
 
     def variable_access(self, key, val=None):
         # Generic Getter if val is empty, Setter if val is given
+        if self.nobj is not None:
+            if val is None:
+                return self.nobj.get(self.index(key))
+            self.nobj.set(self.index(key), val)
+            return None
         if val is None:
-            return wobos.cpplib.pywobos_get_map_variable(self.obj, six.b(key))
+            return wobos.cpplib.pywobos_get_variable(self.obj, self.index(key))
         else:
-            wobos.cpplib.pywobos_set_map_variable(self.obj, six.b(key), val)
+            wobos.cpplib.pywobos_set_variable(self.obj, self.index(key), val)
             return None
 
+
+    def run_batch(self, inputs, scenarios, outputs, nthreads=1):
+        # Evaluate one scenario per row of the 2-D array scenarios (columns ordered like the input names), each
+        # starting from the current variables of this object.  Returns a 2-D array with the outputs of each
+        # scenario.  Use nthreads=0 to spread the scenarios over all cores.
+        scenarios = np.ascontiguousarray(scenarios, dtype=np.float64).reshape(-1, len(inputs))
+        results   = np.empty((scenarios.shape[0], len(outputs)))
+        if self.nobj is not None:
+            self.nobj.run_batch(list(inputs), scenarios, list(outputs), results, nthreads)
+        else:
+            batch = wobos_batch(inputs, outputs)
+            with self.lock:
+                wobos.cpplib.pywobos_batch_set_baseline(batch.obj, self.obj)
+            batch.run_arrays(scenarios, results, nthreads)
+        return results
+
+
+    def substructure_mass_cost(self, waterD, turbR=None, hubH=None, rnaM=None):
+        # Mass (tonnes) and cost ($) of one substructure of the current type for every element of the arrays,
+        # broadcast against each other, e.g. over a grid of water depths.  Arguments left out take the values
+        # of this object.  Secondary steel and spar ballast are included, mooring is not, and nothing is
+        # multiplied by nTurb (see lib_wind_obos_substructure.h).
+        given = [(k, v) for k, v in enumerate((turbR, waterD, hubH, rnaM)) if v is not None]
+        arrs  = np.broadcast_arrays(*[np.asarray(v, dtype=np.float64) for k, v in given])
+        cols  = [None]*4
+        for (k, v), a in zip(given, arrs):
+            cols[k] = np.ascontiguousarray(a)
+        mass = np.empty(arrs[0].shape)
+        cost = np.empty(arrs[0].shape)
+        ptrs = [None if c is None else c.ctypes.data_as(POINTER(c_double)) for c in cols]
+        with self.lock:
+            wobos.cpplib.pywobos_map2variables(self.obj)
+            ok = wobos.cpplib.pywobos_substructure_mass_cost(self.obj, mass.size, *(ptrs + [mass.ctypes.data_as(POINTER(c_double)),
+                                                                                             cost.ctypes.data_as(POINTER(c_double))]))
+        if not ok:
+            raise ValueError('Unknown substructure type')
+        return mass, cost
+
+
+    def set_weather(self, wind=None, wave=None, fname=None):
+        # Hourly wind speed (m/s) and significant wave height (m) at the site, as arrays or from a csv-file or
+        # a weather store written by make_weather_store (see lib_wind_obos_weather.h), for installSimulation,
+        # weather_delays and set_weather_contingencies.  No arguments removes the weather.
+        with self.lock:
+            if fname is not None:
+                ok = wobos.cpplib.pywobos_read_weather(self.obj, fname.encode('utf-8'))
+                if not ok:
+                    raise IOError('Cannot read weather file: ' + fname)
+            elif wind is None:
+                wobos.cpplib.pywobos_set_weather(self.obj, 0, None, None)
+            else:
+                wind = np.ascontiguousarray(wind, dtype=np.float64).ravel()
+                wave = np.ascontiguousarray(wave, dtype=np.float64).ravel()
+                if wind.size != wave.size:
+                    raise ValueError('Need one wave height per wind speed')
+                wobos.cpplib.pywobos_set_weather(self.obj, wind.size, wind.ctypes.data_as(POINTER(c_double)),
+                                                 wave.ctypes.data_as(POINTER(c_double)))
+
+    def weather_hours(self):
+        return wobos.cpplib.pywobos_weather_hours(self.obj)
+
+    def weather_delays(self):
+        # Waits (hours) for a workable window of the installation of a turbine, a substructure and an array
+        # cable section over every start hour of the weather, with the current variables and vessels:
+        # {'turbine': {'hours':, 'mean':, 'p50':, 'p90':, 'max':, 'contingency':}, 'substructure': ..., 'cable': ...}
+        out = np.empty(18)
+        with self.lock:
+            wobos.cpplib.pywobos_map2variables(self.obj)
+            wobos.cpplib.pywobos_set_vessel_defaults(self.obj)
+            ok = wobos.cpplib.pywobos_weather_delays(self.obj, out.ctypes.data_as(POINTER(c_double)))
+        if not ok:
+            raise ValueError('No weather set')
+        keys = ['hours', 'mean', 'p50', 'p90', 'max', 'contingency']
+        vals = out.tolist()
+        return dict((name, dict(zip(keys, vals[6*k:6*k+6]))) for k, name in enumerate(['turbine', 'substructure', 'cable']))
+
+    def set_weather_contingencies(self):
+        # Replace turbCont, substructCont and elecCont by the contingencies of weather_delays()
+        with self.lock:
+            wobos.cpplib.pywobos_map2variables(self.obj)
+            wobos.cpplib.pywobos_set_vessel_defaults(self.obj)
+            ok = wobos.cpplib.pywobos_set_weather_contingencies(self.obj)
+        if not ok:
+            raise ValueError('No weather set, or no window long enough for an installation activity')
+
         
+    def set_array_layout(self, turbines=None, substations=None):
+        # Turbine and substation positions (m) as (n, 2) arrays, for array cable lengths from the strings of
+        # the layout instead of the arrayX by arrayY grid (see lib_wind_obos_array_layout.h).  Also sets nTurb.
+        # No arguments goes back to the grid.
+        with self.lock:
+            if turbines is None:
+                wobos.cpplib.pywobos_set_array_layout(self.obj, 0, None, None, 0, None, None)
+                return
+            turbines    = np.asarray(turbines, dtype=np.float64).reshape(-1, 2)
+            substations = np.asarray(substations, dtype=np.float64).reshape(-1, 2)
+            tx, ty = np.ascontiguousarray(turbines[:,0]), np.ascontiguousarray(turbines[:,1])
+            sx, sy = np.ascontiguousarray(substations[:,0]), np.ascontiguousarray(substations[:,1])
+            ok = wobos.cpplib.pywobos_set_array_layout(self.obj, tx.size, tx.ctypes.data_as(POINTER(c_double)),
+                                                       ty.ctypes.data_as(POINTER(c_double)), sx.size,
+                                                       sx.ctypes.data_as(POINTER(c_double)),
+                                                       sy.ctypes.data_as(POINTER(c_double)))
+        if not ok:
+            raise ValueError('Invalid array layout')
+
     def enum_access(self, key, LocalEnum, val=None):
         # Generic Getter if val is empty, Setter if val is given
         assert isinstance(LocalEnum, Enum)
         if val is None:
-            return LocalEnum[int(wobos.cpplib.pywobos_get_map_variable(self.obj, six.b(key)))]
+            return LocalEnum[int(wobos.cpplib.pywobos_get_variable(self.obj, self.index(key)))]
         else:
-            wobos.cpplib.pywobos_set_map_variable(self.obj, six.b(key), float(LocalEnum[val]))
+            wobos.cpplib.pywobos_set_variable(self.obj, self.index(key), float(LocalEnum[val]))
             return None
 
     def bool_access(self, key, val=None):
         if val is None:
-            return True if wobos.cpplib.pywobos_get_map_variable(self.obj, six.b(key))==1.0 else False
+            return True if wobos.cpplib.pywobos_get_variable(self.obj, self.index(key))==1.0 else False
         else:
             bval = 1.0 if val else 0.0
-            wobos.cpplib.pywobos_set_map_variable(self.obj, six.b(key), bval)
+            wobos.cpplib.pywobos_set_variable(self.obj, self.index(key), bval)
             return None
 
 
+    @staticmethod
+    def profile_enabled():
+        # True if the library was built with WOBOS_PROFILE, otherwise profiles stay at zero
+        return wobos.cpplib.pywobos_profile_enabled() != 0
+
+
+    def profile(self):
+        # Calls, wall time (seconds) and optimizer candidates per stage of run() since the last reset
+        return profile_dict(wobos.cpplib.pywobos_profile_get, self.obj)
+
+
+    def profile_reset(self):
+        wobos.cpplib.pywobos_profile_reset(self.obj)
+
+
+    @staticmethod
+    def cable_cache(capacity=None):
+        # Cable optimizer choices cached across all wobos objects of the process (see lib_wind_obos_cable_cache.h).
+        # Sets the number of choices kept if capacity is given (0 switches the cache off), and returns the
+        # capacity, the number of choices held, and the hits and misses since the last cable_cache_clear()
+        if capacity is not None:
+            wobos.cpplib.pywobos_cable_cache_set_capacity(int(capacity))
+        hits   = c_ulonglong(0)
+        misses = c_ulonglong(0)
+        wobos.cpplib.pywobos_cable_cache_stats(byref(hits), byref(misses))
+        return {'capacity':wobos.cpplib.pywobos_cable_cache_capacity(), 'size':wobos.cpplib.pywobos_cable_cache_size(),
+                'hits':hits.value, 'misses':misses.value}
+
+
+    @staticmethod
+    def cable_cache_clear():
+        wobos.cpplib.pywobos_cable_cache_clear()
+
+
+# Fill in the variable table description
+for k in range(wobos.cpplib.pywobos_nvariables()):
+    wobos.var_names.append(wobos.cpplib.pywobos_variable_name(k).decode())
+    wobos.var_index[wobos.var_names[-1]] = k
+wobos.var_percent = np.array([(wobos.cpplib.pywobos_variable_flags(k) & wobos.cpplib.pywobos_variable_percent_flag()) != 0
+                              for k in range(len(wobos.var_names))], dtype=bool)
+
+
+# Stage name -> dictionary of calls, seconds and candidates, from one of the library profile getters
+def profile_dict(getter, obj):
+    n = wobos.cpplib.pywobos_profile_nstages()
+    calls      = (c_double * n)()
+    seconds    = (c_double * n)()
+    candidates = (c_double * n)()
+    getter(obj, calls, seconds, candidates)
+    out = {}
+    for k in range(n):
+        name = wobos.cpplib.pywobos_profile_stage_name(k).decode()
+        out[name] = {'calls':int(calls[k]), 'seconds':seconds[k], 'candidates':int(candidates[k])}
+    return out
+
+
 # Variable defaults
 fdefaults  = 'wind_obos_defaults.csv'
 fpath      = os.path.dirname(os.path.abspath(__file__)) + os.path.sep + fdefaults
@@ -163,7 +483,7 @@ for k in poplist: wobos_vars.pop(k)
 # For a reason I don't quite understand, this has to be done outside of wobos (not in the __init__)
 # and divided between a for loop and a separate function (as opposed to stuffing everything in the loop)
 def add_variable_fn(fn_name):
-   if fn_name in ['cableOptimizer']:
+   if fn_name in ['cableOptimizer', 'installSimulation']:
        def fn(self, val=None): return self.bool_access(fn_name, val)
    elif fn_name == 'substructure':
        def fn(self, val=None): return self.enum_access(fn_name, Substructure, val)
@@ -182,3 +502,411 @@ def add_variable_fn(fn_name):
 
 for k in range(len(wobos_vars)):
     add_variable_fn(wobos_vars[k][1])
+
+
+# Batch evaluation of many scenarios with a single library call
+class wobos_batch(object):
+    cpplib = wobos.cpplib
+
+    # Establish interface types
+    cpplib.pywobos_batch_new.argtypes = [POINTER(c_char_p), c_int, POINTER(c_char_p), c_int]
+    cpplib.pywobos_batch_new.restype = c_void_p
+
+    cpplib.pywobos_batch_run.argtypes = [c_void_p, POINTER(c_double), c_int, POINTER(c_double)]
+    cpplib.pywobos_batch_run.restype = None
+
+    cpplib.pywobos_batch_run_parallel.argtypes = [c_void_p, POINTER(c_double), c_int, POINTER(c_double), c_int]
+    cpplib.pywobos_batch_run_parallel.restype = None
+
+    cpplib.pywobos_batch_delete.argtypes = [c_void_p]
+    cpplib.pywobos_batch_delete.restype = None
+
+    cpplib.pywobos_batch_profile_get.argtypes = [c_void_p, POINTER(c_double), POINTER(c_double), POINTER(c_double)]
+    cpplib.pywobos_batch_profile_get.restype = None
+
+    cpplib.pywobos_batch_profile_reset.argtypes = [c_void_p]
+    cpplib.pywobos_batch_profile_reset.restype = None
+
+    cpplib.pywobos_batch_set_baseline.argtypes = [c_void_p, c_void_p]
+    cpplib.pywobos_batch_set_baseline.restype = None
+
+    def __init__(self, inputs, outputs):
+        # Column names of the scenario (input) and result (output) tables
+        self.inputs  = list(inputs)
+        self.outputs = list(outputs)
+        inNames  = (c_char_p * len(self.inputs))(*[six.b(k) for k in self.inputs])
+        outNames = (c_char_p * len(self.outputs))(*[six.b(k) for k in self.outputs])
+        self.obj = wobos_batch.cpplib.pywobos_batch_new(inNames, len(self.inputs), outNames, len(self.outputs))
+        if not self.obj:
+            raise ValueError('Unknown variable name in batch inputs or outputs')
+
+
+    def __del__(self):
+        if getattr(self, 'obj', None):
+            wobos_batch.cpplib.pywobos_batch_delete(self.obj)
+
+
+    def run(self, scenarios, nthreads=1):
+        # Each scenario is a row of values ordered like self.inputs, returns rows ordered like self.outputs
+        # (a 2-D array if scenarios is one, lists otherwise).  Use nthreads=0 to spread the scenarios over all cores
+        inputs  = np.ascontiguousarray(scenarios, dtype=np.float64).reshape(-1, len(self.inputs))
+        outputs = np.empty((inputs.shape[0], len(self.outputs)))
+        self.run_arrays(inputs, outputs, nthreads)
+        return outputs if isinstance(scenarios, np.ndarray) else outputs.tolist()
+
+
+    def run_arrays(self, inputs, outputs, nthreads=1):
+        # Same as run() on contiguous float64 arrays, filling outputs in place
+        nrow = inputs.shape[0]
+        pin  = inputs.ctypes.data_as(POINTER(c_double))
+        pout = outputs.ctypes.data_as(POINTER(c_double))
+        if nthreads == 1:
+            wobos_batch.cpplib.pywobos_batch_run(self.obj, pin, nrow, pout)
+        else:
+            wobos_batch.cpplib.pywobos_batch_run_parallel(self.obj, pin, nrow, pout, nthreads)
+
+
+    def profile(self):
+        # Stage profile (see wobos.profile) summed over all scenarios run so far
+        return profile_dict(wobos_batch.cpplib.pywobos_batch_profile_get, self.obj)
+
+
+    def profile_reset(self):
+        wobos_batch.cpplib.pywobos_batch_profile_reset(self.obj)
+
+
+# Derivatives of outputs with respect to inputs (forward mode automatic differentiation)
+class wobos_jacobian(object):
+    cpplib = wobos.cpplib
+
+    # Establish interface types
+    cpplib.pywobos_jacobian_new.argtypes = [POINTER(c_char_p), c_int, POINTER(c_char_p), c_int]
+    cpplib.pywobos_jacobian_new.restype = c_void_p
+
+    cpplib.pywobos_jacobian_run.argtypes = [c_void_p, c_void_p, POINTER(c_double), POINTER(c_double), POINTER(c_ubyte)]
+    cpplib.pywobos_jacobian_run.restype = None
+
+    cpplib.pywobos_jacobian_delete.argtypes = [c_void_p]
+    cpplib.pywobos_jacobian_delete.restype = None
+
+    def __init__(self, inputs, outputs):
+        # Inputs must be continuous (not enumerated or boolean) variables
+        self.inputs  = list(inputs)
+        self.outputs = list(outputs)
+        inNames  = (c_char_p * len(self.inputs))(*[six.b(k) for k in self.inputs])
+        outNames = (c_char_p * len(self.outputs))(*[six.b(k) for k in self.outputs])
+        self.obj = wobos_jacobian.cpplib.pywobos_jacobian_new(inNames, len(self.inputs), outNames, len(self.outputs))
+        if not self.obj:
+            raise ValueError('Unknown or non-continuous variable name in jacobian inputs or outputs')
+
+
+    def __del__(self):
+        if getattr(self, 'obj', None):
+            wobos_jacobian.cpplib.pywobos_jacobian_delete(self.obj)
+
+
+    def run(self, obos):
+        # Evaluates from the current variables of the wobos object obos, which is left unchanged.
+        # Returns the outputs, the Jacobian as rows of d(output)/d(input), and rows of flags that are True
+        # where the derivative ignores a step (ceil/floor/cable choice) in the output.
+        nin  = len(self.inputs)
+        nout = len(self.outputs)
+        outputs  = (c_double * nout)()
+        jacobian = (c_double * (nout*nin))()
+        steps    = (c_ubyte * (nout*nin))()
+        wobos_jacobian.cpplib.pywobos_jacobian_run(self.obj, obos.obj, outputs, jacobian, steps)
+        return (list(outputs),
+                [list(jacobian[k*nin:(k+1)*nin]) for k in range(nout)],
+                [[bool(v) for v in steps[k*nin:(k+1)*nin]] for k in range(nout)])
+
+
+# Monte Carlo propagation of input uncertainty, with statistics kept in the library as samples stream through
+class wobos_montecarlo(object):
+    cpplib = wobos.cpplib
+
+    # Distribution kinds and their number of parameters
+    kinds = {'uniform': (0, 2), 'normal': (1, 2), 'triangular': (2, 3), 'lognormal': (3, 2)}
+
+    # Establish interface types
+    cpplib.pywobos_mc_new.argtypes = [POINTER(c_char_p), POINTER(c_int), POINTER(c_double), POINTER(c_double), c_int,
+                                      POINTER(c_char_p), c_int]
+    cpplib.pywobos_mc_new.restype = c_void_p
+
+    cpplib.pywobos_mc_set_baseline.argtypes = [c_void_p, c_void_p]
+    cpplib.pywobos_mc_set_baseline.restype = None
+
+    cpplib.pywobos_mc_run.argtypes = [c_void_p, c_double, c_double, c_int]
+    cpplib.pywobos_mc_run.restype = None
+
+    cpplib.pywobos_mc_samples.argtypes = [c_void_p]
+    cpplib.pywobos_mc_samples.restype = c_double
+
+    cpplib.pywobos_mc_stats.argtypes = [c_void_p, c_int, POINTER(c_double)]
+    cpplib.pywobos_mc_stats.restype = None
+
+    cpplib.pywobos_mc_quantile.argtypes = [c_void_p, c_int, c_double]
+    cpplib.pywobos_mc_quantile.restype = c_double
+
+    cpplib.pywobos_mc_histogram.argtypes = [c_void_p, c_int, c_int, POINTER(c_double), POINTER(c_double)]
+    cpplib.pywobos_mc_histogram.restype = None
+
+    cpplib.pywobos_mc_reset.argtypes = [c_void_p]
+    cpplib.pywobos_mc_reset.restype = None
+
+    cpplib.pywobos_mc_delete.argtypes = [c_void_p]
+    cpplib.pywobos_mc_delete.restype = None
+
+    def __init__(self, inputs, outputs, base=None):
+        # inputs maps variable names (a dict or list of pairs) to a distribution (kind, parameters...):
+        #   ('uniform', lower, upper), ('normal', mean, std), ('triangular', lower, mode, upper) or
+        #   ('lognormal', mean of log, std of log), optionally followed by truncation bounds lower, upper.
+        # Samples start from the variables of the wobos object base, or from the defaults.
+        pairs = list(inputs.items()) if isinstance(inputs, dict) else list(inputs)
+        self.inputs  = [name for name, _ in pairs]
+        self.outputs = list(outputs)
+        nin = len(self.inputs)
+        types  = (c_int * max(nin, 1))()
+        params = (c_double * max(3*nin, 1))()
+        bounds = (c_double * max(2*nin, 1))()
+        for k, (name, dist) in enumerate(pairs):
+            kind = dist[0].lower()
+            if kind not in wobos_montecarlo.kinds:
+                raise ValueError('Unknown distribution for %s: %s' % (name, dist[0]))
+            types[k], npar = wobos_montecarlo.kinds[kind]
+            vals = [float(v) for v in dist[1:]]
+            if len(vals) not in (npar, npar+2):
+                raise ValueError('Distribution %s for %s takes %d parameters and optional bounds' % (kind, name, npar))
+            for i in range(npar):
+                params[3*k+i] = vals[i]
+            bounds[2*k]   = vals[npar] if len(vals) > npar else -np.inf
+            bounds[2*k+1] = vals[npar+1] if len(vals) > npar else np.inf
+        inNames  = (c_char_p * max(nin, 1))(*[six.b(k) for k in self.inputs])
+        outNames = (c_char_p * max(len(self.outputs), 1))(*[six.b(k) for k in self.outputs])
+        self.obj = wobos_montecarlo.cpplib.pywobos_mc_new(inNames, types, params, bounds, nin, outNames, len(self.outputs))
+        if not self.obj:
+            raise ValueError('Unknown variable name or invalid distribution in Monte Carlo inputs or outputs')
+        if base is not None:
+            self.set_baseline(base)
+
+
+    def __del__(self):
+        if getattr(self, 'obj', None):
+            wobos_montecarlo.cpplib.pywobos_mc_delete(self.obj)
+
+
+    def set_baseline(self, obos):
+        with obos.lock:
+            wobos_montecarlo.cpplib.pywobos_mc_set_baseline(self.obj, obos.obj)
+
+
+    def run(self, nsamples, seed=0, nthreads=0):
+        # Adds nsamples samples to the statistics (nthreads=0 uses all cores).  The same seed and sample
+        # counts give the same statistics whatever the number of threads.
+        wobos_montecarlo.cpplib.pywobos_mc_run(self.obj, nsamples, seed, nthreads)
+
+
+    def samples(self):
+        return int(wobos_montecarlo.cpplib.pywobos_mc_samples(self.obj))
+
+
+    def stats(self):
+        # Dictionary of output name to its count, nans (samples where it was NaN), mean, std, min, max and
+        # infs (samples where it was infinite, which are in count, min and max but not in mean and std)
+        vals = (c_double * 7)()
+        result = {}
+        for k, name in enumerate(self.outputs):
+            wobos_montecarlo.cpplib.pywobos_mc_stats(self.obj, k, vals)
+            result[name] = dict(zip(['count', 'nans', 'mean', 'std', 'min', 'max', 'infs'], list(vals)))
+        return result
+
+
+    def quantile(self, output, q):
+        # Value(s) of the output at quantile(s) q, within the relative accuracy of the sketch (0.5%)
+        k = self.outputs.index(output)
+        if np.isscalar(q):
+            return wobos_montecarlo.cpplib.pywobos_mc_quantile(self.obj, k, q)
+        return [wobos_montecarlo.cpplib.pywobos_mc_quantile(self.obj, k, v) for v in q]
+
+
+    def histogram(self, output, nbins=20):
+        # Bin edges and counts between the smallest and largest value of the output
+        k = self.outputs.index(output)
+        edges  = np.empty(nbins+1)
+        counts = np.empty(nbins)
+        wobos_montecarlo.cpplib.pywobos_mc_histogram(self.obj, k, nbins, edges.ctypes.data_as(POINTER(c_double)),
+                                                     counts.ctypes.data_as(POINTER(c_double)))
+        return edges, counts
+
+
+    def reset(self):
+        wobos_montecarlo.cpplib.pywobos_mc_reset(self.obj)
+
+
+# Installation started at every step of the site weather, for the spread of installation times and costs
+class wobos_weather_sweep(object):
+    cpplib = wobos.cpplib
+
+    # Establish interface types
+    cpplib.pywobos_sweep_new.argtypes = [POINTER(c_char_p), c_int]
+    cpplib.pywobos_sweep_new.restype = c_void_p
+
+    cpplib.pywobos_sweep_run.argtypes = [c_void_p, c_void_p, c_double, c_int]
+    cpplib.pywobos_sweep_run.restype = c_int
+
+    cpplib.pywobos_sweep_starts.argtypes = [c_void_p]
+    cpplib.pywobos_sweep_starts.restype = c_double
+
+    cpplib.pywobos_sweep_stats.argtypes = [c_void_p, c_int, POINTER(c_double)]
+    cpplib.pywobos_sweep_stats.restype = None
+
+    cpplib.pywobos_sweep_quantile.argtypes = [c_void_p, c_int, c_double]
+    cpplib.pywobos_sweep_quantile.restype = c_double
+
+    cpplib.pywobos_sweep_delete.argtypes = [c_void_p]
+    cpplib.pywobos_sweep_delete.restype = None
+
+    def __init__(self, outputs=None):
+        # Outputs to gather; totInstTime, turbine_install_cost, substructure_install_cost, mob_demob_cost and
+        # installSeasons if None
+        self.outputs = list(outputs or ['totInstTime', 'turbine_install_cost', 'substructure_install_cost',
+                                        'mob_demob_cost', 'installSeasons'])
+        outNames = (c_char_p * len(self.outputs))(*[six.b(k) for k in self.outputs])
+        self.obj = wobos_weather_sweep.cpplib.pywobos_sweep_new(outNames, len(self.outputs))
+        if not self.obj:
+            raise ValueError('Unknown variable name in weather sweep outputs')
+
+
+    def __del__(self):
+        if getattr(self, 'obj', None):
+            wobos_weather_sweep.cpplib.pywobos_sweep_delete(self.obj)
+
+
+    def run(self, obos, step=24.0, nthreads=0):
+        # Starts the installation of the wobos object obos, which needs weather (see wobos.set_weather), every
+        # step hours of its weather, with installSimulation on (nthreads=0 uses all cores)
+        with obos.lock:
+            ok = wobos_weather_sweep.cpplib.pywobos_sweep_run(self.obj, obos.obj, step, nthreads)
+        if not ok:
+            raise ValueError('No weather to start the installation in, or step not positive')
+
+
+    def starts(self):
+        return int(wobos_weather_sweep.cpplib.pywobos_sweep_starts(self.obj))
+
+
+    def stats(self):
+        # Dictionary of output name to its count, nans, mean, std, min, max, infs, p50 and p90 over the starts
+        vals = (c_double * 7)()
+        result = {}
+        for k, name in enumerate(self.outputs):
+            wobos_weather_sweep.cpplib.pywobos_sweep_stats(self.obj, k, vals)
+            result[name] = dict(zip(['count', 'nans', 'mean', 'std', 'min', 'max', 'infs'], list(vals)))
+            result[name]['p50'] = wobos_weather_sweep.cpplib.pywobos_sweep_quantile(self.obj, k, 0.5)
+            result[name]['p90'] = wobos_weather_sweep.cpplib.pywobos_sweep_quantile(self.obj, k, 0.9)
+        return result
+
+
+    def quantile(self, output, q):
+        # Value(s) of the output at quantile(s) q, within the relative accuracy of the sketch (0.5%)
+        k = self.outputs.index(output)
+        if np.isscalar(q):
+            return wobos_weather_sweep.cpplib.pywobos_sweep_quantile(self.obj, k, q)
+        return [wobos_weather_sweep.cpplib.pywobos_sweep_quantile(self.obj, k, v) for v in q]
+
+
+# Global sensitivity (Sobol indices and Morris elementary effects) of outputs to inputs varied between bounds
+class wobos_sensitivity(object):
+    cpplib = wobos.cpplib
+
+    # Establish interface types
+    cpplib.pywobos_sa_new.argtypes = [POINTER(c_char_p), POINTER(c_double), POINTER(c_double), c_int, POINTER(c_char_p), c_int]
+    cpplib.pywobos_sa_new.restype = c_void_p
+
+    cpplib.pywobos_sa_default_bounds.argtypes = [c_char_p, c_double, POINTER(c_double), POINTER(c_double)]
+    cpplib.pywobos_sa_default_bounds.restype = c_int
+
+    cpplib.pywobos_sa_set_baseline.argtypes = [c_void_p, c_void_p]
+    cpplib.pywobos_sa_set_baseline.restype = None
+
+    cpplib.pywobos_sa_sobol.argtypes = [c_void_p, c_double, c_double, c_int, POINTER(c_double), POINTER(c_double)]
+    cpplib.pywobos_sa_sobol.restype = None
+
+    cpplib.pywobos_sa_morris.argtypes = [c_void_p, c_double, c_int, c_double, c_int, POINTER(c_double), POINTER(c_double), POINTER(c_double)]
+    cpplib.pywobos_sa_morris.restype = c_int
+
+    cpplib.pywobos_sa_delete.argtypes = [c_void_p]
+    cpplib.pywobos_sa_delete.restype = None
+
+    @staticmethod
+    def default_bounds(name, spread=0.25):
+        # (lower, upper) from the Constraints column of the defaults, missing bounds at the default -/+ spread
+        # times its magnitude.  None for outputs, enumerated inputs and inputs that run() fills in when zero.
+        lo = c_double()
+        hi = c_double()
+        if wobos_sensitivity.cpplib.pywobos_sa_default_bounds(six.b(name), spread, byref(lo), byref(hi)):
+            return (lo.value, hi.value)
+        return None
+
+
+    def __init__(self, outputs, inputs=None, bounds=None, spread=0.25, base=None):
+        # Varies the named inputs (every input with default bounds if None) uniformly between the bounds given
+        # as a dict of name to (lower, upper), or default_bounds(name, spread) otherwise.  Runs start from
+        # the variables of the wobos object base, or from the defaults.
+        bounds = dict(bounds or {})
+        if inputs is None:
+            inputs = [k for k in wobos.var_names if k in bounds or wobos_sensitivity.default_bounds(k, spread)]
+        self.inputs  = list(inputs)
+        self.outputs = list(outputs)
+        for k in self.inputs:
+            if k not in bounds:
+                bounds[k] = wobos_sensitivity.default_bounds(k, spread)
+                if bounds[k] is None:
+                    raise ValueError('No bounds for sensitivity input %s' % k)
+        nin = len(self.inputs)
+        lo = (c_double * max(nin, 1))(*[bounds[k][0] for k in self.inputs])
+        hi = (c_double * max(nin, 1))(*[bounds[k][1] for k in self.inputs])
+        self.bounds = [tuple(bounds[k]) for k in self.inputs]
+        inNames  = (c_char_p * max(nin, 1))(*[six.b(k) for k in self.inputs])
+        outNames = (c_char_p * max(len(self.outputs), 1))(*[six.b(k) for k in self.outputs])
+        self.obj = wobos_sensitivity.cpplib.pywobos_sa_new(inNames, lo, hi, nin, outNames, len(self.outputs))
+        if not self.obj:
+            raise ValueError('Unknown variable name or invalid bounds in sensitivity inputs or outputs')
+        if base is not None:
+            with base.lock:
+                wobos_sensitivity.cpplib.pywobos_sa_set_baseline(self.obj, base.obj)
+
+
+    def __del__(self):
+        if getattr(self, 'obj', None):
+            wobos_sensitivity.cpplib.pywobos_sa_delete(self.obj)
+
+
+    def tables(self, *arrays):
+        # Output name to a dict of input name to value, for every row-major nout x nin array
+        nin = len(self.inputs)
+        return [dict((name, dict(zip(self.inputs, a[k*nin:(k+1)*nin]))) for k, name in enumerate(self.outputs))
+                for a in arrays]
+
+
+    def sobol(self, n=1000, seed=0, nthreads=0):
+        # First-order (S1) and total (ST) indices from n base samples, n*(len(inputs)+2) runs in all.
+        # Returns output name to {'S1': {input: index}, 'ST': {input: index}}
+        size  = max(len(self.inputs) * len(self.outputs), 1)
+        first = (c_double * size)()
+        total = (c_double * size)()
+        wobos_sensitivity.cpplib.pywobos_sa_sobol(self.obj, n, seed, nthreads, first, total)
+        S1, ST = self.tables(list(first), list(total))
+        return dict((k, {'S1': S1[k], 'ST': ST[k]}) for k in self.outputs)
+
+
+    def morris(self, r=100, levels=4, seed=0, nthreads=0):
+        # Elementary effects over r trajectories, r*(len(inputs)+1) runs in all.  Effects are per full input range.
+        # Returns output name to {'mu': {input: value}, 'mu_star': {...}, 'sigma': {...}}
+        size   = max(len(self.inputs) * len(self.outputs), 1)
+        mu     = (c_double * size)()
+        muStar = (c_double * size)()
+        sigma  = (c_double * size)()
+        if not wobos_sensitivity.cpplib.pywobos_sa_morris(self.obj, r, levels, seed, nthreads, mu, muStar, sigma):
+            raise ValueError('Morris levels must be even and at least 2')
+        MU, MS, SG = self.tables(list(mu), list(muStar), list(sigma))
+        return dict((k, {'mu': MU[k], 'mu_star': MS[k], 'sigma': SG[k]}) for k in self.outputs)
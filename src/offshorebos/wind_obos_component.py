@@ -1,6 +1,6 @@
 from openmdao.api import Component, Group, IndepVarComp
 import numpy as np
-from .wind_obos import wobos, wobos_vars
+from .wind_obos import wobos, wobos_jacobian, wobos_vars
 
         
 class WindOBOSComp(Component):
@@ -16,20 +16,30 @@ class WindOBOSComp(Component):
         self.mywobos = wobos()
 
         # Go through all variables from wobos text file of defaults and add as either inputs or outputs
+        derivIn  = []
+        derivOut = []
         for k in range(len(wobos_vars)):
             passBy = not (type(wobos_vars[k][-2]) == type(0.0))
             if wobos_vars[k][1] in ['moorLines']:
                 passBy = False
             if wobos_vars[k][0].upper() == 'INPUT':
                 self.add_param(wobos_vars[k][1], desc=wobos_vars[k][2], units=wobos_vars[k][3], val=wobos_vars[k][-2], pass_by_obj=passBy)
+                if not passBy: derivIn.append(wobos_vars[k][1])
             elif wobos_vars[k][0].upper() == 'OUTPUT':
                 self.add_output(wobos_vars[k][1], desc=wobos_vars[k][2], units=wobos_vars[k][3], val=wobos_vars[k][-2], pass_by_obj=passBy)
+                if not passBy: derivOut.append(wobos_vars[k][1])
 
-        # Derivatives
-        self.deriv_options['type'] = 'fd'
-        self.deriv_options['form'] = 'central'
-        self.deriv_options['step_calc'] = 'relative'
-        self.deriv_options['step_size'] = 1e-5
+        # Derivatives by automatic differentiation in the library (see linearize)
+        self.deriv_options['type'] = 'user'
+        self.myjacobian = wobos_jacobian(derivIn, derivOut)
+
+        # Continuous variables move through the library variable table in one step each way, the others
+        # (enumerations given by name, booleans, counts) through their accessors
+        self.inNames  = derivIn
+        self.outNames = derivOut
+        self.inIds    = wobos.indices(derivIn)
+        self.outIds   = wobos.indices(derivOut)
+        self.byTable  = set(derivIn + derivOut)
 
     def solve_nonlinear(self, params, unknowns, resids):
         '''Sets mooring line properties then writes MAP input file and executes MAP.
@@ -44,14 +54,46 @@ class WindOBOSComp(Component):
 
         # Store local variables in wobos structure
         for k in params.keys():
-            self.mywobos.variable_access(k, params[k])
+            if k in self.byTable or k not in wobos.var_index: continue
+            getattr(self.mywobos, k)(params[k])
+        self.mywobos.set_values(self.inIds, [params[k] for k in self.inNames])
             
         # Run model
         self.mywobos.run()
 
         # Extract outputs
         for k in unknowns.keys():
+            if k in self.byTable: continue
             unknowns[k] = self.mywobos.variable_access(k)
+        outputs = self.mywobos.values()[self.outIds]
+        for k, val in zip(self.outNames, outputs):
+            unknowns[k] = val
+
+
+    def linearize(self, params, unknowns, resids):
+        '''Derivatives of the continuous outputs with respect to the continuous inputs.
+
+        Entries that step at discontinuities (ceil/floor, cable choices) hold the
+        derivative of the smooth piece around the current point.
+        '''
+
+        # Fresh object: after a run the variable table of self.mywobos also holds the previous outputs
+        obos = wobos()
+        for k in params.keys():
+            obos.variable_access(k, params[k])
+
+        # Percentages are stored as fractions in the library
+        scale = []
+        for k in self.myjacobian.inputs:
+            p = float(params[k])
+            scale.append( (obos.variable_access(k) / p) if p != 0.0 else 1.0 )
+
+        _, jac, _ = self.myjacobian.run(obos)
+        J = {}
+        for i, out in enumerate(self.myjacobian.outputs):
+            for j, inp in enumerate(self.myjacobian.inputs):
+                J[out, inp] = np.array([[jac[i][j] * scale[j]]])
+        return J
 
 
 class WindOBOS(Group):
@@ -76,6 +118,7 @@ class WindOBOS(Group):
         self.add('towerInstallMethod',           IndepVarComp('towerInstallMethod', 'ONEPIECE', pass_by_obj=True), promotes=['*'])
         self.add('installStrategy',              IndepVarComp('installStrategy', 'PRIMARYVESSEL', pass_by_obj=True), promotes=['*'])
         self.add('cableOptimizer',               IndepVarComp('cableOptimizer', False, pass_by_obj=True), promotes=['*'])
+        self.add('installSimulation',            IndepVarComp('installSimulation', False, pass_by_obj=True), promotes=['*'])
         self.add('buryDepth',                    IndepVarComp('buryDepth', 0.0), promotes=['*']) #2.0
         self.add('arrayY',                       IndepVarComp('arrayY', 0.0), promotes=['*']) #9.0
         self.add('arrayX',                       IndepVarComp('arrayX', 0.0), promotes=['*']) #9.0
@@ -117,6 +160,8 @@ class WindOBOS(Group):
         self.add('ssHeaveCR',                    IndepVarComp('ssHeaveCR', 0.0), promotes=['*']) #6250.0
         self.add('scourMat',                     IndepVarComp('scourMat', 0.0), promotes=['*']) #250000.0
         self.add('number_install_seasons',       IndepVarComp('number_install_seasons', 0, pass_by_obj=True), promotes=['*']) #1
+        self.add('installSeasonLength',          IndepVarComp('installSeasonLength', 0.0), promotes=['*']) #0.0
+        self.add('installStartHour',             IndepVarComp('installStartHour', 0.0), promotes=['*']) #0.0
         # Mooring
         self.add('deaFixLeng',                   IndepVarComp('deaFixLeng', 0.0), promotes=['*']) #250000.0
         #self.add('moorCR',                       IndepVarComp('moorCR', 0.0), promotes=['*']) #250000.0